@@ -0,0 +1,420 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/async_executor.h"
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstring>
+#include <utility>
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite_api {
+
+AsyncRequest::AsyncRequest() : impl_(new Impl) {}
+
+AsyncRequest::~AsyncRequest() = default;
+
+std::unique_ptr<Tensor> AsyncRequest::GetInput(int i) {
+  CHECK_GE(i, 0);
+  while (static_cast<int>(impl_->inputs.size()) <= i) {
+    impl_->inputs.emplace_back(new lite::Tensor);
+  }
+  return std::unique_ptr<Tensor>(new Tensor(impl_->inputs[i].get()));
+}
+
+std::unique_ptr<const Tensor> AsyncRequest::GetOutput(int i) const {
+  CHECK(i >= 0 && i < output_size()) << "The " << i
+                                     << "-th output is not available";
+  return std::unique_ptr<const Tensor>(
+      new Tensor(static_cast<const void*>(impl_->outputs[i].get())));
+}
+
+int AsyncRequest::input_size() const {
+  return static_cast<int>(impl_->inputs.size());
+}
+
+int AsyncRequest::output_size() const {
+  return static_cast<int>(impl_->outputs.size());
+}
+
+}  // namespace lite_api
+
+namespace lite {
+
+namespace {
+
+size_t ElementSize(const Tensor& tensor) {
+  return PrecisionTypeLength(tensor.precision());
+}
+
+// A sample is a sequence of the first level of the LoD if the tensor has the
+// LoD, otherwise a row of the first dim.
+int64_t SampleCount(const Tensor& tensor) {
+  if (!tensor.lod().empty()) {
+    return static_cast<int64_t>(tensor.lod()[0].size()) - 1;
+  }
+  return tensor.dims().size() > 0 ? tensor.dims()[0] : -1;
+}
+
+size_t RowBytes(const Tensor& tensor) {
+  auto& dims = tensor.dims();
+  return dims.count(1, static_cast<int>(dims.size())) * ElementSize(tensor);
+}
+
+bool SameData(const Tensor& a, const Tensor& b) {
+  if (a.dims() != b.dims() || a.lod() != b.lod()) return false;
+  size_t bytes = a.dims().production() * ElementSize(a);
+  return std::memcmp(a.raw_data(), b.raw_data(), bytes) == 0;
+}
+
+// Concatenate the tensors along the first dim, the offsets of each level of
+// the LoD are shifted by the last offset of the previous tensors.
+void ConcatTensors(const std::vector<const Tensor*>& tensors, Tensor* out) {
+  auto dims = tensors[0]->dims();
+  int64_t rows = 0;
+  for (auto* tensor : tensors) {
+    rows += tensor->dims()[0];
+  }
+  dims[0] = rows;
+  out->Resize(dims);
+  out->set_precision(tensors[0]->precision());
+  size_t row_bytes = RowBytes(*tensors[0]);
+  auto* dst = static_cast<char*>(
+      out->mutable_data(TARGET(kHost), static_cast<size_t>(rows) * row_bytes));
+  LoD lod = tensors[0]->lod();
+  for (size_t i = 0; i < tensors.size(); i++) {
+    size_t bytes = static_cast<size_t>(tensors[i]->dims()[0]) * row_bytes;
+    std::memcpy(dst, tensors[i]->raw_data(), bytes);
+    dst += bytes;
+    if (i == 0) continue;
+    auto& src_lod = tensors[i]->lod();
+    for (size_t level = 0; level < lod.size(); level++) {
+      uint64_t shift = lod[level].back();
+      for (size_t j = 1; j < src_lod[level].size(); j++) {
+        lod[level].push_back(src_lod[level][j] + shift);
+      }
+    }
+  }
+  out->set_lod(lod);
+}
+
+// Copy the samples [begin, end) of the tensor.
+void SliceSamples(const Tensor& tensor,
+                  int64_t begin,
+                  int64_t end,
+                  Tensor* out) {
+  LoD lod;
+  uint64_t row_begin = static_cast<uint64_t>(begin);
+  uint64_t row_end = static_cast<uint64_t>(end);
+  for (auto& level : tensor.lod()) {
+    std::vector<uint64_t> offsets;
+    for (uint64_t i = row_begin; i <= row_end; i++) {
+      offsets.push_back(level[i] - level[row_begin]);
+    }
+    lod.push_back(offsets);
+    row_begin = level[row_begin];
+    row_end = level[row_end];
+  }
+  auto dims = tensor.dims();
+  dims[0] = static_cast<int64_t>(row_end - row_begin);
+  out->Resize(dims);
+  out->set_precision(tensor.precision());
+  size_t row_bytes = RowBytes(tensor);
+  size_t bytes = (row_end - row_begin) * row_bytes;
+  void* dst = out->mutable_data(TARGET(kHost), bytes);
+  std::memcpy(dst,
+              static_cast<const char*>(tensor.raw_data()) +
+                  row_begin * row_bytes,
+              bytes);
+  out->set_lod(lod);
+}
+
+void MergeRequests(const std::vector<lite_api::AsyncRequest*>& requests,
+                   const std::set<int>& unbatchable_inputs,
+                   lite_api::AsyncRequest* merged) {
+  auto& inputs = merged->impl()->inputs;
+  int input_size = requests[0]->input_size();
+  for (int i = 0; i < input_size; i++) {
+    inputs.emplace_back(new Tensor);
+    if (unbatchable_inputs.count(i)) {
+      inputs[i]->ShareDataWith(*requests[0]->impl()->inputs[i]);
+      continue;
+    }
+    std::vector<const Tensor*> tensors;
+    for (auto* request : requests) {
+      tensors.push_back(request->impl()->inputs[i].get());
+    }
+    ConcatTensors(tensors, inputs[i].get());
+  }
+}
+
+// Return false if any output of the batch doesn't have the batch axis.
+bool SplitOutputs(const lite_api::AsyncRequest& merged,
+                  const std::vector<int64_t>& batch_sizes,
+                  const std::vector<lite_api::AsyncRequest*>& requests) {
+  int64_t total = 0;
+  for (auto batch_size : batch_sizes) {
+    total += batch_size;
+  }
+  auto& outputs = merged.impl()->outputs;
+  for (auto& output : outputs) {
+    bool by_sequences =
+        !output->lod().empty() && SampleCount(*output) == total;
+    bool by_rows = output->lod().empty() && output->dims().size() > 0 &&
+                   output->dims()[0] == total;
+    if ((!by_sequences && !by_rows) || ElementSize(*output) == 0) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < requests.size(); i++) {
+    auto& request_outputs = requests[i]->impl()->outputs;
+    request_outputs.resize(outputs.size());
+  }
+  for (size_t j = 0; j < outputs.size(); j++) {
+    int64_t begin = 0;
+    for (size_t i = 0; i < requests.size(); i++) {
+      auto& request_output = requests[i]->impl()->outputs[j];
+      if (!request_output) request_output.reset(new Tensor);
+      SliceSamples(
+          *outputs[j], begin, begin + batch_sizes[i], request_output.get());
+      begin += batch_sizes[i];
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+AsyncBatchOptions MakeAsyncBatchOptions(
+    const lite_api::ConfigBase& config,
+    const std::vector<std::string>& input_names) {
+  AsyncBatchOptions options;
+  options.max_batch_size = config.async_max_batch_size();
+  options.timeout_us = config.async_batch_timeout_us();
+  for (auto& name : config.async_unbatchable_inputs()) {
+    auto it = std::find(input_names.begin(), input_names.end(), name);
+    if (it == input_names.end()) {
+      LOG(WARNING) << "The unbatchable input " << name << " is not found";
+      continue;
+    }
+    options.unbatchable_inputs.insert(
+        static_cast<int>(it - input_names.begin()));
+  }
+  return options;
+}
+
+void FeedAsyncRequest(const lite_api::AsyncRequest& request,
+                      const std::function<Tensor*(int)>& get_input) {
+  auto& inputs = request.impl()->inputs;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    CHECK(inputs[i]->IsInitialized()) << "The " << i
+                                      << "-th input of the request is not set";
+    get_input(static_cast<int>(i))->CopyDataFrom(*inputs[i]);
+  }
+}
+
+void FetchAsyncRequest(const std::vector<const Tensor*>& outputs,
+                       lite_api::AsyncRequest* request) {
+  auto& request_outputs = request->impl()->outputs;
+  request_outputs.resize(outputs.size());
+  for (size_t i = 0; i < outputs.size(); i++) {
+    if (!request_outputs[i]) request_outputs[i].reset(new Tensor);
+    request_outputs[i]->CopyDataFrom(*outputs[i]);
+  }
+}
+
+AsyncExecutor::AsyncExecutor(std::vector<Worker>&& workers,
+                             int queue_size,
+                             std::function<void()>&& thread_init,
+                             const AsyncBatchOptions& batch_options)
+    : workers_(std::move(workers)),
+      queue_size_(queue_size > 1 ? queue_size : 1),
+      thread_init_(std::move(thread_init)),
+      batch_options_(batch_options) {
+  CHECK(!workers_.empty());
+  batching_ = batch_options_.max_batch_size > 1;
+  for (auto& worker : workers_) {
+    threads_.emplace_back([this, &worker]() { WorkerLoop(worker); });
+  }
+}
+
+AsyncExecutor::~AsyncExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  not_empty_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+std::future<void> AsyncExecutor::Submit(
+    const std::shared_ptr<lite_api::AsyncRequest>& request,
+    lite_api::AsyncCallback callback) {
+  CHECK(request);
+  Task task;
+  task.request = request;
+  task.callback = std::move(callback);
+  auto future = task.promise.get_future();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [&]() { return queue_.size() < queue_size_; });
+    queue_.push_back(std::move(task));
+  }
+  not_empty_.notify_one();
+  return future;
+}
+
+void AsyncExecutor::WorkerLoop(const Worker& worker) {
+  if (thread_init_) thread_init_();
+  while (true) {
+    std::vector<Task> tasks;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_empty_.wait(lock, [&]() { return stop_ || !queue_.empty(); });
+      // The pending requests are finished before the workers exit.
+      if (queue_.empty()) return;
+      tasks.push_back(std::move(queue_.front()));
+      queue_.pop_front();
+      not_full_.notify_one();
+      if (batching_) CollectBatch(&lock, &tasks);
+    }
+    RunBatch(worker, &tasks);
+  }
+}
+
+int64_t AsyncExecutor::BatchSize(const lite_api::AsyncRequest& request) const {
+  int64_t batch_size = -1;
+  auto& inputs = request.impl()->inputs;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    auto& input = inputs[i];
+    if (!input->IsInitialized() || ElementSize(*input) == 0) return -1;
+    if (batch_options_.unbatchable_inputs.count(static_cast<int>(i))) {
+      continue;
+    }
+    if (batch_size < 0) batch_size = SampleCount(*input);
+  }
+  return batch_size > 0 ? batch_size : -1;
+}
+
+bool AsyncExecutor::CanBatch(const lite_api::AsyncRequest& a,
+                             const lite_api::AsyncRequest& b) const {
+  auto& a_inputs = a.impl()->inputs;
+  auto& b_inputs = b.impl()->inputs;
+  if (a_inputs.size() != b_inputs.size()) return false;
+  for (size_t i = 0; i < a_inputs.size(); i++) {
+    auto& x = *a_inputs[i];
+    auto& y = *b_inputs[i];
+    if (x.precision() != y.precision()) return false;
+    if (batch_options_.unbatchable_inputs.count(static_cast<int>(i))) {
+      if (!SameData(x, y)) return false;
+      continue;
+    }
+    auto& x_dims = x.dims();
+    auto& y_dims = y.dims();
+    if (x_dims.size() != y_dims.size() || x.lod().size() != y.lod().size()) {
+      return false;
+    }
+    for (size_t j = 1; j < x_dims.size(); j++) {
+      if (x_dims[j] != y_dims[j]) return false;
+    }
+  }
+  return true;
+}
+
+void AsyncExecutor::CollectBatch(std::unique_lock<std::mutex>* lock,
+                                 std::vector<Task>* tasks) {
+  auto& first = *tasks->front().request;
+  int64_t batch_size = BatchSize(first);
+  if (batch_size < 0) return;
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::microseconds(batch_options_.timeout_us);
+  while (batch_size < batch_options_.max_batch_size) {
+    if (!not_empty_.wait_until(*lock, deadline, [&]() {
+          return stop_ || !queue_.empty();
+        })) {
+      break;
+    }
+    // Keep the order of the requests, a batch stops at the first request
+    // which can't be merged.
+    if (queue_.empty()) break;
+    auto& next = *queue_.front().request;
+    int64_t next_size = BatchSize(next);
+    if (next_size < 0 ||
+        batch_size + next_size > batch_options_.max_batch_size ||
+        !CanBatch(first, next)) {
+      break;
+    }
+    tasks->push_back(std::move(queue_.front()));
+    queue_.pop_front();
+    not_full_.notify_one();
+    batch_size += next_size;
+  }
+}
+
+void AsyncExecutor::RunBatch(const Worker& worker, std::vector<Task>* tasks) {
+  std::vector<std::exception_ptr> errors(tasks->size());
+  bool done = false;
+  if (tasks->size() > 1) {
+    std::vector<lite_api::AsyncRequest*> requests;
+    std::vector<int64_t> batch_sizes;
+    for (auto& task : *tasks) {
+      requests.push_back(task.request.get());
+      batch_sizes.push_back(BatchSize(*task.request));
+    }
+    // Run the requests one by one if the batch fails, so that a bad request
+    // doesn't fail the others.
+    try {
+      lite_api::AsyncRequest merged;
+      MergeRequests(requests, batch_options_.unbatchable_inputs, &merged);
+      worker(&merged);
+      done = SplitOutputs(merged, batch_sizes, requests);
+      if (!done) {
+        LOG(WARNING) << "The outputs don't have the batch axis, disable the "
+                        "batching of the requests.";
+        batching_ = false;
+      }
+    } catch (...) {
+      done = false;
+    }
+  }
+  for (size_t i = 0; i < tasks->size() && !done; i++) {
+    try {
+      worker(tasks->at(i).request.get());
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+  for (size_t i = 0; i < tasks->size(); i++) {
+    auto& task = tasks->at(i);
+    auto& error = errors[i];
+    if (task.callback) {
+      try {
+        task.callback(task.request, error == nullptr);
+      } catch (...) {
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) {
+      task.promise.set_exception(error);
+    } else {
+      task.promise.set_value();
+    }
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
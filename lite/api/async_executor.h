@@ -0,0 +1,128 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <functional>
+#include <future>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <set>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/api/paddle_api.h"
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite_api {
+
+struct AsyncRequest::Impl {
+  std::vector<std::unique_ptr<lite::Tensor>> inputs;
+  std::vector<std::unique_ptr<lite::Tensor>> outputs;
+};
+
+}  // namespace lite_api
+
+namespace lite {
+
+// Copy the inputs of the request into the input tensors of a predictor.
+void FeedAsyncRequest(const lite_api::AsyncRequest& request,
+                      const std::function<Tensor*(int)>& get_input);
+
+// Copy the output tensors of a predictor into the outputs of the request.
+void FetchAsyncRequest(const std::vector<const Tensor*>& outputs,
+                       lite_api::AsyncRequest* request);
+
+struct AsyncBatchOptions {
+  // The max number of the samples of a batch, no batching if it's 1.
+  int max_batch_size{1};
+  // How long a worker waits for more requests to fill a batch.
+  int64_t timeout_us{0};
+  // The indices of the inputs without the batch axis.
+  std::set<int> unbatchable_inputs;
+};
+
+// Map the names of the unbatchable inputs of the config to the indices.
+AsyncBatchOptions MakeAsyncBatchOptions(
+    const lite_api::ConfigBase& config,
+    const std::vector<std::string>& input_names);
+
+/*
+ * A bounded executor of the requests of PaddlePredictor::RunAsync. Each worker
+ * runs on its own thread and owns a predictor, the requests are dispatched to
+ * the idle workers in the FIFO order, and Submit blocks while 'queue_size'
+ * requests are pending.
+ *
+ * If the batching is enabled, a worker merges the compatible requests at the
+ * front of the queue into one batch: the batchable inputs are concatenated
+ * along the first dim (the LoD is concatenated as well) and the unbatchable
+ * inputs must be equal. The outputs are split back by the sequences of the
+ * first level of the LoD or by the first dim, the requests run one by one if
+ * the outputs can't be split.
+ */
+class AsyncExecutor {
+ public:
+  using Worker = std::function<void(lite_api::AsyncRequest*)>;
+
+  // 'thread_init' is called on each worker thread before the first request,
+  // e.g. to set the threads of the math library.
+  AsyncExecutor(std::vector<Worker>&& workers,
+                int queue_size,
+                std::function<void()>&& thread_init = nullptr,
+                const AsyncBatchOptions& batch_options = AsyncBatchOptions());
+  // Finish the pending requests and join the workers.
+  ~AsyncExecutor();
+
+  std::future<void> Submit(
+      const std::shared_ptr<lite_api::AsyncRequest>& request,
+      lite_api::AsyncCallback callback);
+
+ private:
+  struct Task {
+    std::shared_ptr<lite_api::AsyncRequest> request;
+    lite_api::AsyncCallback callback;
+    std::promise<void> promise;
+  };
+
+  void WorkerLoop(const Worker& worker);
+  // The number of the samples of the request, or -1 if it can't be batched.
+  int64_t BatchSize(const lite_api::AsyncRequest& request) const;
+  bool CanBatch(const lite_api::AsyncRequest& a,
+                const lite_api::AsyncRequest& b) const;
+  // Pop the requests which can be batched with the first task until the batch
+  // is full or the timeout expires.
+  void CollectBatch(std::unique_lock<std::mutex>* lock,
+                    std::vector<Task>* tasks);
+  void RunBatch(const Worker& worker, std::vector<Task>* tasks);
+
+  std::vector<Worker> workers_;
+  size_t queue_size_;
+  std::function<void()> thread_init_;
+  AsyncBatchOptions batch_options_;
+  // The batching is disabled once the outputs of a batch can't be split.
+  std::atomic<bool> batching_{false};
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<Task> queue_;
+  bool stop_{false};
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -72,16 +72,21 @@ bool IsQuantizedMode(const std::shared_ptr<cpp::ProgramDesc> &program_desc) {
 
 void Predictor::SaveModel(const std::string &dir,
                           lite_api::LiteModelType model_type,
-                          bool record_info) {
+                          bool record_info,
+                          bool compress_weights) {
   if (!program_) {
     GenRuntimeProgram();
   }
+  program_->SaveTunedAlgosIntoProgramDesc(program_desc_);
   switch (model_type) {
     case lite_api::LiteModelType::kProtobuf:
       SaveModelPb(dir, *program_->exec_scope(), *program_desc_.get(), true);
       break;
     case lite_api::LiteModelType::kNaiveBuffer:
-      SaveModelNaive(dir, *program_->exec_scope(), *program_desc_.get());
+      SaveModelNaive(dir,
+                     *program_->exec_scope(),
+                     *program_desc_.get(),
+                     compress_weights);
       break;
     default:
       LOG(FATAL) << "Unknown model type";
@@ -192,6 +197,42 @@ lite::Tensor *Predictor::GetInput(size_t offset) {
 }
 #endif
 
+void Predictor::BindInput(size_t offset,
+                          void *data,
+                          size_t memory_size,
+                          const DDim &dims,
+                          PrecisionType precision,
+                          TargetType target) {
+  CHECK_LT(offset, input_names_.size())
+      << "The network has " << input_names_.size() << " inputs"
+      << ", the offset should be less than this.";
+  io_binding_.BindInput(offset, data, memory_size, dims, precision, target);
+}
+
+void Predictor::BindOutput(size_t offset,
+                           void *data,
+                           size_t memory_size,
+                           TargetType target) {
+  CHECK_LT(offset, output_names_.size())
+      << "The network has " << output_names_.size() << " outputs"
+      << ", the offset should be less than this.";
+  io_binding_.BindOutput(offset, data, memory_size, target);
+}
+
+void Predictor::ClearIOBindings() {
+  io_binding_.Clear(InputGetter(), OutputGetter());
+}
+
+IOBinding::TensorGetter Predictor::InputGetter() {
+  return [this](size_t offset) { return GetInput(offset); };
+}
+
+IOBinding::TensorGetter Predictor::OutputGetter() {
+  return [this](size_t offset) {
+    return const_cast<lite::Tensor *>(GetOutput(offset));
+  };
+}
+
 // get inputs names
 std::vector<std::string> Predictor::GetInputNames() { return input_names_; }
 
@@ -400,6 +441,21 @@ void Predictor::Build(const std::shared_ptr<cpp::ProgramDesc> &program_desc,
   program_->SaveRuntimProgramIntoProgramDesc(program_desc_);
 }
 
+void Predictor::BuildFromOptimizedModel(
+    const std::string &model_file, const std::vector<Place> &valid_places) {
+  LoadModelNaiveFromFile(model_file, scope_.get(), program_desc_.get());
+  // The same as the construction of the clones.
+  Program program(program_desc_, scope_, valid_places);
+  exec_scope_ = program.exec_scope();
+  valid_places_ = valid_places;
+  program_.reset(new RuntimeProgram(program_desc_, exec_scope_, kRootBlockIdx));
+  if (program_desc_->HasVersion()) {
+    program_->set_version(program_desc_->Version());
+  }
+  program_generated_ = true;
+  PrepareFeedFetch();
+}
+
 void Predictor::GenRuntimeProgram() {
   CHECK_EQ(exec_scope_, program_->exec_scope());
   program_generated_ = true;
@@ -19,7 +19,9 @@
 #include <string>
 #include <utility>
 #include <vector>
+#include "lite/api/async_executor.h"
 #include "lite/api/paddle_api.h"
+#include "lite/core/io_binding.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/optimizer/optimizer.h"
 #include "lite/core/program.h"
@@ -101,6 +103,12 @@ class LITE_API Predictor {
              const std::vector<std::string>& passes = {},
              const lite_api::CxxConfig& config = lite_api::CxxConfig());
 
+  // Build from the naive buffer model saved by SaveModel after optimizing,
+  // the kernels recorded in the model are created without running the
+  // optimizer again.
+  void BuildFromOptimizedModel(const std::string& model_file,
+                               const std::vector<Place>& valid_places);
+
   //////////////////////////////////////////////////////////
   // Function: Clone
   // Usage: Create a Predictor from an existed one,
@@ -161,6 +169,9 @@ class LITE_API Predictor {
     if (!program_generated_) {
       GenRuntimeProgram();
     }
+    if (!io_binding_.empty()) {
+      io_binding_.Prepare(InputGetter(), OutputGetter());
+    }
     CheckInputValid();
 
 #ifdef LITE_WITH_XPU
@@ -172,12 +183,54 @@ class LITE_API Predictor {
 #endif
 
     program_->Run();
+    if (!io_binding_.empty()) {
+      io_binding_.Finish(OutputGetter());
+    }
 
 #ifdef LITE_WITH_XPU
     lite::TargetWrapperXPU::FreeL3Cache();
 #endif
   }
 
+  void set_inter_op_threads(int inter_op_threads) {
+    if (!program_generated_) {
+      GenRuntimeProgram();
+    }
+    program_->set_inter_op_threads(inter_op_threads);
+  }
+
+  void set_op_stats_interval(int interval) {
+    if (!program_generated_) {
+      GenRuntimeProgram();
+    }
+    program_->set_op_stats_interval(interval);
+  }
+  void set_frozen(bool frozen) {
+    if (!program_generated_) {
+      GenRuntimeProgram();
+    }
+    program_->set_frozen(frozen);
+  }
+  void set_autotune(bool autotune) {
+    if (!program_generated_) {
+      GenRuntimeProgram();
+    }
+    program_->set_autotune(autotune);
+  }
+  void set_observer(const RuntimeProgram::InstructionObserver& observer) {
+    if (!program_generated_) {
+      GenRuntimeProgram();
+    }
+    program_->set_observer(observer);
+  }
+  std::vector<lite_api::OpStats> GetOpStats() const {
+    if (!program_) return std::vector<lite_api::OpStats>();
+    return program_->GetOpStats();
+  }
+  void ResetOpStats() {
+    if (program_) program_->ResetOpStats();
+  }
+
 #ifdef LITE_WITH_METAL
   void ConfigMetalContext(const lite_api::CxxConfig& config) {
     program_->ConfigMetalContext(config.metal_lib_path(),
@@ -214,6 +267,20 @@ class LITE_API Predictor {
   const lite::Tensor* GetOutput(size_t offset) const;
   std::vector<const lite::Tensor*> GetOutputs() const;
 
+  // Bind the user buffers as the memory of the offset-th input and output,
+  // they are used by every run until ClearIOBindings, see IOBinding.
+  void BindInput(size_t offset,
+                 void* data,
+                 size_t memory_size,
+                 const DDim& dims,
+                 PrecisionType precision,
+                 TargetType target);
+  void BindOutput(size_t offset,
+                  void* data,
+                  size_t memory_size,
+                  TargetType target);
+  void ClearIOBindings();
+
   const cpp::ProgramDesc& program_desc() const;
   // get a mutable tensor according to its name
   lite::Tensor* GetMutableTensor(const std::string& name);
@@ -226,7 +293,8 @@ class LITE_API Predictor {
   void SaveModel(
       const std::string& dir,
       lite_api::LiteModelType model_type = lite_api::LiteModelType::kProtobuf,
-      bool record_info = false);
+      bool record_info = false,
+      bool compress_weights = false);
   void SaveOpKernelInfo(const std::string& model_dir);
 
   /////////////////////////////////////////////////////////////////////////////
@@ -253,6 +321,9 @@ class LITE_API Predictor {
   void ClearTensorArray(
       const std::shared_ptr<const cpp::ProgramDesc>& program_desc);
 
+  IOBinding::TensorGetter InputGetter();
+  IOBinding::TensorGetter OutputGetter();
+
  private:
   std::shared_ptr<cpp::ProgramDesc> program_desc_;
   std::shared_ptr<Scope> scope_;
@@ -263,6 +334,7 @@ class LITE_API Predictor {
   std::vector<std::string> output_names_;
   std::vector<Place> valid_places_;
   std::vector<PrecisionType> input_precisions_;
+  IOBinding io_binding_;
 };
 
 class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
@@ -288,6 +360,12 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
       const std::string& name) const;
 
   void Run() override;
+  std::future<void> RunAsync(
+      const std::shared_ptr<lite_api::AsyncRequest>& request,
+      lite_api::AsyncCallback callback = nullptr) override;
+  void SetOpStatsInterval(int interval) override;
+  std::vector<lite_api::OpStats> GetOpStats() override;
+  void ResetOpStats() override;
 
   /// \brief Release all tmp tensor to compress the size of the memory pool.
   /// The memory pool is considered to be composed of a list of chunks, if
@@ -321,11 +399,40 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
       lite_api::LiteModelType model_type = lite_api::LiteModelType::kProtobuf,
       bool record_info = false) override;
 
+  bool IsOptimizedModelCacheHit() const override {
+    return optimized_model_cache_hit_;
+  }
+
+  void BindInput(int i,
+                 void* data,
+                 size_t memory_size,
+                 const lite_api::shape_t& shape,
+                 PrecisionType precision,
+                 TargetType target = TargetType::kHost) override;
+  void BindOutput(int i,
+                  void* data,
+                  size_t memory_size,
+                  TargetType target = TargetType::kHost) override;
+  void ClearIOBindings() override;
+
  private:
+  void RunAsyncRequest(lite_api::AsyncRequest* request);
+  // Build from the optimized model cache of the config if it's enabled.
+  void BuildWithOptimizedModelCache(const lite_api::CxxConfig& config,
+                                    const std::vector<Place>& places,
+                                    const std::vector<std::string>& passes);
+  void SaveOptimizedModelCache();
+
   std::shared_ptr<Predictor> raw_predictor_;
   lite_api::CxxConfig config_;
   std::mutex mutex_;
   bool status_is_cloned_;
+  std::mutex async_mutex_;
+  std::unique_ptr<AsyncExecutor> async_executor_;
+  bool optimized_model_cache_hit_{false};
+  // The cache file to save the optimized model into after the first run,
+  // since the algorithms are autotuned by the first run.
+  std::string optimized_model_cache_file_;
 };
 
 /*
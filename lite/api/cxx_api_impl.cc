@@ -13,15 +13,25 @@
 // limitations under the License.
 
 #include "lite/api/cxx_api.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <memory>
 #include <mutex>  //NOLINT
 #include <string>
 #include "lite/api/paddle_api.h"
+#include "lite/core/autotune.h"
 #include "lite/core/device_info.h"
 #include "lite/core/optimizer/mir/pass_manager.h"
 #include "lite/core/optimizer/mir/post_quant_dynamic_pass.h"
 #include "lite/core/optimizer/mir/sparse_conv_detect_pass.h"
+#include "lite/core/optimizer/mir/static_kernel_pick_pass.h"
+#include "lite/core/optimizer/mir/x86_sparse_weight_detect_pass.h"
 #include "lite/core/version.h"
+#include "lite/utils/env.h"
+#include "lite/utils/io.h"
+#include "lite/utils/timer.h"
 #ifdef LITE_USE_THREAD_POOL
 #include "lite/core/parallel_defines.h"
 #include "lite/core/thread_pool.h"
@@ -36,10 +46,131 @@
 #include <omp.h>
 #endif
 #include "lite/backends/x86/mklml.h"
+#include "lite/backends/x86/parallel.h"
 #endif
 namespace paddle {
 namespace lite {
 
+namespace {
+
+// The 64-bit FNV-1a hash.
+const uint64_t kHashOffsetBasis = 14695981039346656037ULL;
+const uint64_t kHashPrime = 1099511628211ULL;
+
+uint64_t HashBytes(const char *data, size_t size, uint64_t hash) {
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ static_cast<uint8_t>(data[i])) * kHashPrime;
+  }
+  return hash;
+}
+
+uint64_t HashString(const std::string &str, uint64_t hash) {
+  // Hash the size too, so the concatenations of the strings are unique.
+  const uint64_t size = str.size();
+  hash = HashBytes(reinterpret_cast<const char *>(&size), sizeof(size), hash);
+  return HashBytes(str.data(), str.size(), hash);
+}
+
+uint64_t HashFile(const std::string &path, uint64_t hash) {
+  hash = HashString(path, hash);
+  std::ifstream fin(path, std::ios::binary);
+  std::vector<char> buffer(1 << 20);
+  while (fin) {
+    fin.read(buffer.data(), buffer.size());
+    hash = HashBytes(buffer.data(), fin.gcount(), hash);
+  }
+  return hash;
+}
+
+// The environment variables read by the passes, which change the optimized
+// program as the config does.
+const char *kOptimizerEnvs[] = {SUBGRAPH_CUSTOM_PARTITION_CONFIG_FILE,
+                                SUBGRAPH_ONLINE_MODE,
+                                CONSTANT_FOLDING_MAX_BYTES,
+                                "XPUForceUseFP16",
+                                "XPU_ENCODER_PRECISION",
+                                "XPU_COMPUTE_PRECISION",
+                                "XPU_ENABLE_XTCL",
+                                "LITE_DISABLE_MLU_CAST"};
+
+// The path of the optimized model of 'config' in the cache, without the
+// suffix '.nb', or empty if the model can't be cached. The key is the hash of
+// the version of the library, the model, and the config which affects the
+// optimizing, i.e. the places, the passes, the discarded passes, the options
+// of the passes and the environment variables read by them. The CPU model is
+// hashed too, since the autotuned algorithms are only valid on it.
+std::string OptimizedModelCachePath(const lite_api::CxxConfig &config,
+                                    const std::vector<Place> &places,
+                                    const std::vector<std::string> &passes) {
+  if (config.optimized_model_cache_dir().empty()) return "";
+  // The quantized weights and the fp16 weights are converted by the light
+  // api while loading, which is not supported by the cache.
+  if (config.quant_model()) return "";
+  for (auto &place : places) {
+    if (place.precision == PRECISION(kFP16)) return "";
+  }
+  uint64_t hash = HashString(lite::version(), kHashOffsetBasis);
+  if (config.is_model_from_memory()) {
+    hash = HashString(config.get_model_buffer().get_program(), hash);
+    hash = HashString(config.get_model_buffer().get_params(), hash);
+  } else if (!config.model_file().empty() && !config.param_file().empty()) {
+    hash = HashFile(config.model_file(), hash);
+    hash = HashFile(config.param_file(), hash);
+  } else {
+    if (!IsDir(config.model_dir())) return "";
+    auto files = ListFile(config.model_dir());
+    std::sort(files.begin(), files.end());
+    for (auto &file : files) {
+      hash = HashFile(config.model_dir() + "/" + file, hash);
+    }
+  }
+  for (auto &place : places) {
+    hash = HashString(place.DebugString(), hash);
+  }
+  for (auto &pass : passes) {
+    hash = HashString(pass, hash);
+  }
+  // The discarded passes are hashed after a separator, so they never collide
+  // with the passes.
+  hash = HashString("discarded_passes", hash);
+  for (auto &pass : config.get_discarded_passes()) {
+    hash = HashString(pass, hash);
+  }
+  for (auto *env : kOptimizerEnvs) {
+    const char *value = std::getenv(env);
+    hash = HashString(value ? std::string(env) + "=" + value : env, hash);
+  }
+  const std::string partition_config =
+      GetStringFromEnv(SUBGRAPH_CUSTOM_PARTITION_CONFIG_FILE);
+  if (!partition_config.empty()) {
+    hash = HashFile(partition_config, hash);
+  }
+  hash = HashString(std::to_string(config.autotune()) + "," + CpuModelName(),
+                    hash);
+  hash = HashString(std::to_string(config.sparse_model()) + "," +
+                        std::to_string(config.sparse_threshold()),
+                    hash);
+  if (!config.kernel_latency_table().empty()) {
+    for (auto &table : Split(config.kernel_latency_table(), ",")) {
+      hash = HashFile(table, hash);
+    }
+  }
+  for (auto &device_name : config.nnadapter_device_names()) {
+    hash = HashString(device_name, hash);
+  }
+  hash = HashString(config.nnadapter_context_properties(), hash);
+  hash = HashFile(config.nnadapter_subgraph_partition_config_path(), hash);
+  hash = HashString(config.nnadapter_subgraph_partition_config_buffer(), hash);
+  hash = HashFile(config.nnadapter_mixed_precision_quantization_config_path(),
+                  hash);
+  hash = HashString(
+      config.nnadapter_mixed_precision_quantization_config_buffer(), hash);
+  return config.optimized_model_cache_dir() + "/" +
+         string_format("%016llx", static_cast<unsigned long long>(hash));
+}
+
+}  // namespace
+
 void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
   config_ = config;
   mode_ = config.power_mode();
@@ -130,6 +261,7 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
           "post_quant_dynamic_pass");
       CHECK(pass);
       pass->SetQuantType(config.quant_type());
+      pass->SetQuantOps(config.quant_ops());
     }
 
     auto *sparse_detect_pass =
@@ -143,8 +275,20 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
       // internally.
       sparse_detect_pass->SetSparseThreshold(1.5);
     }
-
-    raw_predictor_->Build(config, places, passes);
+    auto *x86_sparse_detect_pass =
+        mir::PassManager::Global().LookUp<mir::X86SparseWeightDetectPass>(
+            "x86_sparse_weight_detect_pass");
+    CHECK(x86_sparse_detect_pass);
+    x86_sparse_detect_pass->SetSparseThreshold(
+        config.sparse_model() ? config.sparse_threshold() : 1.5);
+    auto *kernel_pick_pass =
+        mir::PassManager::Global().LookUp<mir::StaticKernelPickPass>(
+            "static_kernel_pick_pass");
+    CHECK(kernel_pick_pass);
+    kernel_pick_pass->SetLatencyTable(config.kernel_latency_table());
+    kernel_pick_pass->SetPlanPath(config.kernel_pick_plan_path());
+
+    BuildWithOptimizedModelCache(config, places, passes);
   } else {
     raw_predictor_->PrepareFeedFetch();
     CHECK(raw_predictor_) << "The Predictor can not be nullptr in Clone mode.";
@@ -154,6 +298,19 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
   raw_predictor_->ConfigMetalContext(config);
 #endif
 
+  if (config.inter_op_threads() > 1) {
+    raw_predictor_->set_inter_op_threads(config.inter_op_threads());
+  }
+  if (config.op_stats_interval() > 0) {
+    raw_predictor_->set_op_stats_interval(config.op_stats_interval());
+  }
+  if (config.frozen_program()) {
+    raw_predictor_->set_frozen(true);
+  }
+  if (config.autotune()) {
+    raw_predictor_->set_autotune(true);
+  }
+
 #ifdef LITE_WITH_NPU
   // Store the model-level configuration into scope for kernels, and use
   // exe_scope to store the execution-level configuration
@@ -226,7 +383,51 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
 #endif
 }
 
+void CxxPaddleApiImpl::BuildWithOptimizedModelCache(
+    const lite_api::CxxConfig &config,
+    const std::vector<Place> &places,
+    const std::vector<std::string> &passes) {
+  const std::string cache_path =
+      OptimizedModelCachePath(config, places, passes);
+  if (cache_path.empty()) {
+    raw_predictor_->Build(config, places, passes);
+    return;
+  }
+  if (IsFileExists(cache_path + ".nb")) {
+    LOG(INFO) << "Optimized model cache hit: " << cache_path << ".nb";
+    raw_predictor_->BuildFromOptimizedModel(cache_path + ".nb", places);
+    optimized_model_cache_hit_ = true;
+    return;
+  }
+  LOG(INFO) << "Optimized model cache miss: " << cache_path << ".nb";
+  raw_predictor_->Build(config, places, passes);
+  optimized_model_cache_file_ = cache_path;
+  // The algorithms are autotuned by the first run, cache the model after it.
+  if (!config.autotune()) {
+    SaveOptimizedModelCache();
+  }
+}
+
+void CxxPaddleApiImpl::SaveOptimizedModelCache() {
+  const std::string cache_path = optimized_model_cache_file_;
+  optimized_model_cache_file_.clear();
+  MkDirRecur(config_.optimized_model_cache_dir());
+  // Save into a temporary file and rename it, so the concurrent creations
+  // never load an incomplete model.
+  const std::string tmp_path =
+      cache_path + "." + std::to_string(lite::Timer::GetCurrentUS()) + ".tmp";
+  raw_predictor_->SaveModel(tmp_path, lite_api::LiteModelType::kNaiveBuffer);
+  if (std::rename((tmp_path + ".nb").c_str(), (cache_path + ".nb").c_str()) !=
+      0) {
+    LOG(WARNING) << "Failed to save the optimized model cache into "
+                 << cache_path << ".nb";
+    std::remove((tmp_path + ".nb").c_str());
+  }
+}
+
 CxxPaddleApiImpl::~CxxPaddleApiImpl() {
+  // Finish the pending requests before the predictor is released.
+  async_executor_.reset();
 #ifdef LITE_USE_THREAD_POOL
   ThreadPool::ReleaseThreadPool();
 #endif
@@ -272,6 +473,85 @@ void CxxPaddleApiImpl::Run() {
   lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
 #endif
   raw_predictor_->Run();
+  if (!optimized_model_cache_file_.empty()) {
+    SaveOptimizedModelCache();
+  }
+}
+
+std::future<void> CxxPaddleApiImpl::RunAsync(
+    const std::shared_ptr<lite_api::AsyncRequest> &request,
+    lite_api::AsyncCallback callback) {
+  {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    if (!async_executor_) {
+      // The first worker runs on this predictor and the others run on the
+      // clones which share the weights with it.
+      std::vector<AsyncExecutor::Worker> workers;
+      workers.emplace_back([this](lite_api::AsyncRequest *request) {
+        RunAsyncRequest(request);
+      });
+      for (int i = 1; i < config_.async_workers(); i++) {
+        auto clone = std::static_pointer_cast<CxxPaddleApiImpl>(Clone());
+        workers.emplace_back([clone](lite_api::AsyncRequest *request) {
+          clone->RunAsyncRequest(request);
+        });
+      }
+      // The math library threads of x86 are thread local.
+      std::function<void()> thread_init;
+#if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
+    !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+      int math_threads = config_.x86_math_num_threads();
+      thread_init = [math_threads]() { x86::SetNumThreads(math_threads); };
+#endif
+      async_executor_.reset(new AsyncExecutor(
+          std::move(workers),
+          config_.async_queue_size(),
+          std::move(thread_init),
+          MakeAsyncBatchOptions(config_, raw_predictor_->GetInputNames())));
+    }
+  }
+  return async_executor_->Submit(request, std::move(callback));
+}
+
+void CxxPaddleApiImpl::BindInput(int i,
+                                 void *data,
+                                 size_t memory_size,
+                                 const lite_api::shape_t &shape,
+                                 PrecisionType precision,
+                                 TargetType target) {
+  raw_predictor_->BindInput(
+      i, data, memory_size, DDim(shape), precision, target);
+}
+
+void CxxPaddleApiImpl::BindOutput(int i,
+                                  void *data,
+                                  size_t memory_size,
+                                  TargetType target) {
+  raw_predictor_->BindOutput(i, data, memory_size, target);
+}
+
+void CxxPaddleApiImpl::ClearIOBindings() { raw_predictor_->ClearIOBindings(); }
+
+void CxxPaddleApiImpl::SetOpStatsInterval(int interval) {
+  raw_predictor_->set_op_stats_interval(interval);
+}
+
+std::vector<lite_api::OpStats> CxxPaddleApiImpl::GetOpStats() {
+  return raw_predictor_->GetOpStats();
+}
+
+void CxxPaddleApiImpl::ResetOpStats() { raw_predictor_->ResetOpStats(); }
+
+void CxxPaddleApiImpl::RunAsyncRequest(lite_api::AsyncRequest *request) {
+  FeedAsyncRequest(*request,
+                   [this](int i) { return raw_predictor_->GetInput(i); });
+  Run();
+  std::vector<const Tensor *> outputs;
+  size_t output_size = raw_predictor_->GetOutputNames().size();
+  for (size_t i = 0; i < output_size; i++) {
+    outputs.push_back(raw_predictor_->GetOutput(i));
+  }
+  FetchAsyncRequest(outputs, request);
 }
 
 std::shared_ptr<lite_api::PaddlePredictor> CxxPaddleApiImpl::Clone() {
@@ -308,7 +588,8 @@ std::unique_ptr<lite_api::Tensor> CxxPaddleApiImpl::GetMutableTensor(
 void CxxPaddleApiImpl::SaveOptimizedModel(const std::string &model_dir,
                                           lite_api::LiteModelType model_type,
                                           bool record_info) {
-  raw_predictor_->SaveModel(model_dir, model_type, record_info);
+  raw_predictor_->SaveModel(
+      model_dir, model_type, record_info, config_.compress_weights());
 }
 
 bool CxxPaddleApiImpl::TryShrinkMemory() {
@@ -19,7 +19,7 @@
 #include "lite/api/paddle_use_kernels.h"
 #include "lite/api/paddle_use_ops.h"
 #include "lite/api/paddle_use_passes.h"
-#include "lite/api/test_helper.h"
+#include "lite/api/test/test_helper.h"
 #include "lite/core/op_registry.h"
 
 DEFINE_string(optimized_model, "", "optimized_model");
@@ -32,6 +32,23 @@ namespace paddle {
 namespace lite {
 
 #ifdef LITE_WITH_ARM
+// Return the average latency of the runs in ms.
+double RunModel(lite::Predictor* predictor) {
+  for (int i = 0; i < FLAGS_warmup; ++i) {
+    predictor->Run();
+  }
+
+  double sum_duration = 0.0;  // millisecond;
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    auto start = GetCurrentUS();
+    predictor->Run();
+    auto duration = (GetCurrentUS() - start) / 1000.0;
+    sum_duration += duration;
+    VLOG(1) << "run_idx:" << i << " " << duration << " ms";
+  }
+  return sum_duration / FLAGS_repeats;
+}
+
 void TestModel(const std::vector<Place>& valid_places,
                const std::string& model_dir = FLAGS_model_dir,
                bool save_model = false) {
@@ -50,18 +67,7 @@ void TestModel(const std::vector<Place>& valid_places,
     data[i] = 1;
   }
 
-  for (int i = 0; i < FLAGS_warmup; ++i) {
-    predictor.Run();
-  }
-
-  double sum_duration = 0.0;  // millisecond;
-  for (int i = 0; i < FLAGS_repeats; ++i) {
-    auto start = GetCurrentUS();
-    predictor.Run();
-    auto duration = (GetCurrentUS() - start) / 1000.0;
-    sum_duration += duration;
-    VLOG(1) << "run_idx:" << i << " " << duration << " ms";
-  }
+  double avg_duration = RunModel(&predictor);
 
   if (save_model) {
     LOG(INFO) << "Save optimized model to " << FLAGS_optimized_model;
@@ -73,7 +79,25 @@ void TestModel(const std::vector<Place>& valid_places,
   LOG(INFO) << "================== Speed Report ===================";
   LOG(INFO) << "Model: " << model_dir << ", threads num " << FLAGS_threads
             << ", warmup: " << FLAGS_warmup << ", repeats: " << FLAGS_repeats
-            << ", spend " << sum_duration / FLAGS_repeats << " ms in average.";
+            << ", spend " << avg_duration << " ms in average.";
+
+  // Run the independent ops, e.g. the branches of the inception modules,
+  // concurrently and compare with the sequential run.
+  if (FLAGS_inter_op_threads > 1) {
+    auto* out = predictor.GetOutput(0);
+    std::vector<float> seq_out(out->data<float>(),
+                               out->data<float>() + out->numel());
+    predictor.set_inter_op_threads(FLAGS_inter_op_threads);
+    double parallel_duration = RunModel(&predictor);
+    LOG(INFO) << "inter_op_threads " << FLAGS_inter_op_threads << ", spend "
+              << parallel_duration << " ms in average, speedup "
+              << avg_duration / parallel_duration;
+    out = predictor.GetOutput(0);
+    ASSERT_EQ(out->numel(), static_cast<int64_t>(seq_out.size()));
+    for (size_t i = 0; i < seq_out.size(); ++i) {
+      EXPECT_NEAR(out->data<float>()[i], seq_out[i], 1e-5);
+    }
+  }
 
   std::vector<std::vector<float>> ref;
   ref.emplace_back(std::vector<float>(
@@ -15,6 +15,7 @@
 #include "lite/api/light_api.h"
 #include <algorithm>
 #include <map>
+#include "lite/core/lazy_params.h"
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
 #endif
@@ -23,12 +24,16 @@ namespace paddle {
 namespace lite {
 
 void LightPredictor::Build(const std::string& lite_model_file,
-                           bool model_from_memory) {
+                           bool model_from_memory,
+                           bool lazy_sub_block_params) {
   if (model_from_memory) {
     LoadModelNaiveFromMemory(
         lite_model_file, scope_.get(), program_desc_.get());
   } else {
-    LoadModelNaiveFromFile(lite_model_file, scope_.get(), program_desc_.get());
+    LoadModelNaiveFromFile(lite_model_file,
+                           scope_.get(),
+                           program_desc_.get(),
+                           lazy_sub_block_params);
   }
 
   // For weight quantization of post training, load the int8/16 weights
@@ -150,6 +155,42 @@ const lite::Tensor* LightPredictor::GetOutput(size_t offset) {
 }
 #endif
 
+void LightPredictor::BindInput(size_t offset,
+                               void* data,
+                               size_t memory_size,
+                               const DDim& dims,
+                               PrecisionType precision,
+                               TargetType target) {
+  CHECK_LT(offset, input_names_.size())
+      << "The network has " << input_names_.size() << " inputs"
+      << ", the offset should be less than this.";
+  io_binding_.BindInput(offset, data, memory_size, dims, precision, target);
+}
+
+void LightPredictor::BindOutput(size_t offset,
+                                void* data,
+                                size_t memory_size,
+                                TargetType target) {
+  CHECK_LT(offset, output_names_.size())
+      << "The network has " << output_names_.size() << " outputs"
+      << ", the offset should be less than this.";
+  io_binding_.BindOutput(offset, data, memory_size, target);
+}
+
+void LightPredictor::ClearIOBindings() {
+  io_binding_.Clear(InputGetter(), OutputGetter());
+}
+
+IOBinding::TensorGetter LightPredictor::InputGetter() {
+  return [this](size_t offset) { return GetInput(offset); };
+}
+
+IOBinding::TensorGetter LightPredictor::OutputGetter() {
+  return [this](size_t offset) {
+    return const_cast<Tensor*>(GetOutput(offset));
+  };
+}
+
 // get inputs names
 std::vector<std::string> LightPredictor::GetInputNames() {
   return input_names_;
@@ -250,6 +291,11 @@ void LightPredictor::DequantizeWeight() {
 
   auto is_weight_quantized_op = [](const cpp::OpDesc* op_desc) {
     CHECK(op_desc != nullptr);
+    // The kernels run the int8 weights by the dynamic quantization.
+    if (op_desc->HasAttr("dynamic_quant_int8") &&
+        op_desc->GetAttr<bool>("dynamic_quant_int8")) {
+      return false;
+    }
     bool result = false;
     if (op_desc->HasAttr("quantization_type")) {
       std::string type = op_desc->GetAttr<std::string>("quantization_type");
@@ -437,6 +483,12 @@ bool LightPredictor::TryShrinkMemory() {
       continue;
     }
   }
+  // Release the params of the sub-blocks, they will be loaded again when the
+  // sub-blocks run.
+  auto lazy_params = LazyParams::Get(scope_.get());
+  if (lazy_params) {
+    lazy_params->Evict(scope_.get());
+  }
   return true;
 }
 void LightPredictor::ClearTensorArray(
@@ -21,11 +21,14 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <utility>
 #include <vector>
+#include "lite/api/async_executor.h"
 #include "lite/api/paddle_api.h"
 #include "lite/core/context.h"
+#include "lite/core/io_binding.h"
 #include "lite/core/program.h"
 #include "lite/core/tensor.h"
 #include "lite/core/types.h"
@@ -42,12 +45,14 @@ class LITE_API LightPredictor {
  public:
   // constructor function of LightPredictor, `lite_model_file` refers to data in
   // model file or buffer,`model_from_memory` refers to whther to load model
-  // from memory.
+  // from memory, `lazy_sub_block_params` refers to whether to load the params
+  // of the sub-blocks on demand.
   LightPredictor(const std::string& lite_model_file,
-                 bool model_from_memory = false) {
+                 bool model_from_memory = false,
+                 bool lazy_sub_block_params = false) {
     scope_ = std::make_shared<Scope>();
     program_desc_ = std::make_shared<cpp::ProgramDesc>();
-    Build(lite_model_file, model_from_memory);
+    Build(lite_model_file, model_from_memory, lazy_sub_block_params);
   }
 
   // NOTE: This is a deprecated API and will be removed in latter release.
@@ -63,8 +68,14 @@ class LITE_API LightPredictor {
   }
 
   void Run() {
+    if (!io_binding_.empty()) {
+      io_binding_.Prepare(InputGetter(), OutputGetter());
+    }
     CheckInputValid();
     program_->Run();
+    if (!io_binding_.empty()) {
+      io_binding_.Finish(OutputGetter());
+    }
     if (bool_clear_tensor_) ClearTensorArray(program_desc_);
   }
 
@@ -84,6 +95,20 @@ class LITE_API LightPredictor {
   // Get offset-th col of fetch outputs.
   const Tensor* GetOutput(size_t offset);
 
+  // Bind the user buffers as the memory of the offset-th input and output,
+  // they are used by every run until ClearIOBindings, see IOBinding.
+  void BindInput(size_t offset,
+                 void* data,
+                 size_t memory_size,
+                 const DDim& dims,
+                 PrecisionType precision,
+                 TargetType target);
+  void BindOutput(size_t offset,
+                  void* data,
+                  size_t memory_size,
+                  TargetType target);
+  void ClearIOBindings();
+
   const lite::Tensor* GetTensor(const std::string& name) const {
     auto* var = program_->exec_scope()->FindVar(name);
     CHECK(var) << "no fatch variable " << name << " in exec_scope";
@@ -98,6 +123,20 @@ class LITE_API LightPredictor {
   void PrepareFeedFetch();
   Scope* scope() { return scope_.get(); }
 
+  void set_inter_op_threads(int inter_op_threads) {
+    program_->set_inter_op_threads(inter_op_threads);
+  }
+
+  void set_op_stats_interval(int interval) {
+    program_->set_op_stats_interval(interval);
+  }
+  void set_frozen(bool frozen) { program_->set_frozen(frozen); }
+  void set_autotune(bool autotune) { program_->set_autotune(autotune); }
+  std::vector<lite_api::OpStats> GetOpStats() const {
+    return program_->GetOpStats();
+  }
+  void ResetOpStats() { program_->ResetOpStats(); }
+
 #ifdef LITE_WITH_METAL
   void ConfigMetalContext(const lite_api::MobileConfig& config) {
     program_->ConfigMetalContext(config.metal_lib_path(),
@@ -114,7 +153,8 @@ class LITE_API LightPredictor {
   void CheckInputValid();
 
   void Build(const std::string& lite_model_file,
-             bool model_from_memory = false);
+             bool model_from_memory = false,
+             bool lazy_sub_block_params = false);
 
   // NOTE: This is a deprecated API and will be removed in latter release.
   void Build(
@@ -136,6 +176,9 @@ class LITE_API LightPredictor {
   void ClearTensorArray(
       const std::shared_ptr<const cpp::ProgramDesc>& program_desc);
 
+  IOBinding::TensorGetter InputGetter();
+  IOBinding::TensorGetter OutputGetter();
+
  private:
   std::shared_ptr<Scope> scope_;
   std::unique_ptr<RuntimeProgram> program_;
@@ -144,6 +187,7 @@ class LITE_API LightPredictor {
   std::vector<std::string> output_names_;
   std::vector<PrecisionType> input_precisions_;
   bool bool_clear_tensor_ = false;
+  IOBinding io_binding_;
 };
 
 class LightPredictorImpl : public lite_api::PaddlePredictor {
@@ -157,6 +201,23 @@ class LightPredictorImpl : public lite_api::PaddlePredictor {
   std::unique_ptr<const lite_api::Tensor> GetOutputByName(
       const std::string& name) const;
   void Run() override;
+  std::future<void> RunAsync(
+      const std::shared_ptr<lite_api::AsyncRequest>& request,
+      lite_api::AsyncCallback callback = nullptr) override;
+  void SetOpStatsInterval(int interval) override;
+  std::vector<lite_api::OpStats> GetOpStats() override;
+  void ResetOpStats() override;
+  void BindInput(int i,
+                 void* data,
+                 size_t memory_size,
+                 const lite_api::shape_t& shape,
+                 PrecisionType precision,
+                 TargetType target = TargetType::kHost) override;
+  void BindOutput(int i,
+                  void* data,
+                  size_t memory_size,
+                  TargetType target = TargetType::kHost) override;
+  void ClearIOBindings() override;
 
   std::shared_ptr<lite_api::PaddlePredictor> Clone() override;
   std::shared_ptr<lite_api::PaddlePredictor> Clone(
@@ -178,7 +239,17 @@ class LightPredictorImpl : public lite_api::PaddlePredictor {
   bool TryShrinkMemory() override;
 
  private:
+  void RunAsyncRequest(lite_api::AsyncRequest* request);
+
   std::unique_ptr<lite::LightPredictor> raw_predictor_;
+#if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
+    !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  int x86_math_num_threads_{1};
+#endif
+  int async_queue_size_{1};
+  AsyncBatchOptions async_batch_options_;
+  std::mutex async_mutex_;
+  std::unique_ptr<AsyncExecutor> async_executor_;
 };
 
 }  // namespace lite
@@ -27,6 +27,7 @@
 #if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
     !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
 #include "lite/backends/x86/mklml.h"
+#include "lite/backends/x86/parallel.h"
 #endif
 
 namespace paddle {
@@ -43,10 +44,22 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
                            lite_api::LiteModelType::kNaiveBuffer));
   } else {
     raw_predictor_.reset(new LightPredictor(config.lite_model_file(),
-                                            config.is_model_from_memory()));
+                                            config.is_model_from_memory(),
+                                            config.lazy_sub_block_params()));
   }
   mode_ = config.power_mode();
   threads_ = config.threads();
+#if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
+    !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  x86_math_num_threads_ = config.x86_math_num_threads();
+#endif
+  async_queue_size_ = config.async_queue_size();
+  async_batch_options_ =
+      MakeAsyncBatchOptions(config, raw_predictor_->GetInputNames());
+  if (config.async_workers() > 1) {
+    LOG(WARNING) << "The light predictor can't be cloned, so the requests of "
+                    "RunAsync run on one worker.";
+  }
 #ifdef LITE_USE_THREAD_POOL
   int thread_num = ThreadPool::Init(threads_);
   if (thread_num > 1) {
@@ -58,6 +71,19 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
   raw_predictor_->ConfigMetalContext(config);
 #endif
 
+  if (config.inter_op_threads() > 1) {
+    raw_predictor_->set_inter_op_threads(config.inter_op_threads());
+  }
+  if (config.op_stats_interval() > 0) {
+    raw_predictor_->set_op_stats_interval(config.op_stats_interval());
+  }
+  if (config.frozen_program()) {
+    raw_predictor_->set_frozen(true);
+  }
+  if (config.autotune()) {
+    raw_predictor_->set_autotune(true);
+  }
+
 #ifdef LITE_WITH_NPU
   // Store the model-level configuration into scope for kernels, and use
   // exe_scope to store the execution-level configuration
@@ -98,6 +124,8 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
 }
 
 LightPredictorImpl::~LightPredictorImpl() {
+  // Finish the pending requests before the predictor is released.
+  async_executor_.reset();
 #ifdef LITE_USE_THREAD_POOL
   ThreadPool::ReleaseThreadPool();
 #endif
@@ -133,6 +161,75 @@ void LightPredictorImpl::Run() {
   raw_predictor_->Run();
 }
 
+std::future<void> LightPredictorImpl::RunAsync(
+    const std::shared_ptr<lite_api::AsyncRequest>& request,
+    lite_api::AsyncCallback callback) {
+  {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    if (!async_executor_) {
+      std::vector<AsyncExecutor::Worker> workers;
+      workers.emplace_back([this](lite_api::AsyncRequest* request) {
+        RunAsyncRequest(request);
+      });
+      // The math library threads of x86 are thread local.
+      std::function<void()> thread_init;
+#if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
+    !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+      int math_threads = x86_math_num_threads_;
+      thread_init = [math_threads]() { x86::SetNumThreads(math_threads); };
+#endif
+      async_executor_.reset(new AsyncExecutor(std::move(workers),
+                                              async_queue_size_,
+                                              std::move(thread_init),
+                                              async_batch_options_));
+    }
+  }
+  return async_executor_->Submit(request, std::move(callback));
+}
+
+void LightPredictorImpl::SetOpStatsInterval(int interval) {
+  raw_predictor_->set_op_stats_interval(interval);
+}
+
+std::vector<lite_api::OpStats> LightPredictorImpl::GetOpStats() {
+  return raw_predictor_->GetOpStats();
+}
+
+void LightPredictorImpl::ResetOpStats() { raw_predictor_->ResetOpStats(); }
+
+void LightPredictorImpl::BindInput(int i,
+                                   void* data,
+                                   size_t memory_size,
+                                   const lite_api::shape_t& shape,
+                                   PrecisionType precision,
+                                   TargetType target) {
+  raw_predictor_->BindInput(
+      i, data, memory_size, DDim(shape), precision, target);
+}
+
+void LightPredictorImpl::BindOutput(int i,
+                                    void* data,
+                                    size_t memory_size,
+                                    TargetType target) {
+  raw_predictor_->BindOutput(i, data, memory_size, target);
+}
+
+void LightPredictorImpl::ClearIOBindings() {
+  raw_predictor_->ClearIOBindings();
+}
+
+void LightPredictorImpl::RunAsyncRequest(lite_api::AsyncRequest* request) {
+  FeedAsyncRequest(*request,
+                   [this](int i) { return raw_predictor_->GetInput(i); });
+  Run();
+  std::vector<const Tensor*> outputs;
+  size_t output_size = raw_predictor_->GetOutputNames().size();
+  for (size_t i = 0; i < output_size; i++) {
+    outputs.push_back(raw_predictor_->GetOutput(i));
+  }
+  FetchAsyncRequest(outputs, request);
+}
+
 std::shared_ptr<lite_api::PaddlePredictor> LightPredictorImpl::Clone() {
   LOG(FATAL) << "The Clone API is not supported in LigthPredictor";
   return nullptr;
@@ -20,6 +20,7 @@
 #include "lite/core/device_info.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/core/tensor.h"
+#include "lite/core/tracer.h"
 
 #ifdef LITE_WITH_CUDA
 #include "lite/backends/cuda/target_wrapper.h"
@@ -82,6 +83,12 @@ int GetOpenCLDeviceType() {
   return -1;
 }
 
+void StartTrace() { lite::Tracer::Global().Start(); }
+
+bool StopTrace(const std::string &path) {
+  return lite::Tracer::Global().Stop(path);
+}
+
 Tensor::Tensor(void *raw) : raw_tensor_(raw) {}
 
 // TODO(Superjomn) refine this by using another `const void* const_raw`;
@@ -291,6 +298,26 @@ std::vector<std::string> PaddlePredictor::GetParamNames() {
   return null_result;
 }
 
+std::future<void> PaddlePredictor::RunAsync(
+    const std::shared_ptr<AsyncRequest> &request, AsyncCallback callback) {
+  LOG(FATAL) << "The RunAsync API is not supported by this predictor.";
+  return std::future<void>();
+}
+
+void PaddlePredictor::SetOpStatsInterval(int interval) {
+  LOG(FATAL)
+      << "The SetOpStatsInterval API is not supported by this predictor.";
+}
+
+std::vector<OpStats> PaddlePredictor::GetOpStats() {
+  LOG(FATAL) << "The GetOpStats API is not supported by this predictor.";
+  return std::vector<OpStats>();
+}
+
+void PaddlePredictor::ResetOpStats() {
+  LOG(FATAL) << "The ResetOpStats API is not supported by this predictor.";
+}
+
 void PaddlePredictor::SaveOptimizedModel(const std::string &model_dir,
                                          LiteModelType model_type,
                                          bool record_info) {
@@ -298,6 +325,28 @@ void PaddlePredictor::SaveOptimizedModel(const std::string &model_dir,
       << "The SaveOptimizedModel API is only supported by CxxConfig predictor.";
 }
 
+bool PaddlePredictor::IsOptimizedModelCacheHit() const { return false; }
+
+void PaddlePredictor::BindInput(int i,
+                                void *data,
+                                size_t memory_size,
+                                const shape_t &shape,
+                                PrecisionType precision,
+                                TargetType target) {
+  LOG(FATAL) << "The BindInput API is not supported by this predictor.";
+}
+
+void PaddlePredictor::BindOutput(int i,
+                                 void *data,
+                                 size_t memory_size,
+                                 TargetType target) {
+  LOG(FATAL) << "The BindOutput API is not supported by this predictor.";
+}
+
+void PaddlePredictor::ClearIOBindings() {
+  LOG(FATAL) << "The ClearIOBindings API is not supported by this predictor.";
+}
+
 template <typename ConfigT>
 std::shared_ptr<PaddlePredictor> CreatePaddlePredictor(const ConfigT &) {
   return std::shared_ptr<PaddlePredictor>();
@@ -20,6 +20,7 @@
 #ifndef PADDLE_LITE_API_H_  // NOLINT
 #define PADDLE_LITE_API_H_
 #include <functional>
+#include <future>  // NOLINT
 #include <map>
 #include <memory>
 #include <string>
@@ -51,6 +52,16 @@ LITE_API bool IsOpenCLBackendValid(bool check_fp16_valid = false);
 // UNKNOWN:0, QUALCOMM_ADRENO:1, ARM_MALI:2, IMAGINATION_POWERVR:3, OTHERS:4,
 LITE_API int GetOpenCLDeviceType();
 
+// Start recording the timeline of all of the predictors in the process: the
+// ops, the tasks of the thread pool workers, the memory allocations and the
+// subgraphs of the devices. Call it between the runs.
+LITE_API void StartTrace();
+
+// Stop recording and write the timeline in the Chrome Trace Event format to
+// `path`, which can be opened by chrome://tracing or Perfetto. Return false if
+// the file can't be written.
+LITE_API bool StopTrace(const std::string& path);
+
 struct LITE_API Tensor {
   explicit Tensor(void* raw);
   explicit Tensor(const void* raw);
@@ -93,6 +104,61 @@ struct LITE_API Tensor {
   void* raw_tensor_;
 };
 
+/// The inputs and outputs of a request of PaddlePredictor::RunAsync. They are
+/// owned by the request, so several requests can be queued against one
+/// predictor while the caller prepares the next inputs.
+class LITE_API AsyncRequest {
+ public:
+  AsyncRequest();
+  ~AsyncRequest();
+
+  /// Get i-th input to fill, it's copied into the predictor when the request
+  /// runs. The inputs are created on demand.
+  std::unique_ptr<Tensor> GetInput(int i);
+  /// Get i-th output, it's valid after the request is finished.
+  std::unique_ptr<const Tensor> GetOutput(int i) const;
+  int input_size() const;
+  int output_size() const;
+
+  // The internal storage of the tensors.
+  struct Impl;
+  Impl* impl() const { return impl_.get(); }
+
+ private:
+  AsyncRequest(const AsyncRequest&) = delete;
+  AsyncRequest& operator=(const AsyncRequest&) = delete;
+  std::unique_ptr<Impl> impl_;
+};
+
+/// Called on the executor thread when a request of RunAsync is finished,
+/// `success` is false if the inference failed.
+using AsyncCallback = std::function<void(
+    const std::shared_ptr<AsyncRequest>& request, bool success)>;
+
+/// The runtime stats of an op of the root block, collected by the sampling
+/// of PaddlePredictor::SetOpStatsInterval.
+struct LITE_API OpStats {
+  std::string op_type;
+  std::string kernel_name;
+  /// The first output of the op, it identifies the layer.
+  std::string output_name;
+  /// The shape of the first output in the last run.
+  std::vector<int64_t> output_shape;
+  /// The number of the sampled runs.
+  int64_t count{0};
+  double avg_ms{0};
+  /// The 99th percentile of the latest sampled runs.
+  double p99_ms{0};
+  double max_ms{0};
+  /// The bytes of the inputs and outputs of the op in the last run.
+  int64_t bytes{0};
+  /// The estimated floating point operations of the op in the last run, 0 if
+  /// it's not estimated for the op type.
+  double flops{0};
+  /// The estimated GFLOPS, i.e. flops / avg_ms.
+  double gflops{0};
+};
+
 /// The PaddlePredictor defines the basic interfaces for different kinds of
 /// predictors.
 class LITE_API PaddlePredictor {
@@ -106,6 +172,19 @@ class LITE_API PaddlePredictor {
   virtual std::unique_ptr<const Tensor> GetOutput(int i) const = 0;
 
   virtual void Run() = 0;
+  /// Queue the request on the internal executor of the predictor and return
+  /// immediately, the caller is blocked only if the queue is full. The future
+  /// becomes ready after the outputs are copied into the request and
+  /// `callback` returns. Don't call Run on the same predictor meanwhile.
+  virtual std::future<void> RunAsync(
+      const std::shared_ptr<AsyncRequest>& request,
+      AsyncCallback callback = nullptr);
+  /// Sample the run time of the ops in one of every `interval` runs, it can be
+  /// changed at any time between the runs. The sampling is off if it's 0.
+  virtual void SetOpStatsInterval(int interval);
+  /// Get the stats of the sampled ops, sorted by the total time descending.
+  virtual std::vector<OpStats> GetOpStats();
+  virtual void ResetOpStats();
   virtual std::shared_ptr<PaddlePredictor> Clone() = 0;
   virtual std::shared_ptr<PaddlePredictor> Clone(
       const std::vector<std::string>& var_names) = 0;
@@ -139,6 +218,32 @@ class LITE_API PaddlePredictor {
       LiteModelType model_type = LiteModelType::kProtobuf,
       bool record_info = false);
 
+  /// Whether the predictor is created from the optimized model cache, see
+  /// CxxConfig::set_optimized_model_cache_dir.
+  virtual bool IsOptimizedModelCacheHit() const;
+
+  /// Bind a pre-allocated buffer as the memory of the i-th input, the first
+  /// ops read the input from it directly in every run until ClearIOBindings.
+  /// Fill the buffer before Run and keep it valid while it's bound, the shape
+  /// and the precision of the input are set by the binding.
+  virtual void BindInput(int i,
+                         void* data,
+                         size_t memory_size,
+                         const shape_t& shape,
+                         PrecisionType precision,
+                         TargetType target = TargetType::kHost);
+  /// Bind a pre-allocated buffer as the memory of the i-th output, the last
+  /// ops write the output into it directly in every run until
+  /// ClearIOBindings. It must be large enough for the output, and the shape of
+  /// the output is still got by GetOutput.
+  virtual void BindOutput(int i,
+                          void* data,
+                          size_t memory_size,
+                          TargetType target = TargetType::kHost);
+  /// Unbind the buffers of BindInput and BindOutput, they can be released by
+  /// the users after that.
+  virtual void ClearIOBindings();
+
   virtual ~PaddlePredictor() = default;
 
  protected:
@@ -150,6 +255,15 @@ class LITE_API PaddlePredictor {
 class LITE_API ConfigBase {
   std::string model_dir_;
   int threads_{1};
+  int inter_op_threads_{1};
+  int async_workers_{1};
+  int async_queue_size_{16};
+  int async_max_batch_size_{1};
+  int64_t async_batch_timeout_us_{1000};
+  int op_stats_interval_{0};
+  bool frozen_program_{false};
+  bool autotune_{false};
+  std::vector<std::string> async_unbatchable_inputs_{};
   PowerMode mode_{LITE_POWER_NO_BIND};
   // gpu opencl
   CLTuneMode opencl_tune_mode_{CL_TUNE_NONE};
@@ -197,6 +311,69 @@ class LITE_API ConfigBase {
   // set Power_mode
   void set_power_mode(PowerMode mode);
   PowerMode power_mode() const { return mode_; }
+  // Run at most `inter_op_threads` independent ops concurrently on the CPU,
+  // the threads set by set_threads (ARM) or set_x86_math_num_threads (x86)
+  // are partitioned among them. The ops run one by one if it's 1 (default).
+  void set_inter_op_threads(int inter_op_threads) {
+    inter_op_threads_ = inter_op_threads > 1 ? inter_op_threads : 1;
+  }
+  int inter_op_threads() const { return inter_op_threads_; }
+  // The number of the requests of RunAsync which run concurrently, each of
+  // them runs on a clone of the predictor. Only CxxConfig supports more than
+  // one worker.
+  void set_async_workers(int async_workers) {
+    async_workers_ = async_workers > 1 ? async_workers : 1;
+  }
+  int async_workers() const { return async_workers_; }
+  // The max number of the pending requests of RunAsync.
+  void set_async_queue_size(int async_queue_size) {
+    async_queue_size_ = async_queue_size > 1 ? async_queue_size : 1;
+  }
+  int async_queue_size() const { return async_queue_size_; }
+  // Merge the pending requests of RunAsync into a batch of at most
+  // `async_max_batch_size` samples along the first dim (or the sequences of
+  // the LoD) of the inputs, run it at once and split the outputs back to the
+  // requests. The requests run one by one if it's 1 (default).
+  void set_async_max_batch_size(int async_max_batch_size) {
+    async_max_batch_size_ =
+        async_max_batch_size > 1 ? async_max_batch_size : 1;
+  }
+  int async_max_batch_size() const { return async_max_batch_size_; }
+  // How long a worker waits for more requests to fill a batch.
+  void set_async_batch_timeout_us(int64_t async_batch_timeout_us) {
+    async_batch_timeout_us_ =
+        async_batch_timeout_us > 0 ? async_batch_timeout_us : 0;
+  }
+  int64_t async_batch_timeout_us() const { return async_batch_timeout_us_; }
+  // The inputs without the batch axis, e.g. the image shape of the detection
+  // models. They're fed once for a batch, so only the requests with the same
+  // values of them are merged.
+  void set_async_unbatchable_inputs(const std::vector<std::string>& names) {
+    async_unbatchable_inputs_ = names;
+  }
+  const std::vector<std::string>& async_unbatchable_inputs() const {
+    return async_unbatchable_inputs_;
+  }
+  // Sample the run time of the ops in one of every `op_stats_interval` runs,
+  // see PaddlePredictor::GetOpStats. The sampling is off if it's 0 (default).
+  void set_op_stats_interval(int op_stats_interval) {
+    op_stats_interval_ = op_stats_interval > 0 ? op_stats_interval : 0;
+  }
+  int op_stats_interval() const { return op_stats_interval_; }
+  // Skip InferShape of the ops and dispatch the kernels from a flat array
+  // after the first run on each signature of the input shapes. Only for the
+  // models whose op shapes depend on the input shapes alone, not the input
+  // data.
+  void set_frozen_program(bool frozen_program) {
+    frozen_program_ = frozen_program;
+  }
+  bool frozen_program() const { return frozen_program_; }
+  // Time the eligible algorithms of the kernels, e.g. winograd, direct and
+  // gemm of conv2d, in the first run and keep the fastest ones instead of
+  // picking them by the heuristics. The picked algorithms are saved by
+  // SaveOptimizedModel and reused by the later loads on the same CPU model.
+  void set_autotune(bool autotune) { autotune_ = autotune; }
+  bool autotune() const { return autotune_; }
 
   /// \brief Set path and file name of generated OpenCL compiled kernel binary.
   ///
@@ -376,8 +553,15 @@ class LITE_API CxxConfig : public ConfigBase {
   std::vector<std::string> passes_internal_{};
   bool quant_model_{false};  // Enable post_quant_dynamic in opt
   QuantType quant_type_{QuantType::QUANT_INT16};
+  // The op types quantized by post_quant_dynamic, empty for the defaults.
+  std::vector<std::string> quant_ops_{};
   bool sparse_model_{false};  // Enable sparse_conv_detect_pass in opt
   float sparse_threshold_{0.6f};
+  bool compress_weights_{false};  // Compress the params of naive buffer model
+  // The latency lookup tables of the cost model of static_kernel_pick_pass.
+  std::string kernel_latency_table_;
+  std::string kernel_pick_plan_path_;
+  std::string optimized_model_cache_dir_;
   std::map<int, std::vector<std::shared_ptr<void>>>
       preferred_inputs_for_warmup_;
 #ifdef LITE_WITH_CUDA
@@ -507,6 +691,13 @@ class LITE_API CxxConfig : public ConfigBase {
   bool quant_model() const { return quant_model_; }
   void set_quant_type(QuantType quant_type) { quant_type_ = quant_type; }
   QuantType quant_type() const { return quant_type_; }
+  // Only quantize the ops of these types, e.g. {"fc", "matmul_v2"}. With
+  // QUANT_INT8 the x86 kernels of fc, mul and matmul named here run the int8
+  // weights by the dynamic quantization, which isn't used by default.
+  void set_quant_ops(const std::vector<std::string>& quant_ops) {
+    quant_ops_ = quant_ops;
+  }
+  const std::vector<std::string>& quant_ops() const { return quant_ops_; }
 
   void set_sparse_model(bool sparse_model) { sparse_model_ = sparse_model; }
   bool sparse_model() const { return sparse_model_; }
@@ -515,6 +706,45 @@ class LITE_API CxxConfig : public ConfigBase {
   }
   float sparse_threshold() const { return sparse_threshold_; }
 
+  // Pick the kernels by the latencies of the latency lookup tables, separated
+  // by ',', in the format of lite/tests/benchmark, the latencies of the
+  // kernels plus the costs of the casts between them are minimized. The
+  // picked kernels are dumped into 'kernel_pick_plan_path' if it's set.
+  void set_kernel_latency_table(const std::string& kernel_latency_table) {
+    kernel_latency_table_ = kernel_latency_table;
+  }
+  const std::string& kernel_latency_table() const {
+    return kernel_latency_table_;
+  }
+  void set_kernel_pick_plan_path(const std::string& kernel_pick_plan_path) {
+    kernel_pick_plan_path_ = kernel_pick_plan_path;
+  }
+  const std::string& kernel_pick_plan_path() const {
+    return kernel_pick_plan_path_;
+  }
+
+  // Cache the optimized model in 'dir', keyed by the hash of the model, the
+  // config, the environment variables read by the passes, e.g.
+  // CONSTANT_FOLDING_MAX_BYTES, and the version of the library. The first
+  // creation optimizes the model and saves it into the cache, the later ones
+  // load the cached model like MobileConfig, skipping the optimizer and the
+  // kernel picking. With autotuning, the model is cached after the first run
+  // with the tuned algorithms. The models quantized by set_quant_model and the
+  // fp16 models aren't cached.
+  void set_optimized_model_cache_dir(const std::string& dir) {
+    optimized_model_cache_dir_ = dir;
+  }
+  const std::string& optimized_model_cache_dir() const {
+    return optimized_model_cache_dir_;
+  }
+
+  // Compress the params losslessly while saving the naive buffer model, the
+  // model is smaller but can't be loaded by the former runtime.
+  void set_compress_weights(bool compress_weights) {
+    compress_weights_ = compress_weights;
+  }
+  bool compress_weights() const { return compress_weights_; }
+
   // Enable the custom subgraph partition for NNAdapter by providing the
   // configuration file or buffer
   void set_nnadapter_subgraph_partition_config_path(
@@ -564,6 +794,9 @@ class LITE_API MobileConfig : public ConfigBase {
   // model data readed from file or memory buffer in combined format.
   std::string lite_model_file_;
 
+  // whether to load the params only used by the sub-blocks on demand.
+  bool lazy_sub_block_params_{false};
+
   // NOTE: This is a deprecated variable and will be removed in latter release.
   std::string model_buffer_;
   std::string param_buffer_;
@@ -587,6 +820,13 @@ class LITE_API MobileConfig : public ConfigBase {
   // abandoned in v3.0.
   bool model_from_memory() const { return model_from_memory_; }
 
+  // The params which are only used by the sub-blocks of conditional_block and
+  // while are read from the model file when the sub-block runs for the first
+  // time, and released by TryShrinkMemory. It only works for the model loaded
+  // from file.
+  void set_lazy_sub_block_params(bool x) { lazy_sub_block_params_ = x; }
+  bool lazy_sub_block_params() const { return lazy_sub_block_params_; }
+
   // NOTE: This is a deprecated API and will be removed in latter release.
   void set_model_buffer(const char* model_buffer,
                         size_t model_buffer_size,
@@ -88,7 +88,9 @@ enum class DataLayoutType : int {
   kAny = 2,           // any data layout
   kMetalTexture2DArray = 7,
   kMetalTexture2D = 8,
-  NUM = 9,  // number of fields.
+  kNCHW8c = 9,    // for x86, the channels blocked by 8
+  kNCHW16c = 10,  // for x86, the channels blocked by 16
+  NUM = 11,       // number of fields.
 };
 
 typedef enum {
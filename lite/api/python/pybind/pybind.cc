@@ -74,8 +74,22 @@ void BindLiteOpt(py::module *m) {
       .def("set_model_type", &OptBase::SetModelType)
       .def("set_quant_model", &OptBase::SetQuantModel)
       .def("set_quant_type", &OptBase::SetQuantType)
+      .def("set_quant_ops", &OptBase::SetQuantOps)
       .def("set_sparse_model", &OptBase::SetSparseModel)
       .def("set_sparse_threshold", &OptBase::SetSparseThreshold)
+      .def("set_compress_weights", &OptBase::SetCompressWeights)
+      .def("set_autotune", &OptBase::SetAutotune)
+      .def("set_calibration",
+           &OptBase::SetCalibration,
+           py::arg("data_dir"),
+           py::arg("input_shapes"),
+           py::arg("algo") = "kl")
+      .def("set_kernel_latency_table",
+           &OptBase::SetKernelLatencyTable,
+           py::arg("latency_table"),
+           py::arg("plan_path") = "")
+      .def("set_optimized_model_cache_dir",
+           &OptBase::SetOptimizedModelCacheDir)
       .def("record_model_info", &OptBase::RecordModelInfo)
       .def("set_passes_internal", &OptBase::SetPassesInternal)
       .def("run", &OptBase::Run)
@@ -152,11 +166,17 @@ void BindLiteCxxConfig(py::module *m) {
                CxxConfig::set_model_buffer)
       .def("set_passes_internal", &CxxConfig::set_passes_internal)
       .def("is_model_from_memory", &CxxConfig::is_model_from_memory)
-      .def("add_discarded_pass", &CxxConfig::add_discarded_pass);
+      .def("add_discarded_pass", &CxxConfig::add_discarded_pass)
+      .def("set_optimized_model_cache_dir",
+           &CxxConfig::set_optimized_model_cache_dir)
+      .def("optimized_model_cache_dir",
+           &CxxConfig::optimized_model_cache_dir);
   cxx_config.def("set_threads", &CxxConfig::set_threads)
       .def("threads", &CxxConfig::threads)
       .def("set_power_mode", &CxxConfig::set_power_mode)
-      .def("power_mode", &CxxConfig::power_mode);
+      .def("power_mode", &CxxConfig::power_mode)
+      .def("set_inter_op_threads", &CxxConfig::set_inter_op_threads)
+      .def("inter_op_threads", &CxxConfig::inter_op_threads);
 
   cxx_config
       .def("set_opencl_binary_path_name",
@@ -217,7 +237,9 @@ void BindLiteMobileConfig(py::module *m) {
   mobile_config.def("set_threads", &MobileConfig::set_threads)
       .def("threads", &MobileConfig::threads)
       .def("set_power_mode", &MobileConfig::set_power_mode)
-      .def("power_mode", &MobileConfig::power_mode);
+      .def("power_mode", &MobileConfig::power_mode)
+      .def("set_inter_op_threads", &MobileConfig::set_inter_op_threads)
+      .def("inter_op_threads", &MobileConfig::inter_op_threads);
 #endif
   mobile_config
       .def("set_opencl_binary_path_name",
@@ -322,7 +344,9 @@ void BindLitePlace(py::module *m) {
       .value("ImageFolder", DataLayoutType::kImageFolder)
       .value("ImageNW", DataLayoutType::kImageNW)
       .value("MetalTexture2DArray", DataLayoutType::kMetalTexture2DArray)
-      .value("MetalTexture2D", DataLayoutType::kMetalTexture2D);
+      .value("MetalTexture2D", DataLayoutType::kMetalTexture2D)
+      .value("NCHW8c", DataLayoutType::kNCHW8c)
+      .value("NCHW16c", DataLayoutType::kNCHW16c);
 
   // Place
   py::class_<Place>(*m, "Place")
@@ -407,6 +431,8 @@ void BindLiteCxxPredictor(py::module *m) {
       .def("get_output_by_name", &CxxPaddleApiImpl::GetOutputByName)
       .def("run", &CxxPaddleApiImpl::Run)
       .def("get_version", &CxxPaddleApiImpl::GetVersion)
+      .def("is_optimized_model_cache_hit",
+           &CxxPaddleApiImpl::IsOptimizedModelCacheHit)
       .def("save_optimized_pb_model",
            [](CxxPaddleApiImpl &self, const std::string &output_dir) {
              self.SaveOptimizedModel(output_dir,
@@ -0,0 +1,108 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/async_executor.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>  // NOLINT
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+// out = x * scale, with the LoD of x, where scale is the unbatchable input 1.
+void ScaleWorker(lite_api::AsyncRequest* request) {
+  auto& x = *request->impl()->inputs[0];
+  float scale = request->impl()->inputs[1]->data<float>()[0];
+  auto& outputs = request->impl()->outputs;
+  outputs.resize(1);
+  outputs[0].reset(new Tensor);
+  auto* out = outputs[0].get();
+  out->Resize(x.dims());
+  out->set_lod(x.lod());
+  auto* out_data = out->mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    out_data[i] = x.data<float>()[i] * scale;
+  }
+}
+
+// The even requests have a sequence of 2 rows, and the odd ones have the
+// sequences of 1 and 3 rows.
+lite_api::lod_t LoDOf(int request) {
+  return request % 2 == 0 ? lite_api::lod_t{{0, 2}}
+                          : lite_api::lod_t{{0, 1, 4}};
+}
+
+TEST(AsyncExecutor, batch_lod_requests) {
+  // The 6 requests have 9 sequences in total, which are merged into the
+  // batches of up to 9 sequences.
+  const int num_requests = 6;
+  std::atomic<int> num_calls{0};
+  std::atomic<int> num_merged_calls{0};
+  std::vector<AsyncExecutor::Worker> workers;
+  workers.emplace_back([&](lite_api::AsyncRequest* request) {
+    num_calls++;
+    if (request->impl()->inputs[0]->lod()[0].size() > 3) {
+      num_merged_calls++;
+    }
+    ScaleWorker(request);
+  });
+  AsyncBatchOptions batch_options;
+  batch_options.max_batch_size = 9;
+  batch_options.timeout_us = 1000000;
+  batch_options.unbatchable_inputs.insert(1);
+  AsyncExecutor executor(std::move(workers), 16, nullptr, batch_options);
+
+  std::vector<std::shared_ptr<lite_api::AsyncRequest>> requests;
+  std::vector<std::future<void>> futures;
+  for (int r = 0; r < num_requests; r++) {
+    std::shared_ptr<lite_api::AsyncRequest> request(
+        new lite_api::AsyncRequest);
+    auto x = request->GetInput(0);
+    int64_t rows = r % 2 == 0 ? 2 : 4;
+    x->Resize({rows, 3});
+    x->SetLoD(LoDOf(r));
+    auto* x_data = x->mutable_data<float>();
+    for (int i = 0; i < rows * 3; i++) {
+      x_data[i] = r * 100 + i;
+    }
+    auto scale = request->GetInput(1);
+    scale->Resize({1});
+    scale->mutable_data<float>()[0] = 2.f;
+    futures.push_back(executor.Submit(request, nullptr));
+    requests.push_back(request);
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+
+  EXPECT_LT(num_calls.load(), num_requests);
+  EXPECT_GT(num_merged_calls.load(), 0);
+  for (int r = 0; r < num_requests; r++) {
+    ASSERT_EQ(requests[r]->output_size(), 1);
+    auto out = requests[r]->GetOutput(0);
+    int64_t rows = r % 2 == 0 ? 2 : 4;
+    EXPECT_EQ(out->shape(), std::vector<int64_t>({rows, 3}));
+    EXPECT_EQ(out->lod(), LoDOf(r));
+    auto* out_data = out->data<float>();
+    for (int i = 0; i < rows * 3; i++) {
+      EXPECT_EQ(out_data[i], (r * 100 + i) * 2.f) << "request " << r;
+    }
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
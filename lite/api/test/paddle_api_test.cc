@@ -15,6 +15,13 @@
 #include "lite/api/paddle_api.h"
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cmath>
+#include <cstdio>
+#include <future>  // NOLINT
+#include <string>
+#include <vector>
 #include "lite/utils/io.h"
 #include "lite/utils/log/cp_logging.h"
 
@@ -110,6 +117,306 @@ TEST(CxxApi, share_external_data) {
   EXPECT_NEAR(out[1], -28.8729, 1e-3);
 }
 
+TEST(CxxApi, run_async) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+  config.set_async_workers(2);
+  config.set_async_queue_size(2);
+
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+
+  // Queue more requests than the workers and the queue can hold, the
+  // requests with the different inputs must not see each other's data.
+  const int num_requests = 8;
+  std::vector<std::shared_ptr<AsyncRequest>> requests;
+  std::vector<std::future<void>> futures;
+  std::atomic<int> num_callbacks{0};
+  for (int r = 0; r < num_requests; r++) {
+    std::shared_ptr<AsyncRequest> request(new AsyncRequest);
+    auto input_tensor = request->GetInput(0);
+    input_tensor->Resize(std::vector<int64_t>({100, 100}));
+    auto* data = input_tensor->mutable_data<float>();
+    for (int i = 0; i < 100 * 100; i++) {
+      data[i] = r % 2 == 0 ? i : 0;
+    }
+    futures.push_back(predictor->RunAsync(
+        request,
+        [&num_callbacks](const std::shared_ptr<AsyncRequest>& finished,
+                         bool success) {
+          EXPECT_TRUE(success);
+          EXPECT_EQ(finished->output_size(), 1);
+          num_callbacks++;
+        }));
+    requests.push_back(request);
+  }
+
+  for (int r = 0; r < num_requests; r++) {
+    futures[r].get();
+    auto output = requests[r]->GetOutput(0);
+    auto* out = output->data<float>();
+    if (r % 2 == 0) {
+      EXPECT_NEAR(out[0], 50.2132, 1e-3);
+      EXPECT_NEAR(out[1], -28.8729, 1e-3);
+    } else {
+      EXPECT_GT(std::abs(out[0] - 50.2132), 1e-3);
+    }
+  }
+  EXPECT_EQ(num_callbacks.load(), num_requests);
+}
+
+TEST(CxxApi, run_async_batching) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+  config.set_async_queue_size(8);
+  config.set_async_max_batch_size(300);
+  config.set_async_batch_timeout_us(100000);
+
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+
+  // The rows of the merged requests are split back to each of them.
+  const int num_requests = 8;
+  std::vector<std::shared_ptr<AsyncRequest>> requests;
+  std::vector<std::future<void>> futures;
+  for (int r = 0; r < num_requests; r++) {
+    std::shared_ptr<AsyncRequest> request(new AsyncRequest);
+    auto input_tensor = request->GetInput(0);
+    input_tensor->Resize(std::vector<int64_t>({100, 100}));
+    auto* data = input_tensor->mutable_data<float>();
+    for (int i = 0; i < 100 * 100; i++) {
+      data[i] = r % 2 == 0 ? i : 0;
+    }
+    futures.push_back(predictor->RunAsync(request));
+    requests.push_back(request);
+  }
+
+  for (int r = 0; r < num_requests; r++) {
+    futures[r].get();
+    auto output = requests[r]->GetOutput(0);
+    EXPECT_EQ(output->shape()[0], 100);
+    auto* out = output->data<float>();
+    if (r % 2 == 0) {
+      EXPECT_NEAR(out[0], 50.2132, 1e-3);
+      EXPECT_NEAR(out[1], -28.8729, 1e-3);
+    } else {
+      EXPECT_GT(std::abs(out[0] - 50.2132), 1e-3);
+    }
+  }
+}
+
+TEST(CxxApi, op_stats) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+  config.set_op_stats_interval(2);
+
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  auto input_tensor = predictor->GetInput(0);
+  input_tensor->Resize(std::vector<int64_t>({100, 100}));
+  auto* data = input_tensor->mutable_data<float>();
+  for (int i = 0; i < 100 * 100; i++) {
+    data[i] = i;
+  }
+
+  // One of every two runs is sampled.
+  for (int i = 0; i < 10; i++) {
+    predictor->Run();
+  }
+  auto stats = predictor->GetOpStats();
+  ASSERT_FALSE(stats.empty());
+  double flops = 0;
+  for (auto& op_stats : stats) {
+    EXPECT_EQ(op_stats.count, 5);
+    EXPECT_LE(op_stats.p99_ms, op_stats.max_ms);
+    EXPECT_GT(op_stats.bytes, 0);
+    flops += op_stats.flops;
+  }
+  EXPECT_GT(flops, 0);
+
+  // The sampling can be turned off at runtime.
+  predictor->ResetOpStats();
+  predictor->SetOpStatsInterval(0);
+  predictor->Run();
+  EXPECT_TRUE(predictor->GetOpStats().empty());
+}
+
+TEST(CxxApi, trace) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  auto input_tensor = predictor->GetInput(0);
+  input_tensor->Resize(std::vector<int64_t>({100, 100}));
+  auto* data = input_tensor->mutable_data<float>();
+  for (int i = 0; i < 100 * 100; i++) {
+    data[i] = i;
+  }
+
+  std::string trace_file = FLAGS_model_dir + ".trace.json";
+  lite_api::StartTrace();
+  for (int i = 0; i < 3; i++) {
+    predictor->Run();
+  }
+  ASSERT_TRUE(lite_api::StopTrace(trace_file));
+  std::string trace = lite::ReadFile(trace_file);
+  EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(trace.find("\"cat\": \"op\""), std::string::npos);
+}
+
+TEST(CxxApi, frozen_program) {
+  std::shared_ptr<PaddlePredictor> predictors[2];
+  for (int i = 0; i < 2; i++) {
+    lite_api::CxxConfig config;
+    config.set_model_dir(FLAGS_model_dir);
+    config.set_valid_places({
+        Place{TARGET(kX86), PRECISION(kFloat)},
+        Place{TARGET(kARM), PRECISION(kFloat)},
+    });
+    config.set_frozen_program(i == 1);
+    predictors[i] = lite_api::CreatePaddlePredictor(config);
+  }
+
+  // The second signature refreezes the program, and the first one runs on
+  // the fallback before it's frozen again.
+  const int64_t batch_sizes[] = {100, 20, 100};
+  const int repeats = 100;
+  for (auto batch_size : batch_sizes) {
+    double avg_ms[2];
+    for (int i = 0; i < 2; i++) {
+      auto input_tensor = predictors[i]->GetInput(0);
+      input_tensor->Resize(std::vector<int64_t>({batch_size, 100}));
+      auto* data = input_tensor->mutable_data<float>();
+      for (int j = 0; j < batch_size * 100; j++) {
+        data[j] = j;
+      }
+      predictors[i]->Run();
+      auto start = std::chrono::steady_clock::now();
+      for (int j = 0; j < repeats; j++) {
+        predictors[i]->Run();
+      }
+      auto end = std::chrono::steady_clock::now();
+      avg_ms[i] =
+          std::chrono::duration<double, std::milli>(end - start).count() /
+          repeats;
+    }
+    LOG(INFO) << "batch_size: " << batch_size << ", avg " << avg_ms[0]
+              << " ms, frozen avg " << avg_ms[1] << " ms";
+
+    auto output = predictors[0]->GetOutput(0);
+    auto frozen_output = predictors[1]->GetOutput(0);
+    ASSERT_EQ(output->shape(), frozen_output->shape());
+    EXPECT_EQ(output->shape()[0], batch_size);
+    int64_t size = 1;
+    for (auto dim : output->shape()) {
+      size *= dim;
+    }
+    auto* out = output->data<float>();
+    auto* frozen_out = frozen_output->data<float>();
+    for (int64_t j = 0; j < size; j++) {
+      EXPECT_NEAR(out[j], frozen_out[j], 1e-5);
+    }
+  }
+}
+
+void ClearOptimizedModelCache(const std::string& cache_dir) {
+  if (!lite::IsDir(cache_dir)) return;
+  for (auto& file : lite::ListFile(cache_dir)) {
+    std::remove((cache_dir + "/" + file).c_str());
+  }
+}
+
+std::shared_ptr<PaddlePredictor> CreateCachedPredictor(
+    const std::string& cache_dir,
+    const std::vector<Place>& valid_places,
+    const std::vector<std::string>& discarded_passes = {}) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places(valid_places);
+  for (auto& pass : discarded_passes) {
+    config.add_discarded_pass(pass);
+  }
+  config.set_optimized_model_cache_dir(cache_dir);
+  return lite_api::CreatePaddlePredictor(config);
+}
+
+std::vector<float> RunPredictor(PaddlePredictor* predictor) {
+  auto input_tensor = predictor->GetInput(0);
+  input_tensor->Resize(std::vector<int64_t>({100, 100}));
+  auto* data = input_tensor->mutable_data<float>();
+  for (int i = 0; i < 100 * 100; i++) {
+    data[i] = i;
+  }
+  predictor->Run();
+  auto output = predictor->GetOutput(0);
+  int64_t size = 1;
+  for (auto dim : output->shape()) {
+    size *= dim;
+  }
+  return std::vector<float>(output->data<float>(),
+                            output->data<float>() + size);
+}
+
+TEST(CxxApi, optimized_model_cache) {
+  const std::string cache_dir = FLAGS_model_dir + ".cache";
+  ClearOptimizedModelCache(cache_dir);
+  const std::vector<Place> valid_places{
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  };
+
+  // The first creation optimizes the model and saves it as '<hash>.nb'.
+  auto predictor = CreateCachedPredictor(cache_dir, valid_places);
+  EXPECT_FALSE(predictor->IsOptimizedModelCacheHit());
+  auto files = lite::ListFile(cache_dir);
+  ASSERT_EQ(files.size(), 1u);
+  ASSERT_EQ(files[0].size(), 16u + 3u);
+  EXPECT_EQ(files[0].find_first_not_of("0123456789abcdef"), 16u);
+  EXPECT_EQ(files[0].substr(16), ".nb");
+  auto output = RunPredictor(predictor.get());
+  EXPECT_NEAR(output[0], 50.2132, 1e-3);
+  EXPECT_NEAR(output[1], -28.8729, 1e-3);
+
+  // The second one loads the cached model and gets the same outputs.
+  auto cached_predictor = CreateCachedPredictor(cache_dir, valid_places);
+  EXPECT_TRUE(cached_predictor->IsOptimizedModelCacheHit());
+  EXPECT_EQ(lite::ListFile(cache_dir).size(), 1u);
+  auto cached_output = RunPredictor(cached_predictor.get());
+  ASSERT_EQ(cached_output.size(), output.size());
+  for (size_t i = 0; i < output.size(); i++) {
+    EXPECT_NEAR(cached_output[i], output[i], 1e-5);
+  }
+
+  // The other places or discarded passes are keyed to the other files.
+  auto x86_predictor = CreateCachedPredictor(
+      cache_dir, {Place{TARGET(kX86), PRECISION(kFloat)}});
+  EXPECT_FALSE(x86_predictor->IsOptimizedModelCacheHit());
+  EXPECT_EQ(lite::ListFile(cache_dir).size(), 2u);
+  auto discarded_predictor =
+      CreateCachedPredictor(cache_dir, valid_places, {"lite_fc_fuse_pass"});
+  EXPECT_FALSE(discarded_predictor->IsOptimizedModelCacheHit());
+  EXPECT_EQ(lite::ListFile(cache_dir).size(), 3u);
+  auto discarded_output = RunPredictor(discarded_predictor.get());
+  ASSERT_EQ(discarded_output.size(), output.size());
+  for (size_t i = 0; i < output.size(); i++) {
+    EXPECT_NEAR(discarded_output[i], output[i], 1e-3);
+  }
+  ClearOptimizedModelCache(cache_dir);
+}
+
 // Demo1 for Mobile Devices :Load model from file and run
 #ifdef LITE_WITH_ARM
 TEST(LightApi, run) {
@@ -39,6 +39,7 @@ DEFINE_int32(power_mode,
              "2 for all cores, "
              "3 for no bind");
 DEFINE_int32(threads, 1, "threads num");
+DEFINE_int32(inter_op_threads, 1, "max number of the ops to run concurrently");
 DEFINE_int32(im_width, 224, "image width");
 DEFINE_int32(im_height, 224, "image height");
 DEFINE_bool(int8, false, "is run int8");
@@ -31,6 +31,8 @@ TEST(InceptionV4, test_inceptionv4_lite_x86) {
   config.set_model_dir(FLAGS_model_dir);
   config.set_valid_places({lite_api::Place{TARGET(kX86), PRECISION(kFloat)},
                            lite_api::Place{TARGET(kHost), PRECISION(kFloat)}});
+  config.set_x86_math_num_threads(FLAGS_threads);
+  config.set_inter_op_threads(FLAGS_inter_op_threads);
   auto predictor = lite_api::CreatePaddlePredictor(config);
 
   auto input_tensor = predictor->GetInput(0);
@@ -55,8 +57,9 @@ TEST(InceptionV4, test_inceptionv4_lite_x86) {
   }
 
   LOG(INFO) << "================== Speed Report ===================";
-  LOG(INFO) << "Model: " << FLAGS_model_dir << ", warmup: " << FLAGS_warmup
-            << ", repeats: " << FLAGS_repeats << ", spend "
+  LOG(INFO) << "Model: " << FLAGS_model_dir << ", threads num " << FLAGS_threads
+            << ", inter_op_threads " << FLAGS_inter_op_threads
+            << ", warmup: " << FLAGS_warmup << ", repeats: " << FLAGS_repeats << ", spend "
             << (GetCurrentUS() - start) / FLAGS_repeats / 1000.0
             << " ms in average.";
   std::vector<std::vector<float>> results;
@@ -15,7 +15,9 @@
 #include "lite/api/tools/benchmark/benchmark.h"
 #include <algorithm>
 #include <cstdio>
+#include <deque>
 #include <fstream>
+#include <future>  // NOLINT
 #include <iomanip>
 #include <map>
 #include <memory>
@@ -67,7 +69,17 @@ std::shared_ptr<PaddlePredictor> CreatePredictor(
   MobileConfig config;
   config.set_model_from_file(model_file);
   config.set_threads(FLAGS_threads);
+  config.set_inter_op_threads(FLAGS_inter_op_threads);
+  config.set_frozen_program(FLAGS_frozen_program);
+  config.set_autotune(FLAGS_autotune);
   config.set_power_mode(static_cast<PowerMode>(FLAGS_power_mode));
+  config.set_async_queue_size(FLAGS_concurrency);
+  config.set_async_max_batch_size(FLAGS_max_batch_size);
+  config.set_async_batch_timeout_us(FLAGS_batch_timeout_us);
+  if (!FLAGS_unbatchable_inputs.empty()) {
+    config.set_async_unbatchable_inputs(
+        lite::Split(FLAGS_unbatchable_inputs, ","));
+  }
 
   // Set backend config info
   SetBackendConfig(config);
@@ -83,6 +95,52 @@ void RunImpl(std::shared_ptr<PaddlePredictor> predictor, PerfData* perf_data) {
   perf_data->set_run_time(timer.Stop());
 }
 
+// Keep FLAGS_concurrency requests of RunAsync in flight with the inputs of the
+// predictor, the run time of a request is the latency from the submission to
+// the completion. Return the total time of the repeats.
+float RunConcurrently(std::shared_ptr<PaddlePredictor> predictor,
+                      PerfData* perf_data) {
+  size_t input_num = predictor->GetInputNames().size();
+  std::vector<std::shared_ptr<AsyncRequest>> requests(FLAGS_concurrency);
+  for (auto& request : requests) {
+    request = std::make_shared<AsyncRequest>();
+    for (size_t i = 0; i < input_num; i++) {
+      auto input_tensor = predictor->GetInput(i);
+      auto request_input = request->GetInput(i);
+      request_input->Resize(input_tensor->shape());
+      request_input->SetLoD(input_tensor->lod());
+      request_input->CopyFromCpu<float, TargetType::kHost>(
+          input_tensor->data<float>());
+    }
+  }
+  std::vector<float> latencies(FLAGS_repeats);
+  std::deque<std::future<void>> futures;
+  lite::Timer timer;
+  timer.Start();
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    // The request is reused once its previous submission is finished.
+    if (futures.size() == requests.size()) {
+      futures.front().get();
+      futures.pop_front();
+    }
+    uint64_t start = lite::Timer::GetCurrentUS();
+    futures.push_back(predictor->RunAsync(
+        requests[i % requests.size()],
+        [&latencies, i, start](const std::shared_ptr<AsyncRequest>& request,
+                               bool success) {
+          latencies[i] = (lite::Timer::GetCurrentUS() - start) / 1000.f;
+        }));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+  float total_time = timer.Stop();
+  for (auto latency : latencies) {
+    perf_data->set_run_time(latency);
+  }
+  return total_time;
+}
+
 #ifdef __ANDROID__
 void RunImpl(std::shared_ptr<PaddlePredictor> predictor,
              PerfData* perf_data,
@@ -106,6 +164,39 @@ void RunImpl(std::shared_ptr<PaddlePredictor> predictor,
 }
 #endif
 
+// Append the latencies of the layers sampled in the repeats to the latency
+// lookup table, the layer rows are looked up by the cost model of
+// static_kernel_pick_pass with the first output and the place of the kernel.
+void SaveKernelLatencyTable(std::shared_ptr<PaddlePredictor> predictor,
+                            const std::string& path) {
+  bool exists = lite::IsFileExists(path);
+  std::ofstream fs(path, std::ios::app);
+  if (!fs.is_open()) {
+    std::cerr << "Fail to open the latency lookup table: " << path
+              << std::endl;
+    return;
+  }
+  if (!exists) {
+    fs << "dev_info\tarmv7/v8\tcore_num\tthread_num\tpower_mode\n";
+    fs << "benchmark_bin\t-\t-\t" << FLAGS_threads << "\t"
+       << FLAGS_power_mode << "\n";
+    fs << "op_name\tinput_dims\toutput_dims\tparam_info\tmin_latency(ms)\t"
+          "max_latency(ms)\tavg_latency(ms)\n";
+  }
+  for (auto& stats : predictor->GetOpStats()) {
+    if (stats.op_type == "feed" || stats.op_type == "fetch") continue;
+    // The kernel name is op_type:target/precision/layout.
+    auto kernel = stats.kernel_name.substr(stats.kernel_name.find(':') + 1);
+    fs << stats.op_type << "\t[]\t[";
+    for (size_t i = 0; i < stats.output_shape.size(); i++) {
+      fs << (i > 0 ? " " : "") << stats.output_shape[i];
+    }
+    fs << "]\t(output=" << stats.output_name << ",kernel=" << kernel
+       << ")\t-\t" << stats.max_ms << "\t" << stats.avg_ms << "\n";
+  }
+  std::cout << "Append the latencies of the layers to " << path << std::endl;
+}
+
 void Run(const std::string& model_file,
          const std::vector<std::vector<int64_t>>& input_shapes) {
   lite::Timer timer;
@@ -178,6 +269,7 @@ void Run(const std::string& model_file,
   }
 
   bool has_validation_set = !(FLAGS_validation_set.empty());
+  float total_time = 0.f;
   // Warmup
   for (int i = 0; i < FLAGS_warmup; ++i) {
 #ifdef __ANDROID__
@@ -195,6 +287,10 @@ void Run(const std::string& model_file,
     timer.SleepInMs(FLAGS_run_delay);
   }
 
+  if (!FLAGS_trace_file.empty()) StartTrace();
+  if (!FLAGS_kernel_latency_table_out.empty()) {
+    predictor->SetOpStatsInterval(1);
+  }
   if (has_validation_set) {
     for (int i = 0; i < FLAGS_repeats; ++i) {
 #ifdef __ANDROID__
@@ -211,6 +307,10 @@ void Run(const std::string& model_file,
 #endif
       timer.SleepInMs(FLAGS_run_delay);
     }
+  } else if (FLAGS_concurrency > 1) {
+    total_time = RunConcurrently(predictor, &perf_data);
+    // The outputs of the predictor may be the ones of a batch.
+    predictor->Run();
   } else {
     for (int i = 0; i < FLAGS_repeats; ++i) {
       RunImpl(predictor, &perf_data);
@@ -218,6 +318,12 @@ void Run(const std::string& model_file,
     }
   }
 
+  if (!FLAGS_trace_file.empty()) StopTrace(FLAGS_trace_file);
+  if (!FLAGS_kernel_latency_table_out.empty()) {
+    SaveKernelLatencyTable(predictor, FLAGS_kernel_latency_table_out);
+    predictor->SetOpStatsInterval(0);
+  }
+
   // Get output
   size_t output_tensor_num = predictor->GetOutputNames().size();
   std::stringstream out_ss;
@@ -274,6 +380,15 @@ void Run(const std::string& model_file,
   ss << "\n======= Runtime Info =======\n";
   ss << "benchmark_bin version: " << lite::version() << std::endl;
   ss << "threads: " << FLAGS_threads << std::endl;
+  ss << "inter_op_threads: " << FLAGS_inter_op_threads << std::endl;
+  ss << "frozen_program: " << FLAGS_frozen_program << std::endl;
+  ss << "autotune: " << FLAGS_autotune << std::endl;
+  if (FLAGS_concurrency > 1) {
+    ss << "concurrency: " << FLAGS_concurrency << std::endl;
+    ss << "max_batch_size: " << FLAGS_max_batch_size << std::endl;
+    ss << "batch_timeout_us: " << FLAGS_batch_timeout_us << std::endl;
+    ss << "unbatchable_inputs: " << FLAGS_unbatchable_inputs << std::endl;
+  }
   ss << "power_mode: " << FLAGS_power_mode << std::endl;
   ss << "warmup: " << FLAGS_warmup << std::endl;
   ss << "repeats: " << FLAGS_repeats << std::endl;
@@ -318,6 +433,23 @@ void Run(const std::string& model_file,
   ss << "min   = " << std::setw(12) << perf_data.min_run_time() << std::endl;
   ss << "max   = " << std::setw(12) << perf_data.max_run_time() << std::endl;
   ss << "avg   = " << std::setw(12) << perf_data.avg_run_time() << std::endl;
+  if (total_time > 0.f) {
+    ss << "\nThroughput(unit: requests/s):\n";
+    ss << "qps   = " << std::setw(12) << FLAGS_repeats / (total_time / 1000)
+       << std::endl;
+  }
+  std::ifstream model_stream(model_file, std::ios::binary | std::ios::ate);
+  if (model_stream.is_open()) {
+    float model_size = static_cast<float>(model_stream.tellg());
+    ss << "\nModel Size(unit: MB):\n";
+    ss << "size  = " << std::setw(12) << model_size / 1024 / 1024 << std::endl;
+    // The init time also covers the creation of the kernels besides the
+    // loading of the params, so it's a lower bound of the load throughput.
+    ss << "\nInit Throughput(unit: GB/s):\n";
+    ss << "init  = " << std::setw(12)
+       << model_size / 1024 / 1024 / 1024 / (perf_data.init_time() / 1000)
+       << std::endl;
+  }
 #ifdef __linux__
   if (FLAGS_enable_memory_profile) {
     ss << "\nMemory Usage(unit: MB):\n";
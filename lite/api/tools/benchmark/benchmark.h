@@ -29,6 +29,7 @@
 #include "lite/utils/log/cp_logging.h"
 #include "lite/utils/model_util.h"
 #include "lite/utils/string.h"
+#include "lite/utils/timer.h"
 
 namespace paddle {
 namespace lite_api {
@@ -385,6 +386,18 @@ const std::string OutputOptModel(const std::string& opt_model_file) {
     out_name = model_dir + "/opt";
   }
   opt.SetOptimizeOut(out_name);
+  if (FLAGS_compress_weights) {
+    opt.SetCompressWeights(true);
+  }
+  if (FLAGS_autotune) {
+    opt.SetAutotune(FLAGS_input_shape);
+  }
+  if (!FLAGS_kernel_latency_table.empty()) {
+    opt.SetKernelLatencyTable(FLAGS_kernel_latency_table);
+  }
+  if (!FLAGS_optimized_model_cache_dir.empty()) {
+    opt.SetOptimizedModelCacheDir(FLAGS_optimized_model_cache_dir);
+  }
 
   std::string saved_opt_model_file =
       opt_model_file.empty() ? out_name + ".nb" : opt_model_file;
@@ -397,7 +410,10 @@ const std::string OutputOptModel(const std::string& opt_model_file) {
     }
   }
 
+  lite::Timer timer;
+  timer.Start();
   opt.Run();
+  float opt_time = timer.Stop();
 
   std::stringstream ss;
   ss << "\n======= Opt Info =======\n";
@@ -407,6 +423,12 @@ const std::string OutputOptModel(const std::string& opt_model_file) {
              : FLAGS_uncombined_model_dir)
      << std::endl;
   ss << "Save optimized model to " << saved_opt_model_file << std::endl;
+  if (!FLAGS_optimized_model_cache_dir.empty()) {
+    ss << "Optimized model cache: "
+       << (opt.IsOptimizedModelCacheHit() ? "hit" : "miss") << " in "
+       << FLAGS_optimized_model_cache_dir << std::endl;
+  }
+  ss << "Opt time(unit: ms): " << opt_time << std::endl;
   std::cout << ss.str();
 
   StoreBenchmarkResult(ss.str());
@@ -26,6 +26,10 @@ DEFINE_string(input_shape, "", input_shape_msg);
 DEFINE_string(input_data_path, "", input_data_path_msg);
 DEFINE_string(validation_set, "", validation_set_msg);
 DEFINE_bool(show_output_elem, false, show_output_elem_msg);
+DEFINE_bool(compress_weights, false, compress_weights_msg);
+DEFINE_bool(autotune, false, autotune_msg);
+DEFINE_string(kernel_latency_table, "", kernel_latency_table_msg);
+DEFINE_string(optimized_model_cache_dir, "", optimized_model_cache_dir_msg);
 
 // Common runtime options
 DEFINE_int32(warmup, 0, warmup_msg);
@@ -33,6 +37,12 @@ DEFINE_int32(repeats, 1, repeats_msg);
 DEFINE_double(run_delay, -1.0, run_delay_msg);
 DEFINE_int32(power_mode, 0, power_mode_msg);
 DEFINE_int32(threads, 1, threads_msg);
+DEFINE_int32(inter_op_threads, 1, inter_op_threads_msg);
+DEFINE_bool(frozen_program, false, frozen_program_msg);
+DEFINE_int32(concurrency, 1, concurrency_msg);
+DEFINE_int32(max_batch_size, 1, max_batch_size_msg);
+DEFINE_int64(batch_timeout_us, 1000, batch_timeout_us_msg);
+DEFINE_string(unbatchable_inputs, "", unbatchable_inputs_msg);
 DEFINE_string(result_path, "", result_path_msg);
 
 // Backend options
@@ -56,6 +66,8 @@ DEFINE_string(nnadapter_context_properties,
 DEFINE_bool(enable_op_time_profile, false, enable_op_time_profile_msg);
 DEFINE_bool(enable_memory_profile, false, enable_memory_profile_msg);
 DEFINE_int32(memory_check_interval_ms, 5, memory_check_interval_ms_msg);
+DEFINE_string(trace_file, "", trace_file_msg);
+DEFINE_string(kernel_latency_table_out, "", kernel_latency_table_out_msg);
 
 // Configuration options
 DEFINE_string(config_path, "", config_path_msg);
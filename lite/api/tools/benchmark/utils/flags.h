@@ -49,6 +49,21 @@ static const char validation_set_msg[] =
     "Supported set: ILSVRC_2012";
 static const char show_output_elem_msg[] =
     "Show each output tensor's all elements.";
+static const char compress_weights_msg[] =
+    "Compress the weights losslessly when the model is optimized by opt. "
+    "The compressed model is smaller and is decompressed while loading.";
+static const char autotune_msg[] =
+    "Time the algorithms of the kernels, e.g. winograd and gemm of conv2d, "
+    "on this machine in the first run. The model optimized by opt records "
+    "the fastest ones, which are reused on the same CPU model.";
+static const char kernel_latency_table_msg[] =
+    "Pick the kernels of the model optimized by opt by the latency lookup "
+    "tables separated by ',', e.g. the ones of --kernel_latency_table_out of "
+    "the runs on the different backends.";
+static const char optimized_model_cache_dir_msg[] =
+    "Cache the models optimized by opt in the dir, keyed by the hash of the "
+    "model, the options and the version. The later runs on the same model "
+    "load the cached one without optimizing.";
 
 // Common runtime options
 static const char warmup_msg[] = "warmup times";
@@ -63,6 +78,23 @@ static const char power_mode_msg[] =
     "2 for all cores, "
     "3 for no bind";
 static const char threads_msg[] = "threads num";
+static const char inter_op_threads_msg[] =
+    "The max number of the independent ops to run concurrently, the threads "
+    "are partitioned among them.";
+static const char frozen_program_msg[] =
+    "Skip InferShape of the static ops and dispatch the kernels from a flat "
+    "array after the first run, the op shapes of the model must only depend "
+    "on the input shapes.";
+static const char concurrency_msg[] =
+    "The number of the requests of RunAsync in flight, the repeats are "
+    "submitted by RunAsync if it's greater than 1.";
+static const char max_batch_size_msg[] =
+    "The max number of the samples of the pending requests of RunAsync "
+    "merged into a batch, no batching if it's 1.";
+static const char batch_timeout_us_msg[] =
+    "The time in microseconds to wait for more requests to fill a batch.";
+static const char unbatchable_inputs_msg[] =
+    "The names of the inputs without the batch axis, separated by comma.";
 static const char result_path_msg[] = "Save benchmark info to the file.";
 
 // Backend options
@@ -106,6 +138,12 @@ static const char memory_check_interval_ms_msg[] =
     "The interval in millisecond between two consecutive memory "
     "footprint checks. This is only used when "
     "--enable_memory_profile is set to true. Not supported yet.";
+static const char trace_file_msg[] =
+    "Write the timeline of the repeats in the Chrome Trace Event format to "
+    "the file, which can be opened by chrome://tracing or Perfetto.";
+static const char kernel_latency_table_out_msg[] =
+    "Append the latency of each layer of the repeats to the latency lookup "
+    "table, which --kernel_latency_table and opt read.";
 
 // Configuration options
 static const char config_path_msg[] = "Configuration options.";
@@ -121,6 +159,10 @@ DECLARE_string(input_shape);
 DECLARE_string(input_data_path);
 DECLARE_string(validation_set);
 DECLARE_bool(show_output_elem);
+DECLARE_bool(compress_weights);
+DECLARE_bool(autotune);
+DECLARE_string(kernel_latency_table);
+DECLARE_string(optimized_model_cache_dir);
 
 // Common runtime options
 DECLARE_int32(warmup);
@@ -128,6 +170,12 @@ DECLARE_int32(repeats);
 DECLARE_double(run_delay);
 DECLARE_int32(power_mode);
 DECLARE_int32(threads);
+DECLARE_int32(inter_op_threads);
+DECLARE_bool(frozen_program);
+DECLARE_int32(concurrency);
+DECLARE_int32(max_batch_size);
+DECLARE_int64(batch_timeout_us);
+DECLARE_string(unbatchable_inputs);
 DECLARE_string(result_path);
 
 // Backend options
@@ -145,6 +193,8 @@ DECLARE_string(nnadapter_context_properties);
 DECLARE_bool(enable_op_time_profile);
 DECLARE_bool(enable_memory_profile);
 DECLARE_int32(memory_check_interval_ms);
+DECLARE_string(trace_file);
+DECLARE_string(kernel_latency_table_out);
 
 // Configuration options
 DECLARE_string(config_path);
@@ -47,6 +47,12 @@ DEFINE_string(quant_type,
               "QUANT_INT16",
               "Set the quant_type for post_quant_dynamic, "
               "and it should be QUANT_INT8 or QUANT_INT16 for now.");
+DEFINE_string(quant_ops,
+              "",
+              "The op types quantized by post_quant_dynamic splitted by \",\", "
+              "e.g. \"fc,matmul_v2\", all of the supported ones by default. "
+              "With QUANT_INT8, the x86 fc, mul and matmul(_v2) named here run "
+              "the int8 weights by the dynamic quantization.");
 DEFINE_bool(enable_fp16, false, "Set kernel_type run in FP16.");
 DEFINE_bool(record_tailoring_info,
             false,
@@ -57,7 +63,8 @@ DEFINE_string(optimize_out, "", "path of the output optimized model");
 DEFINE_string(valid_targets,
               "arm",
               "The targets this model optimized for, should be one of (arm, "
-              "opencl, x86, x86_opencl), splitted by space");
+              "opencl, x86, x86_nchw8c, x86_nchw16c, x86_opencl), splitted by "
+              "space");
 DEFINE_bool(print_supported_ops,
             false,
             "Print supported operators on the inputed target");
@@ -74,6 +81,34 @@ DEFINE_bool(sparse_model,
 DEFINE_double(sparse_threshold,
               0.6,
               "Set 0.6 as the lower bound for the sparse conv pass.");
+DEFINE_bool(compress_weights,
+            false,
+            "Compress the weights of the naive buffer model losslessly.");
+DEFINE_string(autotune_input_shape,
+              "",
+              "Time the algorithms of the kernels on the inputs of the "
+              "shapes, e.g. 1,3,224,224, and save the fastest ones into the "
+              "optimized model. Only if opt is built with the kernels and "
+              "runs on the target machine.");
+DEFINE_string(calibration_data,
+              "",
+              "The dir of the calibration samples to quantize the model to "
+              "int8, each file is the raw float32 data of the inputs. Only if "
+              "opt is built with the kernels and runs on the target machine.");
+DEFINE_string(calibration_input_shape,
+              "",
+              "The shapes of the inputs of the calibration samples, e.g. "
+              "1,3,224,224.");
+DEFINE_string(calibration_algo,
+              "kl",
+              "The calibration algorithm: abs_max, kl or percentile.");
+DEFINE_string(kernel_latency_table,
+              "",
+              "Pick the kernels by the latency lookup tables, separated by "
+              "',', instead of the order of valid_targets.");
+DEFINE_string(kernel_pick_plan,
+              "",
+              "The file to dump the kernels picked by kernel_latency_table.");
 DEFINE_string(optimized_nb_model_path,
               "",
               "path of the optimized nb model, this argument is use for the "
@@ -124,11 +159,29 @@ int main(int argc, char** argv) {
   if (FLAGS_quant_model) {
     opt.SetQuantModel(true);
     opt.SetQuantType(FLAGS_quant_type);
+    if (!FLAGS_quant_ops.empty()) {
+      opt.SetQuantOps(FLAGS_quant_ops);
+    }
   }
   if (FLAGS_sparse_model) {
     opt.SetSparseModel(true);
     opt.SetSparseThreshold(FLAGS_sparse_threshold);
   }
+  if (FLAGS_compress_weights) {
+    opt.SetCompressWeights(true);
+  }
+  if (!FLAGS_autotune_input_shape.empty()) {
+    opt.SetAutotune(FLAGS_autotune_input_shape);
+  }
+  if (!FLAGS_calibration_data.empty()) {
+    opt.SetCalibration(FLAGS_calibration_data,
+                       FLAGS_calibration_input_shape,
+                       FLAGS_calibration_algo);
+  }
+  if (!FLAGS_kernel_latency_table.empty()) {
+    opt.SetKernelLatencyTable(FLAGS_kernel_latency_table,
+                              FLAGS_kernel_pick_plan);
+  }
   if (FLAGS_print_all_ops) {
     opt.PrintAllOps();
     return 0;
@@ -13,11 +13,18 @@
 // limitations under the License.
 
 #include "lite/api/tools/opt_base.h"
+#include <algorithm>
 #include <fstream>
+#include <functional>
+#include <map>
 #include <memory>
 #include <utility>
+#include "lite/core/calibration.h"
 #include "lite/core/optimizer/mir/dot.h"
+#include "lite/core/optimizer/mir/pass_manager.h"
+#include "lite/core/optimizer/mir/post_training_quant_pass.h"
 #include "lite/core/scope.h"
+#include "lite/utils/model_util.h"
 #include "lite/utils/string.h"
 namespace paddle {
 namespace lite_api {
@@ -58,18 +65,22 @@ void OptBase::SetQuantType(const std::string& quant_type) {
   }
 }
 
+void OptBase::SetQuantOps(const std::string& quant_ops) {
+  opt_config_.set_quant_ops(lite::Split(quant_ops, ","));
+}
+
 void OptBase::SetSparseModel(bool sparse_model) {
   opt_config_.set_sparse_model(sparse_model);
 }
 
 void OptBase::SetSparseThreshold(float sparse_threshold) {
-  // sparse_model mode only supported on Arm.
+  // sparse_model mode only supported on Arm and X86.
   TargetType target;
   for (size_t i = 0; i < valid_places_.size(); i++) {
     target = valid_places_[i].target;
-    if (target != TargetType::kARM) {
-      OPT_LOG << "sparse_model mode only supported on Arm. The model will "
-                 "be optimized to dense format.";
+    if (target != TargetType::kARM && target != TargetType::kX86) {
+      OPT_LOG << "sparse_model mode only supported on Arm and X86. The model "
+                 "will be optimized to dense format.";
       opt_config_.set_sparse_model(false);
       break;
     }
@@ -82,6 +93,269 @@ void OptBase::SetSparseThreshold(float sparse_threshold) {
   }
 }
 
+void OptBase::SetCompressWeights(bool compress_weights) {
+  opt_config_.set_compress_weights(compress_weights);
+}
+
+void OptBase::SetAutotune(const std::string& input_shapes) {
+#ifdef LITE_ON_MODEL_OPTIMIZE_TOOL
+  LOG(WARNING) << "The kernels of opt can't run, please run the tool built "
+                  "with the kernels, e.g. benchmark_bin, on the target "
+                  "machine to autotune.";
+  return;
+#endif
+  autotune_input_shapes_ = input_shapes;
+  opt_config_.set_autotune(!input_shapes.empty());
+}
+
+void OptBase::SetCalibration(const std::string& data_dir,
+                             const std::string& input_shapes,
+                             const std::string& algo) {
+#ifdef LITE_ON_MODEL_OPTIMIZE_TOOL
+  LOG(WARNING) << "The kernels of opt can't run, please run the tool built "
+                  "with the kernels on the target machine to calibrate.";
+  return;
+#endif
+  lite::CalibrationAlgo calibration_algo;
+  if (!lite::ParseCalibrationAlgo(algo, &calibration_algo)) {
+    OPT_LOG_FATAL << "Unsupported calibration algorithm: " << algo
+                  << ", only abs_max, kl and percentile are supported.";
+  }
+  if (!data_dir.empty() && input_shapes.empty()) {
+    OPT_LOG_FATAL << "Please set the input shapes of the calibration data.";
+  }
+  calibration_data_dir_ = data_dir;
+  calibration_input_shapes_ = input_shapes;
+  calibration_algo_ = algo;
+}
+
+void OptBase::SetKernelLatencyTable(const std::string& latency_table,
+                                    const std::string& plan_path) {
+  opt_config_.set_kernel_latency_table(latency_table);
+  opt_config_.set_kernel_pick_plan_path(plan_path);
+}
+
+void OptBase::SetOptimizedModelCacheDir(const std::string& cache_dir) {
+  opt_config_.set_optimized_model_cache_dir(cache_dir);
+}
+
+void OptBase::Autotune(PaddlePredictor* predictor) {
+  if (autotune_input_shapes_.empty()) return;
+  auto shapes = lite::GetShapes(autotune_input_shapes_);
+  for (size_t i = 0; i < shapes.size(); i++) {
+    auto input = predictor->GetInput(i);
+    input->Resize(shapes[i]);
+    auto* data = input->mutable_data<float>();
+    std::fill(data, data + lite::ShapeProduction(shapes[i]), 1.f);
+  }
+  predictor->Run();
+}
+
+namespace {
+
+// Sets the activation scales of post_training_quant_pass for the predictors
+// built in its lifetime. The pass is global, so the scales are cleared at the
+// end, otherwise they would quantize the next model optimized in the process.
+class ActivationScalesGuard {
+ public:
+  explicit ActivationScalesGuard(const std::map<std::string, float>& scales)
+      : quant_pass_(lite::mir::PassManager::Global()
+                        .LookUp<lite::mir::PostTrainingQuantPass>(
+                            "post_training_quant_pass")) {
+    CHECK(quant_pass_);
+    quant_pass_->SetActivationScales(scales);
+  }
+  ~ActivationScalesGuard() { quant_pass_->SetActivationScales({}); }
+
+  lite::mir::PostTrainingQuantPass* quant_pass() { return quant_pass_; }
+
+ private:
+  lite::mir::PostTrainingQuantPass* quant_pass_;
+};
+
+// Fill the inputs of 'predictor' of 'shapes' by the raw float32 sample in
+// 'path'.
+void FeedCalibrationSample(lite::Predictor* predictor,
+                           const std::string& path,
+                           const std::vector<std::vector<int64_t>>& shapes) {
+  std::ifstream fin(path, std::ios::binary);
+  for (size_t i = 0; i < shapes.size(); i++) {
+    auto* input = predictor->GetInput(i);
+    input->Resize(shapes[i]);
+    auto* data = input->mutable_data<float>();
+    fin.read(reinterpret_cast<char*>(data),
+             lite::ShapeProduction(shapes[i]) * sizeof(float));
+    if (!fin) {
+      OPT_LOG_FATAL << "[" << path
+                    << "] is smaller than the inputs of the calibration.";
+    }
+  }
+}
+
+// Call 'collect' with the float activations consumed by each op of
+// 'predictor' before running it.
+void ObserveActivations(
+    lite::Predictor* predictor,
+    const std::function<void(const std::string&, const lite::Tensor&)>&
+        collect) {
+  predictor->set_observer([collect](lite::Instruction* inst) {
+    auto layout = inst->kernel()->layout();
+    if (layout != DATALAYOUT(kNCHW) && layout != DATALAYOUT(kAny)) return;
+    auto* op = inst->mutable_op();
+    for (auto& name : op->op_info()->input_names()) {
+      auto* var = op->scope()->FindVar(name);
+      if (var == nullptr || !var->IsType<lite::Tensor>()) continue;
+      const auto& tensor = var->Get<lite::Tensor>();
+      if (tensor.persistable() || !tensor.IsInitialized() ||
+          tensor.precision() != PRECISION(kFloat) ||
+          (tensor.target() != TARGET(kHost) &&
+           tensor.target() != TARGET(kX86) &&
+           tensor.target() != TARGET(kARM))) {
+        continue;
+      }
+      collect(name, tensor);
+    }
+  });
+}
+
+}  // namespace
+
+std::map<std::string, float> OptBase::Calibrate() {
+  // The fp32 predictor isn't quantized.
+  ActivationScalesGuard fp32_guard({});
+  if (calibration_data_dir_.empty()) return {};
+
+  auto shapes = lite::GetShapes(calibration_input_shapes_);
+  auto files = lite::ListFile(calibration_data_dir_);
+  if (files.empty()) {
+    OPT_LOG_FATAL << "[" << calibration_data_dir_ << "] has no sample.";
+  }
+  std::sort(files.begin(), files.end());
+  for (auto& file : files) {
+    file = lite::Join<std::string>({calibration_data_dir_, file}, "/");
+  }
+  // The int8 kernels of x86 and arm are picked before the fp32 ones, the
+  // blocked layouts are left out of the calibration.
+  std::vector<Place> fp32_places;
+  std::vector<Place> int8_places;
+  for (auto& place : valid_places_) {
+    if (place.layout == DATALAYOUT(kNCHW8c) ||
+        place.layout == DATALAYOUT(kNCHW16c)) {
+      continue;
+    }
+    fp32_places.push_back(place);
+    Place int8_place{place.target, PRECISION(kInt8)};
+    if ((place.target == TARGET(kX86) || place.target == TARGET(kARM)) &&
+        std::find(int8_places.begin(), int8_places.end(), int8_place) ==
+            int8_places.end()) {
+      int8_places.push_back(int8_place);
+    }
+  }
+  if (int8_places.empty()) {
+    LOG(WARNING) << "The post-training quantization only supports x86 and "
+                    "arm, skip the calibration.";
+    return {};
+  }
+
+  // 1. Compute the scales of the activations on the fp32 model. The vars
+  // keep their names in the model to calibrate, which are the keys of the
+  // scales.
+  lite_api::CxxConfig config = opt_config_;
+  config.add_discarded_pass("memory_optimize_pass");
+  lite::CalibrationAlgo algo;
+  CHECK(lite::ParseCalibrationAlgo(calibration_algo_, &algo));
+  lite::Calibrator calibrator(algo);
+  lite::Predictor fp32_predictor;
+  fp32_predictor.Build(config, fp32_places);
+  ObserveActivations(
+      &fp32_predictor,
+      [&](const std::string& name, const lite::Tensor& tensor) {
+        calibrator.CollectAbsMax(name, tensor.data<float>(), tensor.numel());
+      });
+  for (auto& file : files) {
+    FeedCalibrationSample(&fp32_predictor, file, shapes);
+    fp32_predictor.Run();
+  }
+  if (calibrator.NeedHistogram()) {
+    ObserveActivations(
+        &fp32_predictor,
+        [&](const std::string& name, const lite::Tensor& tensor) {
+          calibrator.CollectHistogram(
+              name, tensor.data<float>(), tensor.numel());
+        });
+    for (auto& file : files) {
+      FeedCalibrationSample(&fp32_predictor, file, shapes);
+      fp32_predictor.Run();
+    }
+  }
+  std::map<std::string, float> scales;
+  for (auto& item : calibrator.ComputeThresholds()) {
+    scales[item.first] = item.second / 127.f;
+  }
+
+  // 2. The errors of the quantized activations and the outputs of the fp32
+  // model on the first sample.
+  std::map<std::string, float> activation_errors;
+  ObserveActivations(
+      &fp32_predictor,
+      [&](const std::string& name, const lite::Tensor& tensor) {
+        auto iter = scales.find(name);
+        if (iter == scales.end()) return;
+        activation_errors[name] = lite::QuantizationError(
+            tensor.data<float>(), tensor.numel(), iter->second);
+      });
+  FeedCalibrationSample(&fp32_predictor, files.front(), shapes);
+  fp32_predictor.Run();
+  fp32_predictor.set_observer(nullptr);
+  auto output_names = fp32_predictor.GetOutputNames();
+  std::vector<lite::Tensor> fp32_outputs(output_names.size());
+  for (size_t i = 0; i < output_names.size(); i++) {
+    fp32_outputs[i].CopyDataFrom(*fp32_predictor.GetOutput(i));
+  }
+
+  // 3. Quantize the model, and compare its outputs with the fp32 ones.
+  ActivationScalesGuard int8_guard(scales);
+  auto* quant_pass = int8_guard.quant_pass();
+  valid_places_.insert(
+      valid_places_.begin(), int8_places.begin(), int8_places.end());
+  int8_places.insert(int8_places.end(), fp32_places.begin(), fp32_places.end());
+  lite::Predictor int8_predictor;
+  int8_predictor.Build(config, int8_places);
+  FeedCalibrationSample(&int8_predictor, files.front(), shapes);
+  int8_predictor.Run();
+
+  OPT_LOG << "Quantized " << quant_pass->quantized_layers().size()
+          << " ops to int8 by the " << calibration_algo_
+          << " calibration of " << files.size() << " samples, the relative "
+          << "errors of the layers on the first sample:";
+  for (auto& layer : quant_pass->quantized_layers()) {
+    auto iter = activation_errors.find(layer.input);
+    OPT_LOG << lite::string_format(
+        "  %s(%s -> %s): input scale %g, input error %.4f, weight error %.4f",
+        layer.op_type.c_str(),
+        layer.input.c_str(),
+        layer.output.c_str(),
+        layer.input_scale,
+        iter != activation_errors.end() ? iter->second : 0.f,
+        layer.weight_error);
+  }
+  for (size_t i = 0; i < output_names.size(); i++) {
+    const auto* output = int8_predictor.GetOutput(i);
+    if (fp32_outputs[i].precision() != PRECISION(kFloat) ||
+        output->precision() != PRECISION(kFloat) ||
+        output->numel() != fp32_outputs[i].numel()) {
+      continue;
+    }
+    OPT_LOG << lite::string_format(
+        "  output %s: error %.4f",
+        output_names[i].c_str(),
+        lite::RelativeError(fp32_outputs[i].data<float>(),
+                            output->data<float>(),
+                            output->numel()));
+  }
+  return scales;
+}
+
 void OptBase::SetPassesInternal(
     const std::vector<std::string>& passes_internal) {
   opt_config_.set_passes_internal(passes_internal);
@@ -145,6 +419,17 @@ void OptBase::SetValidPlaces(const std::string& valid_places) {
       valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kFloat)});
       valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kInt64)});
       valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kAny)});
+    } else if (target_repr == "x86_nchw8c" || target_repr == "x86_nchw16c") {
+      // The blocked place comes first to make its kernels preferred, the
+      // other ops fall back to the plain x86 kernels.
+      valid_places_.emplace_back(
+          Place{TARGET(kX86),
+                PRECISION(kFloat),
+                target_repr == "x86_nchw8c" ? DATALAYOUT(kNCHW8c)
+                                            : DATALAYOUT(kNCHW16c)});
+      valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kFloat)});
+      valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kInt64)});
+      valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kAny)});
     } else if (target_repr == "x86_opencl") {
       valid_places_.emplace_back(
           Place{TARGET(kOpenCL), PRECISION(kFP16), DATALAYOUT(kImageDefault)});
@@ -248,11 +533,19 @@ void OptBase::RecordModelInfo(bool record_strip_info) {
 void OptBase::Run() {
   CheckIfModelSupported(false);
   OpKernelInfoCollector::Global().SetKernel2path(kernel2path_map);
-  opt_config_.set_valid_places(valid_places_);
   if (model_set_dir_ != "") {
+    opt_config_.set_valid_places(valid_places_);
     RunOptimizeFromModelSet(record_strip_info_);
   } else {
+    ActivationScalesGuard guard(Calibrate());
+    opt_config_.set_valid_places(valid_places_);
+    // The activation scales of the calibration aren't in the cache key.
+    if (!calibration_data_dir_.empty()) {
+      opt_config_.set_optimized_model_cache_dir("");
+    }
     auto opt_predictor = lite_api::CreatePaddlePredictor(opt_config_);
+    optimized_model_cache_hit_ = opt_predictor->IsOptimizedModelCacheHit();
+    Autotune(opt_predictor.get());
     opt_predictor->SaveOptimizedModel(
         lite_out_name_, model_type_, record_strip_info_);
   }
@@ -272,11 +565,19 @@ void OptBase::RunOptimize(const std::string& model_dir_path,
   SetOptimizeOut(optimized_out_path);
   CheckIfModelSupported(false);
   OpKernelInfoCollector::Global().SetKernel2path(kernel2path_map);
-  opt_config_.set_valid_places(valid_places_);
   if (model_set_dir_ != "") {
+    opt_config_.set_valid_places(valid_places_);
     RunOptimizeFromModelSet(record_strip_info_);
   } else {
+    ActivationScalesGuard guard(Calibrate());
+    opt_config_.set_valid_places(valid_places_);
+    // The activation scales of the calibration aren't in the cache key.
+    if (!calibration_data_dir_.empty()) {
+      opt_config_.set_optimized_model_cache_dir("");
+    }
     auto opt_predictor = lite_api::CreatePaddlePredictor(opt_config_);
+    optimized_model_cache_hit_ = opt_predictor->IsOptimizedModelCacheHit();
+    Autotune(opt_predictor.get());
     opt_predictor->SaveOptimizedModel(
         lite_out_name_, model_type_, record_strip_info_);
   }
@@ -422,9 +723,19 @@ void OptBase::PrintExecutableBinHelpInfo() {
       "  Arguments of mode quantization in opt:\n"
       "        `--quant_model=(true|false)`\n"
       "        `--quant_type=(QUANT_INT8|QUANT_INT16)`\n"
+      "        `--quant_ops=<op_types>`\n"
+      "  Arguments of post-training int8 quantization in opt:\n"
+      "        `--calibration_data=<calibration_samples_dir>`\n"
+      "        `--calibration_input_shape=<input_shapes>`\n"
+      "        `--calibration_algo=(abs_max|kl|percentile)`\n"
       "  Arguements of sparse convolution in opt: \n"
       "        `--sparse_model=(true|false)`\n"
       "        `--sparse_threshold=(float)`\n"
+      "  Arguments of weights compression in opt: \n"
+      "        `--compress_weights=(true|false)`\n"
+      "  Arguments of picking the kernels by the latencies in opt: \n"
+      "        `--kernel_latency_table=<latency_lookup_table_paths>`\n"
+      "        `--kernel_pick_plan=<output_plan_path>`\n"
       "  Arguments of enable_fp16 in opt: \n"
       "        `--enable_fp16=(true|false)`\n"
       "  Arguments of model checking and ops information:\n"
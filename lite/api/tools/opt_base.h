@@ -54,8 +54,36 @@ class LITE_API OptBase {
   void RecordModelInfo(bool record_strip_info = true);
   void SetQuantModel(bool quant_model);
   void SetQuantType(const std::string &quant_type);
+  // Only quantize the ops of these types splitted by ",", e.g. "fc,matmul".
+  void SetQuantOps(const std::string &quant_ops);
   void SetSparseModel(bool sparse_model);
   void SetSparseThreshold(const float sparse_threshold = 0.6f);
+  void SetCompressWeights(bool compress_weights);
+  // Run the model once on the inputs of 'input_shapes', e.g. "1,3,224,224",
+  // to time the algorithms of the kernels on this machine, the picked ones
+  // are saved into the optimized model. Only for the tools built with the
+  // kernels of the target, and running on it.
+  void SetAutotune(const std::string &input_shapes);
+  // Quantize the model to int8 by the static post-training quantization for
+  // x86 and arm. The fp32 model is run on the calibration set in 'data_dir',
+  // each file of which is a sample of the raw float32 data of the inputs of
+  // 'input_shapes', e.g. "1,3,224,224", concatenated in the order of the
+  // inputs. 'algo' is abs_max, kl or percentile, see lite/core/calibration.h.
+  // The quantization error of each layer is reported. Only for the tools
+  // built with the kernels of the target, and running on it.
+  void SetCalibration(const std::string &data_dir,
+                      const std::string &input_shapes,
+                      const std::string &algo = "kl");
+  // Pick the kernels by the latency lookup tables, separated by ',', and
+  // dump the picked ones into 'plan_path' if it's set.
+  void SetKernelLatencyTable(const std::string &latency_table,
+                             const std::string &plan_path = "");
+  // Cache the optimized models in 'cache_dir', the later runs on the same
+  // model and options load the cached one without optimizing. It's off with
+  // the calibration.
+  void SetOptimizedModelCacheDir(const std::string &cache_dir);
+  // Whether the last Run loaded the model from the cache.
+  bool IsOptimizedModelCacheHit() const { return optimized_model_cache_hit_; }
   // set optimized_model type
   void SetModelType(std::string model_type = "naive_buffer");
   // internal inference for developer, not recommanded.
@@ -123,7 +151,17 @@ class LITE_API OptBase {
   bool record_strip_info_{false};
   std::map<std::string, std::set<std::string>> target_supported_ops_{};
   std::map<std::string, std::set<std::string>> all_supported_ops_{};
+  // The shapes of the inputs to autotune the kernels, empty if it's off.
+  std::string autotune_input_shapes_;
+  // The calibration set of the post-training quantization, empty if it's off.
+  std::string calibration_data_dir_;
+  std::string calibration_input_shapes_;
+  std::string calibration_algo_;
+  bool optimized_model_cache_hit_{false};
   void RunOptimizeFromModelSet(bool record_strip_info = false);
+  void Autotune(PaddlePredictor *predictor);
+  // The scales of the activations by the calibration, empty if it's off.
+  std::map<std::string, float> Calibrate();
   void InitSupportedOpInfo();
 };
 
@@ -0,0 +1,672 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runtime/builtin_kernels.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <limits>
+#include "operation/batch_normalization.h"
+#include "operation/conv2d.h"
+#include "operation/fully_connected.h"
+#include "operation/pool2d.h"
+#include "operation/softmax.h"
+#include "operation/unary_activations.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+#include "utility/modeling.h"
+#include "utility/utility.h"
+
+namespace nnadapter {
+namespace builtin_device {
+
+ThreadPool::ThreadPool(int num_threads) {
+  for (int i = 1; i < num_threads; i++) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Run(size_t task_count,
+                     const std::function<void(size_t)>& func) {
+  if (task_count == 0) return;
+  if (workers_.empty() || task_count == 1) {
+    for (size_t i = 0; i < task_count; i++) {
+      func(i);
+    }
+    return;
+  }
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    func_ = &func;
+    task_count_ = task_count;
+    next_task_ = 0;
+    pending_workers_ = workers_.size();
+    generation_++;
+  }
+  cv_.notify_all();
+  RunTasks();
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [&] { return pending_workers_ == 0; });
+  func_ = nullptr;
+}
+
+void ThreadPool::RunTasks() {
+  size_t i;
+  while ((i = next_task_.fetch_add(1)) < task_count_) {
+    (*func_)(i);
+  }
+}
+
+void ThreadPool::WorkerLoop() {
+  uint64_t generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] { return stop_ || generation_ != generation; });
+      if (stop_) return;
+      generation = generation_;
+    }
+    RunTasks();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--pending_workers_ == 0) {
+      done_cv_.notify_one();
+    }
+  }
+}
+
+namespace {
+
+// The tiles of GEMM, a tile of 4 rows and 256 columns of the output fits in L1
+// cache
+const int kGemmBlockM = 16;
+const int kGemmBlockN = 256;
+// The number of elements processed by a task of the elementwise kernels
+const int64_t kElementwiseBlockSize = 16 * 1024;
+
+void ParallelRun(ThreadPool* thread_pool,
+                 size_t task_count,
+                 const std::function<void(size_t)>& func) {
+  if (thread_pool) {
+    thread_pool->Run(task_count, func);
+  } else {
+    for (size_t i = 0; i < task_count; i++) {
+      func(i);
+    }
+  }
+}
+
+void ApplyFuseCode(int32_t fuse_code, float* __restrict data, int64_t size) {
+  if (fuse_code == NNADAPTER_FUSED_RELU) {
+    for (int64_t i = 0; i < size; i++) {
+      data[i] = data[i] > 0.f ? data[i] : 0.f;
+    }
+  } else if (fuse_code == NNADAPTER_FUSED_RELU1) {
+    for (int64_t i = 0; i < size; i++) {
+      data[i] = std::min(std::max(data[i], 0.f), 1.f);
+    }
+  } else if (fuse_code == NNADAPTER_FUSED_RELU6) {
+    for (int64_t i = 0; i < size; i++) {
+      data[i] = std::min(std::max(data[i], 0.f), 6.f);
+    }
+  }
+}
+
+bool IsSupportedFuseCode(int32_t fuse_code) {
+  return fuse_code == NNADAPTER_FUSED_NONE ||
+         fuse_code == NNADAPTER_FUSED_RELU ||
+         fuse_code == NNADAPTER_FUSED_RELU1 ||
+         fuse_code == NNADAPTER_FUSED_RELU6;
+}
+
+// C(MxN) = A(MxK) * B(KxN) + bias(M), all of the matrices are row-major. Four
+// rows of C are computed at a time to reuse the loaded rows of B.
+void GemmTile(int m_begin,
+              int m_end,
+              int n_begin,
+              int n_end,
+              int N,
+              int K,
+              const float* A,
+              const float* B,
+              const float* bias,
+              int32_t fuse_code,
+              float* C) {
+  int n_size = n_end - n_begin;
+  int m = m_begin;
+  for (; m + 4 <= m_end; m += 4) {
+    float* __restrict c0 = C + m * N + n_begin;
+    float* __restrict c1 = c0 + N;
+    float* __restrict c2 = c1 + N;
+    float* __restrict c3 = c2 + N;
+    const float* a0 = A + m * K;
+    const float* a1 = a0 + K;
+    const float* a2 = a1 + K;
+    const float* a3 = a2 + K;
+    for (int n = 0; n < n_size; n++) {
+      c0[n] = bias ? bias[m] : 0.f;
+      c1[n] = bias ? bias[m + 1] : 0.f;
+      c2[n] = bias ? bias[m + 2] : 0.f;
+      c3[n] = bias ? bias[m + 3] : 0.f;
+    }
+    for (int k = 0; k < K; k++) {
+      const float* __restrict b = B + k * N + n_begin;
+      float v0 = a0[k], v1 = a1[k], v2 = a2[k], v3 = a3[k];
+      for (int n = 0; n < n_size; n++) {
+        c0[n] += v0 * b[n];
+        c1[n] += v1 * b[n];
+        c2[n] += v2 * b[n];
+        c3[n] += v3 * b[n];
+      }
+    }
+    ApplyFuseCode(fuse_code, c0, n_size);
+    ApplyFuseCode(fuse_code, c1, n_size);
+    ApplyFuseCode(fuse_code, c2, n_size);
+    ApplyFuseCode(fuse_code, c3, n_size);
+  }
+  for (; m < m_end; m++) {
+    float* __restrict c = C + m * N + n_begin;
+    const float* a = A + m * K;
+    for (int n = 0; n < n_size; n++) {
+      c[n] = bias ? bias[m] : 0.f;
+    }
+    for (int k = 0; k < K; k++) {
+      const float* __restrict b = B + k * N + n_begin;
+      float v = a[k];
+      for (int n = 0; n < n_size; n++) {
+        c[n] += v * b[n];
+      }
+    }
+    ApplyFuseCode(fuse_code, c, n_size);
+  }
+}
+
+void Gemm(int M,
+          int N,
+          int K,
+          const float* A,
+          const float* B,
+          const float* bias,
+          int32_t fuse_code,
+          float* C,
+          ThreadPool* thread_pool) {
+  int m_blocks = (M + kGemmBlockM - 1) / kGemmBlockM;
+  int n_blocks = (N + kGemmBlockN - 1) / kGemmBlockN;
+  ParallelRun(thread_pool, m_blocks * n_blocks, [&](size_t i) {
+    int m_begin = (i / n_blocks) * kGemmBlockM;
+    int n_begin = (i % n_blocks) * kGemmBlockN;
+    GemmTile(m_begin,
+             std::min(m_begin + kGemmBlockM, M),
+             n_begin,
+             std::min(n_begin + kGemmBlockN, N),
+             N,
+             K,
+             A,
+             B,
+             bias,
+             fuse_code,
+             C);
+  });
+}
+
+// The range [begin, end) of the output index 'o' which makes the input index
+// o * stride + offset within [0, size)
+void GetValidRange(
+    int offset, int stride, int size, int output_size, int* begin, int* end) {
+  *begin = offset >= 0 ? 0 : (-offset + stride - 1) / stride;
+  *end = size - offset <= 0 ? 0 : (size - offset + stride - 1) / stride;
+  *begin = std::min(*begin, output_size);
+  *end = std::max(std::min(*end, output_size), *begin);
+}
+
+int ExecuteConv2D(core::Operation* operation, ThreadPool* thread_pool) {
+  CONV_2D_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  auto& input_type = input_operand->type;
+  auto& filter_type = filter_operand->type;
+  auto& output_type = output_operand->type;
+  if (input_type.precision != NNADAPTER_FLOAT32 ||
+      filter_type.precision != NNADAPTER_FLOAT32 ||
+      input_type.layout != NNADAPTER_NCHW ||
+      filter_type.layout != NNADAPTER_NCHW ||
+      input_type.dimensions.count != 4 || !IsSupportedFuseCode(fuse_code)) {
+    return NNADAPTER_FEATURE_NOT_SUPPORTED;
+  }
+  auto input_data = reinterpret_cast<const float*>(input_operand->buffer);
+  auto filter_data = reinterpret_cast<const float*>(filter_operand->buffer);
+  auto bias_data = reinterpret_cast<const float*>(bias_operand->buffer);
+  NNADAPTER_CHECK(input_data);
+  NNADAPTER_CHECK(filter_data);
+  auto output_data = reinterpret_cast<float*>(AllocateOperand(output_operand));
+  int batch_size = input_type.dimensions.data[0];
+  int input_height = input_type.dimensions.data[2];
+  int input_width = input_type.dimensions.data[3];
+  int output_height = output_type.dimensions.data[2];
+  int output_width = output_type.dimensions.data[3];
+  int input_size = input_height * input_width;
+  int output_size = output_height * output_width;
+  if (is_depthwise_mode && output_channel_size == group) {
+    // Compute each channel directly, the interior of the rows is processed
+    // without the boundary checks.
+    ParallelRun(thread_pool, batch_size * group, [&](size_t i) {
+      int c = i % group;
+      const float* input = input_data + i * input_size;
+      const float* filter = filter_data + c * filter_height * filter_width;
+      float* __restrict output = output_data + i * output_size;
+      std::fill(output, output + output_size, bias_data ? bias_data[c] : 0.f);
+      for (int kh = 0; kh < filter_height; kh++) {
+        for (int kw = 0; kw < filter_width; kw++) {
+          float weight = filter[kh * filter_width + kw];
+          int w_offset = kw * dilation_width - pad_width_left;
+          int ow_begin, ow_end;
+          GetValidRange(w_offset,
+                        stride_width,
+                        input_width,
+                        output_width,
+                        &ow_begin,
+                        &ow_end);
+          for (int oh = 0; oh < output_height; oh++) {
+            int ih = oh * stride_height - pad_height_top + kh * dilation_height;
+            if (ih < 0 || ih >= input_height) continue;
+            const float* __restrict src = input + ih * input_width;
+            float* __restrict dst = output + oh * output_width;
+            if (stride_width == 1) {
+              for (int ow = ow_begin; ow < ow_end; ow++) {
+                dst[ow] += weight * src[ow + w_offset];
+              }
+            } else {
+              for (int ow = ow_begin; ow < ow_end; ow++) {
+                dst[ow] += weight * src[ow * stride_width + w_offset];
+              }
+            }
+          }
+        }
+      }
+      ApplyFuseCode(fuse_code, output, output_size);
+    });
+    return NNADAPTER_NO_ERROR;
+  }
+  // Lower to GEMM with im2col, the 1x1 convolution with stride 1 and without
+  // padding uses the input directly.
+  int input_channel_group = input_channel_size / group;
+  int output_channel_group = output_channel_size / group;
+  int K = input_channel_group * filter_height * filter_width;
+  bool use_im2col = !(filter_height == 1 && filter_width == 1 &&
+                      stride_height == 1 && stride_width == 1 &&
+                      pad_height_top == 0 && pad_height_bottom == 0 &&
+                      pad_width_left == 0 && pad_width_right == 0);
+  std::vector<float> col_data(use_im2col ? K * output_size : 0);
+  for (int bs = 0; bs < batch_size; bs++) {
+    for (int g = 0; g < group; g++) {
+      const float* input =
+          input_data +
+          (bs * input_channel_size + g * input_channel_group) * input_size;
+      const float* B = input;
+      if (use_im2col) {
+        ParallelRun(thread_pool, K, [&](size_t k) {
+          int kw = k % filter_width;
+          int kh = (k / filter_width) % filter_height;
+          int ic = k / (filter_width * filter_height);
+          const float* src = input + ic * input_size;
+          float* __restrict dst = col_data.data() + k * output_size;
+          int w_offset = kw * dilation_width - pad_width_left;
+          int ow_begin, ow_end;
+          GetValidRange(w_offset,
+                        stride_width,
+                        input_width,
+                        output_width,
+                        &ow_begin,
+                        &ow_end);
+          for (int oh = 0; oh < output_height; oh++) {
+            float* __restrict row = dst + oh * output_width;
+            int ih = oh * stride_height - pad_height_top + kh * dilation_height;
+            if (ih < 0 || ih >= input_height) {
+              memset(row, 0, output_width * sizeof(float));
+              continue;
+            }
+            const float* __restrict src_row = src + ih * input_width;
+            for (int ow = 0; ow < ow_begin; ow++) row[ow] = 0.f;
+            for (int ow = ow_begin; ow < ow_end; ow++) {
+              row[ow] = src_row[ow * stride_width + w_offset];
+            }
+            for (int ow = ow_end; ow < output_width; ow++) row[ow] = 0.f;
+          }
+        });
+        B = col_data.data();
+      }
+      Gemm(output_channel_group,
+           output_size,
+           K,
+           filter_data + g * output_channel_group * K,
+           B,
+           bias_data ? bias_data + g * output_channel_group : nullptr,
+           fuse_code,
+           output_data + (bs * output_channel_size +
+                          g * output_channel_group) *
+                             output_size,
+           thread_pool);
+    }
+  }
+  return NNADAPTER_NO_ERROR;
+}
+
+int ExecuteFullyConnected(core::Operation* operation,
+                          ThreadPool* thread_pool) {
+  FULLY_CONNECTED_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  auto& input_type = input_operand->type;
+  if (input_type.precision != NNADAPTER_FLOAT32 ||
+      weight_operand->type.precision != NNADAPTER_FLOAT32 ||
+      !IsSupportedFuseCode(fuse_code)) {
+    return NNADAPTER_FEATURE_NOT_SUPPORTED;
+  }
+  auto input_data = reinterpret_cast<const float*>(input_operand->buffer);
+  auto weight_data = reinterpret_cast<const float*>(weight_operand->buffer);
+  auto bias_data = reinterpret_cast<const float*>(bias_operand->buffer);
+  NNADAPTER_CHECK(input_data);
+  NNADAPTER_CHECK(weight_data);
+  auto output_data = reinterpret_cast<float*>(AllocateOperand(output_operand));
+  auto batch_size = ProductionOfDimensions(input_type.dimensions.data,
+                                           input_type.dimensions.count) /
+                    input_size;
+  // Each task computes a block of the units for all of the batches, so that
+  // the rows of the weight are loaded once.
+  const int kBlockSize = 16;
+  int block_count = (num_units + kBlockSize - 1) / kBlockSize;
+  ParallelRun(thread_pool, block_count, [&](size_t i) {
+    int n_begin = i * kBlockSize;
+    int n_end = std::min(n_begin + kBlockSize, static_cast<int>(num_units));
+    for (int n = n_begin; n < n_end; n++) {
+      const float* __restrict weight = weight_data + n * input_size;
+      for (int64_t m = 0; m < batch_size; m++) {
+        const float* __restrict input = input_data + m * input_size;
+        float sums[8] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+        int k = 0;
+        for (; k + 8 <= input_size; k += 8) {
+          for (int j = 0; j < 8; j++) {
+            sums[j] += input[k + j] * weight[k + j];
+          }
+        }
+        float sum = bias_data ? bias_data[n] : 0.f;
+        for (int j = 0; j < 8; j++) {
+          sum += sums[j];
+        }
+        for (; k < input_size; k++) {
+          sum += input[k] * weight[k];
+        }
+        output_data[m * num_units + n] = sum;
+      }
+    }
+  });
+  ApplyFuseCode(fuse_code, output_data, batch_size * num_units);
+  return NNADAPTER_NO_ERROR;
+}
+
+int ExecutePool2D(core::Operation* operation, ThreadPool* thread_pool) {
+  POOL_2D_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  auto& input_type = input_operand->type;
+  auto& output_type = output_operand->type;
+  if (input_type.precision != NNADAPTER_FLOAT32 ||
+      input_type.layout != NNADAPTER_NCHW ||
+      input_type.dimensions.count != 4 || !IsSupportedFuseCode(fuse_code)) {
+    return NNADAPTER_FEATURE_NOT_SUPPORTED;
+  }
+  auto input_data = reinterpret_cast<const float*>(input_operand->buffer);
+  NNADAPTER_CHECK(input_data);
+  auto output_data = reinterpret_cast<float*>(AllocateOperand(output_operand));
+  bool is_max_pool = operation_type == NNADAPTER_MAX_POOL_2D;
+  bool count_include_pad = !is_max_pool && flag;
+  int plane_count =
+      input_type.dimensions.data[0] * input_type.dimensions.data[1];
+  int input_height = input_type.dimensions.data[2];
+  int input_width = input_type.dimensions.data[3];
+  int output_height = output_type.dimensions.data[2];
+  int output_width = output_type.dimensions.data[3];
+  int input_size = input_height * input_width;
+  int output_size = output_height * output_width;
+  if (global_pooling && output_size == 1 && pad_height_top == 0 &&
+      pad_height_bottom == 0 && pad_width_left == 0 && pad_width_right == 0) {
+    ParallelRun(thread_pool, plane_count, [&](size_t i) {
+      const float* __restrict input = input_data + i * input_size;
+      float value = input[0];
+      if (is_max_pool) {
+        for (int j = 1; j < input_size; j++) {
+          value = value >= input[j] ? value : input[j];
+        }
+      } else {
+        for (int j = 1; j < input_size; j++) {
+          value += input[j];
+        }
+        value /= input_size;
+      }
+      output_data[i] = value;
+    });
+    ApplyFuseCode(fuse_code, output_data, plane_count);
+    return NNADAPTER_NO_ERROR;
+  }
+  ParallelRun(thread_pool, plane_count, [&](size_t i) {
+    const float* input = input_data + i * input_size;
+    float* output = output_data + i * output_size;
+    for (int oh = 0; oh < output_height; oh++) {
+      int sh = oh * stride_height - pad_height_top;
+      int eh = std::min(sh + kernel_height, input_height);
+      sh = std::max(sh, 0);
+      for (int ow = 0; ow < output_width; ow++) {
+        int sw = ow * stride_width - pad_width_left;
+        int ew = std::min(sw + kernel_width, input_width);
+        sw = std::max(sw, 0);
+        // The window lying entirely in the padding pools nothing, the padding
+        // value 0 is written, i.e. the average of zeros, and -inf of max pool
+        // is clamped to 0.
+        if (ew <= sw || eh <= sh) {
+          output[oh * output_width + ow] = 0.f;
+          continue;
+        }
+        int pooling_size = (ew - sw) * (eh - sh);
+        float value = is_max_pool ? input[sh * input_width + sw] : 0.f;
+        for (int h = sh; h < eh; h++) {
+          const float* row = input + h * input_width;
+          if (is_max_pool) {
+            for (int w = sw; w < ew; w++) {
+              value = value >= row[w] ? value : row[w];
+            }
+          } else {
+            for (int w = sw; w < ew; w++) {
+              value += row[w];
+            }
+          }
+        }
+        if (!is_max_pool) {
+          value /= count_include_pad ? kernel_height * kernel_width
+                                     : pooling_size;
+        }
+        output[oh * output_width + ow] = value;
+      }
+    }
+    ApplyFuseCode(fuse_code, output, output_size);
+  });
+  return NNADAPTER_NO_ERROR;
+}
+
+int ExecuteSoftmax(core::Operation* operation, ThreadPool* thread_pool) {
+  SOFTMAX_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  auto& input_type = input_operand->type;
+  if (input_type.precision != NNADAPTER_FLOAT32) {
+    return NNADAPTER_FEATURE_NOT_SUPPORTED;
+  }
+  auto input_data = reinterpret_cast<const float*>(input_operand->buffer);
+  NNADAPTER_CHECK(input_data);
+  auto output_data = reinterpret_cast<float*>(AllocateOperand(output_operand));
+  auto input_rank = static_cast<int>(input_type.dimensions.count);
+  if (axis < 0) {
+    axis += input_rank;
+  }
+  auto dims = input_type.dimensions.data;
+  int64_t outer_count = ProductionOfDimensions(dims, axis);
+  int64_t axis_count = dims[axis];
+  int64_t inner_count =
+      ProductionOfDimensions(dims + axis + 1, input_rank - axis - 1);
+  ParallelRun(thread_pool, outer_count, [&](size_t i) {
+    const float* input = input_data + i * axis_count * inner_count;
+    float* output = output_data + i * axis_count * inner_count;
+    if (inner_count == 1) {
+      float max_value = input[0];
+      for (int64_t j = 1; j < axis_count; j++) {
+        max_value = std::max(max_value, input[j]);
+      }
+      float sum_value = 0.f;
+      for (int64_t j = 0; j < axis_count; j++) {
+        output[j] = expf(input[j] - max_value);
+        sum_value += output[j];
+      }
+      float scale = 1.f / sum_value;
+      for (int64_t j = 0; j < axis_count; j++) {
+        output[j] *= scale;
+      }
+      return;
+    }
+    // Reduce along the axis with the contiguous inner elements
+    std::vector<float> max_values(input, input + inner_count);
+    std::vector<float> sum_values(inner_count, 0.f);
+    float* __restrict max_data = max_values.data();
+    float* __restrict sum_data = sum_values.data();
+    for (int64_t j = 1; j < axis_count; j++) {
+      const float* __restrict row = input + j * inner_count;
+      for (int64_t k = 0; k < inner_count; k++) {
+        max_data[k] = std::max(max_data[k], row[k]);
+      }
+    }
+    for (int64_t j = 0; j < axis_count; j++) {
+      const float* __restrict src = input + j * inner_count;
+      float* __restrict dst = output + j * inner_count;
+      for (int64_t k = 0; k < inner_count; k++) {
+        dst[k] = expf(src[k] - max_data[k]);
+        sum_data[k] += dst[k];
+      }
+    }
+    for (int64_t k = 0; k < inner_count; k++) {
+      sum_data[k] = 1.f / sum_data[k];
+    }
+    for (int64_t j = 0; j < axis_count; j++) {
+      float* __restrict dst = output + j * inner_count;
+      for (int64_t k = 0; k < inner_count; k++) {
+        dst[k] *= sum_data[k];
+      }
+    }
+  });
+  return NNADAPTER_NO_ERROR;
+}
+
+int ExecuteBatchNormalization(core::Operation* operation,
+                              ThreadPool* thread_pool) {
+  BATCH_NORMALIZATION_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  auto& input_type = input_operand->type;
+  if (input_type.precision != NNADAPTER_FLOAT32 ||
+      input_type.dimensions.count < 2) {
+    return NNADAPTER_FEATURE_NOT_SUPPORTED;
+  }
+  auto input_data = reinterpret_cast<const float*>(input_operand->buffer);
+  NNADAPTER_CHECK(input_data);
+  auto output_data = reinterpret_cast<float*>(AllocateOperand(output_operand));
+  auto dims = input_type.dimensions.data;
+  int channel_size = dims[1];
+  int64_t plane_count = static_cast<int64_t>(dims[0]) * channel_size;
+  int64_t inner_size =
+      ProductionOfDimensions(dims + 2, input_type.dimensions.count - 2);
+  // y = alpha * x + beta
+  std::vector<float> alphas(channel_size), betas(channel_size);
+  for (int c = 0; c < channel_size; c++) {
+    alphas[c] = scale_data[c] / sqrtf(variance_data[c] + epsilon);
+    betas[c] = bias_data[c] - mean_data[c] * alphas[c];
+  }
+  ParallelRun(thread_pool, plane_count, [&](size_t i) {
+    int c = i % channel_size;
+    float alpha = alphas[c], beta = betas[c];
+    const float* __restrict input = input_data + i * inner_size;
+    float* __restrict output = output_data + i * inner_size;
+    for (int64_t j = 0; j < inner_size; j++) {
+      output[j] = alpha * input[j] + beta;
+    }
+  });
+  return NNADAPTER_NO_ERROR;
+}
+
+int ExecuteUnaryActivations(core::Operation* operation,
+                            ThreadPool* thread_pool) {
+  auto operation_type = operation->type;
+  if (operation_type != NNADAPTER_RELU && operation_type != NNADAPTER_RELU6) {
+    return NNADAPTER_FEATURE_NOT_SUPPORTED;
+  }
+  UNARY_ACTIVATIONS_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  auto& input_type = input_operand->type;
+  if (input_type.precision != NNADAPTER_FLOAT32) {
+    return NNADAPTER_FEATURE_NOT_SUPPORTED;
+  }
+  auto input_data = reinterpret_cast<const float*>(input_operand->buffer);
+  NNADAPTER_CHECK(input_data);
+  auto output_data = reinterpret_cast<float*>(AllocateOperand(output_operand));
+  auto size = ProductionOfDimensions(input_type.dimensions.data,
+                                     input_type.dimensions.count);
+  float max_value = operation_type == NNADAPTER_RELU6
+                        ? 6.f
+                        : std::numeric_limits<float>::infinity();
+  int64_t block_count =
+      (size + kElementwiseBlockSize - 1) / kElementwiseBlockSize;
+  ParallelRun(thread_pool, block_count, [&](size_t i) {
+    int64_t begin = i * kElementwiseBlockSize;
+    int64_t end = std::min(begin + kElementwiseBlockSize, size);
+    const float* __restrict input = input_data;
+    float* __restrict output = output_data;
+    for (int64_t j = begin; j < end; j++) {
+      output[j] = std::min(std::max(input[j], 0.f), max_value);
+    }
+  });
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace
+
+int ExecuteBuiltinKernel(core::Operation* operation, ThreadPool* thread_pool) {
+  switch (operation->type) {
+    case NNADAPTER_CONV_2D:
+      return ExecuteConv2D(operation, thread_pool);
+    case NNADAPTER_FULLY_CONNECTED:
+      return ExecuteFullyConnected(operation, thread_pool);
+    case NNADAPTER_AVERAGE_POOL_2D:
+    case NNADAPTER_MAX_POOL_2D:
+      return ExecutePool2D(operation, thread_pool);
+    case NNADAPTER_SOFTMAX:
+      return ExecuteSoftmax(operation, thread_pool);
+    case NNADAPTER_BATCH_NORMALIZATION:
+      return ExecuteBatchNormalization(operation, thread_pool);
+    case NNADAPTER_RELU:
+    case NNADAPTER_RELU6:
+      return ExecuteUnaryActivations(operation, thread_pool);
+    default:
+      break;
+  }
+  return NNADAPTER_FEATURE_NOT_SUPPORTED;
+}
+
+}  // namespace builtin_device
+}  // namespace nnadapter
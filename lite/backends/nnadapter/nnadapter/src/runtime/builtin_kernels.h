@@ -0,0 +1,62 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+#include "core/types.h"
+
+namespace nnadapter {
+namespace builtin_device {
+
+// A fixed-size thread pool, the calling thread also runs the tasks.
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_threads);
+  ~ThreadPool();
+
+  int num_threads() const { return static_cast<int>(workers_.size()) + 1; }
+  // Run func(0) ~ func(task_count - 1) and wait for all of them to finish.
+  void Run(size_t task_count, const std::function<void(size_t)>& func);
+
+ private:
+  void RunTasks();
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable done_cv_;
+  const std::function<void(size_t)>* func_{nullptr};
+  size_t task_count_{0};
+  std::atomic<size_t> next_task_{0};
+  size_t pending_workers_{0};
+  uint64_t generation_{0};
+  bool stop_{false};
+};
+
+// Execute the operation with the vectorized and multi-threaded float32 kernels
+// of the builtin device, the output operands must be prepared. Return
+// NNADAPTER_FEATURE_NOT_SUPPORTED if no kernel is matched, then the reference
+// implementation should be used. 'thread_pool' may be nullptr.
+int ExecuteBuiltinKernel(core::Operation* operation, ThreadPool* thread_pool);
+
+}  // namespace builtin_device
+}  // namespace nnadapter
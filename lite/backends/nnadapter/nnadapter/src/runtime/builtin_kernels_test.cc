@@ -0,0 +1,505 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runtime/builtin_kernels.h"
+#include <gtest/gtest.h>
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>  // NOLINT
+#include <vector>
+#include "utility/modeling.h"
+#include "utility/utility.h"
+
+#define REGISTER_OPERATION(__op_type__,            \
+                           __validate_func_name__, \
+                           __prepare_func_name__,  \
+                           __execute_func_name__,  \
+                           ...)                    \
+  extern int __prepare_func_name__(nnadapter::core::Operation* operation);
+namespace nnadapter {
+namespace operation {
+#include "operation/all.h"  // NOLINT
+#undef __NNADAPTER_OPERATION_ALL_H__
+}  // namespace operation
+}  // namespace nnadapter
+#undef REGISTER_OPERATION
+
+namespace nnadapter {
+namespace builtin_device {
+
+std::vector<float> RandomData(int64_t size, float min, float max) {
+  static std::mt19937 engine(0);
+  std::uniform_real_distribution<float> dist(min, max);
+  std::vector<float> data(size);
+  for (auto& value : data) {
+    value = dist(engine);
+  }
+  return data;
+}
+
+float Fuse(int32_t fuse_code, float value) {
+  if (fuse_code == NNADAPTER_FUSED_RELU) return std::max(value, 0.f);
+  if (fuse_code == NNADAPTER_FUSED_RELU1) {
+    return std::min(std::max(value, 0.f), 1.f);
+  }
+  if (fuse_code == NNADAPTER_FUSED_RELU6) {
+    return std::min(std::max(value, 0.f), 6.f);
+  }
+  return value;
+}
+
+// Prepare the operation of the inputs, execute it with and without the thread
+// pool, and compare the output with the reference result.
+class KernelTester {
+ public:
+  core::Operand* AddInput(const std::vector<int32_t>& dimensions,
+                          float min = -1.f,
+                          float max = 1.f) {
+    inputs_.push_back(RandomData(ProductionOfDimensions(dimensions), min, max));
+    return AddFloat32ConstantOperand(
+        &model_, inputs_.back().data(), dimensions);
+  }
+  const float* input(size_t index) { return inputs_[index].data(); }
+  core::Model* model() { return &model_; }
+
+  void Run(NNAdapterOperationType type,
+           const std::vector<core::Operand*>& input_operands,
+           size_t output_count,
+           const std::vector<int32_t>& expected_dimensions,
+           const std::vector<float>& expected_output,
+           float abs_error = 1e-5f) {
+    for (int num_threads : {1, 3}) {
+      std::unique_ptr<ThreadPool> thread_pool(
+          num_threads > 1 ? new ThreadPool(num_threads) : nullptr);
+      auto operation = AddOperation(&model_);
+      operation->type = type;
+      operation->input_operands = input_operands;
+      for (size_t i = 0; i < output_count; i++) {
+        operation->output_operands.push_back(
+            AddFloat32VariableOperand(&model_, {}));
+      }
+      auto output_operand = operation->output_operands[0];
+      ASSERT_EQ(Prepare(operation), NNADAPTER_NO_ERROR);
+      ASSERT_EQ(ExecuteBuiltinKernel(operation, thread_pool.get()),
+                NNADAPTER_NO_ERROR);
+      auto& dimensions = output_operand->type.dimensions;
+      ASSERT_EQ(std::vector<int32_t>(dimensions.data,
+                                     dimensions.data + dimensions.count),
+                expected_dimensions);
+      ASSERT_EQ(ProductionOfDimensions(expected_dimensions),
+                static_cast<int64_t>(expected_output.size()));
+      auto output_data = reinterpret_cast<float*>(output_operand->buffer);
+      for (size_t i = 0; i < expected_output.size(); i++) {
+        ASSERT_NEAR(output_data[i], expected_output[i], abs_error)
+            << "at " << i << " with " << num_threads << " threads";
+      }
+    }
+  }
+
+ private:
+  int Prepare(core::Operation* operation) {
+    switch (operation->type) {
+#define REGISTER_OPERATION(__op_type__,            \
+                           __validate_func_name__, \
+                           __prepare_func_name__,  \
+                           __execute_func_name__,  \
+                           ...)                    \
+  case NNADAPTER_##__op_type__:                    \
+    return operation::__prepare_func_name__(operation);
+#include "operation/all.h"  // NOLINT
+#undef __NNADAPTER_OPERATION_ALL_H__
+#undef REGISTER_OPERATION
+      default:
+        break;
+    }
+    return NNADAPTER_FEATURE_NOT_SUPPORTED;
+  }
+
+  std::vector<std::vector<float>> inputs_;
+  core::Model model_;
+};
+
+TEST(ThreadPool, run_each_task_once) {
+  for (int num_threads : {0, 1, 2, 4}) {
+    ThreadPool thread_pool(num_threads);
+    EXPECT_EQ(thread_pool.num_threads(), std::max(num_threads, 1));
+    for (size_t task_count : {0, 1, 2, 3, 4, 5, 17, 1000}) {
+      for (int iteration = 0; iteration < 10; iteration++) {
+        std::unique_ptr<std::atomic<int>[]> counts(
+            new std::atomic<int>[task_count]);
+        for (size_t i = 0; i < task_count; i++) {
+          counts[i] = 0;
+        }
+        thread_pool.Run(task_count, [&](size_t i) { counts[i]++; });
+        for (size_t i = 0; i < task_count; i++) {
+          ASSERT_EQ(counts[i], 1) << "task " << i << " of " << task_count;
+        }
+      }
+    }
+  }
+}
+
+TEST(ThreadPool, run_from_threads) {
+  // The runs from the different threads are serialized
+  ThreadPool thread_pool(3);
+  std::vector<std::thread> threads;
+  std::vector<int64_t> sums(4, 0);
+  for (size_t i = 0; i < sums.size(); i++) {
+    threads.emplace_back([&, i] {
+      for (int iteration = 0; iteration < 100; iteration++) {
+        std::atomic<int64_t> sum(0);
+        thread_pool.Run(64, [&](size_t j) { sum += j; });
+        sums[i] += sum;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto sum : sums) {
+    EXPECT_EQ(sum, 100 * 64 * 63 / 2);
+  }
+}
+
+struct Conv2DParam {
+  std::vector<int32_t> input_dimensions;
+  int32_t output_channel_size;
+  int32_t filter_size;
+  std::vector<int32_t> pads;
+  int32_t stride;
+  int32_t dilation;
+  int32_t group;
+  int32_t fuse_code;
+};
+
+TEST(BuiltinKernels, conv2d) {
+  std::vector<Conv2DParam> params = {
+      // The GEMM is split into several tiles of rows and columns
+      {{2, 6, 21, 19}, 20, 3, {1, 1, 1, 1}, 1, 1, 1, NNADAPTER_FUSED_NONE},
+      // The asymmetric padding and stride 2
+      {{1, 5, 13, 11}, 8, 3, {0, 2, 1, 0}, 2, 1, 1, NNADAPTER_FUSED_RELU},
+      // The padding is larger than the filter, so the borders of the output
+      // only see the padding
+      {{1, 3, 6, 7}, 4, 3, {4, 3, 5, 4}, 1, 1, 1, NNADAPTER_FUSED_RELU1},
+      // 1x1 without padding uses the input directly
+      {{2, 16, 9, 9}, 24, 1, {0, 0, 0, 0}, 1, 1, 1, NNADAPTER_FUSED_RELU6},
+      // 1x1 with stride 2
+      {{1, 16, 9, 9}, 8, 1, {0, 0, 0, 0}, 2, 1, 1, NNADAPTER_FUSED_NONE},
+      // Group and dilation
+      {{1, 8, 12, 10}, 6, 3, {2, 2, 2, 2}, 1, 2, 2, NNADAPTER_FUSED_NONE},
+      // Depthwise
+      {{2, 8, 15, 14}, 8, 3, {1, 1, 1, 1}, 1, 1, 8, NNADAPTER_FUSED_RELU6},
+      {{1, 8, 15, 14}, 8, 5, {2, 1, 0, 3}, 2, 1, 8, NNADAPTER_FUSED_NONE},
+      {{1, 4, 11, 9}, 4, 3, {3, 3, 3, 3}, 3, 2, 4, NNADAPTER_FUSED_RELU},
+  };
+  for (auto& param : params) {
+    KernelTester tester;
+    auto m = tester.model();
+    auto& input_dimensions = param.input_dimensions;
+    int batch_size = input_dimensions[0];
+    int input_channel_size = input_dimensions[1];
+    int input_height = input_dimensions[2];
+    int input_width = input_dimensions[3];
+    int output_channel_size = param.output_channel_size;
+    int k = param.filter_size;
+    int group = param.group;
+    int input_channel_group = input_channel_size / group;
+    int output_channel_group = output_channel_size / group;
+    auto input = tester.AddInput(input_dimensions);
+    auto filter =
+        tester.AddInput({output_channel_size, input_channel_group, k, k});
+    auto bias = tester.AddInput({output_channel_size});
+    auto& pads = param.pads;
+    int stride = param.stride;
+    int dilation = param.dilation;
+    int output_height =
+        (input_height + pads[0] + pads[1] - dilation * (k - 1) - 1) / stride +
+        1;
+    int output_width =
+        (input_width + pads[2] + pads[3] - dilation * (k - 1) - 1) / stride +
+        1;
+    std::vector<float> expected_output;
+    for (int n = 0; n < batch_size; n++) {
+      for (int oc = 0; oc < output_channel_size; oc++) {
+        int g = oc / output_channel_group;
+        for (int oh = 0; oh < output_height; oh++) {
+          for (int ow = 0; ow < output_width; ow++) {
+            float sum = tester.input(2)[oc];
+            for (int ic = 0; ic < input_channel_group; ic++) {
+              for (int kh = 0; kh < k; kh++) {
+                for (int kw = 0; kw < k; kw++) {
+                  int ih = oh * stride - pads[0] + kh * dilation;
+                  int iw = ow * stride - pads[2] + kw * dilation;
+                  if (ih < 0 || ih >= input_height || iw < 0 ||
+                      iw >= input_width) {
+                    continue;
+                  }
+                  int c = g * input_channel_group + ic;
+                  sum += tester.input(0)[((n * input_channel_size + c) *
+                                              input_height +
+                                          ih) *
+                                             input_width +
+                                         iw] *
+                         tester.input(1)[((oc * input_channel_group + ic) * k +
+                                          kh) *
+                                             k +
+                                         kw];
+                }
+              }
+            }
+            expected_output.push_back(Fuse(param.fuse_code, sum));
+          }
+        }
+      }
+    }
+    tester.Run(NNADAPTER_CONV_2D,
+               {input,
+                filter,
+                bias,
+                AddInt32ConstantOperand(m, NNADAPTER_AUTO_PAD_NONE),
+                AddInt32ConstantOperand(m, pads),
+                AddInt32ConstantOperand(m,
+                                        std::vector<int32_t>{stride, stride}),
+                AddInt32ConstantOperand(m, group),
+                AddInt32ConstantOperand(
+                    m, std::vector<int32_t>{dilation, dilation}),
+                AddInt32ConstantOperand(m, param.fuse_code)},
+               1,
+               {batch_size, output_channel_size, output_height, output_width},
+               expected_output,
+               1e-4f);
+  }
+}
+
+struct Pool2DParam {
+  bool is_max_pool;
+  std::vector<int32_t> input_dimensions;
+  int32_t kernel_size;
+  std::vector<int32_t> pads;
+  int32_t stride;
+  bool ceil_mode;
+  bool count_include_pad;
+  int32_t fuse_code;
+};
+
+TEST(BuiltinKernels, pool2d) {
+  std::vector<Pool2DParam> params = {
+      {false, {2, 5, 9, 9}, 3, {1, 1, 1, 1}, 2, false, false, 0},
+      {false, {2, 5, 9, 9}, 3, {1, 1, 1, 1}, 2, false, true, 0},
+      {false, {1, 3, 10, 11}, 3, {0, 1, 2, 0}, 2, true, false, 0},
+      {true, {2, 5, 9, 9}, 3, {1, 1, 1, 1}, 2, false, false, 0},
+      {true, {1, 3, 10, 11}, 3, {0, 1, 2, 0}, 2, true, false, 0},
+      {true, {1, 4, 8, 8}, 3, {1, 1, 1, 1}, 1, false, false, 1},
+      // The windows lying entirely in the padding output 0
+      {false, {1, 2, 5, 5}, 3, {3, 3, 3, 3}, 3, false, false, 0},
+      {true, {1, 2, 5, 5}, 3, {3, 3, 3, 3}, 3, false, false, 0},
+      // Global pooling
+      {false, {2, 6, 7, 7}, 7, {0, 0, 0, 0}, 1, false, false, 0},
+      {true, {2, 6, 7, 7}, 7, {0, 0, 0, 0}, 1, false, false, 0},
+  };
+  for (auto& param : params) {
+    KernelTester tester;
+    auto m = tester.model();
+    auto& input_dimensions = param.input_dimensions;
+    int plane_count = input_dimensions[0] * input_dimensions[1];
+    int input_height = input_dimensions[2];
+    int input_width = input_dimensions[3];
+    int k = param.kernel_size;
+    auto& pads = param.pads;
+    int stride = param.stride;
+    int ceil = param.ceil_mode ? stride - 1 : 0;
+    int output_height =
+        (input_height + pads[0] + pads[1] - k + ceil) / stride + 1;
+    int output_width =
+        (input_width + pads[2] + pads[3] - k + ceil) / stride + 1;
+    auto input = tester.AddInput(input_dimensions);
+    std::vector<float> expected_output;
+    for (int i = 0; i < plane_count; i++) {
+      for (int oh = 0; oh < output_height; oh++) {
+        for (int ow = 0; ow < output_width; ow++) {
+          float max_value = -std::numeric_limits<float>::infinity();
+          float sum = 0.f;
+          int count = 0;
+          for (int kh = 0; kh < k; kh++) {
+            for (int kw = 0; kw < k; kw++) {
+              int ih = oh * stride - pads[0] + kh;
+              int iw = ow * stride - pads[2] + kw;
+              if (ih < 0 || ih >= input_height || iw < 0 ||
+                  iw >= input_width) {
+                continue;
+              }
+              float value =
+                  tester.input(0)[(i * input_height + ih) * input_width + iw];
+              max_value = std::max(max_value, value);
+              sum += value;
+              count++;
+            }
+          }
+          float value = 0.f;
+          if (count > 0) {
+            value = param.is_max_pool
+                        ? max_value
+                        : sum / (param.count_include_pad ? k * k : count);
+          }
+          expected_output.push_back(Fuse(param.fuse_code, value));
+        }
+      }
+    }
+    std::vector<core::Operand*> input_operands = {
+        input,
+        AddInt32ConstantOperand(m, NNADAPTER_AUTO_PAD_NONE),
+        AddInt32ConstantOperand(m, pads),
+        AddInt32ConstantOperand(m, std::vector<int32_t>{k, k}),
+        AddInt32ConstantOperand(m, std::vector<int32_t>{stride, stride}),
+        AddBool8ConstantOperand(m, param.ceil_mode),
+        AddBool8ConstantOperand(m, param.count_include_pad)};
+    if (param.is_max_pool) {
+      input_operands.push_back(AddInt32ConstantOperand(m, NNADAPTER_INT32));
+    }
+    input_operands.push_back(AddInt32ConstantOperand(m, param.fuse_code));
+    tester.Run(param.is_max_pool ? NNADAPTER_MAX_POOL_2D
+                                 : NNADAPTER_AVERAGE_POOL_2D,
+               input_operands,
+               param.is_max_pool ? 2 : 1,
+               {input_dimensions[0],
+                input_dimensions[1],
+                output_height,
+                output_width},
+               expected_output);
+  }
+}
+
+TEST(BuiltinKernels, fully_connected) {
+  for (int32_t fuse_code : {NNADAPTER_FUSED_NONE, NNADAPTER_FUSED_RELU}) {
+    // The units are split into the blocks of 16
+    int batch_size = 3, input_size = 37, num_units = 50;
+    KernelTester tester;
+    auto input = tester.AddInput({batch_size, input_size});
+    auto weight = tester.AddInput({num_units, input_size});
+    auto bias = tester.AddInput({num_units});
+    std::vector<float> expected_output;
+    for (int m = 0; m < batch_size; m++) {
+      for (int n = 0; n < num_units; n++) {
+        float sum = tester.input(2)[n];
+        for (int k = 0; k < input_size; k++) {
+          sum += tester.input(0)[m * input_size + k] *
+                 tester.input(1)[n * input_size + k];
+        }
+        expected_output.push_back(Fuse(fuse_code, sum));
+      }
+    }
+    tester.Run(NNADAPTER_FULLY_CONNECTED,
+               {input,
+                weight,
+                bias,
+                AddInt32ConstantOperand(tester.model(), fuse_code)},
+               1,
+               {batch_size, num_units},
+               expected_output);
+  }
+}
+
+TEST(BuiltinKernels, softmax) {
+  std::vector<int32_t> dimensions = {2, 5, 7};
+  for (int32_t axis : {0, 1, -1}) {
+    KernelTester tester;
+    auto input = tester.AddInput(dimensions, -5.f, 5.f);
+    int rank = dimensions.size();
+    int positive_axis = axis < 0 ? axis + rank : axis;
+    int64_t outer_count =
+        ProductionOfDimensions(dimensions.data(), positive_axis);
+    int64_t axis_count = dimensions[positive_axis];
+    int64_t inner_count = ProductionOfDimensions(
+        dimensions.data() + positive_axis + 1, rank - positive_axis - 1);
+    std::vector<float> expected_output(outer_count * axis_count * inner_count);
+    for (int64_t i = 0; i < outer_count; i++) {
+      for (int64_t k = 0; k < inner_count; k++) {
+        auto index = [&](int64_t j) {
+          return (i * axis_count + j) * inner_count + k;
+        };
+        double sum = 0;
+        for (int64_t j = 0; j < axis_count; j++) {
+          sum += exp(tester.input(0)[index(j)]);
+        }
+        for (int64_t j = 0; j < axis_count; j++) {
+          expected_output[index(j)] = exp(tester.input(0)[index(j)]) / sum;
+        }
+      }
+    }
+    tester.Run(NNADAPTER_SOFTMAX,
+               {input, AddInt32ConstantOperand(tester.model(), axis)},
+               1,
+               dimensions,
+               expected_output);
+  }
+}
+
+TEST(BuiltinKernels, batch_normalization) {
+  // The parameters of the channels are broadcast to the planes
+  std::vector<int32_t> dimensions = {2, 3, 4, 5};
+  int channel_size = dimensions[1];
+  int inner_size = dimensions[2] * dimensions[3];
+  float epsilon = 1e-5f;
+  KernelTester tester;
+  auto input = tester.AddInput(dimensions);
+  auto scale = tester.AddInput({channel_size});
+  auto bias = tester.AddInput({channel_size});
+  auto mean = tester.AddInput({channel_size});
+  auto variance = tester.AddInput({channel_size}, 0.1f, 2.f);
+  std::vector<float> expected_output;
+  for (int i = 0; i < dimensions[0] * channel_size; i++) {
+    int c = i % channel_size;
+    for (int j = 0; j < inner_size; j++) {
+      float x = tester.input(0)[i * inner_size + j];
+      expected_output.push_back((x - tester.input(3)[c]) /
+                                    sqrtf(tester.input(4)[c] + epsilon) *
+                                    tester.input(1)[c] +
+                                tester.input(2)[c]);
+    }
+  }
+  tester.Run(NNADAPTER_BATCH_NORMALIZATION,
+             {input,
+              scale,
+              bias,
+              mean,
+              variance,
+              AddFloat32ConstantOperand(tester.model(), epsilon)},
+             1,
+             dimensions,
+             expected_output);
+}
+
+TEST(BuiltinKernels, unary_activations) {
+  // The elements are split into the blocks of 16K with a tail
+  std::vector<int32_t> dimensions = {3, 16 * 1024 + 5};
+  for (auto type : {NNADAPTER_RELU, NNADAPTER_RELU6}) {
+    KernelTester tester;
+    auto input = tester.AddInput(dimensions, -8.f, 8.f);
+    std::vector<float> expected_output;
+    for (int64_t i = 0; i < ProductionOfDimensions(dimensions); i++) {
+      expected_output.push_back(
+          Fuse(type == NNADAPTER_RELU ? NNADAPTER_FUSED_RELU
+                                      : NNADAPTER_FUSED_RELU6,
+               tester.input(0)[i]));
+    }
+    tester.Run(type, {input}, 1, dimensions, expected_output);
+  }
+}
+
+}  // namespace builtin_device
+}  // namespace nnadapter
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "runtime/compilation.h"
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -139,71 +140,55 @@ Compilation::Compilation(Model* model,
   }
 }
 
+Compilation::~Compilation() { StopWorkers(); }
+
 int Compilation::Execute(std::vector<core::Argument>* input_arguments,
                          std::vector<core::Argument>* output_arguments) {
-  auto create_program_arguments = [&](
-      std::vector<core::Argument>* args,
-      const std::vector<int>& indexes,
-      std::vector<core::Argument>* arguments,
-      std::vector<std::shared_ptr<Buffer>>* buffers,
-      void* (*access)(
-          void* memory, NNAdapterOperandType* type, void* device_buffer)) {
-    for (size_t i = 0; i < indexes.size(); i++) {
-      core::Argument arg;
-      arg.index = i;
-      auto pos = indexes[i];
-      if (pos < 0) {
-        pos = -pos - 1;
-        bool found = false;
-        for (size_t j = 0; j < arguments->size(); j++) {
-          if (pos == arguments->at(j).index) {
-            arg.memory = arguments->at(j).memory;
-            arg.access = arguments->at(j).access;
-            found = true;
-            break;
-          }
-        }
-        NNADAPTER_CHECK(found) << "No matched argument found!";
-      } else {
-        for (int j = buffers->size(); j <= pos; j++) {
-          auto buffer = std::make_shared<Compilation::Buffer>();
-          NNADAPTER_CHECK(buffer)
-              << "Failed to allocate memory for a operand, out of memory!";
-          buffers->push_back(buffer);
-        }
-        arg.memory = buffers->at(pos).get();
-        arg.access = access;
-      }
-      args->push_back(arg);
+  // Index the arguments of the model inputs and outputs
+  auto index_arguments = [&](std::vector<core::Argument>* arguments,
+                             size_t count,
+                             std::vector<core::Argument*>* indexed_arguments) {
+    indexed_arguments->assign(count, nullptr);
+    for (auto& argument : *arguments) {
+      NNADAPTER_CHECK(argument.index >= 0 &&
+                      argument.index < static_cast<int>(count))
+          << "Invalid argument index " << argument.index << "!";
+      indexed_arguments->at(argument.index) = &argument;
+    }
+  };
+  auto bind_arguments = [&](
+      const std::vector<std::pair<size_t, int>>& bindings,
+      const std::vector<core::Argument*>& indexed_arguments,
+      std::vector<core::Argument>* args) {
+    for (auto& binding : bindings) {
+      auto argument = indexed_arguments[binding.second];
+      NNADAPTER_CHECK(argument) << "No matched argument found!";
+      args->at(binding.first).memory = argument->memory;
+      args->at(binding.first).access = argument->access;
     }
   };
-  // Executes the compiled programs on the multi-devices asynchronously or
-  // synchronously
-  // TODO(hong19860320) Supports asynchronously execution in future.
+  std::vector<core::Argument*> indexed_input_arguments,
+      indexed_output_arguments;
+  index_arguments(
+      input_arguments, input_types_.size(), &indexed_input_arguments);
+  index_arguments(
+      output_arguments, output_types_.size(), &indexed_output_arguments);
+  auto request = AcquireRequest();
   for (size_t i = 0; i < programs_.size(); i++) {
-    auto device_context = programs_[i].device_context;
-    std::vector<core::Argument> input_args, output_args;
-    create_program_arguments(&input_args,
-                             programs_[i].input_indexes,
-                             input_arguments,
-                             &buffers_,
-                             AccessSubmodelInput);
-    create_program_arguments(&output_args,
-                             programs_[i].output_indexes,
-                             output_arguments,
-                             &buffers_,
-                             AccessSubmodelOutput);
-    auto result = device_context->device->ExecuteProgram(programs_[i].program,
-                                                         input_args.size(),
-                                                         input_args.data(),
-                                                         output_args.size(),
-                                                         output_args.data());
-    if (result == NNADAPTER_INVALID_DIMENSIONS) return result;
-    NNADAPTER_CHECK_EQ(result, NNADAPTER_NO_ERROR)
-        << "Failed to Execute a program for " << i
-        << "th compiled program on the device '"
-        << device_context->device->GetName() << "'";
+    bind_arguments(programs_[i].model_input_bindings,
+                   indexed_input_arguments,
+                   &request->input_arguments[i]);
+    bind_arguments(programs_[i].model_output_bindings,
+                   indexed_output_arguments,
+                   &request->output_arguments[i]);
   }
+  // Executes the compiled programs on the multi-devices, the independent
+  // programs are executed concurrently, and the successive requests from the
+  // concurrent executions are pipelined across the devices.
+  auto result = ExecutePrograms(request);
+  ReleaseRequest(request);
+  if (result != NNADAPTER_NO_ERROR) return result;
+  std::lock_guard<std::mutex> lock(cache_mutex_);
   if (CheckCache()) {
     // Serialize the cache models into the file or memory at the first iteration
     if (model_ && !cache_token_.empty() && !cache_dir_.empty()) {
@@ -244,7 +229,6 @@ int Compilation::Finish() {
   completed_ = true;
   if (model_) {
     programs_.clear();
-    buffers_.clear();
     std::vector<std::pair<
         Context::DeviceContext*,
         std::tuple<core::Model*, bool, std::vector<int>, std::vector<int>>>>
@@ -335,6 +319,7 @@ int Compilation::Finish() {
                               "and cache is provided.";
     return NNADAPTER_INVALID_PARAMETER;
   }
+  PrepareSchedule();
   return NNADAPTER_NO_ERROR;
 }
 
@@ -377,6 +362,260 @@ void Compilation::ClearCache() {
   }
 }
 
+void Compilation::PrepareSchedule() {
+  StopWorkers();
+  requests_.clear();
+  idle_requests_.clear();
+  program_order_.clear();
+  buffer_count_ = 0;
+  max_parallelism_ = 1;
+  auto program_count = programs_.size();
+  // Find the producers of the shared buffers and bind the arguments of the
+  // model inputs and outputs
+  std::unordered_map<int, size_t> producers;
+  std::unordered_map<Context::DeviceContext*, std::shared_ptr<std::mutex>>
+      device_mutexes;
+  for (size_t i = 0; i < program_count; i++) {
+    auto& program = programs_[i];
+    program.model_input_bindings.clear();
+    program.model_output_bindings.clear();
+    program.consumer_indexes.clear();
+    program.producer_count = 0;
+    for (size_t j = 0; j < program.input_indexes.size(); j++) {
+      auto pos = program.input_indexes[j];
+      if (pos < 0) {
+        program.model_input_bindings.emplace_back(j, -pos - 1);
+      } else {
+        buffer_count_ = std::max(buffer_count_, static_cast<size_t>(pos + 1));
+      }
+    }
+    for (size_t j = 0; j < program.output_indexes.size(); j++) {
+      auto pos = program.output_indexes[j];
+      if (pos < 0) {
+        program.model_output_bindings.emplace_back(j, -pos - 1);
+      } else {
+        buffer_count_ = std::max(buffer_count_, static_cast<size_t>(pos + 1));
+        producers[pos] = i;
+      }
+    }
+    auto& device_mutex = device_mutexes[program.device_context];
+    if (!device_mutex) {
+      device_mutex = std::make_shared<std::mutex>();
+    }
+    program.device_mutex = device_mutex;
+  }
+  for (size_t i = 0; i < program_count; i++) {
+    auto& program = programs_[i];
+    std::unordered_set<size_t> producer_indexes;
+    for (auto pos : program.input_indexes) {
+      if (pos < 0) continue;
+      NNADAPTER_CHECK(producers.count(pos))
+          << "No producer found for the shared operand " << pos << "!";
+      producer_indexes.insert(producers[pos]);
+    }
+    program.producer_count = producer_indexes.size();
+    for (auto producer_index : producer_indexes) {
+      programs_[producer_index].consumer_indexes.push_back(i);
+    }
+  }
+  // Sort the programs topologically, the programs of the same level are
+  // independent of each other
+  std::vector<size_t> producer_counts(program_count);
+  std::vector<size_t> levels(program_count, 0);
+  std::vector<size_t> level_sizes;
+  for (size_t i = 0; i < program_count; i++) {
+    producer_counts[i] = programs_[i].producer_count;
+    if (producer_counts[i] == 0) program_order_.push_back(i);
+  }
+  for (size_t i = 0; i < program_order_.size(); i++) {
+    auto index = program_order_[i];
+    auto level = levels[index];
+    if (level >= level_sizes.size()) level_sizes.resize(level + 1, 0);
+    level_sizes[level]++;
+    for (auto consumer_index : programs_[index].consumer_indexes) {
+      levels[consumer_index] = std::max(levels[consumer_index], level + 1);
+      if (--producer_counts[consumer_index] == 0) {
+        program_order_.push_back(consumer_index);
+      }
+    }
+  }
+  NNADAPTER_CHECK_EQ(program_order_.size(), program_count)
+      << "The submodels have cyclic dependencies!";
+  for (auto level_size : level_sizes) {
+    max_parallelism_ = std::max(max_parallelism_, level_size);
+  }
+  NNADAPTER_VLOG(3) << program_count << " programs, max parallelism "
+                    << max_parallelism_;
+  // The calling thread of each execution is one of the executors
+  for (size_t i = 1; i < max_parallelism_; i++) {
+    workers_.emplace_back(&Compilation::WorkerLoop, this);
+  }
+}
+
+Compilation::Request* Compilation::AcquireRequest() {
+  std::unique_lock<std::mutex> lock(request_mutex_);
+  // Each program is a stage of the pipeline, so at most programs_.size()
+  // requests are in flight.
+  if (idle_requests_.empty() &&
+      requests_.size() < std::max(programs_.size(), static_cast<size_t>(1))) {
+    std::unique_ptr<Request> request(new Request());
+    for (size_t i = 0; i < buffer_count_; i++) {
+      auto buffer = std::make_shared<Compilation::Buffer>();
+      NNADAPTER_CHECK(buffer)
+          << "Failed to allocate memory for a operand, out of memory!";
+      request->buffers.push_back(buffer);
+    }
+    auto create_program_arguments = [&](
+        const std::vector<int>& indexes,
+        void* (*access)(
+            void* memory, NNAdapterOperandType* type, void* device_buffer),
+        std::vector<core::Argument>* args) {
+      args->resize(indexes.size());
+      for (size_t i = 0; i < indexes.size(); i++) {
+        auto& arg = args->at(i);
+        arg.index = i;
+        arg.memory = nullptr;
+        arg.access = nullptr;
+        auto pos = indexes[i];
+        if (pos >= 0) {
+          arg.memory = request->buffers[pos].get();
+          arg.access = access;
+        }
+      }
+    };
+    auto program_count = programs_.size();
+    request->input_arguments.resize(program_count);
+    request->output_arguments.resize(program_count);
+    for (size_t i = 0; i < program_count; i++) {
+      create_program_arguments(programs_[i].input_indexes,
+                               AccessSubmodelInput,
+                               &request->input_arguments[i]);
+      create_program_arguments(programs_[i].output_indexes,
+                               AccessSubmodelOutput,
+                               &request->output_arguments[i]);
+    }
+    requests_.push_back(std::move(request));
+    return requests_.back().get();
+  }
+  request_cv_.wait(lock, [&] { return !idle_requests_.empty(); });
+  auto request = idle_requests_.back();
+  idle_requests_.pop_back();
+  return request;
+}
+
+void Compilation::ReleaseRequest(Request* request) {
+  {
+    std::lock_guard<std::mutex> lock(request_mutex_);
+    idle_requests_.push_back(request);
+  }
+  request_cv_.notify_one();
+}
+
+int Compilation::ExecuteProgram(Request* request, size_t index) {
+  auto& program = programs_[index];
+  auto device_context = program.device_context;
+  auto& input_args = request->input_arguments[index];
+  auto& output_args = request->output_arguments[index];
+  std::lock_guard<std::mutex> lock(*program.device_mutex);
+  auto result = device_context->device->ExecuteProgram(program.program,
+                                                       input_args.size(),
+                                                       input_args.data(),
+                                                       output_args.size(),
+                                                       output_args.data());
+  if (result == NNADAPTER_INVALID_DIMENSIONS) return result;
+  NNADAPTER_CHECK_EQ(result, NNADAPTER_NO_ERROR)
+      << "Failed to Execute a program for " << index
+      << "th compiled program on the device '"
+      << device_context->device->GetName() << "'";
+  return NNADAPTER_NO_ERROR;
+}
+
+int Compilation::ExecutePrograms(Request* request) {
+  if (max_parallelism_ <= 1) {
+    for (auto index : program_order_) {
+      auto result = ExecuteProgram(request, index);
+      if (result != NNADAPTER_NO_ERROR) return result;
+    }
+    return NNADAPTER_NO_ERROR;
+  }
+  std::unique_lock<std::mutex> lock(task_mutex_);
+  request->producer_counts.resize(programs_.size());
+  request->pending_count = 0;
+  request->result = NNADAPTER_NO_ERROR;
+  for (size_t i = 0; i < programs_.size(); i++) {
+    request->producer_counts[i] = programs_[i].producer_count;
+    if (request->producer_counts[i] == 0) {
+      ready_tasks_.emplace_back(request, i);
+      request->pending_count++;
+    }
+  }
+  task_cv_.notify_all();
+  // The calling thread executes the ready programs of its own request until
+  // all of them are finished, and the workers execute the rest
+  while (request->pending_count > 0) {
+    auto task = std::find_if(ready_tasks_.begin(),
+                             ready_tasks_.end(),
+                             [&](const std::pair<Request*, size_t>& t) {
+                               return t.first == request;
+                             });
+    if (task == ready_tasks_.end()) {
+      task_cv_.wait(lock);
+      continue;
+    }
+    ExecuteTask(task, &lock);
+  }
+  return request->result;
+}
+
+void Compilation::ExecuteTask(
+    std::deque<std::pair<Request*, size_t>>::iterator task,
+    std::unique_lock<std::mutex>* lock) {
+  auto request = task->first;
+  auto index = task->second;
+  ready_tasks_.erase(task);
+  // Stop executing the programs of the request once a program fails
+  auto status = request->result;
+  if (status == NNADAPTER_NO_ERROR) {
+    lock->unlock();
+    status = ExecuteProgram(request, index);
+    lock->lock();
+  }
+  request->pending_count--;
+  if (status != NNADAPTER_NO_ERROR) {
+    if (request->result == NNADAPTER_NO_ERROR) request->result = status;
+  } else {
+    for (auto consumer_index : programs_[index].consumer_indexes) {
+      if (--request->producer_counts[consumer_index] == 0) {
+        ready_tasks_.emplace_back(request, consumer_index);
+        request->pending_count++;
+      }
+    }
+  }
+  task_cv_.notify_all();
+}
+
+void Compilation::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(task_mutex_);
+  while (true) {
+    task_cv_.wait(lock, [&] { return stop_workers_ || !ready_tasks_.empty(); });
+    if (stop_workers_) return;
+    ExecuteTask(ready_tasks_.begin(), &lock);
+  }
+}
+
+void Compilation::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(task_mutex_);
+    stop_workers_ = true;
+  }
+  task_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  stop_workers_ = false;
+}
+
 int Compilation::PartitionModel(
     Context* context,
     Model* model,
@@ -544,7 +783,6 @@ bool Compilation::Serialize(std::vector<uint8_t>* buffer) {
 
 bool Compilation::Deserialize(void* buffer, uint64_t size) {
   programs_.clear();
-  buffers_.clear();
   input_types_.clear();
   output_types_.clear();
   auto helper = std::make_shared<nnadapter::Cache>();
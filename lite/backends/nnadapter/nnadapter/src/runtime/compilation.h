@@ -14,8 +14,12 @@
 
 #pragma once
 
+#include <condition_variable>  // NOLINT
+#include <deque>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
+#include <thread>  // NOLINT
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -61,6 +65,35 @@ class Compilation {
     // represents the index of operand shared between the submodels.
     std::vector<int> input_indexes;
     std::vector<int> output_indexes;
+    // The following is built by PrepareSchedule() after the programs are
+    // created
+    // The positions of the arguments bound to the inputs and outputs of the
+    // entire model, and the indexes of the model inputs and outputs.
+    std::vector<std::pair<size_t, int>> model_input_bindings;
+    std::vector<std::pair<size_t, int>> model_output_bindings;
+    // The programs which consume the outputs of this program, and the number
+    // of the programs whose outputs are consumed by this program.
+    std::vector<size_t> consumer_indexes;
+    size_t producer_count{0};
+    // The programs on the same device are executed exclusively.
+    std::shared_ptr<std::mutex> device_mutex;
+  };
+  // The state of a request in flight. Each request has its own shared buffers
+  // among the submodels, so the successive requests from the concurrent
+  // executions are pipelined across the submodels.
+  class Request {
+   public:
+    std::vector<std::shared_ptr<Buffer>> buffers;
+    // The arguments of the programs, the ones of the shared buffers are bound
+    // once, and the ones of the model inputs and outputs are bound on each
+    // execution.
+    std::vector<std::vector<core::Argument>> input_arguments;
+    std::vector<std::vector<core::Argument>> output_arguments;
+    // The scheduling state of ExecutePrograms(), guarded by 'task_mutex_'
+    std::vector<size_t> producer_counts;
+    // The number of the programs which are ready or running
+    size_t pending_count{0};
+    int result{NNADAPTER_NO_ERROR};
   };
   Compilation(Model* model,
               const char* cache_token,
@@ -68,7 +101,7 @@ class Compilation {
               uint32_t cache_length,
               const char* cache_dir,
               Context* context);
-  ~Compilation() {}
+  ~Compilation();
   int Finish();
   int QueryInputsAndOutputs(uint32_t* input_count,
                             NNAdapterOperandType** input_types,
@@ -80,6 +113,20 @@ class Compilation {
  private:
   bool CheckCache();
   void ClearCache();
+  // Build the dependencies among the programs and the argument bindings.
+  void PrepareSchedule();
+  Request* AcquireRequest();
+  void ReleaseRequest(Request* request);
+  int ExecuteProgram(Request* request, size_t index);
+  // Execute the programs in the topological order, the independent programs
+  // are executed concurrently.
+  int ExecutePrograms(Request* request);
+  // Execute a ready program and schedule its consumers, 'lock' holds
+  // 'task_mutex_' and is released during the execution.
+  void ExecuteTask(std::deque<std::pair<Request*, size_t>>::iterator task,
+                   std::unique_lock<std::mutex>* lock);
+  void WorkerLoop();
+  void StopWorkers();
   int PartitionModel(
       Context* context,
       Model* model,
@@ -96,8 +143,23 @@ class Compilation {
   std::string cache_token_;
   std::string cache_dir_;
   std::vector<Program> programs_;
-  std::vector<std::shared_ptr<Buffer>>
-      buffers_;  // The shared buffers among the submodels
+  // The topological order of the programs
+  std::vector<size_t> program_order_;
+  // The max number of the programs which can be executed concurrently
+  size_t max_parallelism_{1};
+  size_t buffer_count_{0};  // The number of the shared buffers
+  std::vector<std::unique_ptr<Request>> requests_;
+  std::vector<Request*> idle_requests_;
+  std::mutex request_mutex_;
+  std::condition_variable request_cv_;
+  // The persistent workers executing the ready programs of all of the
+  // requests in flight, together with the calling threads
+  std::vector<std::thread> workers_;
+  std::deque<std::pair<Request*, size_t>> ready_tasks_;
+  std::mutex task_mutex_;
+  std::condition_variable task_cv_;
+  bool stop_workers_{false};
+  std::mutex cache_mutex_;
   std::vector<NNAdapterOperandType> input_types_;
   std::vector<NNAdapterOperandType> output_types_;
   Context* context_{nullptr};
@@ -0,0 +1,253 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runtime/compilation.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+#include "runtime/device.h"
+#include "runtime/execution.h"
+#include "utility/modeling.h"
+#include "utility/utility.h"
+
+#define REGISTER_OPERATION(__op_type__,            \
+                           __validate_func_name__, \
+                           __prepare_func_name__,  \
+                           __execute_func_name__,  \
+                           ...)                    \
+  extern int __prepare_func_name__(nnadapter::core::Operation* operation);
+namespace nnadapter {
+namespace operation {
+#include "operation/all.h"  // NOLINT
+#undef __NNADAPTER_OPERATION_ALL_H__
+}  // namespace operation
+}  // namespace nnadapter
+#undef REGISTER_OPERATION
+
+namespace nnadapter {
+namespace runtime {
+
+const std::vector<int32_t> kInputDims = {1, 4, 8, 8};
+
+struct Memory {
+  std::vector<int32_t> dimensions;
+  std::vector<float> data;
+};
+
+void* AccessInput(void* memory, NNAdapterOperandType* type, void* buffer) {
+  auto m = static_cast<Memory*>(memory);
+  type->dimensions.count = m->dimensions.size();
+  memcpy(type->dimensions.data,
+         m->dimensions.data(),
+         m->dimensions.size() * sizeof(int32_t));
+  return m->data.data();
+}
+
+void* AccessOutput(void* memory, NNAdapterOperandType* type, void* buffer) {
+  auto m = static_cast<Memory*>(memory);
+  m->dimensions.assign(type->dimensions.data,
+                       type->dimensions.data + type->dimensions.count);
+  m->data.resize(ProductionOfDimensions(m->dimensions));
+  return m->data.data();
+}
+
+std::vector<float> RandomData(size_t size, int seed) {
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> data(size);
+  for (auto& value : data) {
+    value = dist(engine);
+  }
+  return data;
+}
+
+// Add the operation and infer the shapes of its outputs as
+// NNAdapterModel_addOperation does.
+void AddOperation(Model* model,
+                  NNAdapterOperationType type,
+                  std::vector<core::Operand*> input_operands,
+                  std::vector<core::Operand*> output_operands) {
+  core::Operation* operation = nullptr;
+  ASSERT_EQ(model->AddOperation(type, &operation), NNADAPTER_NO_ERROR);
+  operation->input_operands = input_operands;
+  operation->output_operands = output_operands;
+  switch (type) {
+#define REGISTER_OPERATION(__op_type__,                    \
+                           __validate_func_name__,         \
+                           __prepare_func_name__,          \
+                           __execute_func_name__,          \
+                           ...)                            \
+  case NNADAPTER_##__op_type__:                            \
+    ASSERT_EQ(operation::__prepare_func_name__(operation), \
+              NNADAPTER_NO_ERROR);                         \
+    break;
+#include "operation/all.h"  // NOLINT
+#undef __NNADAPTER_OPERATION_ALL_H__
+#undef REGISTER_OPERATION
+    default:
+      FAIL() << "Unsupported operation " << type;
+  }
+}
+
+core::Operand* AddConv2D(Model* model, core::Operand* input, int seed) {
+  auto m = &model->model_;
+  int32_t channels = kInputDims[1];
+  auto filter_data = RandomData(channels * channels * 9, seed);
+  auto bias_data = RandomData(channels, seed + 1);
+  auto filter = AddFloat32ConstantOperand(
+      m, filter_data.data(), {channels, channels, 3, 3});
+  auto bias = AddFloat32ConstantOperand(m, bias_data.data(), {channels});
+  auto output = AddFloat32VariableOperand(m, {});
+  AddOperation(model,
+               NNADAPTER_CONV_2D,
+               {input,
+                filter,
+                bias,
+                AddInt32ConstantOperand(m, NNADAPTER_AUTO_PAD_NONE),
+                AddInt32ConstantOperand(m, std::vector<int32_t>{1, 1, 1, 1}),
+                AddInt32ConstantOperand(m, std::vector<int32_t>{1, 1}),
+                AddInt32ConstantOperand(m, 1),
+                AddInt32ConstantOperand(m, std::vector<int32_t>{1, 1}),
+                AddInt32ConstantOperand(m, NNADAPTER_FUSED_NONE)},
+               {output});
+  return output;
+}
+
+core::Operand* AddSoftmax(Model* model, core::Operand* input) {
+  auto m = &model->model_;
+  auto output = AddFloat32VariableOperand(m, {});
+  AddOperation(model,
+               NNADAPTER_SOFTMAX,
+               {input, AddInt32ConstantOperand(m, 1)},
+               {output});
+  return output;
+}
+
+// y0 = conv2d(x) and y1 = softmax(conv2d(softmax(x))), the conv2d operations
+// are supported by fake_device and softmax is left to builtin_device, so the
+// submodels of y0 and y1 are independent.
+void BuildModel(Model* model) {
+  auto x = AddFloat32VariableOperand(&model->model_, kInputDims);
+  core::Operand* y[2] = {
+      AddConv2D(model, x, 1),
+      AddSoftmax(model, AddConv2D(model, AddSoftmax(model, x), 3))};
+  ASSERT_EQ(model->IdentifyInputsAndOutputs(1, &x, 2, y), NNADAPTER_NO_ERROR);
+  ASSERT_EQ(model->Finish(), NNADAPTER_NO_ERROR);
+}
+
+class Session {
+ public:
+  explicit Session(const std::vector<std::string>& device_names) {
+    for (auto& device_name : device_names) {
+      devices_.emplace_back(new Device(device_name));
+    }
+    std::vector<Device*> devices;
+    for (auto& device : devices_) {
+      devices.push_back(device.get());
+    }
+    context_.reset(new Context(devices, "", nullptr));
+    BuildModel(&model_);
+    compilation_.reset(
+        new Compilation(&model_, "", nullptr, 0, "", context_.get()));
+  }
+
+  Compilation* compilation() { return compilation_.get(); }
+  Model* model() { return &model_; }
+  Context* context() { return context_.get(); }
+
+  std::vector<Memory> Run(const std::vector<float>& x) {
+    Memory input{kInputDims, x};
+    std::vector<Memory> outputs(2);
+    Execution execution(compilation_.get());
+    EXPECT_EQ(execution.SetInput(0, &input, AccessInput), NNADAPTER_NO_ERROR);
+    for (int i = 0; i < 2; i++) {
+      EXPECT_EQ(execution.SetOutput(i, &outputs[i], AccessOutput),
+                NNADAPTER_NO_ERROR);
+    }
+    EXPECT_EQ(execution.Compute(), NNADAPTER_NO_ERROR);
+    return outputs;
+  }
+
+ private:
+  std::vector<std::unique_ptr<Device>> devices_;
+  std::unique_ptr<Context> context_;
+  Model model_;
+  std::unique_ptr<Compilation> compilation_;
+};
+
+void ExpectNear(const std::vector<Memory>& x, const std::vector<Memory>& y) {
+  ASSERT_EQ(x.size(), y.size());
+  for (size_t i = 0; i < x.size(); i++) {
+    EXPECT_EQ(x[i].dimensions, kInputDims);
+    EXPECT_EQ(x[i].dimensions, y[i].dimensions);
+    ASSERT_EQ(x[i].data.size(), y[i].data.size());
+    for (size_t j = 0; j < x[i].data.size(); j++) {
+      EXPECT_NEAR(x[i].data[j], y[i].data[j], 1e-5f) << "output " << i;
+    }
+  }
+}
+
+TEST(Compilation, partition_into_device_and_cpu_submodels) {
+  Session reference({"builtin_device"});
+  ASSERT_EQ(reference.compilation()->Finish(), NNADAPTER_NO_ERROR);
+  Session session({"fake_device", "builtin_device"});
+  // Check the operations taken by fake_device before they're partitioned
+  auto& operations = session.model()->model_.operations;
+  std::unique_ptr<bool[]> supported(new bool[operations.size()]);
+  ASSERT_EQ(session.model()->GetSupportedOperations(
+                session.context()->GetDeviceContext(0), supported.get()),
+            NNADAPTER_NO_ERROR);
+  size_t index = 0;
+  for (auto& operation : operations) {
+    EXPECT_EQ(supported[index++], operation.type == NNADAPTER_CONV_2D);
+  }
+  ASSERT_EQ(session.compilation()->Finish(), NNADAPTER_NO_ERROR);
+
+  auto size = ProductionOfDimensions(kInputDims);
+  for (int i = 0; i < 3; i++) {
+    auto x = RandomData(size, 100 + i);
+    ExpectNear(session.Run(x), reference.Run(x));
+  }
+  // The concurrent executions are pipelined across the submodels, and each
+  // of them must get the result of its own input.
+  const int thread_count = 4;
+  std::vector<std::vector<float>> inputs;
+  std::vector<std::vector<Memory>> expected_outputs, outputs;
+  for (int i = 0; i < thread_count; i++) {
+    inputs.push_back(RandomData(size, 200 + i));
+    expected_outputs.push_back(reference.Run(inputs[i]));
+  }
+  outputs.resize(thread_count);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < thread_count; i++) {
+    threads.emplace_back([&, i] {
+      for (int j = 0; j < 10; j++) {
+        outputs[i] = session.Run(inputs[i]);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int i = 0; i < thread_count; i++) {
+    ExpectNear(outputs[i], expected_outputs[i]);
+  }
+}
+
+}  // namespace runtime
+}  // namespace nnadapter
@@ -15,6 +15,7 @@
 #include "runtime/device.h"
 #include <dlfcn.h>
 #include <stdlib.h>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -24,6 +25,7 @@
 #include "optimizer/fuse_conv2d_batch_norm_into_conv2d.h"
 #include "optimizer/fuse_matmul_add_into_fully_connected.h"
 #include "optimizer/fuse_reshape_transpose_reshape_into_channel_shuffle.h"
+#include "runtime/builtin_kernels.h"
 #include "utility/debug.h"
 #include "utility/modeling.h"
 #include "utility/string.h"
@@ -65,12 +67,14 @@ class Device {
 class Context {
  public:
   explicit Context(void* device, const char* properties);
-  bool num_threads() { return num_threads_; }
+  int num_threads() { return num_threads_; }
+  ThreadPool* thread_pool() { return thread_pool_.get(); }
   ~Context() {}
 
  private:
   void* device_{nullptr};
   int num_threads_{0};
+  std::unique_ptr<ThreadPool> thread_pool_;
 };
 
 Context::Context(void* device, const char* properties) : device_(device) {
@@ -85,6 +89,9 @@ Context::Context(void* device, const char* properties) : device_(device) {
     num_threads_ = GetIntFromEnv(BUILTIN_DEVICE_NUM_THREADS, 0);
   }
   NNADAPTER_LOG(INFO) << "num_threads: " << num_threads_;
+  if (num_threads_ > 1) {
+    thread_pool_.reset(new ThreadPool(num_threads_));
+  }
 }
 
 class Program {
@@ -238,19 +245,25 @@ int Program::Execute(uint32_t input_count,
     operand->buffer = buffer;
     operand->length = GetOperandTypeBufferLength(*type);
   }
+  // The optimized kernels are preferred, and the reference implementations
+  // of the operations are used if they are not matched.
+  auto start_time = GetCurrentUS();
   for (auto& operation : operations_) {
     NNADAPTER_VLOG(5) << "Running " << OperationTypeToString(operation->type)
                       << " ...";
     switch (operation->type) {
-#define REGISTER_OPERATION(__op_type__,                            \
-                           __validate_func_name__,                 \
-                           __prepare_func_name__,                  \
-                           __execute_func_name__)                  \
-  case NNADAPTER_##__op_type__:                                    \
-    NNADAPTER_CHECK(operation::__prepare_func_name__(operation) == \
-                    NNADAPTER_NO_ERROR);                           \
-    NNADAPTER_CHECK(operation::__execute_func_name__(operation) == \
-                    NNADAPTER_NO_ERROR);                           \
+#define REGISTER_OPERATION(__op_type__,                                     \
+                           __validate_func_name__,                          \
+                           __prepare_func_name__,                           \
+                           __execute_func_name__)                           \
+  case NNADAPTER_##__op_type__:                                             \
+    NNADAPTER_CHECK(operation::__prepare_func_name__(operation) ==          \
+                    NNADAPTER_NO_ERROR);                                    \
+    result = ExecuteBuiltinKernel(operation, context_->thread_pool());      \
+    if (result == NNADAPTER_FEATURE_NOT_SUPPORTED) {                        \
+      result = operation::__execute_func_name__(operation);                 \
+    }                                                                       \
+    NNADAPTER_CHECK(result == NNADAPTER_NO_ERROR);                          \
     break;
 #include "operation/all.h"  // NOLINT
 #undef __NNADAPTER_OPERATION_ALL_H__
@@ -275,7 +288,6 @@ int Program::Execute(uint32_t input_count,
     NNADAPTER_CHECK(buffer);
     memcpy(buffer, operand->buffer, length);
   }
-  auto start_time = GetCurrentUS();
   NNADAPTER_VLOG(3) << "Process cost " << GetCurrentUS() - start_time << " us";
   return NNADAPTER_NO_ERROR;
 }
@@ -0,0 +1,134 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/dynamic_quant_gemm.h"
+#include <algorithm>
+#include <cmath>
+#include "lite/backends/x86/math/gemm_s8u8_kernel.h"
+#include "lite/backends/x86/math/gemm_s8u8_pack.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+static const float kActRange = 63.f;
+static const int kL2Size = 262144;
+
+void QuantizeRowsAbsMax(
+    const float* x, int M, int K, int8_t* x_int8, float* row_scales) {
+  for (int m = 0; m < M; m++) {
+    const float* row = x + m * K;
+    int8_t* row_int8 = x_int8 + m * K;
+    float abs_max = 0.f;
+    for (int k = 0; k < K; k++) {
+      abs_max = std::max(abs_max, std::fabs(row[k]));
+    }
+    // The rows of zeros keep the scale 1 to avoid dividing by zero.
+    const float scale = abs_max > 0.f ? abs_max / kActRange : 1.f;
+    const float inv_scale = 1.f / scale;
+    for (int k = 0; k < K; k++) {
+      float q = std::round(row[k] * inv_scale);
+      row_int8[k] =
+          static_cast<int8_t>(std::min(std::max(q, -kActRange), kActRange));
+    }
+    row_scales[m] = scale;
+  }
+}
+
+DynamicQuantGemm::DynamicQuantGemm(int N,
+                                   int K,
+                                   const int8_t* w,
+                                   const float* w_scales)
+    : N_(N), K_(K), w_scales_(w_scales, w_scales + N) {
+  k_align4_ = (K + 3) / 4 * 4;
+  // A block of the packed weights takes half of the 256K L2 as the blocks
+  // of gemm_s8u8_compute.h, and the columns are multiples of 32.
+  block_n_ = std::max((kL2Size / 2 / k_align4_) / 32 * 32, 32);
+  const int blocks = (N + block_n_ - 1) / block_n_;
+  packed_w_.resize(static_cast<size_t>(blocks) * block_n_ * k_align4_);
+  for (int b = 0; b < blocks; b++) {
+    const int n = b * block_n_;
+    gemm_s8u8s8_runpackB(std::min(block_n_, N - n),
+                         K,
+                         N,
+                         w + n,
+                         packed_w_.data() +
+                             static_cast<size_t>(b) * block_n_ * k_align4_,
+                         false);
+  }
+}
+
+void DynamicQuantGemm::Run(
+    int M, const float* x, const float* bias, bool relu, float* y) {
+  if (M <= 0 || N_ <= 0) return;
+  x_int8_.resize(static_cast<size_t>(M) * K_);
+  packed_x_.resize(static_cast<size_t>(M) * k_align4_);
+  row_scales_.resize(M);
+  row_bias_.resize(M);
+  QuantizeRowsAbsMax(x, M, K_, x_int8_.data(), row_scales_.data());
+  std::fill(packed_x_.begin(), packed_x_.end(), 0);
+  gemm_s8u8s8_prepackA(M, K_, x_int8_.data(), packed_x_.data(), false);
+
+  // The weights are shifted to u8 by 128, which adds 128 * sum(x_int8) to
+  // each row, and is removed by the bias of the rows.
+  for (int m = 0; m < M; m++) {
+    const int8_t* row = x_int8_.data() + m * K_;
+    int sum = 0;
+    for (int k = 0; k < K_; k++) {
+      sum += row[k];
+    }
+    row_bias_[m] = -row_scales_[m] * TRANS_INT8_UINT8_OFFT * sum;
+  }
+
+  // y = row_scales[m] * (x_int8 * w), the scales of the weights are applied
+  // by the epilogue since the GEMM only scales the rows.
+  for (int n = 0; n < N_; n += block_n_) {
+    gemm_kernel_loop_int8(M,
+                          std::min(block_n_, N_ - n),
+                          K_,
+                          packed_x_.data(),
+                          packed_w_.data() +
+                              static_cast<size_t>(n) * k_align4_,
+                          y + n,
+                          N_,
+                          row_scales_.data(),
+                          row_bias_.data(),
+                          0,
+                          1.f);
+  }
+
+  for (int m = 0; m < M; m++) {
+    float* row = y + m * N_;
+    if (bias) {
+      for (int n = 0; n < N_; n++) {
+        row[n] = row[n] * w_scales_[n] + bias[n];
+      }
+    } else {
+      for (int n = 0; n < N_; n++) {
+        row[n] = row[n] * w_scales_[n];
+      }
+    }
+    if (relu) {
+      for (int n = 0; n < N_; n++) {
+        row[n] = std::max(row[n], 0.f);
+      }
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
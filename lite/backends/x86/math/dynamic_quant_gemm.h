@@ -0,0 +1,69 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/*
+ * The GEMM of the dynamic quantization, whose weights are quantized to int8
+ * per output channel offline by post_quant_dynamic_pass, and whose float
+ * activations are quantized to int8 per row at each call.
+ *
+ * The activations are quantized to [-63, 63] instead of [-127, 127], since
+ * the u8s8 GEMM of gemm_s8u8_kernel.h sums the pairs of the u8 x s8
+ * products in int16, which overflows for the full range.
+ */
+
+// Quantize each row of x[M, K] to int8 by its abs max, 'row_scales' are the
+// scales to dequantize the rows.
+void QuantizeRowsAbsMax(
+    const float* x, int M, int K, int8_t* x_int8, float* row_scales);
+
+// y[M, N] = act(x[M, K] * dequant(w[K, N]) + bias[N]), where the int8
+// weights w are dequantized by 'w_scales' of the N columns, and act is none
+// or relu. The weights are packed to the u8 B of the u8s8 GEMM once at the
+// construction, each run only packs the quantized activations.
+class DynamicQuantGemm {
+ public:
+  DynamicQuantGemm(int N, int K, const int8_t* w, const float* w_scales);
+
+  // 'bias' is optional.
+  void Run(int M, const float* x, const float* bias, bool relu, float* y);
+
+ private:
+  int N_;
+  int K_;
+  int k_align4_;
+  // the columns of a block of the packed weights
+  int block_n_;
+  std::vector<uint8_t> packed_w_;
+  std::vector<float> w_scales_;
+  // the buffers of the activations kept between runs
+  std::vector<int8_t> x_int8_;
+  std::vector<int8_t> packed_x_;
+  std::vector<float> row_scales_;
+  std::vector<float> row_bias_;
+};
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
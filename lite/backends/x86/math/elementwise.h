@@ -13,163 +13,175 @@
 // limitations under the License.
 #pragma once
 
-#include <string>
+#include <algorithm>
+#include <vector>
 #include "lite/backends/x86/math/elementwise_common_broadcast_config.h"
+#include "lite/core/dim.h"
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
 namespace x86 {
 namespace math {
 
-#define ElementWiseFunc(op)                                                    \
-  template <typename T>                                                        \
-  void Elementwise_##op(const T* dinx,                                         \
-                        const T* diny,                                         \
-                        T* dout,                                               \
-                        int num,                                               \
-                        bool has_active,                                       \
-                        std::string act_type) {                                \
-    if (act_type == "tanh") {                                                  \
-      lite::x86::math::elementwise_range_to_range<                             \
-          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::TANH, T>>>(      \
-          dinx, diny, dout, num);                                              \
-    } else if (act_type == "relu") {                                           \
-      lite::x86::math::elementwise_range_to_range<                             \
-          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::RELU, T>>>(      \
-          dinx, diny, dout, num);                                              \
-    } else if (act_type == "sigmoid") {                                        \
-      lite::x86::math::elementwise_range_to_range<                             \
-          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::SIGMOID, T>>>(   \
-          dinx, diny, dout, num);                                              \
-    } else {                                                                   \
-      lite::x86::math::elementwise_range_to_range<                             \
-          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
-          dinx, diny, dout, num);                                              \
-    }                                                                          \
+/*
+ * The broadcast of Out = X op Y in the fewest dims.
+ *
+ * The tensor of the lower rank is aligned to the other one at 'axis', the
+ * dims of size 1 in Out are dropped, and the adjacent dims which X and Y
+ * broadcast in the same way are merged. For example:
+ * 1. X(2, 3, 4, 5), Y(3, 4), axis = 1: Out(2, 12, 5), X strides (60, 5, 1),
+ *    Y strides (0, 1, 0).
+ * 2. X(B, S, H), Y(H): Out(B * S, H), X strides (H, 1), Y strides (0, 1).
+ * 3. X(B, N, S, S), Y(B, 1, 1, S): Out(B, N * S, S), X strides
+ *    (N * S * S, S, 1), Y strides (S, 0, 1).
+ * The innermost dim is either contiguous in both of X and Y, or a scalar of
+ * one of them, which are the three SIMD loops of do_isa_elementwise.
+ */
+struct BroadcastDims {
+  std::vector<int64_t> out;
+  // The strides in elements, 0 if the dim is broadcast.
+  std::vector<int64_t> x_strides;
+  std::vector<int64_t> y_strides;
+};
+
+// Return false if the dims can't be broadcast.
+inline bool CollapseBroadcastDims(const DDim& x_dims,
+                                  const DDim& y_dims,
+                                  int axis,
+                                  BroadcastDims* dims) {
+  auto x_shape = x_dims.Vectorize();
+  auto y_shape = y_dims.Vectorize();
+  bool x_is_shorter = x_shape.size() < y_shape.size();
+  auto& long_shape = x_is_shorter ? y_shape : x_shape;
+  auto& short_shape = x_is_shorter ? x_shape : y_shape;
+  int rank = static_cast<int>(long_shape.size());
+  // The axis is ignored if X and Y have the same rank.
+  if (axis < 0 || x_shape.size() == y_shape.size()) {
+    axis = rank - static_cast<int>(short_shape.size());
+  }
+  // The trailing dims of size 1 may exceed the rank, i.e. X(2, 3) and
+  // Y(3, 1) with axis = 1.
+  while (!short_shape.empty() &&
+         axis + static_cast<int>(short_shape.size()) > rank &&
+         short_shape.back() == 1) {
+    short_shape.pop_back();
   }
+  if (axis < 0 || axis + static_cast<int>(short_shape.size()) > rank) {
+    return false;
+  }
+  short_shape.insert(short_shape.begin(), axis, 1);
+  short_shape.resize(rank, 1);
 
-#define ElementWiseFuncBCast(op)                                      \
-  template <typename T>                                               \
-  void Elementwise_Broadcast_##op(const T* dinx,                      \
-                                  const T* diny,                      \
-                                  T* dout,                            \
-                                  int batch,                          \
-                                  int channels,                       \
-                                  int num,                            \
-                                  bool has_active,                    \
-                                  std::string act_type,               \
-                                  bool inv) {                         \
-    if (act_type == "tanh") {                                         \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::TANH, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::TANH, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    } else if (act_type == "relu") {                                  \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::RELU, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::RELU, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    } else if (act_type == "sigmoid") {                               \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::SIGMOID, T>>>(   \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::SIGMOID, T>>>(   \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    } else {                                                          \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    }                                                                 \
+  // Bit 0 is set if X is broadcast along the dim, and bit 1 for Y.
+  std::vector<int> states;
+  dims->out.clear();
+  for (int i = 0; i < rank; i++) {
+    int64_t x = x_shape[i];
+    int64_t y = y_shape[i];
+    if (x != y && x != 1 && y != 1) return false;
+    int64_t out = std::max(x, y);
+    if (out == 1) continue;
+    int state = (x == 1 ? 1 : 0) | (y == 1 ? 2 : 0);
+    if (!states.empty() && states.back() == state) {
+      dims->out.back() *= out;
+    } else {
+      dims->out.push_back(out);
+      states.push_back(state);
+    }
+  }
+  if (dims->out.empty()) {
+    dims->out.push_back(1);
+    states.push_back(0);
   }
 
-// clang-format off
-ElementWiseFunc(Add)
-ElementWiseFuncBCast(Add)
-ElementWiseFunc(Sub)
-ElementWiseFuncBCast(Sub)
-ElementWiseFunc(Mul)
-ElementWiseFuncBCast(Mul)
-ElementWiseFunc(Max)
-ElementWiseFuncBCast(Max)
-ElementWiseFunc(Min)
-ElementWiseFuncBCast(Min)
-ElementWiseFunc(Div)
-ElementWiseFuncBCast(Div)
-ElementWiseFunc(FloorDiv)
-ElementWiseFuncBCast(FloorDiv)
-ElementWiseFunc(Mod)
-ElementWiseFuncBCast(Mod)
-ElementWiseFunc(Pow)
-ElementWiseFuncBCast(Pow)
-// clang-format on
+  int size = static_cast<int>(dims->out.size());
+  dims->x_strides.resize(size);
+  dims->y_strides.resize(size);
+  int64_t x_stride = 1;
+  int64_t y_stride = 1;
+  for (int i = size - 1; i >= 0; i--) {
+    dims->x_strides[i] = (states[i] & 1) ? 0 : x_stride;
+    dims->y_strides[i] = (states[i] & 2) ? 0 : y_stride;
+    if (!(states[i] & 1)) x_stride *= dims->out[i];
+    if (!(states[i] & 2)) y_stride *= dims->out[i];
+  }
+  return true;
+}
+
+// The elements of a task, the rows shorter than it are grouped into a task,
+// and the longer rows are split into several tasks.
+constexpr int64_t kBroadcastGrainSize = 16384;
+
+// Out = act(X op Y), where 'Config' is the MergeConfig of the op and the
+// activation.
+template <class Config>
+void elementwise_broadcast(const typename Config::T* x,
+                           const typename Config::T* y,
+                           typename Config::T* out,
+                           const BroadcastDims& dims) {
+  int rank = static_cast<int>(dims.out.size());
+  int64_t inner = dims.out[rank - 1];
+  int64_t rows = 1;
+  for (int i = 0; i < rank - 1; i++) {
+    rows *= dims.out[i];
+  }
+  bool x_scalar = dims.x_strides[rank - 1] == 0;
+  bool y_scalar = dims.y_strides[rank - 1] == 0;
+
+  int64_t rows_per_task = 1;
+  int64_t blocks_per_row = 1;
+  int64_t block = inner;
+  if (inner >= kBroadcastGrainSize) {
+    block = kBroadcastGrainSize;
+    blocks_per_row = (inner + block - 1) / block;
+  } else {
+    rows_per_task = std::max<int64_t>(1, kBroadcastGrainSize / inner);
+  }
+  int tasks = static_cast<int>((rows + rows_per_task - 1) / rows_per_task *
+                               blocks_per_row);
+
+  auto run_task = [&](int task) {
+    int64_t row_begin = task / blocks_per_row * rows_per_task;
+    int64_t row_end = std::min(rows, row_begin + rows_per_task);
+    int64_t col = task % blocks_per_row * block;
+    int num = static_cast<int>(std::min(block, inner - col));
+    for (int64_t row = row_begin; row < row_end; row++) {
+      int64_t x_offset = x_scalar ? 0 : col;
+      int64_t y_offset = y_scalar ? 0 : col;
+      int64_t index = row;
+      for (int i = rank - 2; i >= 0; i--) {
+        int64_t coord = index % dims.out[i];
+        index /= dims.out[i];
+        x_offset += coord * dims.x_strides[i];
+        y_offset += coord * dims.y_strides[i];
+      }
+      auto* out_ptr = out + row * inner + col;
+      if (x_scalar) {
+        elementwise_one_to_range<Config>(
+            x + x_offset, y + y_offset, out_ptr, num);
+      } else if (y_scalar) {
+        elementwise_range_to_one<Config>(
+            x + x_offset, y + y_offset, out_ptr, num);
+      } else {
+        elementwise_range_to_range<Config>(
+            x + x_offset, y + y_offset, out_ptr, num);
+      }
+    }
+  };
+
+#ifdef LITE_USE_THREAD_POOL
+  LITE_PARALLEL_BEGIN(task, tid, tasks) { run_task(task); }
+  LITE_PARALLEL_END();
+#else
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int task = 0; task < tasks; task++) {
+    run_task(task);
+  }
+#endif
+}
 
 }  // namespace math
 }  // namespace x86
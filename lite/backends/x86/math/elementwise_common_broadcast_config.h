@@ -63,6 +63,9 @@ T div_ps_inline(T a, T b);
 template <typename T>
 T mul_ps_inline(T a, T b);
 
+template <typename T>
+T abs_ps_inline(T a);
+
 template <typename OUT_T, typename IN_T>
 OUT_T set1_epi32_inline(IN_T a);
 
@@ -134,6 +137,10 @@ template <>
 __m256 mul_ps_inline<__m256>(__m256 a, __m256 b) {
   return _mm256_mul_ps(a, b);
 }
+template <>
+__m256 abs_ps_inline<__m256>(__m256 a) {
+  return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a);
+}
 #elif defined(__SSE4_2__)
 template <>
 __m128 loadu_ps_inline<__m128, float>(const float* a) {
@@ -171,6 +178,10 @@ template <>
 __m128 mul_ps_inline<__m128>(__m128 a, __m128 b) {
   return _mm_mul_ps(a, b);
 }
+template <>
+__m128 abs_ps_inline<__m128>(__m128 a) {
+  return _mm_andnot_ps(_mm_set1_ps(-0.f), a);
+}
 
 __m128 _mm_relu_ps(const __m128& a) {
   __m128 vec_zero = _mm_set1_ps(0.f);
@@ -283,6 +294,11 @@ inline T NaiveTanh(T a) {
   return (x - y) / (x + y);
 }
 
+template <class T>
+inline T NaiveAbs(T a) {
+  return a < 0 ? -a : a;
+}
+
 template <class T>
 inline T NaiveSigmoid(T a) {
   const T min = -40.0;  // SIGMOID_THRESHOLD_MIN;
@@ -344,7 +360,7 @@ struct NullCpuInstruction {};
 template <class ComputeConfig, class ActConfig>
 struct MergeConfig : public ComputeConfig, public ActConfig {};
 
-enum class ActiveType { NO_ACTIVE, RELU, TANH, SIGMOID };
+enum class ActiveType { NO_ACTIVE, RELU, TANH, SIGMOID, ABS };
 
 template <class DataType>
 struct BasicConfig {};
@@ -660,6 +676,13 @@ struct ActiveConfig<ActiveType::SIGMOID, float> {
   constexpr static __m256 (*isa_active)(const __m256) = forward_avx::Sigmoid;
   constexpr static bool has_active = true;
 };
+
+template <>
+struct ActiveConfig<ActiveType::ABS, float> {
+  constexpr static float (*naive_active)(float) = NaiveAbs<float>;
+  constexpr static __m256 (*isa_active)(const __m256) = abs_ps_inline<__m256>;
+  constexpr static bool has_active = true;
+};
 #elif defined(__SSE4_2__)
 __m128 _mm_relu_ps(const __m128& a);
 
@@ -684,6 +707,13 @@ struct ActiveConfig<ActiveType::SIGMOID, float> {
   constexpr static __m128 (*isa_active)(const __m128) = nullptr;
   constexpr static bool has_active = true;
 };
+
+template <>
+struct ActiveConfig<ActiveType::ABS, float> {
+  constexpr static float (*naive_active)(float) = NaiveAbs<float>;
+  constexpr static __m128 (*isa_active)(const __m128) = abs_ps_inline<__m128>;
+  constexpr static bool has_active = true;
+};
 #endif
 
 // fuse-activation doesn't support int32 and int64 type
@@ -746,8 +776,9 @@ static bool condition_two(void* isa_op, void* naive_op) {
 
 static bool condition_three(void* isa_act) { return (isa_act != nullptr); }
 
-// Fuse-Activation only supports relu, sigmoid and tanh for AVX instruction,
-// relu for SSE instruction, the others run naive functions instead.
+// Fuse-Activation only supports relu, sigmoid, tanh and abs for AVX
+// instruction, relu and abs for SSE instruction, the others run naive
+// functions instead.
 template <class Config, bool IS_X_SINGLE, bool IS_Y_SINGLE>
 void do_isa_elementwise(const typename Config::T* dinx,
                         const typename Config::T* diny,
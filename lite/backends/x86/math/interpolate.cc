@@ -16,6 +16,7 @@ limitations under the License. */
 #include <string>
 #include <vector>
 #include "lite/backends/x86/math/math_function.h"
+#include "lite/backends/x86/math/nchwc.h"
 
 namespace paddle {
 namespace lite {
@@ -545,6 +546,54 @@ inline std::vector<T> get_new_data_from_tensor(const Tensor* new_data_tensor) {
   return vec_new_data;
 }
 
+// The interpolation of the input and the output in the layout blocked by
+// 'block'.
+void interpolate_nchwc(const float* input_data,
+                       float* output_data,
+                       const float ratio_h,
+                       const float ratio_w,
+                       const int n,
+                       const int c,
+                       const int in_h,
+                       const int in_w,
+                       const int out_h,
+                       const int out_w,
+                       const int align_mode,
+                       const bool align_corners,
+                       const std::string& interpolate_type,
+                       const int block) {
+  if ("Bilinear" == interpolate_type) {
+    bilinear_interp_nchwc(input_data,
+                          output_data,
+                          ratio_h,
+                          ratio_w,
+                          n,
+                          c,
+                          in_h,
+                          in_w,
+                          out_h,
+                          out_w,
+                          align_corners,
+                          align_mode,
+                          block);
+  } else if ("Nearest" == interpolate_type) {
+    nearest_interp_nchwc(input_data,
+                         output_data,
+                         ratio_h,
+                         ratio_w,
+                         n,
+                         c,
+                         in_h,
+                         in_w,
+                         out_h,
+                         out_w,
+                         align_corners,
+                         block);
+  } else {
+    LOG(FATAL) << "Not supported interpolate_type: " << interpolate_type;
+  }
+}
+
 void interpolate(lite::Tensor* input,
                  lite::Tensor* out_size,
                  std::vector<const lite::Tensor*> list_new_size_tensor,
@@ -556,7 +605,8 @@ void interpolate(lite::Tensor* input,
                  int out_w,
                  const int align_mode,
                  const bool align_corners,
-                 const std::string interpolate_type) {
+                 const std::string interpolate_type,
+                 const int block) {
   // format NCHW
   int n = input->dims()[0];
   int c = input->dims()[1];
@@ -606,6 +656,23 @@ void interpolate(lite::Tensor* input,
   }
 
   const float* input_data = input->data<float>();
+  if (block > 0) {
+    interpolate_nchwc(input_data,
+                      nchwc_mutable_data(output, block),
+                      ratio_h,
+                      ratio_w,
+                      n,
+                      c,
+                      in_h,
+                      in_w,
+                      out_h,
+                      out_w,
+                      align_mode,
+                      align_corners,
+                      interpolate_type,
+                      block);
+    return;
+  }
   float* output_data = output->mutable_data<float>();
   if ("Bilinear" == interpolate_type) {
     bilinear_interp(input_data,
@@ -648,7 +715,8 @@ void interpolate_v2(lite::Tensor* input,
                     int out_w,
                     const int align_mode,
                     const bool align_corners,
-                    const std::string interpolate_type) {
+                    const std::string interpolate_type,
+                    const int block) {
   // format NCHW
   int n = input->dims()[0];
   int c = input->dims()[1];
@@ -709,6 +777,23 @@ void interpolate_v2(lite::Tensor* input,
   }
 
   const float* input_data = input->data<float>();
+  if (block > 0) {
+    interpolate_nchwc(input_data,
+                      nchwc_mutable_data(output, block),
+                      ratio_h,
+                      ratio_w,
+                      n,
+                      c,
+                      in_h,
+                      in_w,
+                      out_h,
+                      out_w,
+                      align_mode,
+                      align_corners,
+                      interpolate_type,
+                      block);
+    return;
+  }
   float* output_data = output->mutable_data<float>();
   if ("Bilinear" == interpolate_type) {
     bilinear_interp(input_data,
@@ -47,6 +47,8 @@ void nearest_interp(const float* input_data,
                     const int out_w,
                     const bool align_corners);
 
+// The input and the output are in the layout blocked by 'block' if it's
+// positive, see nchwc.h.
 void interpolate(lite::Tensor* input,
                  lite::Tensor* out_size,
                  std::vector<const lite::Tensor*> list_new_size_tensor,
@@ -58,7 +60,8 @@ void interpolate(lite::Tensor* input,
                  int out_w,
                  const int align_mode,
                  const bool align_corners,
-                 const std::string interpolate_type);
+                 const std::string interpolate_type,
+                 const int block = 0);
 
 void interpolate_v2(lite::Tensor* input,
                     lite::Tensor* out_size,
@@ -71,7 +74,8 @@ void interpolate_v2(lite::Tensor* input,
                     int out_w,
                     const int align_mode,
                     const bool align_corners,
-                    const std::string interpolate_type);
+                    const std::string interpolate_type,
+                    const int block = 0);
 
 }  // namespace math
 }  // namespace x86
@@ -0,0 +1,863 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/nchwc.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The loops over the lanes of a block are unrolled by the block size of the
+// template, so the compiler vectorizes them.
+#define NCHWC_DISPATCH(block, func, ...)                 \
+  if (block == 8) {                                      \
+    func<8>(__VA_ARGS__);                                \
+  } else if (block == 16) {                              \
+    func<16>(__VA_ARGS__);                               \
+  } else {                                               \
+    LOG(FATAL) << "Unsupported channel block " << block; \
+  }
+
+int nchwc_block(DataLayoutType layout) {
+  switch (layout) {
+    case DATALAYOUT(kNCHW8c):
+      return 8;
+    case DATALAYOUT(kNCHW16c):
+      return 16;
+    default:
+      return 0;
+  }
+}
+
+int64_t nchwc_size(const DDim& dims, int block) {
+  if (dims.size() != 4 || block <= 0) return dims.production();
+  return dims[0] * ((dims[1] + block - 1) / block) * block * dims[2] * dims[3];
+}
+
+float* nchwc_mutable_data(Tensor* tensor, int block) {
+  return tensor->mutable_data<float>(
+      TARGET(kX86), nchwc_size(tensor->dims(), block) * sizeof(float));
+}
+
+template <int B>
+void nchw_to_nchwc_impl(
+    const float* din, float* dout, int num, int channel, int size) {
+  int blocks = (channel + B - 1) / B;
+  LITE_PARALLEL_BEGIN(nb, tid, num * blocks) {
+    int n = nb / blocks;
+    int cb = nb % blocks;
+    int valid = std::min(B, channel - cb * B);
+    const float* src = din + (n * channel + cb * B) * size;
+    float* dst = dout + nb * size * B;
+    for (int l = 0; l < valid; l++) {
+      for (int i = 0; i < size; i++) {
+        dst[i * B + l] = src[l * size + i];
+      }
+    }
+    for (int l = valid; l < B; l++) {
+      for (int i = 0; i < size; i++) {
+        dst[i * B + l] = 0.f;
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void nchw_to_nchwc(const float* din,
+                   float* dout,
+                   int num,
+                   int channel,
+                   int size,
+                   int block) {
+  NCHWC_DISPATCH(block, nchw_to_nchwc_impl, din, dout, num, channel, size);
+}
+
+template <int B>
+void nchwc_to_nchw_impl(
+    const float* din, float* dout, int num, int channel, int size) {
+  int blocks = (channel + B - 1) / B;
+  LITE_PARALLEL_BEGIN(nb, tid, num * blocks) {
+    int n = nb / blocks;
+    int cb = nb % blocks;
+    int valid = std::min(B, channel - cb * B);
+    const float* src = din + nb * size * B;
+    float* dst = dout + (n * channel + cb * B) * size;
+    for (int l = 0; l < valid; l++) {
+      for (int i = 0; i < size; i++) {
+        dst[l * size + i] = src[i * B + l];
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void nchwc_to_nchw(const float* din,
+                   float* dout,
+                   int num,
+                   int channel,
+                   int size,
+                   int block) {
+  NCHWC_DISPATCH(block, nchwc_to_nchw_impl, din, dout, num, channel, size);
+}
+
+void conv_nchwc_pack_weights(const float* weights,
+                             float* packed,
+                             int oc,
+                             int ic_per_group,
+                             int kernel_size,
+                             int block) {
+  int blocks = (oc + block - 1) / block;
+  for (int ob = 0; ob < blocks; ob++) {
+    for (int i = 0; i < ic_per_group; i++) {
+      for (int k = 0; k < kernel_size; k++) {
+        float* dst =
+            packed + ((ob * ic_per_group + i) * kernel_size + k) * block;
+        for (int l = 0; l < block; l++) {
+          int o = ob * block + l;
+          dst[l] = o < oc ? weights[(o * ic_per_group + i) * kernel_size + k]
+                          : 0.f;
+        }
+      }
+    }
+  }
+}
+
+template <int B>
+void conv_nchwc_impl(const float* din,
+                     float* dout,
+                     const float* weights,
+                     const float* bias,
+                     int num,
+                     int ic,
+                     int ih,
+                     int iw,
+                     int oc,
+                     int oh,
+                     int ow,
+                     int kh,
+                     int kw,
+                     int stride_h,
+                     int stride_w,
+                     int pad_h,
+                     int pad_w,
+                     int dila_h,
+                     int dila_w,
+                     int groups,
+                     const operators::ActivationParam& act_param) {
+  // The outputs of a row are computed by the tiles of kTile pixels, which
+  // reuse the weights loaded for the tile.
+  const int kTile = 4;
+  const int ic_blocks = (ic + B - 1) / B;
+  const int oc_blocks = (oc + B - 1) / B;
+  const int ic_per_group = ic / groups;
+  const int oc_per_group = oc / groups;
+  const int kernel_size = kh * kw;
+  const int in_block_size = ih * iw * B;
+  const int out_block_size = oh * ow * B;
+  // The lane l of the output block ob reads the lane l of the input block ob.
+  const bool depthwise = groups == ic && groups == oc;
+  // All of the lanes of an output block read the same input channels.
+  const bool uniform = groups == 1 || oc_per_group % B == 0;
+  LITE_PARALLEL_BEGIN(nb, tid, num * oc_blocks) {
+    int n = nb / oc_blocks;
+    int ob = nb % oc_blocks;
+    const float* w_block = weights + ob * ic_per_group * kernel_size * B;
+    const float* in_batch = din + n * ic_blocks * in_block_size;
+    float* out_block = dout + nb * out_block_size;
+    for (int oy = 0; oy < oh; oy++) {
+      for (int ox0 = 0; ox0 < ow; ox0 += kTile) {
+        int tile = std::min(kTile, ow - ox0);
+        float acc[kTile][B];
+        for (int t = 0; t < kTile; t++) {
+          for (int l = 0; l < B; l++) {
+            acc[t][l] = bias ? bias[ob * B + l] : 0.f;
+          }
+        }
+        for (int ky = 0; ky < kh; ky++) {
+          int iy = oy * stride_h - pad_h + ky * dila_h;
+          if (iy < 0 || iy >= ih) continue;
+          for (int kx = 0; kx < kw; kx++) {
+            int k = ky * kw + kx;
+            for (int t = 0; t < tile; t++) {
+              int ix = (ox0 + t) * stride_w - pad_w + kx * dila_w;
+              if (ix < 0 || ix >= iw) continue;
+              int pixel = (iy * iw + ix) * B;
+              if (depthwise) {
+                const float* in = in_batch + ob * in_block_size + pixel;
+                const float* w = w_block + k * B;
+                for (int l = 0; l < B; l++) {
+                  acc[t][l] += in[l] * w[l];
+                }
+              } else if (uniform) {
+                int c0 = ob * B / oc_per_group * ic_per_group;
+                for (int i = 0; i < ic_per_group; i++) {
+                  int c = c0 + i;
+                  float in = in_batch[(c / B) * in_block_size + pixel + c % B];
+                  const float* w = w_block + (i * kernel_size + k) * B;
+                  for (int l = 0; l < B; l++) {
+                    acc[t][l] += in * w[l];
+                  }
+                }
+              } else {
+                for (int l = 0; l < B && ob * B + l < oc; l++) {
+                  int c0 = (ob * B + l) / oc_per_group * ic_per_group;
+                  for (int i = 0; i < ic_per_group; i++) {
+                    int c = c0 + i;
+                    acc[t][l] +=
+                        in_batch[(c / B) * in_block_size + pixel + c % B] *
+                        w_block[(i * kernel_size + k) * B + l];
+                  }
+                }
+              }
+            }
+          }
+        }
+        float* out = out_block + (oy * ow + ox0) * B;
+        for (int t = 0; t < tile; t++) {
+          for (int l = 0; l < B; l++) {
+            out[t * B + l] = acc[t][l];
+          }
+        }
+      }
+    }
+    act_nchwc(out_block, out_block, out_block_size, act_param);
+  }
+  LITE_PARALLEL_END();
+}
+
+void conv_nchwc(const float* din,
+                float* dout,
+                const float* weights,
+                const float* bias,
+                int num,
+                int ic,
+                int ih,
+                int iw,
+                int oc,
+                int oh,
+                int ow,
+                int kh,
+                int kw,
+                int stride_h,
+                int stride_w,
+                int pad_h,
+                int pad_w,
+                int dila_h,
+                int dila_w,
+                int groups,
+                int block,
+                const operators::ActivationParam& act_param) {
+  NCHWC_DISPATCH(block,
+                 conv_nchwc_impl,
+                 din,
+                 dout,
+                 weights,
+                 bias,
+                 num,
+                 ic,
+                 ih,
+                 iw,
+                 oc,
+                 oh,
+                 ow,
+                 kh,
+                 kw,
+                 stride_h,
+                 stride_w,
+                 pad_h,
+                 pad_w,
+                 dila_h,
+                 dila_w,
+                 groups,
+                 act_param);
+}
+
+inline int AdaptStart(int index, int input_size, int output_size) {
+  return static_cast<int>(
+      floor(static_cast<double>(index * input_size) / output_size));
+}
+
+inline int AdaptEnd(int index, int input_size, int output_size) {
+  return static_cast<int>(
+      ceil(static_cast<double>((index + 1) * input_size) / output_size));
+}
+
+template <int B>
+void pool_nchwc_impl(const float* din,
+                     float* dout,
+                     int num,
+                     int channel,
+                     int ih,
+                     int iw,
+                     int oh,
+                     int ow,
+                     const std::vector<int>& ksize,
+                     const std::vector<int>& strides,
+                     const std::vector<int>& paddings,
+                     bool is_max,
+                     bool exclusive,
+                     bool adaptive) {
+  const int blocks = (channel + B - 1) / B;
+  LITE_PARALLEL_BEGIN(nb, tid, num * blocks) {
+    const float* in_block = din + nb * ih * iw * B;
+    float* out_block = dout + nb * oh * ow * B;
+    for (int ph = 0; ph < oh; ph++) {
+      for (int pw = 0; pw < ow; pw++) {
+        int hstart, hend, wstart, wend;
+        int pool_size = 1;
+        if (adaptive) {
+          hstart = AdaptStart(ph, ih, oh);
+          hend = AdaptEnd(ph, ih, oh);
+          wstart = AdaptStart(pw, iw, ow);
+          wend = AdaptEnd(pw, iw, ow);
+        } else {
+          hstart = ph * strides[0] - paddings[0];
+          wstart = pw * strides[1] - paddings[2];
+          hend = std::min(hstart + ksize[0], ih + paddings[1]);
+          wend = std::min(wstart + ksize[1], iw + paddings[3]);
+          pool_size = (hend - hstart) * (wend - wstart);
+          hstart = std::max(hstart, 0);
+          wstart = std::max(wstart, 0);
+          hend = std::min(hend, ih);
+          wend = std::min(wend, iw);
+        }
+        if (exclusive || adaptive) {
+          pool_size = (hend - hstart) * (wend - wstart);
+        }
+        float acc[B];
+        for (int l = 0; l < B; l++) {
+          acc[l] = is_max ? -FLT_MAX : 0.f;
+        }
+        for (int h = hstart; h < hend; h++) {
+          for (int w = wstart; w < wend; w++) {
+            const float* in = in_block + (h * iw + w) * B;
+            for (int l = 0; l < B; l++) {
+              acc[l] = is_max ? std::max(acc[l], in[l]) : acc[l] + in[l];
+            }
+          }
+        }
+        float* out = out_block + (ph * ow + pw) * B;
+        float scale = !is_max && pool_size > 0 ? 1.f / pool_size : 1.f;
+        for (int l = 0; l < B; l++) {
+          out[l] = acc[l] * scale;
+        }
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void pool_nchwc(const float* din,
+                float* dout,
+                int num,
+                int channel,
+                int ih,
+                int iw,
+                int oh,
+                int ow,
+                const std::vector<int>& ksize,
+                const std::vector<int>& strides,
+                const std::vector<int>& paddings,
+                const std::string& pooling_type,
+                bool exclusive,
+                bool adaptive,
+                int block) {
+  CHECK(pooling_type == "max" || pooling_type == "avg")
+      << "Unsupported pooling type " << pooling_type;
+  NCHWC_DISPATCH(block,
+                 pool_nchwc_impl,
+                 din,
+                 dout,
+                 num,
+                 channel,
+                 ih,
+                 iw,
+                 oh,
+                 ow,
+                 ksize,
+                 strides,
+                 paddings,
+                 pooling_type == "max",
+                 exclusive,
+                 adaptive);
+}
+
+void act_nchwc(const float* din,
+               float* dout,
+               int64_t size,
+               const operators::ActivationParam& act_param) {
+  switch (act_param.active_type) {
+    case lite_api::ActivationType::kIndentity:
+      if (dout != din) memcpy(dout, din, size * sizeof(float));
+      break;
+    case lite_api::ActivationType::kRelu:
+      for (int64_t i = 0; i < size; i++) {
+        dout[i] = std::max(din[i], 0.f);
+      }
+      break;
+    case lite_api::ActivationType::kRelu6: {
+      float coef = act_param.Relu_clipped_coef;
+      for (int64_t i = 0; i < size; i++) {
+        dout[i] = std::min(std::max(din[i], 0.f), coef);
+      }
+    } break;
+    case lite_api::ActivationType::kLeakyRelu: {
+      float alpha = act_param.Leaky_relu_alpha;
+      for (int64_t i = 0; i < size; i++) {
+        dout[i] = din[i] > 0.f ? din[i] : din[i] * alpha;
+      }
+    } break;
+    case lite_api::ActivationType::kSigmoid:
+      for (int64_t i = 0; i < size; i++) {
+        dout[i] = 1.f / (1.f + expf(-din[i]));
+      }
+      break;
+    case lite_api::ActivationType::kTanh:
+      for (int64_t i = 0; i < size; i++) {
+        dout[i] = tanhf(din[i]);
+      }
+      break;
+    case lite_api::ActivationType::kSwish: {
+      float beta = act_param.Swish_beta;
+      for (int64_t i = 0; i < size; i++) {
+        dout[i] = din[i] / (1.f + expf(-beta * din[i]));
+      }
+    } break;
+    case lite_api::ActivationType::kHardSwish: {
+      float threshold = act_param.hard_swish_threshold;
+      float scale = act_param.hard_swish_scale;
+      float offset = act_param.hard_swish_offset;
+      for (int64_t i = 0; i < size; i++) {
+        dout[i] = din[i] *
+                  std::min(std::max(din[i] + offset, 0.f), threshold) / scale;
+      }
+    } break;
+    case lite_api::ActivationType::kHardSigmoid: {
+      float slope = act_param.hard_sigmoid_slope;
+      float offset = act_param.hard_sigmoid_offset;
+      for (int64_t i = 0; i < size; i++) {
+        dout[i] = std::min(std::max(slope * din[i] + offset, 0.f), 1.f);
+      }
+    } break;
+    case lite_api::ActivationType::kAbs:
+      for (int64_t i = 0; i < size; i++) {
+        dout[i] = fabsf(din[i]);
+      }
+      break;
+    default:
+      LOG(FATAL) << "Unsupported activation in the blocked channel layout: "
+                 << static_cast<int>(act_param.active_type);
+  }
+}
+
+template <int B>
+void scale_bias_nchwc_impl(const float* din,
+                           float* dout,
+                           const float* scale,
+                           const float* bias,
+                           int num,
+                           int channel,
+                           int size) {
+  const int blocks = (channel + B - 1) / B;
+  LITE_PARALLEL_BEGIN(nb, tid, num * blocks) {
+    const float* s = scale + nb % blocks * B;
+    const float* b = bias + nb % blocks * B;
+    const float* in = din + nb * size * B;
+    float* out = dout + nb * size * B;
+    for (int i = 0; i < size; i++) {
+      for (int l = 0; l < B; l++) {
+        out[i * B + l] = in[i * B + l] * s[l] + b[l];
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void scale_bias_nchwc(const float* din,
+                      float* dout,
+                      const float* scale,
+                      const float* bias,
+                      int num,
+                      int channel,
+                      int size,
+                      int block) {
+  NCHWC_DISPATCH(block,
+                 scale_bias_nchwc_impl,
+                 din,
+                 dout,
+                 scale,
+                 bias,
+                 num,
+                 channel,
+                 size);
+}
+
+template <NCHWcEltwiseType Type>
+inline float EltwiseOp(float x, float y);
+template <>
+inline float EltwiseOp<NCHWcEltwiseType::kAdd>(float x, float y) {
+  return x + y;
+}
+template <>
+inline float EltwiseOp<NCHWcEltwiseType::kSub>(float x, float y) {
+  return x - y;
+}
+template <>
+inline float EltwiseOp<NCHWcEltwiseType::kMul>(float x, float y) {
+  return x * y;
+}
+template <>
+inline float EltwiseOp<NCHWcEltwiseType::kDiv>(float x, float y) {
+  return x / y;
+}
+template <>
+inline float EltwiseOp<NCHWcEltwiseType::kMax>(float x, float y) {
+  return std::max(x, y);
+}
+template <>
+inline float EltwiseOp<NCHWcEltwiseType::kMin>(float x, float y) {
+  return std::min(x, y);
+}
+
+// The dims of a tensor of 'dims' broadcast to 'rank' dims from 'axis'.
+std::vector<int64_t> ExpandDims(const DDim& dims, int rank, int axis) {
+  std::vector<int64_t> expanded(rank, 1);
+  for (size_t i = 0; i < dims.size(); i++) {
+    expanded[axis + i] = dims[i];
+  }
+  return expanded;
+}
+
+// The offset of the element at 'index' of the output in the storage of a
+// tensor of 'dims' broadcast from 'axis'.
+int64_t BroadcastOffset(const DDim& dims,
+                        int axis,
+                        const std::vector<int64_t>& index,
+                        int block) {
+  int rank = static_cast<int>(dims.size());
+  std::vector<int64_t> coord(rank);
+  for (int i = 0; i < rank; i++) {
+    coord[i] = dims[i] == 1 ? 0 : index[axis + i];
+  }
+  if (rank == 4) {
+    return nchwc_offset(dims, block, coord[0], coord[1], coord[2], coord[3]);
+  }
+  int64_t offset = 0;
+  for (int i = 0; i < rank; i++) {
+    offset = offset * dims[i] + coord[i];
+  }
+  return offset;
+}
+
+template <NCHWcEltwiseType Type>
+void elementwise_nchwc_impl(const Tensor* x,
+                            const Tensor* y,
+                            Tensor* out,
+                            int axis,
+                            int block) {
+  const auto& x_dims = x->dims();
+  const auto& y_dims = y->dims();
+  const auto& out_dims = out->dims();
+  const float* x_data = x->data<float>();
+  const float* y_data = y->data<float>();
+  float* out_data = nchwc_mutable_data(out, block);
+  int rank = static_cast<int>(out_dims.size());
+  int x_axis = static_cast<int>(x_dims.size()) == rank
+                   ? 0
+                   : (axis == -1 ? rank - x_dims.size() : axis);
+  int y_axis = static_cast<int>(y_dims.size()) == rank
+                   ? 0
+                   : (axis == -1 ? rank - y_dims.size() : axis);
+  if (x_dims == y_dims && x_dims == out_dims) {
+    int64_t size = nchwc_size(out_dims, block);
+    for (int64_t i = 0; i < size; i++) {
+      out_data[i] = EltwiseOp<Type>(x_data[i], y_data[i]);
+    }
+    return;
+  }
+  if (rank == 4 && x_dims == out_dims) {
+    auto y_expanded = ExpandDims(y_dims, rank, y_axis);
+    int64_t channel = out_dims[1];
+    if (y_expanded[0] == 1 && y_expanded[2] == 1 && y_expanded[3] == 1 &&
+        (y_expanded[1] == channel || y_expanded[1] == 1)) {
+      // y is a scalar or a vector of the channels, pad it to the blocks.
+      int64_t blocks = (channel + block - 1) / block;
+      std::vector<float> y_padded(blocks * block, y_data[0]);
+      if (y_expanded[1] == channel) {
+        memcpy(y_padded.data(), y_data, channel * sizeof(float));
+      }
+      int64_t size = out_dims[2] * out_dims[3] * block;
+      for (int64_t nb = 0; nb < out_dims[0] * blocks; nb++) {
+        const float* y_block = y_padded.data() + nb % blocks * block;
+        const float* x_block = x_data + nb * size;
+        float* out_block = out_data + nb * size;
+        for (int64_t i = 0; i < size; i++) {
+          out_block[i] = EltwiseOp<Type>(x_block[i], y_block[i % block]);
+        }
+      }
+      return;
+    }
+  }
+  // The general broadcast reads the elements one by one.
+  std::vector<int64_t> index(rank, 0);
+  int64_t count = out_dims.production();
+  for (int64_t i = 0; i < count; i++) {
+    int64_t out_offset = BroadcastOffset(out_dims, 0, index, block);
+    out_data[out_offset] = EltwiseOp<Type>(
+        x_data[BroadcastOffset(x_dims, x_axis, index, block)],
+        y_data[BroadcastOffset(y_dims, y_axis, index, block)]);
+    for (int d = rank - 1; d >= 0; d--) {
+      if (++index[d] < out_dims[d]) break;
+      index[d] = 0;
+    }
+  }
+}
+
+void elementwise_nchwc(const Tensor* x,
+                       const Tensor* y,
+                       Tensor* out,
+                       int axis,
+                       NCHWcEltwiseType type,
+                       int block) {
+  switch (type) {
+    case NCHWcEltwiseType::kAdd:
+      elementwise_nchwc_impl<NCHWcEltwiseType::kAdd>(x, y, out, axis, block);
+      break;
+    case NCHWcEltwiseType::kSub:
+      elementwise_nchwc_impl<NCHWcEltwiseType::kSub>(x, y, out, axis, block);
+      break;
+    case NCHWcEltwiseType::kMul:
+      elementwise_nchwc_impl<NCHWcEltwiseType::kMul>(x, y, out, axis, block);
+      break;
+    case NCHWcEltwiseType::kDiv:
+      elementwise_nchwc_impl<NCHWcEltwiseType::kDiv>(x, y, out, axis, block);
+      break;
+    case NCHWcEltwiseType::kMax:
+      elementwise_nchwc_impl<NCHWcEltwiseType::kMax>(x, y, out, axis, block);
+      break;
+    case NCHWcEltwiseType::kMin:
+      elementwise_nchwc_impl<NCHWcEltwiseType::kMin>(x, y, out, axis, block);
+      break;
+  }
+}
+
+void concat_nchwc(const std::vector<Tensor*>& inputs,
+                  Tensor* out,
+                  int axis,
+                  int block) {
+  const auto& out_dims = out->dims();
+  int rank = static_cast<int>(out_dims.size());
+  float* out_data = nchwc_mutable_data(out, block);
+  // Concatenating the channels of the inputs aligned to the blocks copies the
+  // blocks.
+  bool aligned = rank == 4 && axis == 1;
+  for (size_t i = 0; i + 1 < inputs.size() && aligned; i++) {
+    aligned = inputs[i]->dims()[1] % block == 0;
+  }
+  if (aligned) {
+    int64_t size = out_dims[2] * out_dims[3] * block;
+    int64_t out_blocks = (out_dims[1] + block - 1) / block;
+    int64_t offset = 0;
+    for (auto* input : inputs) {
+      int64_t blocks = (input->dims()[1] + block - 1) / block;
+      const float* in_data = input->data<float>();
+      for (int64_t n = 0; n < out_dims[0]; n++) {
+        memcpy(out_data + (n * out_blocks + offset) * size,
+               in_data + n * blocks * size,
+               blocks * size * sizeof(float));
+      }
+      offset += blocks;
+    }
+    return;
+  }
+  int64_t offset = 0;
+  for (auto* input : inputs) {
+    const auto& in_dims = input->dims();
+    const float* in_data = input->data<float>();
+    std::vector<int64_t> index(rank, 0);
+    int64_t count = in_dims.production();
+    for (int64_t i = 0; i < count; i++) {
+      int64_t in_offset = BroadcastOffset(in_dims, 0, index, block);
+      index[axis] += offset;
+      out_data[BroadcastOffset(out_dims, 0, index, block)] = in_data[in_offset];
+      index[axis] -= offset;
+      for (int d = rank - 1; d >= 0; d--) {
+        if (++index[d] < in_dims[d]) break;
+        index[d] = 0;
+      }
+    }
+    offset += in_dims[axis];
+  }
+}
+
+template <int B>
+void bilinear_interp_nchwc_impl(const float* din,
+                                float* dout,
+                                float ratio_h,
+                                float ratio_w,
+                                int num,
+                                int channel,
+                                int ih,
+                                int iw,
+                                int oh,
+                                int ow,
+                                bool align_corners,
+                                int align_mode) {
+  // The source of a destination index, the neighbors and the weight of the
+  // second one.
+  auto source = [&](int dst, float ratio, int in_size, int* i0, int* i1) {
+    float src = ratio * dst;
+    if (!align_corners && align_mode == 0) {
+      src = std::max(ratio * (dst + 0.5f) - 0.5f, 0.f);
+    }
+    int index = static_cast<int>(src);
+    *i0 = std::min(index, in_size - 1);
+    *i1 = std::min(*i0 + 1, in_size - 1);
+    return src - index;
+  };
+  std::vector<int> x0(ow), x1(ow), y0(oh), y1(oh);
+  std::vector<float> lx(ow), ly(oh);
+  for (int ox = 0; ox < ow; ox++) {
+    lx[ox] = source(ox, ratio_w, iw, &x0[ox], &x1[ox]);
+  }
+  for (int oy = 0; oy < oh; oy++) {
+    ly[oy] = source(oy, ratio_h, ih, &y0[oy], &y1[oy]);
+  }
+  const int blocks = (channel + B - 1) / B;
+  LITE_PARALLEL_BEGIN(nb, tid, num * blocks) {
+    const float* in_block = din + nb * ih * iw * B;
+    float* out_block = dout + nb * oh * ow * B;
+    for (int oy = 0; oy < oh; oy++) {
+      const float* row0 = in_block + y0[oy] * iw * B;
+      const float* row1 = in_block + y1[oy] * iw * B;
+      float wy = ly[oy];
+      for (int ox = 0; ox < ow; ox++) {
+        const float* p00 = row0 + x0[ox] * B;
+        const float* p01 = row0 + x1[ox] * B;
+        const float* p10 = row1 + x0[ox] * B;
+        const float* p11 = row1 + x1[ox] * B;
+        float wx = lx[ox];
+        float* out = out_block + (oy * ow + ox) * B;
+        for (int l = 0; l < B; l++) {
+          float top = p00[l] + (p01[l] - p00[l]) * wx;
+          float bottom = p10[l] + (p11[l] - p10[l]) * wx;
+          out[l] = top + (bottom - top) * wy;
+        }
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void bilinear_interp_nchwc(const float* din,
+                           float* dout,
+                           float ratio_h,
+                           float ratio_w,
+                           int num,
+                           int channel,
+                           int ih,
+                           int iw,
+                           int oh,
+                           int ow,
+                           bool align_corners,
+                           int align_mode,
+                           int block) {
+  NCHWC_DISPATCH(block,
+                 bilinear_interp_nchwc_impl,
+                 din,
+                 dout,
+                 ratio_h,
+                 ratio_w,
+                 num,
+                 channel,
+                 ih,
+                 iw,
+                 oh,
+                 ow,
+                 align_corners,
+                 align_mode);
+}
+
+template <int B>
+void nearest_interp_nchwc_impl(const float* din,
+                               float* dout,
+                               float ratio_h,
+                               float ratio_w,
+                               int num,
+                               int channel,
+                               int ih,
+                               int iw,
+                               int oh,
+                               int ow,
+                               bool align_corners) {
+  float round = align_corners ? 0.5f : 0.f;
+  std::vector<int> xs(ow), ys(oh);
+  for (int ox = 0; ox < ow; ox++) {
+    xs[ox] = std::min(static_cast<int>(ratio_w * ox + round), iw - 1);
+  }
+  for (int oy = 0; oy < oh; oy++) {
+    ys[oy] = std::min(static_cast<int>(ratio_h * oy + round), ih - 1);
+  }
+  const int blocks = (channel + B - 1) / B;
+  LITE_PARALLEL_BEGIN(nb, tid, num * blocks) {
+    const float* in_block = din + nb * ih * iw * B;
+    float* out = dout + nb * oh * ow * B;
+    for (int oy = 0; oy < oh; oy++) {
+      const float* row = in_block + ys[oy] * iw * B;
+      for (int ox = 0; ox < ow; ox++) {
+        memcpy(out, row + xs[ox] * B, B * sizeof(float));
+        out += B;
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void nearest_interp_nchwc(const float* din,
+                          float* dout,
+                          float ratio_h,
+                          float ratio_w,
+                          int num,
+                          int channel,
+                          int ih,
+                          int iw,
+                          int oh,
+                          int ow,
+                          bool align_corners,
+                          int block) {
+  NCHWC_DISPATCH(block,
+                 nearest_interp_nchwc_impl,
+                 din,
+                 dout,
+                 ratio_h,
+                 ratio_w,
+                 num,
+                 channel,
+                 ih,
+                 iw,
+                 oh,
+                 ow,
+                 align_corners);
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,193 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "lite/core/tensor.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/*
+ * The blocked channel layouts NCHW8c and NCHW16c.
+ *
+ * The channels of a 4-D tensor are split into the blocks of 'block' channels
+ * and stored as [N, C / block, H, W, block], the last block is padded to
+ * 'block' channels. The tensor keeps its logical NCHW dims, only its storage
+ * is blocked, so the shapes inferred by the ops stay the same. The padded
+ * channels are never read for the results. The tensors of the other ranks,
+ * e.g. the 1-D bias of elementwise_add, are stored as they are.
+ */
+
+// The channels of a block of 'layout', 0 if it's not a blocked layout.
+int nchwc_block(DataLayoutType layout);
+
+// The number of the floats stored for the tensor of 'dims' in the layout
+// blocked by 'block'.
+int64_t nchwc_size(const DDim& dims, int block);
+
+// Allocate the storage of 'tensor' in the layout blocked by 'block'.
+float* nchwc_mutable_data(Tensor* tensor, int block);
+
+// The offset of the element (n, c, h, w) of the 4-D tensor of 'dims' in the
+// layout blocked by 'block'.
+inline int64_t nchwc_offset(
+    const DDim& dims, int block, int64_t n, int64_t c, int64_t h, int64_t w) {
+  int64_t blocks = (dims[1] + block - 1) / block;
+  return (((n * blocks + c / block) * dims[2] + h) * dims[3] + w) * block +
+         c % block;
+}
+
+void nchw_to_nchwc(const float* din,
+                   float* dout,
+                   int num,
+                   int channel,
+                   int size,
+                   int block);
+
+void nchwc_to_nchw(const float* din,
+                   float* dout,
+                   int num,
+                   int channel,
+                   int size,
+                   int block);
+
+// Pack the weights [oc, ic / groups, kh, kw] of conv2d to
+// [oc / block, ic / groups, kh, kw, block], the padded output channels are
+// filled by zeros. 'kernel_size' is kh * kw.
+void conv_nchwc_pack_weights(const float* weights,
+                             float* packed,
+                             int oc,
+                             int ic_per_group,
+                             int kernel_size,
+                             int block);
+
+// conv2d on the input and the output in the layout blocked by 'block', the
+// weights are packed by conv_nchwc_pack_weights, the bias is padded to the
+// blocks or nullptr. The fused relu, relu6, leaky_relu and hard_swish are
+// applied on the output. It vectorizes the lanes of a block, which suits the
+// depthwise conv, the others are faster by the GEMM or the direct conv, see
+// Conv2dNCHWcCompute.
+void conv_nchwc(const float* din,
+                float* dout,
+                const float* weights,
+                const float* bias,
+                int num,
+                int ic,
+                int ih,
+                int iw,
+                int oc,
+                int oh,
+                int ow,
+                int kh,
+                int kw,
+                int stride_h,
+                int stride_w,
+                int pad_h,
+                int pad_w,
+                int dila_h,
+                int dila_w,
+                int groups,
+                int block,
+                const operators::ActivationParam& act_param);
+
+// pool2d of 'pooling_type' max or avg, 'paddings' are {top, bottom, left,
+// right}.
+void pool_nchwc(const float* din,
+                float* dout,
+                int num,
+                int channel,
+                int ih,
+                int iw,
+                int oh,
+                int ow,
+                const std::vector<int>& ksize,
+                const std::vector<int>& strides,
+                const std::vector<int>& paddings,
+                const std::string& pooling_type,
+                bool exclusive,
+                bool adaptive,
+                int block);
+
+// Apply the activation on the 'size' floats of 'din', 'dout' may be 'din'.
+void act_nchwc(const float* din,
+               float* dout,
+               int64_t size,
+               const operators::ActivationParam& act_param);
+
+// out = scale[c] * x + bias[c] of the 4-D tensors, 'scale' and 'bias' are
+// padded to the blocks.
+void scale_bias_nchwc(const float* din,
+                      float* dout,
+                      const float* scale,
+                      const float* bias,
+                      int num,
+                      int channel,
+                      int size,
+                      int block);
+
+enum class NCHWcEltwiseType { kAdd, kSub, kMul, kDiv, kMax, kMin };
+
+// The elementwise op of x and y broadcast along 'axis', the tensors of 4 dims
+// are in the layout blocked by 'block'.
+void elementwise_nchwc(const Tensor* x,
+                       const Tensor* y,
+                       Tensor* out,
+                       int axis,
+                       NCHWcEltwiseType type,
+                       int block);
+
+// Concatenate the tensors along 'axis', the tensors of 4 dims are in the
+// layout blocked by 'block'.
+void concat_nchwc(const std::vector<Tensor*>& inputs,
+                  Tensor* out,
+                  int axis,
+                  int block);
+
+void bilinear_interp_nchwc(const float* din,
+                           float* dout,
+                           float ratio_h,
+                           float ratio_w,
+                           int num,
+                           int channel,
+                           int ih,
+                           int iw,
+                           int oh,
+                           int ow,
+                           bool align_corners,
+                           int align_mode,
+                           int block);
+
+void nearest_interp_nchwc(const float* din,
+                          float* dout,
+                          float ratio_h,
+                          float ratio_w,
+                          int num,
+                          int channel,
+                          int ih,
+                          int iw,
+                          int oh,
+                          int ow,
+                          bool align_corners,
+                          int block);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
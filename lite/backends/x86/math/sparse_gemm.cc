@@ -0,0 +1,302 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/sparse_gemm.h"
+#include <algorithm>
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/log/cp_logging.h"
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+#ifdef __AVX__
+inline __m256 fmadd256(__m256 a, __m256 b, __m256 c) {
+#ifdef __FMA__
+  return _mm256_fmadd_ps(a, b, c);
+#else
+  return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+#endif
+
+#ifdef __SSE__
+inline __m128 fmadd128(__m128 a, __m128 b, __m128 c) {
+#ifdef __FMA__
+  return _mm_fmadd_ps(a, b, c);
+#else
+  return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+inline float hsum128(__m128 v) {
+  __m128 shuf = _mm_movehl_ps(v, v);
+  __m128 sum = _mm_add_ps(v, shuf);
+  shuf = _mm_shuffle_ps(sum, sum, 0x55);
+  sum = _mm_add_ss(sum, shuf);
+  return _mm_cvtss_f32(sum);
+}
+#endif
+
+#if defined(__AVX__) && defined(__AVX2__)
+inline float hsum256(__m256 v) {
+  __m128 lo = _mm256_castps256_ps128(v);
+  __m128 hi = _mm256_extractf128_ps(v, 1);
+  return hsum128(_mm_add_ps(lo, hi));
+}
+#endif
+
+// C[rows, n] = A[rows, cols] * B[cols, n], each block row of A produces BH rows
+// of C, which are accumulated in registers over 8 columns of C at a time.
+template <int BH, int BW>
+void sparse_dense_gemm_impl(const BlockSparseMatrix& a,
+                            const float* b,
+                            int n,
+                            float* c) {
+  int block_rows = static_cast<int>(a.row_offsets.size()) - 1;
+  const int* offsets = a.row_offsets.data();
+  const int* indices = a.col_indices.data();
+  const float* values = a.values.data();
+  LITE_PARALLEL_BEGIN(br, tid, block_rows) {
+    int r0 = br * BH;
+    int valid_h = std::min(BH, a.rows - r0);
+    int start = offsets[br];
+    int end = offsets[br + 1];
+    int x = 0;
+#ifdef __AVX__
+    for (; x + 8 <= n; x += 8) {
+      __m256 acc[BH];
+      for (int i = 0; i < BH; ++i) {
+        acc[i] = _mm256_setzero_ps();
+      }
+      for (int j = start; j < end; ++j) {
+        const float* v = values + j * BH * BW;
+        const float* bp = b + indices[j] * n + x;
+        for (int k = 0; k < BW; ++k) {
+          __m256 vb = _mm256_loadu_ps(bp + k * n);
+          for (int i = 0; i < BH; ++i) {
+            acc[i] = fmadd256(_mm256_set1_ps(v[i * BW + k]), vb, acc[i]);
+          }
+        }
+      }
+      for (int i = 0; i < valid_h; ++i) {
+        _mm256_storeu_ps(c + (r0 + i) * n + x, acc[i]);
+      }
+    }
+#endif
+    for (; x < n; ++x) {
+      float acc[BH] = {0.f};
+      for (int j = start; j < end; ++j) {
+        const float* v = values + j * BH * BW;
+        const float* bp = b + indices[j] * n + x;
+        for (int k = 0; k < BW; ++k) {
+          for (int i = 0; i < BH; ++i) {
+            acc[i] += v[i * BW + k] * bp[k * n];
+          }
+        }
+      }
+      for (int i = 0; i < valid_h; ++i) {
+        c[(r0 + i) * n + x] = acc[i];
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+// C[m, rows] = B[m, cols] * A^T + bias, each block row of A is kept in cache
+// while it's multiplied with all of the m rows of B.
+template <int BH, int BW>
+void dense_sparse_gemm_impl(const float* b,
+                            int m,
+                            const BlockSparseMatrix& a,
+                            const float* bias,
+                            bool with_relu,
+                            float* c) {
+  int block_rows = static_cast<int>(a.row_offsets.size()) - 1;
+  int rows = a.rows;
+  int cols = a.cols;
+  const int* offsets = a.row_offsets.data();
+  const int* indices = a.col_indices.data();
+  const float* values = a.values.data();
+  LITE_PARALLEL_BEGIN(br, tid, block_rows) {
+    int r0 = br * BH;
+    int valid_h = std::min(BH, rows - r0);
+    int start = offsets[br];
+    int end = offsets[br + 1];
+    for (int y = 0; y < m; ++y) {
+      const float* b_row = b + y * cols;
+      float acc[BH] = {0.f};
+      int j = start;
+#ifdef __SSE__
+      if (BW == 4) {
+        __m128 vacc[BH];
+        for (int i = 0; i < BH; ++i) {
+          vacc[i] = _mm_setzero_ps();
+        }
+        for (; j < end; ++j) {
+          const float* v = values + j * BH * BW;
+          __m128 vb = _mm_loadu_ps(b_row + indices[j]);
+          for (int i = 0; i < BH; ++i) {
+            vacc[i] = fmadd128(_mm_loadu_ps(v + i * BW), vb, vacc[i]);
+          }
+        }
+        for (int i = 0; i < BH; ++i) {
+          acc[i] = hsum128(vacc[i]);
+        }
+      }
+#endif
+#if defined(__AVX__) && defined(__AVX2__)
+      if (BH == 1 && BW == 1) {
+        __m256 vacc = _mm256_setzero_ps();
+        for (; j + 8 <= end; j += 8) {
+          __m256i vidx = _mm256_loadu_si256(
+              reinterpret_cast<const __m256i*>(indices + j));
+          __m256 vb = _mm256_i32gather_ps(b_row, vidx, 4);
+          vacc = fmadd256(_mm256_loadu_ps(values + j), vb, vacc);
+        }
+        acc[0] = hsum256(vacc);
+      }
+#endif
+      for (; j < end; ++j) {
+        const float* v = values + j * BH * BW;
+        const float* bp = b_row + indices[j];
+        for (int i = 0; i < BH; ++i) {
+          for (int k = 0; k < BW; ++k) {
+            acc[i] += v[i * BW + k] * bp[k];
+          }
+        }
+      }
+      float* c_row = c + y * rows + r0;
+      for (int i = 0; i < valid_h; ++i) {
+        float out = bias ? acc[i] + bias[r0 + i] : acc[i];
+        c_row[i] = with_relu ? std::max(out, 0.f) : out;
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace
+
+SparseBlockType SparseBlockTypeFromStr(const std::string& type) {
+  if (type == "unstructured") {
+    return SparseBlockType::kUnstructured;
+  } else if (type == "1x4") {
+    return SparseBlockType::kBlock1x4;
+  } else if (type == "4x4") {
+    return SparseBlockType::kBlock4x4;
+  }
+  return SparseBlockType::kNone;
+}
+
+void PackBlockSparseMatrix(const float* dense,
+                           int rows,
+                           int cols,
+                           bool transposed,
+                           SparseBlockType type,
+                           BlockSparseMatrix* sparse) {
+  CHECK(dense);
+  CHECK(sparse);
+  int block_h = type == SparseBlockType::kBlock4x4 ? 4 : 1;
+  int block_w = type == SparseBlockType::kBlock1x4 ||
+                        type == SparseBlockType::kBlock4x4
+                    ? 4
+                    : 1;
+  // The blocks can't be shifted left if there are less columns than the
+  // block width, fall back to the unstructured format.
+  if (cols < block_w) {
+    block_h = 1;
+    block_w = 1;
+  }
+  auto at = [&](int r, int col) {
+    return transposed ? dense[col * rows + r] : dense[r * cols + col];
+  };
+
+  sparse->rows = rows;
+  sparse->cols = cols;
+  sparse->block_h = block_h;
+  sparse->block_w = block_w;
+  sparse->row_offsets.clear();
+  sparse->col_indices.clear();
+  sparse->values.clear();
+  sparse->row_offsets.push_back(0);
+  std::vector<float> block(block_h * block_w);
+  for (int r0 = 0; r0 < rows; r0 += block_h) {
+    for (int c0 = 0; c0 < cols; c0 += block_w) {
+      // The tailing block is shifted left, the columns which are already
+      // covered by the previous block are zeroed.
+      int col = std::min(c0, cols - block_w);
+      bool is_zero = true;
+      for (int i = 0; i < block_h; ++i) {
+        for (int k = 0; k < block_w; ++k) {
+          float v = 0.f;
+          if (r0 + i < rows && col + k >= c0) {
+            v = at(r0 + i, col + k);
+          }
+          block[i * block_w + k] = v;
+          is_zero = is_zero && v == 0.f;
+        }
+      }
+      if (is_zero) continue;
+      sparse->col_indices.push_back(col);
+      sparse->values.insert(sparse->values.end(), block.begin(), block.end());
+    }
+    sparse->row_offsets.push_back(sparse->num_blocks());
+  }
+}
+
+void SparseDenseGemm(const BlockSparseMatrix& a,
+                     const float* b,
+                     int n,
+                     float* c) {
+  if (a.block_h == 4 && a.block_w == 4) {
+    sparse_dense_gemm_impl<4, 4>(a, b, n, c);
+  } else if (a.block_h == 1 && a.block_w == 4) {
+    sparse_dense_gemm_impl<1, 4>(a, b, n, c);
+  } else {
+    CHECK(a.block_h == 1 && a.block_w == 1);
+    sparse_dense_gemm_impl<1, 1>(a, b, n, c);
+  }
+}
+
+void DenseSparseGemm(const float* b,
+                     int m,
+                     const BlockSparseMatrix& a,
+                     const float* bias,
+                     bool with_relu,
+                     float* c) {
+  if (a.block_h == 4 && a.block_w == 4) {
+    dense_sparse_gemm_impl<4, 4>(b, m, a, bias, with_relu, c);
+  } else if (a.block_h == 1 && a.block_w == 4) {
+    dense_sparse_gemm_impl<1, 4>(b, m, a, bias, with_relu, c);
+  } else {
+    CHECK(a.block_h == 1 && a.block_w == 1);
+    dense_sparse_gemm_impl<1, 1>(b, m, a, bias, with_relu, c);
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,87 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The block shapes of the sparse weights, their names are the values of the
+// 'sparse_weight_type' attribute set by x86_sparse_weight_detect_pass.
+enum class SparseBlockType {
+  kNone = 0,
+  kUnstructured,  // "unstructured", 1x1 blocks
+  kBlock1x4,      // "1x4", 1 row x 4 columns blocks
+  kBlock4x4,      // "4x4", 4 rows x 4 columns blocks
+};
+
+SparseBlockType SparseBlockTypeFromStr(const std::string& type);
+
+/*
+ * A row-major [rows, cols] matrix stored in the block compressed sparse row
+ * format, only the blocks which have at least one non-zero are kept.
+ * - row_offsets[i] ~ row_offsets[i + 1] are the blocks of the i-th block row.
+ * - col_indices[j] is the first column of the j-th block, a block never
+ *   exceeds the last column, the tailing blocks are shifted left instead.
+ * - values[j * block_h * block_w ~ (j + 1) * block_h * block_w] are the
+ *   row-major values of the j-th block, zeros are padded if the block is
+ *   partially out of the rows.
+ */
+struct BlockSparseMatrix {
+  int rows{0};
+  int cols{0};
+  int block_h{1};
+  int block_w{1};
+  std::vector<int> row_offsets;
+  std::vector<int> col_indices;
+  std::vector<float> values;
+
+  int num_blocks() const { return static_cast<int>(col_indices.size()); }
+};
+
+// Pack a dense matrix into the block compressed sparse row format, if
+// 'transposed' is true, 'dense' is a row-major [cols, rows] matrix, such as
+// the weights of fc and mul, and it's transposed while packing.
+void PackBlockSparseMatrix(const float* dense,
+                           int rows,
+                           int cols,
+                           bool transposed,
+                           SparseBlockType type,
+                           BlockSparseMatrix* sparse);
+
+// C[rows, n] = A[rows, cols] * B[cols, n], A is sparse, B and C are dense, it's
+// used by conv1x1, where A is the filter and B is the input feature map.
+void SparseDenseGemm(const BlockSparseMatrix& a,
+                     const float* b,
+                     int n,
+                     float* c);
+
+// C[m, rows] = B[m, cols] * A^T + bias, A is sparse, B and C are dense, it's
+// used by fc and mul, where A is the transposed weights and B is the input.
+void DenseSparseGemm(const float* b,
+                     int m,
+                     const BlockSparseMatrix& a,
+                     const float* bias,
+                     bool with_relu,
+                     float* c);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
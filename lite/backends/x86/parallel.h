@@ -36,6 +36,20 @@ static void SetNumThreads(int num_threads) {
 #endif
 }
 
+// Set the threads of MKL and OpenMP on the calling thread only, the MKL
+// threads take precedence over the global ones of SetNumThreads. The MKL
+// threads of the thread fall back to the global ones if 'num_threads' is 0.
+static void SetNumThreadsLocal(int num_threads) {
+#ifdef PADDLE_WITH_MKLML
+#ifdef LITE_WITH_STATIC_MKL
+  MKL_Set_Num_Threads_Local(num_threads);
+#else
+  x86::MKL_Set_Num_Threads_Local(num_threads);
+#endif
+  if (num_threads > 0) omp_set_num_threads(num_threads);
+#endif
+}
+
 static inline int64_t GetMaxThreads() {
   int64_t num_threads = 1;
 #ifdef PADDLE_WITH_MKLML
@@ -0,0 +1,129 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/autotune.h"
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include "lite/utils/log/cp_logging.h"
+#ifdef __APPLE__
+#include <sys/sysctl.h>
+#endif
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+std::string Trim(const std::string& str) {
+  size_t begin = str.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos) return "";
+  size_t end = str.find_last_not_of(" \t\r\n");
+  return str.substr(begin, end - begin + 1);
+}
+
+// The value of a line 'key : value' of /proc/cpuinfo.
+std::string CpuInfoValue(const char* line) {
+  const char* colon = strchr(line, ':');
+  return colon ? Trim(colon + 1) : "";
+}
+
+std::string DetectCpuModelName() {
+#ifdef __APPLE__
+  char brand[256];
+  size_t size = sizeof(brand);
+  if (sysctlbyname("machdep.cpu.brand_string", brand, &size, nullptr, 0) ==
+      0) {
+    return Trim(std::string(brand, strnlen(brand, size)));
+  }
+  return "unknown";
+#else
+  FILE* fp = fopen("/proc/cpuinfo", "rb");
+  if (!fp) return "unknown";
+  // The x86 CPUs are identified by the model name, the ARM SoCs by the
+  // hardware and the parts of the big.LITTLE cores.
+  std::string model_name;
+  std::string hardware;
+  std::set<std::string> parts;
+  char line[1024];
+  while (fgets(line, sizeof(line), fp)) {
+    if (strncmp(line, "model name", 10) == 0 && model_name.empty()) {
+      model_name = CpuInfoValue(line);
+    } else if (strncmp(line, "Hardware", 8) == 0) {
+      hardware = CpuInfoValue(line);
+    } else if (strncmp(line, "CPU part", 8) == 0) {
+      parts.insert(CpuInfoValue(line));
+    }
+  }
+  fclose(fp);
+  std::string name = hardware.empty() ? model_name : hardware;
+  for (auto& part : parts) {
+    name += (name.empty() ? "" : " ") + part;
+  }
+  return name.empty() ? "unknown" : name;
+#endif
+}
+
+}  // namespace
+
+const std::string& CpuModelName() {
+  static const std::string name = DetectCpuModelName();
+  return name;
+}
+
+std::string SelectAlgo(
+    const std::vector<std::string>& algos,
+    const std::string& heuristic,
+    const std::string& recorded_algo,
+    const std::string& recorded_cpu,
+    bool autotune,
+    const std::function<double(const std::string&)>& measure) {
+  CHECK(!algos.empty());
+  if (!recorded_algo.empty() && recorded_cpu == CpuModelName() &&
+      std::find(algos.begin(), algos.end(), recorded_algo) != algos.end()) {
+    return recorded_algo;
+  }
+  if (!autotune || algos.size() == 1) return heuristic;
+  std::string best_algo = heuristic;
+  double best_ms = -1;
+  for (auto& algo : algos) {
+    double ms = measure(algo);
+    VLOG(3) << "autotune " << algo << ": " << ms << " ms";
+    if (best_ms < 0 || ms < best_ms) {
+      best_ms = ms;
+      best_algo = algo;
+    }
+  }
+  return best_algo;
+}
+
+double MeasureMs(const std::function<void()>& run, int repeats) {
+  run();
+  std::vector<double> times;
+  for (int i = 0; i < repeats; i++) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    auto end = std::chrono::steady_clock::now();
+    times.push_back(
+        std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  std::nth_element(
+      times.begin(), times.begin() + times.size() / 2, times.end());
+  return times[times.size() / 2];
+}
+
+}  // namespace lite
+}  // namespace paddle
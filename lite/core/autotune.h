@@ -0,0 +1,56 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+/*
+ * The measurement based selection of the algorithms of the kernels, e.g. the
+ * winograd, direct, depthwise or gemm implementations of conv2d.
+ *
+ * With autotuning, a kernel times each of its eligible algorithms on the
+ * tensors of the first run and keeps the fastest one. The winner is saved
+ * into the op desc of the optimized model along with the CPU model, so the
+ * later loads on the same CPU model reuse it without tuning, and the other
+ * CPUs fall back to the heuristics of the kernel.
+ */
+static const char kAutotuneAlgoAttr[] = "autotune_algo";
+static const char kAutotuneCpuAttr[] = "autotune_cpu";
+
+// The model of the CPU, e.g. the model name of x86 or the hardware and the
+// parts of the cores of ARM, "unknown" if it can't be detected.
+const std::string& CpuModelName();
+
+// Pick an algorithm among the eligible 'algos': the recorded one if it was
+// tuned on the CPU of the same model, the fastest one timed by 'measure' (in
+// milliseconds) if 'autotune' is set, otherwise 'heuristic'.
+std::string SelectAlgo(
+    const std::vector<std::string>& algos,
+    const std::string& heuristic,
+    const std::string& recorded_algo,
+    const std::string& recorded_cpu,
+    bool autotune,
+    const std::function<double(const std::string&)>& measure);
+
+// The median time in milliseconds of 'repeats' runs of 'run' after a warmup.
+double MeasureMs(const std::function<void()>& run, int repeats = 5);
+
+}  // namespace lite
+}  // namespace paddle
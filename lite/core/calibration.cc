@@ -0,0 +1,169 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/calibration.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace paddle {
+namespace lite {
+
+bool ParseCalibrationAlgo(const std::string& name, CalibrationAlgo* algo) {
+  if (name == "abs_max") {
+    *algo = CalibrationAlgo::kAbsMax;
+  } else if (name == "kl") {
+    *algo = CalibrationAlgo::kKL;
+  } else if (name == "percentile") {
+    *algo = CalibrationAlgo::kPercentile;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void Calibrator::CollectAbsMax(const std::string& name,
+                               const float* data,
+                               int64_t size) {
+  auto& stats = stats_[name];
+  for (int64_t i = 0; i < size; i++) {
+    stats.abs_max = std::max(stats.abs_max, std::fabs(data[i]));
+  }
+}
+
+void Calibrator::CollectHistogram(const std::string& name,
+                                  const float* data,
+                                  int64_t size) {
+  auto iter = stats_.find(name);
+  if (iter == stats_.end() || iter->second.abs_max <= 0.f) return;
+  auto& stats = iter->second;
+  if (stats.histogram.empty()) {
+    stats.histogram.resize(kHistogramBins, 0.f);
+  }
+  const float bin_width = stats.abs_max / kHistogramBins;
+  for (int64_t i = 0; i < size; i++) {
+    int bin = static_cast<int>(std::fabs(data[i]) / bin_width);
+    stats.histogram[std::min(bin, kHistogramBins - 1)] += 1.f;
+  }
+}
+
+std::map<std::string, float> Calibrator::ComputeThresholds() const {
+  std::map<std::string, float> thresholds;
+  for (auto& item : stats_) {
+    const auto& stats = item.second;
+    if (stats.abs_max <= 0.f) continue;
+    float threshold = stats.abs_max;
+    if (NeedHistogram() && !stats.histogram.empty()) {
+      const float bin_width = stats.abs_max / kHistogramBins;
+      threshold =
+          algo_ == CalibrationAlgo::kKL
+              ? KLThreshold(stats.histogram, bin_width)
+              : PercentileThreshold(stats.histogram, bin_width, percentile_);
+    }
+    thresholds[item.first] = std::min(threshold, stats.abs_max);
+  }
+  return thresholds;
+}
+
+float KLThreshold(const std::vector<float>& histogram,
+                  float bin_width,
+                  int levels) {
+  const int bins = static_cast<int>(histogram.size());
+  if (bins <= levels) return bins * bin_width;
+  const float eps = 1e-10f;
+  int best_bins = bins;
+  double min_kl = std::numeric_limits<double>::max();
+  std::vector<double> p(bins), q(bins);
+  for (int i = levels; i <= bins; i++) {
+    // The reference distribution clipped at the i-th bin.
+    std::copy(histogram.begin(), histogram.begin() + i, p.begin());
+    p[i - 1] += std::accumulate(histogram.begin() + i, histogram.end(), 0.0);
+    // The candidate distribution: merge the i bins into 'levels' levels, and
+    // expand them back over the nonzero bins.
+    std::fill(q.begin(), q.begin() + i, 0.0);
+    for (int j = 0; j < levels; j++) {
+      const int start = j * i / levels;
+      const int end = (j + 1) * i / levels;
+      double sum = 0.0;
+      int nonzeros = 0;
+      for (int k = start; k < end; k++) {
+        sum += histogram[k];
+        nonzeros += histogram[k] != 0.f;
+      }
+      if (nonzeros == 0) continue;
+      for (int k = start; k < end; k++) {
+        if (histogram[k] != 0.f) q[k] = sum / nonzeros;
+      }
+    }
+    const double p_sum = std::accumulate(p.begin(), p.begin() + i, 0.0);
+    const double q_sum = std::accumulate(q.begin(), q.begin() + i, 0.0);
+    if (p_sum <= 0.0 || q_sum <= 0.0) continue;
+    double kl = 0.0;
+    for (int k = 0; k < i; k++) {
+      if (p[k] == 0.0) continue;
+      const double pk = p[k] / p_sum;
+      const double qk = std::max(q[k] / q_sum, static_cast<double>(eps));
+      kl += pk * std::log(pk / qk);
+    }
+    if (kl < min_kl) {
+      min_kl = kl;
+      best_bins = i;
+    }
+  }
+  return (best_bins + 0.5f) * bin_width;
+}
+
+float PercentileThreshold(const std::vector<float>& histogram,
+                          float bin_width,
+                          float percentile) {
+  const double total =
+      std::accumulate(histogram.begin(), histogram.end(), 0.0);
+  double count = 0.0;
+  for (size_t i = 0; i < histogram.size(); i++) {
+    count += histogram[i];
+    if (count >= total * percentile) {
+      return (i + 1) * bin_width;
+    }
+  }
+  return histogram.size() * bin_width;
+}
+
+float QuantizationError(const float* data, int64_t size, float scale) {
+  if (scale <= 0.f) return 0.f;
+  double error = 0.0;
+  double norm = 0.0;
+  for (int64_t i = 0; i < size; i++) {
+    float q = std::min(std::max(std::round(data[i] / scale), -127.f), 127.f);
+    double diff = q * scale - data[i];
+    error += diff * diff;
+    norm += static_cast<double>(data[i]) * data[i];
+  }
+  return norm > 0.0 ? static_cast<float>(std::sqrt(error / norm)) : 0.f;
+}
+
+float RelativeError(const float* ref, const float* data, int64_t size) {
+  double error = 0.0;
+  double norm = 0.0;
+  for (int64_t i = 0; i < size; i++) {
+    double diff = static_cast<double>(data[i]) - ref[i];
+    error += diff * diff;
+    norm += static_cast<double>(ref[i]) * ref[i];
+  }
+  if (norm <= 0.0) return error > 0.0 ? 1.f : 0.f;
+  return static_cast<float>(std::sqrt(error / norm));
+}
+
+}  // namespace lite
+}  // namespace paddle
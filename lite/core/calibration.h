@@ -0,0 +1,97 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+/*
+ * The statistics of the activations for the static post-training
+ * quantization.
+ *
+ * The fp32 model is run on a calibration set, the calibrator observes the
+ * float activations consumed by the ops and computes the threshold of each
+ * of them, i.e. the abs value clipped to the int8 range [-127, 127], so the
+ * scale of the activation is threshold / 127.
+ *  - abs_max: the max abs value of all of the samples.
+ *  - kl: the threshold minimizing the KL divergence between the histogram of
+ *    the activation and its quantized one, as TensorRT does.
+ *  - percentile: the abs value covering the 'percentile' of the samples.
+ * The histograms of kl and percentile cover [0, abs_max], so the calibration
+ * set is run twice: for the abs max, then for the histograms.
+ */
+enum class CalibrationAlgo { kAbsMax, kKL, kPercentile };
+
+// Parse "abs_max", "kl" or "percentile", return false if it's unknown.
+bool ParseCalibrationAlgo(const std::string& name, CalibrationAlgo* algo);
+
+class Calibrator {
+ public:
+  static constexpr int kHistogramBins = 2048;
+
+  explicit Calibrator(CalibrationAlgo algo, float percentile = 0.9999f)
+      : algo_(algo), percentile_(percentile) {}
+
+  // Whether the calibration set needs to be run again for the histograms.
+  bool NeedHistogram() const { return algo_ != CalibrationAlgo::kAbsMax; }
+
+  // Accumulate the samples of the activation 'name' in the first run over
+  // the calibration set.
+  void CollectAbsMax(const std::string& name, const float* data, int64_t size);
+  // Accumulate the samples of the activation 'name' in the second run, the
+  // values beyond the abs max of the first run fall into the last bin.
+  void CollectHistogram(const std::string& name,
+                        const float* data,
+                        int64_t size);
+
+  // The thresholds of the activations of nonzero abs max.
+  std::map<std::string, float> ComputeThresholds() const;
+
+ private:
+  struct Stats {
+    float abs_max{0.f};
+    std::vector<float> histogram;
+  };
+  CalibrationAlgo algo_;
+  float percentile_;
+  std::map<std::string, Stats> stats_;
+};
+
+// The threshold of the histogram of 'bin_width' minimizing the KL divergence
+// with the histogram quantized to 'levels' levels.
+float KLThreshold(const std::vector<float>& histogram,
+                  float bin_width,
+                  int levels = 128);
+
+// The threshold of the histogram of 'bin_width' covering 'percentile' of the
+// samples.
+float PercentileThreshold(const std::vector<float>& histogram,
+                          float bin_width,
+                          float percentile);
+
+// The relative L2 error of 'data' quantized to int8 by 'scale' and
+// dequantized back.
+float QuantizationError(const float* data, int64_t size, float scale);
+
+// The relative L2 error of 'data' against 'ref'.
+float RelativeError(const float* ref, const float* data, int64_t size);
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,92 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/calibration.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+// The samples of a normal distribution of stddev 1 and a few outliers.
+std::vector<float> NormalWithOutliers() {
+  std::vector<float> data;
+  for (int i = 1; i < 20000; i++) {
+    // The inverse CDF by the approximation of Tukey.
+    float p = i / 20000.f;
+    data.push_back(4.91f * (std::pow(p, 0.14f) - std::pow(1.f - p, 0.14f)));
+  }
+  data.push_back(40.f);
+  data.push_back(-30.f);
+  return data;
+}
+
+TEST(Calibration, parse_algo) {
+  CalibrationAlgo algo;
+  ASSERT_TRUE(ParseCalibrationAlgo("kl", &algo));
+  ASSERT_TRUE(algo == CalibrationAlgo::kKL);
+  ASSERT_TRUE(ParseCalibrationAlgo("percentile", &algo));
+  ASSERT_TRUE(algo == CalibrationAlgo::kPercentile);
+  ASSERT_FALSE(ParseCalibrationAlgo("min_max", &algo));
+}
+
+TEST(Calibration, thresholds) {
+  auto data = NormalWithOutliers();
+  std::map<std::string, float> thresholds[3];
+  CalibrationAlgo algos[3] = {CalibrationAlgo::kAbsMax,
+                              CalibrationAlgo::kKL,
+                              CalibrationAlgo::kPercentile};
+  for (int i = 0; i < 3; i++) {
+    Calibrator calibrator(algos[i]);
+    // Split the samples into two batches.
+    const int64_t half = data.size() / 2;
+    calibrator.CollectAbsMax("x", data.data(), half);
+    calibrator.CollectAbsMax("x", data.data() + half, data.size() - half);
+    if (calibrator.NeedHistogram()) {
+      calibrator.CollectHistogram("x", data.data(), half);
+      calibrator.CollectHistogram("x", data.data() + half, data.size() - half);
+    }
+    thresholds[i] = calibrator.ComputeThresholds();
+    ASSERT_EQ(thresholds[i].size(), 1u);
+  }
+  EXPECT_FLOAT_EQ(thresholds[0]["x"], 40.f);
+  // The outliers are clipped by kl and percentile.
+  EXPECT_GT(thresholds[1]["x"], 2.f);
+  EXPECT_LT(thresholds[1]["x"], 5.f);
+  EXPECT_GT(thresholds[2]["x"], 3.f);
+  EXPECT_LT(thresholds[2]["x"], 5.f);
+  // And the quantization error of the bulk of the samples is lower.
+  float abs_max_error =
+      QuantizationError(data.data(), data.size() - 2, thresholds[0]["x"] / 127);
+  float kl_error =
+      QuantizationError(data.data(), data.size() - 2, thresholds[1]["x"] / 127);
+  EXPECT_LT(kl_error, abs_max_error);
+}
+
+TEST(Calibration, errors) {
+  std::vector<float> ref{1.f, -2.f, 3.f, 0.5f};
+  EXPECT_FLOAT_EQ(RelativeError(ref.data(), ref.data(), ref.size()), 0.f);
+  // The values of multiples of the scale are quantized exactly.
+  EXPECT_NEAR(QuantizationError(ref.data(), ref.size(), 0.5f), 0.f, 1e-6);
+  std::vector<float> out{1.f, -2.f, 3.f, 1.5f};
+  EXPECT_NEAR(RelativeError(ref.data(), out.data(), out.size()),
+              1.f / std::sqrt(14.25f),
+              1e-6);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,187 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/frozen_program.h"
+#include <set>
+#include <string>
+#include "lite/core/program.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+// The ops whose output shapes depend on the data of the inputs, or which run
+// the sub-blocks.
+bool IsDataDependent(const std::string& op_type) {
+  static const std::set<std::string> kOpTypes = {
+      "while",
+      "conditional_block",
+      "conditional_block_infer",
+      "where_index",
+      "unique",
+      "masked_select",
+      "multiclass_nms",
+      "multiclass_nms2",
+      "multiclass_nms3",
+      "matrix_nms",
+      "generate_proposals",
+      "generate_proposals_v2",
+      "distribute_fpn_proposals",
+      "collect_fpn_proposals",
+      "beam_search",
+      "beam_search_decode",
+      "lod_reset",
+      "merge_lod_tensor",
+      "split_lod_tensor",
+      "sequence_mask",
+      "range",
+      "write_to_array",
+      "read_from_array",
+      "tensor_array_to_tensor",
+      "lod_array_length"};
+  return kOpTypes.count(op_type) > 0;
+}
+
+Tensor* FindTensor(Scope* scope, const std::string& name) {
+  auto* var = scope->FindVar(name);
+  if (!var || !var->IsType<Tensor>()) return nullptr;
+  return var->GetMutable<Tensor>();
+}
+
+}  // namespace
+
+std::unique_ptr<FrozenProgram> FrozenProgram::Create(
+    std::vector<Instruction>* insts) {
+  std::unique_ptr<FrozenProgram> program;
+#if defined(LITE_WITH_PROFILE) || defined(LITE_WITH_PRECISION_PROFILE) || \
+    defined(LITE_WITH_NVTX) || defined(LITE_WITH_FPGA) ||                 \
+    defined(LITE_WITH_METAL) || defined(LITE_WITH_CUDA) ||                \
+    defined(LITE_WITH_OPENCL)
+  // The instructions are profiled, synchronized or flushed one by one.
+  return program;
+#endif
+  CHECK(insts);
+  program.reset(new FrozenProgram(insts));
+  return program;
+}
+
+bool FrozenProgram::MatchSignature() const {
+  for (auto& input : inputs_) {
+    if (input.tensor->dims() != input.dims ||
+        input.tensor->lod() != input.lod) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FrozenProgram::Run() {
+  if (!frozen_) return false;
+  if (!MatchSignature()) {
+    VLOG(4) << "The signature of the inputs changed, unfreeze the program";
+    frozen_ = false;
+    return false;
+  }
+  for (auto& thunk : thunks_) {
+    if (thunk.inst) {
+      thunk.inst->Run();
+      continue;
+    }
+    for (int i = thunk.outputs_begin; i < thunk.outputs_end; i++) {
+      auto& output = outputs_[i];
+      output.tensor->Resize(output.dims);
+      output.tensor->set_lod(output.lod);
+    }
+    thunk.kernel->LaunchFrozen();
+  }
+  return true;
+}
+
+void FrozenProgram::Freeze() {
+  if (frozen_ && MatchSignature()) return;
+  frozen_ = false;
+  inputs_.clear();
+  outputs_.clear();
+  thunks_.clear();
+
+  // The inputs of the block are the vars of the exec scope which are read
+  // but not written by the instructions, the weights live in its parent.
+  std::set<std::string> written;
+  std::set<std::string> input_names;
+  for (auto& inst : *insts_) {
+    if (inst.is_feed_fetch_op()) continue;
+    auto* op = inst.mutable_op();
+    auto* scope = op->scope();
+    for (auto& name : op->op_info()->input_names()) {
+      if (!written.count(name) && scope->FindLocalVar(name)) {
+        input_names.insert(name);
+      }
+    }
+    for (auto& name : op->op_info()->output_names()) {
+      written.insert(name);
+    }
+  }
+
+  // The vars derived from the data dependent ops, their consumers need to
+  // infer the shapes.
+  std::set<std::string> tainted;
+  for (auto& inst : *insts_) {
+    if (inst.is_feed_fetch_op()) continue;
+    auto* op = inst.mutable_op();
+    auto* op_info = op->op_info();
+    auto* scope = op->scope();
+    bool dynamic = IsDataDependent(op_info->Type());
+    for (auto& name : op_info->input_names()) {
+      if (tainted.count(name)) dynamic = true;
+      if (!FindTensor(scope, name)) dynamic = true;
+      if (input_names.count(name)) {
+        auto* tensor = FindTensor(scope, name);
+        if (tensor) {
+          inputs_.push_back({tensor, tensor->dims(), tensor->lod()});
+          input_names.erase(name);
+        }
+      }
+    }
+    Thunk thunk{inst.mutable_kernel(), nullptr, 0, 0};
+    thunk.outputs_begin = static_cast<int>(outputs_.size());
+    for (auto& name : op_info->output_names()) {
+      auto* tensor = FindTensor(scope, name);
+      if (!tensor) {
+        dynamic = true;
+        break;
+      }
+      outputs_.push_back({tensor, tensor->dims(), tensor->lod()});
+    }
+    if (dynamic) {
+      outputs_.resize(thunk.outputs_begin);
+      for (auto& name : op_info->output_names()) {
+        tainted.insert(name);
+      }
+      thunk.inst = &inst;
+    } else if (op->run_once()) {
+      outputs_.resize(thunk.outputs_begin);
+      continue;
+    }
+    thunk.outputs_end = static_cast<int>(outputs_.size());
+    thunks_.push_back(thunk);
+  }
+  VLOG(4) << "Freeze " << thunks_.size() << " instructions on "
+          << inputs_.size() << " inputs, " << tainted.size()
+          << " vars have the dynamic shapes";
+  frozen_ = true;
+}
+
+}  // namespace lite
+}  // namespace paddle
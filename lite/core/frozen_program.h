@@ -0,0 +1,87 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+struct Instruction;
+class KernelBase;
+
+/*
+ * The fast dispatch of the instructions of a block whose shapes only depend
+ * on the shapes of its inputs.
+ *
+ * After a run on a new signature (the dims and the lod of the input tensors
+ * of the block), the instructions are compiled into a flat array of calls:
+ * the feed and fetch ops and the ops which run once are dropped, the static
+ * ops restore the dims of their outputs recorded in that run and launch the
+ * kernels directly, skipping InferShape, the shape checks and the re-init of
+ * the kernels. The outputs are restored instead of being left as they are
+ * because the memory optimization shares a tensor among the ops. The ops
+ * whose output shapes depend on the data, e.g. while and where_index, and
+ * the ops consuming their outputs still run as the normal instructions.
+ */
+class FrozenProgram {
+ public:
+  // Return nullptr if the instructions need the per-instruction hooks, e.g.
+  // the profilers, or the sync and the flush of the devices.
+  static std::unique_ptr<FrozenProgram> Create(std::vector<Instruction>* insts);
+
+  // Run the frozen instructions, return false if the program isn't frozen or
+  // the signature of the inputs changed, then it should run as usual.
+  bool Run();
+  // Called after a normal run, compile the instructions if the signature
+  // differs from the frozen one.
+  void Freeze();
+
+  bool frozen() const { return frozen_; }
+
+ private:
+  explicit FrozenProgram(std::vector<Instruction>* insts) : insts_(insts) {}
+  bool MatchSignature() const;
+
+  struct Input {
+    const Tensor* tensor;
+    DDim dims;
+    LoD lod;
+  };
+  struct Output {
+    Tensor* tensor;
+    DDim dims;
+    LoD lod;
+  };
+  // A static op is launched by 'kernel' after restoring the outputs in
+  // [outputs_begin, outputs_end), otherwise 'inst' runs as usual.
+  struct Thunk {
+    KernelBase* kernel;
+    Instruction* inst;
+    int outputs_begin;
+    int outputs_end;
+  };
+
+  std::vector<Instruction>* insts_;
+  bool frozen_{false};
+  std::vector<Input> inputs_;
+  std::vector<Output> outputs_;
+  std::vector<Thunk> thunks_;
+};
+
+}  // namespace lite
+}  // namespace paddle
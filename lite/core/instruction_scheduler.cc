@@ -0,0 +1,329 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/instruction_scheduler.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include "lite/core/device_info.h"
+#include "lite/core/program.h"
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/parallel.h"
+#endif
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+bool IsHostTarget(TargetType target) {
+  return target == TARGET(kHost) || target == TARGET(kX86) ||
+         target == TARGET(kARM) || target == TARGET(kAny);
+}
+
+// The ops which run the sub-blocks or the subgraphs of the devices, their
+// inputs and outputs don't cover all of the vars they touch.
+bool HasSubBlock(const std::string& op_type) {
+  return op_type == "while" || op_type == "conditional_block" ||
+         op_type == "subgraph";
+}
+
+int GetIntraOpThreads() {
+#if defined(LITE_WITH_ARM)
+  return DeviceInfo::Global().threads();
+#elif defined(LITE_WITH_X86)
+  return static_cast<int>(x86::GetMaxThreads());
+#else
+  return 1;
+#endif
+}
+
+// The workers run with LITE_POWER_NO_BIND during the concurrent run, otherwise
+// all of them are bound to the same leading cores of the power mode. The MKL
+// threads are set on each worker, since the ones of SetNumThreads are global
+// and would be shared by all of the workers.
+void ApplyIntraOpThreads(lite_api::PowerMode mode, int threads) {
+#if defined(LITE_WITH_ARM)
+  DeviceInfo::Global().SetRunMode(mode, threads);
+#elif defined(LITE_WITH_X86)
+  x86::SetNumThreadsLocal(threads);
+#endif
+}
+
+// Restore the threads of the calling thread after the concurrent run.
+void RestoreIntraOpThreads(lite_api::PowerMode mode, int threads) {
+#if defined(LITE_WITH_ARM)
+  DeviceInfo::Global().SetRunMode(mode, threads);
+#elif defined(LITE_WITH_X86)
+  // Restore the OpenMP threads, and fall back to the global MKL threads.
+  x86::SetNumThreadsLocal(threads);
+  x86::SetNumThreadsLocal(0);
+#endif
+}
+
+lite_api::PowerMode GetPowerMode() {
+#ifdef LITE_WITH_ARM
+  return DeviceInfo::Global().mode();
+#else
+  return lite_api::LITE_POWER_NO_BIND;
+#endif
+}
+
+}  // namespace
+
+std::unique_ptr<InstructionScheduler> InstructionScheduler::Create(
+    std::vector<Instruction>* insts, int inter_op_threads) {
+  std::unique_ptr<InstructionScheduler> scheduler;
+  if (inter_op_threads <= 1) return scheduler;
+#if defined(LITE_WITHOUT_THREAD_LOCAL) || defined(LITE_WITH_PROFILE) ||  \
+    defined(LITE_WITH_PRECISION_PROFILE) || defined(LITE_WITH_NVTX) ||   \
+    defined(LITE_WITH_FPGA) || defined(LITE_WITH_METAL) ||               \
+    defined(LITE_USE_THREAD_POOL)
+  // The workspaces of the kernels are shared by the threads, or the
+  // instructions are expected to run one by one. The global ThreadPool of
+  // LITE_PARALLEL_BEGIN isn't reentrant, and its size is fixed, so the kernels
+  // run concurrently would race on it.
+  LOG(WARNING) << "inter_op_threads " << inter_op_threads
+               << " is ignored, the instructions run sequentially in this "
+                  "build, e.g. with LITE_USE_THREAD_POOL or the profiler.";
+  return scheduler;
+#endif
+  CHECK(insts);
+  std::vector<int> nodes;
+  for (size_t i = 0; i < insts->size(); i++) {
+    auto& inst = insts->at(i);
+    if (inst.is_feed_fetch_op()) continue;
+    if (!IsHostTarget(inst.kernel()->target()) ||
+        HasSubBlock(inst.op()->op_info()->Type())) {
+      LOG(WARNING) << "inter_op_threads " << inter_op_threads
+                   << " is ignored, the instructions run sequentially "
+                      "because of the op "
+                   << inst.op()->op_info()->Type() << " in "
+                   << TargetToStr(inst.kernel()->target());
+      return scheduler;
+    }
+    nodes.push_back(static_cast<int>(i));
+  }
+  scheduler.reset(new InstructionScheduler(insts, std::move(nodes)));
+  if (scheduler->width() <= 1) {
+    LOG(INFO) << "inter_op_threads " << inter_op_threads
+              << " is ignored, the instructions run sequentially because "
+                 "they form a chain";
+    scheduler.reset();
+    return scheduler;
+  }
+  scheduler->Start(std::min(inter_op_threads, scheduler->width()));
+  VLOG(4) << "Run " << scheduler->nodes_.size() << " instructions on "
+          << scheduler->workers() << " workers, the width is "
+          << scheduler->width();
+  return scheduler;
+}
+
+InstructionScheduler::InstructionScheduler(std::vector<Instruction>* insts,
+                                           std::vector<int>&& nodes)
+    : insts_(insts), nodes_(std::move(nodes)) {
+  Analyze();
+}
+
+InstructionScheduler::~InstructionScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void InstructionScheduler::Analyze() {
+  int size = static_cast<int>(nodes_.size());
+  std::vector<std::set<int>> predecessors(size);
+  // The last writer and the readers since the last write of each var.
+  std::map<std::string, int> writers;
+  std::map<std::string, std::vector<int>> readers;
+  // The outputs of the inplace reshape-like ops share the buffers of the
+  // inputs, which may be reused by memory_optimize_pass afterwards, so they're
+  // tracked as the inputs, and the reshape-like ops write the inputs.
+  std::map<std::string, std::string> shared_outputs;
+  auto resolve = [&](const std::string& name) -> std::string {
+    auto it = shared_outputs.find(name);
+    return it == shared_outputs.end() ? name : it->second;
+  };
+  for (int i = 0; i < size; i++) {
+    auto* op_info = insts_->at(nodes_[i]).op()->op_info();
+    for (auto& input_name : op_info->input_names()) {
+      auto name = resolve(input_name);
+      auto it = writers.find(name);
+      if (it != writers.end() && it->second != i) {
+        predecessors[i].insert(it->second);
+      }
+      readers[name].push_back(i);
+    }
+    if (op_info->HasAttr("inplace") && op_info->GetAttr<bool>("inplace") &&
+        op_info->HasInput("X") && op_info->Input("X").size() == 1 &&
+        op_info->HasOutput("Out") && op_info->Output("Out").size() == 1) {
+      shared_outputs[op_info->Output("Out").front()] =
+          resolve(op_info->Input("X").front());
+    }
+    for (auto& output_name : op_info->output_names()) {
+      auto name = resolve(output_name);
+      auto it = writers.find(name);
+      if (it != writers.end() && it->second != i) {
+        predecessors[i].insert(it->second);
+      }
+      for (auto reader : readers[name]) {
+        if (reader != i) predecessors[i].insert(reader);
+      }
+      readers[name].clear();
+      writers[name] = i;
+    }
+  }
+  successors_.assign(size, {});
+  in_degrees_.assign(size, 0);
+  std::vector<int> depths(size, 0);
+  for (int i = 0; i < size; i++) {
+    in_degrees_[i] = static_cast<int>(predecessors[i].size());
+    for (auto pred : predecessors[i]) {
+      successors_[pred].push_back(i);
+      depths[i] = std::max(depths[i], depths[pred] + 1);
+    }
+  }
+  std::map<int, int> depth_sizes;
+  for (auto depth : depths) {
+    width_ = std::max(width_, ++depth_sizes[depth]);
+  }
+  // The instructions are topologically sorted, so the ranks are computed in
+  // the reverse order.
+  ranks_.assign(size, 1);
+  for (int i = size - 1; i >= 0; i--) {
+    for (auto succ : successors_[i]) {
+      ranks_[i] = std::max(ranks_[i], ranks_[succ] + 1);
+    }
+  }
+  pending_.resize(size);
+  ready_.reserve(size);
+}
+
+void InstructionScheduler::Start(int inter_op_threads) {
+  for (int i = 1; i < inter_op_threads; i++) {
+    workers_.emplace_back([this]() { WorkerLoop(); });
+  }
+}
+
+void InstructionScheduler::WorkerLoop() {
+  int64_t generation = 0;
+  int applied = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_cv_.wait(lock,
+                     [&]() { return stop_ || generation_ != generation; });
+      if (stop_) return;
+      generation = generation_;
+    }
+    SetIntraOpThreads(&applied);
+    Drain();
+  }
+}
+
+void InstructionScheduler::SetIntraOpThreads(int* applied) {
+  int threads = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    threads = intra_op_threads_;
+  }
+  if (*applied == threads) return;
+  ApplyIntraOpThreads(lite_api::LITE_POWER_NO_BIND, threads);
+  *applied = threads;
+}
+
+void InstructionScheduler::Push(int node) {
+  ready_.push_back(node);
+  std::push_heap(ready_.begin(), ready_.end(), [&](int a, int b) {
+    return ranks_[a] < ranks_[b];
+  });
+}
+
+void InstructionScheduler::Drain() {
+  auto by_rank = [&](int a, int b) { return ranks_[a] < ranks_[b]; };
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    ready_cv_.wait(lock, [&]() { return remaining_ == 0 || !ready_.empty(); });
+    if (remaining_ == 0) return;
+    std::pop_heap(ready_.begin(), ready_.end(), by_rank);
+    int node = ready_.back();
+    ready_.pop_back();
+    bool failed = error_ != nullptr;
+    lock.unlock();
+    if (!failed) {
+      try {
+        insts_->at(nodes_[node]).Run();
+      } catch (...) {
+        std::lock_guard<std::mutex> error_lock(mutex_);
+        if (!error_) error_ = std::current_exception();
+      }
+    }
+    lock.lock();
+    int notified = 0;
+    for (auto succ : successors_[node]) {
+      if (--pending_[succ] == 0) {
+        Push(succ);
+        notified++;
+      }
+    }
+    if (--remaining_ == 0) {
+      ready_cv_.notify_all();
+      return;
+    }
+    // Keep one of the ready instructions for the current thread.
+    for (int i = 1; i < notified; i++) {
+      ready_cv_.notify_one();
+    }
+  }
+}
+
+void InstructionScheduler::Run() {
+  int budget = std::max(GetIntraOpThreads(), 1);
+  auto mode = GetPowerMode();
+  int threads = std::max(budget / workers(), 1);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_EQ(remaining_, 0);
+    error_ = nullptr;
+    intra_op_threads_ = threads;
+    pending_ = in_degrees_;
+    ready_.clear();
+    for (size_t i = 0; i < in_degrees_.size(); i++) {
+      if (in_degrees_[i] == 0) Push(static_cast<int>(i));
+    }
+    remaining_ = static_cast<int>(nodes_.size());
+    generation_++;
+  }
+  start_cv_.notify_all();
+  ApplyIntraOpThreads(lite_api::LITE_POWER_NO_BIND, threads);
+  Drain();
+  RestoreIntraOpThreads(mode, budget);
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(error, error_);
+  }
+  if (error) std::rethrow_exception(error);
+}
+
+}  // namespace lite
+}  // namespace paddle
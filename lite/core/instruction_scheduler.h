@@ -0,0 +1,91 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <exception>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+struct Instruction;
+
+/*
+ * Run the independent instructions of a block concurrently on the CPU.
+ *
+ * The dependencies are analyzed by the names of the input and output vars of
+ * the instructions (read-after-write, write-after-read and write-after-write),
+ * the feed and fetch ops are skipped as the sequential RuntimeProgram::Run
+ * does. The ready instructions are dispatched to 'inter_op_threads' workers
+ * (including the calling thread) in the order of their longest path to the
+ * end of the block, and the intra-op threads of the calling thread are
+ * partitioned among the workers.
+ */
+class InstructionScheduler {
+ public:
+  // Return nullptr if the instructions can't run concurrently, e.g. there are
+  // the kernels of the devices, the ops with the sub-blocks, or the
+  // instructions form a chain.
+  static std::unique_ptr<InstructionScheduler> Create(
+      std::vector<Instruction>* insts, int inter_op_threads);
+
+  ~InstructionScheduler();
+
+  void Run();
+
+  int workers() const { return static_cast<int>(workers_.size()) + 1; }
+  // The maximum number of the instructions at the same depth of the graph.
+  int width() const { return width_; }
+
+ private:
+  InstructionScheduler(std::vector<Instruction>* insts,
+                       std::vector<int>&& nodes);
+  void Analyze();
+  void Start(int inter_op_threads);
+  void WorkerLoop();
+  // Run the ready instructions until all of the instructions are finished.
+  void Drain();
+  void Push(int node);
+  // Apply the intra-op threads of the current run to the calling thread.
+  void SetIntraOpThreads(int* applied);
+
+  std::vector<Instruction>* insts_;
+  // The indices of the scheduled instructions in 'insts_'.
+  std::vector<int> nodes_;
+  std::vector<std::vector<int>> successors_;
+  std::vector<int> in_degrees_;
+  // The length of the longest path from the node to the end of the block.
+  std::vector<int> ranks_;
+  int width_{1};
+
+  std::mutex mutex_;
+  std::condition_variable ready_cv_;
+  std::condition_variable start_cv_;
+  std::vector<int> pending_;
+  std::vector<int> ready_;
+  int remaining_{0};
+  int64_t generation_{0};
+  int intra_op_threads_{1};
+  bool stop_{false};
+  std::exception_ptr error_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace lite
+}  // namespace paddle
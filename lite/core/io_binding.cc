@@ -0,0 +1,135 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/io_binding.h"
+#include <memory>
+#include "lite/core/memory.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+void BindBuffer(void* data, size_t memory_size, TargetType target, Tensor* t) {
+  if (t->raw_data() == data && t->target() == target) return;
+  // The tensor of the previous run may be larger than the user buffer, e.g.
+  // before a smaller shape is bound, start over from an empty one.
+  if (t->memory_size() > memory_size) {
+    auto lod = t->lod();
+    *t = Tensor();
+    t->set_lod(lod);
+  }
+  t->ResetBuffer(std::make_shared<Buffer>(data, target, memory_size), 0);
+}
+
+void UnbindBuffer(void* data, Tensor* t) {
+  if (t->raw_data() != data) return;
+  auto lod = t->lod();
+  *t = Tensor();
+  t->set_lod(lod);
+}
+
+}  // namespace
+
+void IOBinding::BindInput(size_t index,
+                          void* data,
+                          size_t memory_size,
+                          const DDim& dims,
+                          PrecisionType precision,
+                          TargetType target) {
+  CHECK(data) << "The buffer of the input " << index << " is null.";
+  const size_t required = dims.production() * PrecisionTypeLength(precision);
+  CHECK_LE(required, memory_size)
+      << "The buffer of the input " << index << " is smaller than its dims "
+      << dims << " of precision " << PrecisionToStr(precision) << ".";
+  auto& binding = inputs_[index];
+  binding.data = data;
+  binding.memory_size = memory_size;
+  binding.target = target;
+  binding.dims = dims;
+  binding.precision = precision;
+}
+
+void IOBinding::BindOutput(size_t index,
+                           void* data,
+                           size_t memory_size,
+                           TargetType target) {
+  CHECK(data) << "The buffer of the output " << index << " is null.";
+  auto& binding = outputs_[index];
+  binding.data = data;
+  binding.memory_size = memory_size;
+  binding.target = target;
+}
+
+void IOBinding::Clear(const TensorGetter& input, const TensorGetter& output) {
+  for (auto& item : inputs_) {
+    UnbindBuffer(item.second.data, input(item.first));
+  }
+  for (auto& item : outputs_) {
+    UnbindBuffer(item.second.data, output(item.first));
+  }
+  inputs_.clear();
+  outputs_.clear();
+}
+
+void IOBinding::Prepare(const TensorGetter& input, const TensorGetter& output) {
+  for (auto& item : inputs_) {
+    const auto& binding = item.second;
+    auto* tensor = input(item.first);
+    BindBuffer(binding.data, binding.memory_size, binding.target, tensor);
+    tensor->Resize(binding.dims);
+    tensor->set_precision(binding.precision);
+    // Update the memory size of the tensor, the buffer isn't reallocated since
+    // it's checked to be large enough by BindInput.
+    tensor->mutable_data(
+        binding.target,
+        binding.dims.production() * PrecisionTypeLength(binding.precision));
+  }
+  for (auto& item : outputs_) {
+    const auto& binding = item.second;
+    BindBuffer(
+        binding.data, binding.memory_size, binding.target, output(item.first));
+  }
+}
+
+int IOBinding::Finish(const TensorGetter& output) {
+  int num_copied = 0;
+  for (auto& item : outputs_) {
+    auto& binding = item.second;
+    const auto* tensor = output(item.first);
+    if (tensor->raw_data() == binding.data) continue;
+    CHECK(tensor->target() == binding.target)
+        << "The output " << item.first << " is on "
+        << TargetToStr(tensor->target()) << ", but its buffer is bound on "
+        << TargetToStr(binding.target) << ".";
+    CHECK_LE(tensor->memory_size(), binding.memory_size)
+        << "The buffer of the output " << item.first
+        << " is smaller than the output of dims " << tensor->dims() << ".";
+    TargetCopy(binding.target,
+               binding.data,
+               tensor->raw_data(),
+               tensor->memory_size());
+    if (!binding.warned) {
+      LOG(WARNING) << "The output " << item.first
+                   << " is redirected by its kernel, it's copied into the "
+                      "bound buffer after each run.";
+      binding.warned = true;
+    }
+    num_copied++;
+  }
+  return num_copied;
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,80 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * The user buffers bound as the memory of the input and output tensors of a
+ * predictor. The tensors of the feed and fetch vars are never reused by
+ * memory_optimize_pass, so once they point to the user buffers, the first ops
+ * read the inputs from the buffers and the last ops write the outputs into
+ * them, and no data is copied at the API boundary.
+ *
+ * The kernels which share the data of other tensors, e.g. the inplace reshape
+ * as the last op, may redirect an output tensor during the run, such outputs
+ * are copied into the user buffers after the run.
+ */
+class IOBinding {
+ public:
+  using TensorGetter = std::function<Tensor*(size_t)>;
+
+  // Bind 'data' as the memory of the index-th input, whose dims and precision
+  // are set before each run.
+  void BindInput(size_t index,
+                 void* data,
+                 size_t memory_size,
+                 const DDim& dims,
+                 PrecisionType precision,
+                 TargetType target);
+  // Bind 'data' as the memory of the index-th output, the kernels fail to
+  // allocate the output if it's smaller than the output.
+  void BindOutput(size_t index,
+                  void* data,
+                  size_t memory_size,
+                  TargetType target);
+  // Unbind all of the buffers, the tensors still using them are reset to
+  // empty ones so the buffers can be released by the users.
+  void Clear(const TensorGetter& input, const TensorGetter& output);
+  bool empty() const { return inputs_.empty() && outputs_.empty(); }
+
+  // Point the bound tensors to the user buffers, called before each run since
+  // TryShrinkMemory and the kernels may reset the tensors.
+  void Prepare(const TensorGetter& input, const TensorGetter& output);
+  // Copy the bound outputs whose tensors were redirected during the run into
+  // the user buffers, return the number of the copied outputs.
+  int Finish(const TensorGetter& output);
+
+ private:
+  struct Binding {
+    void* data{nullptr};
+    size_t memory_size{0};
+    TargetType target{TARGET(kHost)};
+    DDim dims;
+    PrecisionType precision{PRECISION(kUnk)};
+    bool warned{false};
+  };
+
+  std::map<size_t, Binding> inputs_;
+  std::map<size_t, Binding> outputs_;
+};
+
+}  // namespace lite
+}  // namespace paddle
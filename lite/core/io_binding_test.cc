@@ -0,0 +1,79 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/io_binding.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+TEST(IOBinding, BindInputAndOutput) {
+  Tensor input;
+  Tensor output;
+  auto input_getter = [&input](size_t) { return &input; };
+  auto output_getter = [&output](size_t) { return &output; };
+  std::vector<float> input_buffer(6, 1.f);
+  std::vector<float> output_buffer(6, 0.f);
+
+  IOBinding binding;
+  ASSERT_TRUE(binding.empty());
+  binding.BindInput(0,
+                    input_buffer.data(),
+                    input_buffer.size() * sizeof(float),
+                    DDim({2, 3}),
+                    PRECISION(kFloat),
+                    TARGET(kHost));
+  binding.BindOutput(0,
+                     output_buffer.data(),
+                     output_buffer.size() * sizeof(float),
+                     TARGET(kHost));
+  ASSERT_FALSE(binding.empty());
+  binding.Prepare(input_getter, output_getter);
+  ASSERT_EQ(input.dims(), DDim({2, 3}));
+  ASSERT_EQ(input.precision(), PRECISION(kFloat));
+  ASSERT_EQ(input.data<float>(), input_buffer.data());
+
+  // The kernel of the last op writes into the bound buffer.
+  output.Resize({3, 2});
+  float* out_data = output.mutable_data<float>();
+  ASSERT_EQ(out_data, output_buffer.data());
+  for (int i = 0; i < 6; i++) {
+    out_data[i] = input.data<float>()[i] * 2.f;
+  }
+  ASSERT_EQ(binding.Finish(output_getter), 0);
+  ASSERT_EQ(output_buffer[5], 2.f);
+
+  // The output redirected by the kernel is copied into the bound buffer.
+  Tensor other;
+  other.Resize({3, 2});
+  float* other_data = other.mutable_data<float>();
+  for (int i = 0; i < 6; i++) {
+    other_data[i] = static_cast<float>(i);
+  }
+  output.ShareDataWith(other);
+  ASSERT_EQ(binding.Finish(output_getter), 1);
+  ASSERT_EQ(output_buffer[5], 5.f);
+  // The next run writes into the bound buffer again.
+  binding.Prepare(input_getter, output_getter);
+  ASSERT_EQ(output.mutable_data<float>(), output_buffer.data());
+
+  binding.Clear(input_getter, output_getter);
+  ASSERT_TRUE(binding.empty());
+  ASSERT_FALSE(input.IsInitialized());
+  ASSERT_FALSE(output.IsInitialized());
+}
+
+}  // namespace lite
+}  // namespace paddle
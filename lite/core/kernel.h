@@ -91,21 +91,7 @@ class KernelBase {
     /// kernel)
     ReInitWhenNeeded();
 
-    // Reset the workspace to make every kernel in the same thread to share the
-    // temporary memory.
-    WorkSpace::Global_Host().AllocReset();
-#if defined(LITE_WITH_X86)
-    WorkSpace::Global_X86().AllocReset();
-#endif
-#if defined(LITE_WITH_CUDA)
-    WorkSpace::Global_CUDA().AllocReset();
-#endif
-#if defined(LITE_WITH_METAL)
-    WorkSpace::Global_METAL().AllocReset();
-#endif
-#if defined(LITE_WITH_MLU)
-    WorkSpace::Global_MLU().AllocReset();
-#endif
+    ResetWorkSpace();
 
 #ifdef LITE_WITH_PROFILE
     if (!is_kernel_test_) {
@@ -126,6 +112,19 @@ class KernelBase {
 #endif
   }
 
+  // Launch the kernel of a frozen program, the inputs have the same shapes as
+  // the last launch, so PrepareForRun and ReInitWhenNeeded are skipped.
+  void LaunchFrozen() {
+    ResetWorkSpace();
+    Run();
+  }
+
+  // Time the eligible algorithms in PrepareForRun instead of picking one by
+  // the heuristics, see lite/core/autotune.h.
+  void set_autotune(bool autotune) { autotune_ = autotune; }
+  // The algorithm picked by the autotuning, empty if the kernel isn't tuned.
+  const std::string& tuned_algo() const { return tuned_algo_; }
+
   void SetContext(std::unique_ptr<KernelContext>&& ctx) {
     ctx_ = std::move(ctx);
   }
@@ -200,6 +199,24 @@ class KernelBase {
   void Torch() {}
 
  protected:
+  // Reset the workspace to make every kernel in the same thread to share the
+  // temporary memory.
+  static void ResetWorkSpace() {
+    WorkSpace::Global_Host().AllocReset();
+#if defined(LITE_WITH_X86)
+    WorkSpace::Global_X86().AllocReset();
+#endif
+#if defined(LITE_WITH_CUDA)
+    WorkSpace::Global_CUDA().AllocReset();
+#endif
+#if defined(LITE_WITH_METAL)
+    WorkSpace::Global_METAL().AllocReset();
+#endif
+#if defined(LITE_WITH_MLU)
+    WorkSpace::Global_MLU().AllocReset();
+#endif
+  }
+
   std::unique_ptr<KernelContext> ctx_{nullptr};
   mutable operators::param_t param_;
   // The corresponding op type.
@@ -208,6 +225,8 @@ class KernelBase {
   // is the unique ID for the kernel.
   std::string alias_{};
   bool is_first_epoch_{true};
+  bool autotune_{false};
+  std::string tuned_algo_{};
 
 #ifdef LITE_WITH_PROFILE
   profile::Profiler* profiler_{nullptr};
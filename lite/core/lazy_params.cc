@@ -0,0 +1,157 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/lazy_params.h"
+#include <utility>
+
+namespace paddle {
+namespace lite {
+
+namespace {
+const char kLazyParamsVarName[] = "LAZY_PARAMS";
+}  // namespace
+
+void LazyParams::Register(const std::string& name, Loader&& loader) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  loaders_[name] = std::move(loader);
+  loaded_.erase(name);
+}
+
+bool LazyParams::Contains(const std::string& name) const {
+  return loaders_.count(name) > 0;
+}
+
+void LazyParams::Load(const std::vector<std::string>& names, Scope* scope) {
+  CHECK(scope);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& name : names) {
+    auto it = loaders_.find(name);
+    if (it == loaders_.end() || loaded_.count(name)) continue;
+    auto* var = scope->FindVar(name);
+    CHECK(var) << "The lazy param " << name << " is not found in the scope.";
+    it->second(var->GetMutable<lite::Tensor>());
+    loaded_.insert(name);
+    VLOG(4) << "materialize lazy param " << name;
+  }
+}
+
+void LazyParams::Evict(Scope* scope) {
+  CHECK(scope);
+  // A listener may release the nested sub-block programs, which remove their
+  // own listeners, so the next listener is looked up again after each call,
+  // and it's called without the lock.
+  int next_id = 0;
+  while (true) {
+    std::function<void()> listener;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = listeners_.lower_bound(next_id);
+      if (it == listeners_.end()) break;
+      next_id = it->first + 1;
+      listener = it->second;
+    }
+    listener();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& name : loaded_) {
+    auto* var = scope->FindVar(name);
+    if (var == nullptr) continue;
+    var->GetMutable<lite::Tensor>()->clear();
+  }
+  VLOG(4) << "evict " << loaded_.size() << " lazy params";
+  loaded_.clear();
+}
+
+int LazyParams::AddEvictListener(std::function<void()>&& listener) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  listeners_[next_listener_id_] = std::move(listener);
+  return next_listener_id_++;
+}
+
+void LazyParams::RemoveEvictListener(int id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  listeners_.erase(id);
+}
+
+void LazyParams::Set(Scope* scope, const std::shared_ptr<LazyParams>& params) {
+  CHECK(scope);
+  auto* var = scope->Var(kLazyParamsVarName);
+  CHECK(var);
+  *var->GetMutable<std::shared_ptr<LazyParams>>() = params;
+}
+
+std::shared_ptr<LazyParams> LazyParams::Get(const Scope* scope) {
+  CHECK(scope);
+  auto* var = scope->FindVar(kLazyParamsVarName);
+  if (var == nullptr) return nullptr;
+  return var->Get<std::shared_ptr<LazyParams>>();
+}
+
+bool IsSubBlockOp(const std::string& op_type) {
+  return op_type == "conditional_block" || op_type == "while";
+}
+
+std::vector<std::string> GetBlockInputs(const cpp::ProgramDesc& program_desc,
+                                        int block_idx) {
+  std::vector<std::string> inputs;
+  auto* block_desc = program_desc.GetBlock<cpp::BlockDesc>(block_idx);
+  CHECK(block_desc);
+  for (size_t op_idx = 0; op_idx < block_desc->OpsSize(); ++op_idx) {
+    auto* op_desc = block_desc->GetOp<cpp::OpDesc>(op_idx);
+    CHECK(op_desc);
+    if (IsSubBlockOp(op_desc->Type())) continue;
+    auto op_inputs = op_desc->input_vars();
+    inputs.insert(inputs.end(), op_inputs.begin(), op_inputs.end());
+  }
+  return inputs;
+}
+
+std::set<std::string> GetLazyParamNames(const cpp::ProgramDesc& program_desc) {
+  auto is_transformed_op = [](const cpp::OpDesc* op_desc) {
+    if (op_desc->HasAttr("quantize_weight_bits") ||
+        op_desc->HasAttr("quantization_type")) {
+      return true;
+    }
+    for (auto& name : op_desc->input_vars()) {
+      if (op_desc->HasAttr(name + "_fp16")) return true;
+    }
+    return false;
+  };
+  std::set<std::string> eager_names;
+  std::set<std::string> lazy_names;
+  for (size_t block_idx = 0; block_idx < program_desc.BlocksSize();
+       ++block_idx) {
+    auto* block_desc = program_desc.GetBlock<cpp::BlockDesc>(block_idx);
+    CHECK(block_desc);
+    for (size_t op_idx = 0; op_idx < block_desc->OpsSize(); ++op_idx) {
+      auto* op_desc = block_desc->GetOp<cpp::OpDesc>(op_idx);
+      CHECK(op_desc);
+      // The inputs of the sub-block ops are passed through to the sub-blocks.
+      if (IsSubBlockOp(op_desc->Type())) continue;
+      bool eager = block_idx == kRootBlockIdx || is_transformed_op(op_desc);
+      auto& names = eager ? eager_names : lazy_names;
+      auto inputs = op_desc->input_vars();
+      auto outputs = op_desc->output_vars();
+      names.insert(inputs.begin(), inputs.end());
+      names.insert(outputs.begin(), outputs.end());
+    }
+  }
+  for (auto& name : eager_names) {
+    lazy_names.erase(name);
+  }
+  return lazy_names;
+}
+
+}  // namespace lite
+}  // namespace paddle
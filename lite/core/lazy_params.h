@@ -0,0 +1,86 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/scope.h"
+#include "lite/core/tensor.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * The params which are only used by the sub-blocks of conditional_block and
+ * while, they are materialized from the model file into the scope when the
+ * sub-block is executed for the first time, and can be evicted under memory
+ * pressure and materialized again later.
+ *
+ * LazyParams is stored in the root scope, the tensors of the lazy params are
+ * created with their dims and precision but without data.
+ */
+class LazyParams {
+ public:
+  using Loader = std::function<void(lite::Tensor*)>;
+
+  // Register a param whose data is filled by 'loader' on demand.
+  void Register(const std::string& name, Loader&& loader);
+  bool Contains(const std::string& name) const;
+  bool empty() const { return loaders_.empty(); }
+
+  // Materialize the params which are not loaded yet.
+  void Load(const std::vector<std::string>& names, Scope* scope);
+
+  // Release the data of all of the loaded params. The listeners are notified
+  // first to release the resources derived from the params, e.g. the sub-block
+  // programs with the packed weights.
+  void Evict(Scope* scope);
+
+  int AddEvictListener(std::function<void()>&& listener);
+  void RemoveEvictListener(int id);
+
+  static void Set(Scope* scope, const std::shared_ptr<LazyParams>& params);
+  // Return nullptr if there are no lazy params in the scope or its ancestors.
+  static std::shared_ptr<LazyParams> Get(const Scope* scope);
+
+ private:
+  std::mutex mutex_;
+  std::map<std::string, Loader> loaders_;
+  std::set<std::string> loaded_;
+  std::map<int, std::function<void()>> listeners_;
+  int next_listener_id_{0};
+};
+
+// The ops which execute the block of the attr 'sub_block'.
+bool IsSubBlockOp(const std::string& op_type);
+
+// The input vars of the ops in the block, the inputs of the nested sub-block
+// ops are excluded since they are materialized by the nested ops.
+std::vector<std::string> GetBlockInputs(const cpp::ProgramDesc& program_desc,
+                                        int block_idx);
+
+// The params which are only used in the sub-blocks and can be loaded lazily,
+// the params of the ops whose weights are transformed after loading, such as
+// the dequantized or fp16 weights, are excluded.
+std::set<std::string> GetLazyParamNames(const cpp::ProgramDesc& program_desc);
+
+}  // namespace lite
+}  // namespace paddle
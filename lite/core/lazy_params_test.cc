@@ -0,0 +1,64 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/lazy_params.h"
+#include <gtest/gtest.h>
+
+namespace paddle {
+namespace lite {
+
+TEST(LazyParams, LoadAndEvict) {
+  Scope scope;
+  auto* w = scope.Var("w")->GetMutable<Tensor>();
+  w->Resize({2, 3});
+  w->set_persistable(true);
+
+  auto lazy_params = std::make_shared<LazyParams>();
+  int num_loads = 0;
+  lazy_params->Register("w", [&num_loads](Tensor* tensor) {
+    auto* data = tensor->mutable_data<float>();
+    for (int64_t i = 0; i < tensor->numel(); ++i) {
+      data[i] = static_cast<float>(i);
+    }
+    ++num_loads;
+  });
+  LazyParams::Set(&scope, lazy_params);
+  ASSERT_EQ(LazyParams::Get(&scope), lazy_params);
+  ASSERT_TRUE(lazy_params->Contains("w"));
+  ASSERT_FALSE(lazy_params->Contains("x"));
+  ASSERT_FALSE(w->IsInitialized());
+
+  lazy_params->Load({"w", "x"}, &scope);
+  lazy_params->Load({"w"}, &scope);
+  ASSERT_EQ(num_loads, 1);
+  ASSERT_TRUE(w->IsInitialized());
+  ASSERT_EQ(w->data<float>()[5], 5.f);
+
+  int num_evicts = 0;
+  int id = lazy_params->AddEvictListener([&num_evicts] { ++num_evicts; });
+  lazy_params->Evict(&scope);
+  ASSERT_EQ(num_evicts, 1);
+  ASSERT_FALSE(w->IsInitialized());
+  ASSERT_EQ(w->numel(), 6);
+
+  lazy_params->RemoveEvictListener(id);
+  lazy_params->Load({"w"}, &scope);
+  ASSERT_EQ(num_loads, 2);
+  ASSERT_EQ(w->data<float>()[5], 5.f);
+  lazy_params->Evict(&scope);
+  ASSERT_EQ(num_evicts, 1);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/core/memory.h"
+#include "lite/core/tracer.h"
 
 #ifdef LITE_WITH_METAL
 #include "lite/backends/metal/target_wrapper.h"
@@ -69,6 +70,9 @@ void* TargetMalloc(TargetType target, size_t size) {
     default:
       LOG(FATAL) << "Unknown supported target " << TargetToStr(target);
   }
+  if (Tracer::Enabled()) {
+    Tracer::Global().AddAllocation(TargetToStr(target), size);
+  }
   return data;
 }
 
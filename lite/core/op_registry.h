@@ -225,6 +225,10 @@ class ParamTypeDummyRegistry {
                                      int32_t version_id) {
       return *this;
     }
+    NewInstance& BindInplace(const std::string& in_arg,
+                             const std::string& out_arg) {
+      return *this;
+    }
     bool Finalize() { return true; }
   };
 
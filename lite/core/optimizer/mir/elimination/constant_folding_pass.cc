@@ -0,0 +1,242 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/constant_folding_pass.h"
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/context.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+#include "lite/core/optimizer/mir/ssa_graph_utils.h"
+#include "lite/core/type_system.h"
+#include "lite/utils/env.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+// The ops which can't be folded although their inputs are all persistable.
+const std::set<std::string> kUnfoldableOps = {
+    // IO and control flow.
+    "feed",
+    "fetch",
+    "while",
+    "conditional_block",
+    "subgraph",
+    "io_copy",
+    "io_copy_once",
+    "calib",
+    "calib_once",
+    "layout",
+    "layout_once",
+    "write_to_array",
+    "read_from_array",
+    "increment",
+    "print",
+    "assert",
+    // Random.
+    "uniform_random",
+    "gaussian_random",
+    "truncated_gaussian_random",
+    "randint",
+    "randperm",
+    "bernoulli",
+    "sampling_id",
+    "dropout",
+    "seed",
+};
+
+// The targets whose kernels run on the host memory.
+std::vector<Place> FoldingPlaces() {
+  std::vector<TargetType> targets{TARGET(kHost)};
+#ifdef LITE_WITH_X86
+  targets.push_back(TARGET(kX86));
+#endif
+#ifdef LITE_WITH_ARM
+  targets.push_back(TARGET(kARM));
+#endif
+  std::vector<Place> places;
+  for (auto target : targets) {
+    for (auto precision : {PRECISION(kFloat),
+                           PRECISION(kInt32),
+                           PRECISION(kInt64),
+                           PRECISION(kBool),
+                           PRECISION(kAny)}) {
+      places.emplace_back(target, precision, DATALAYOUT(kNCHW));
+    }
+  }
+  return places;
+}
+
+Tensor* FindTensor(Scope* scope, const std::string& name) {
+  auto* var = scope->FindVar(name);
+  if (var == nullptr || !var->IsType<Tensor>()) return nullptr;
+  return var->GetMutable<Tensor>();
+}
+
+// Whether the declared types of the inputs of 'kernel' accept the tensors.
+bool KernelMatchesInputs(const KernelBase& kernel,
+                         const OpInfo& op_info,
+                         Scope* scope) {
+  auto target = kernel.target();
+  if (target != TARGET(kHost) && target != TARGET(kX86) &&
+      target != TARGET(kARM)) {
+    return false;
+  }
+  for (auto& arg_name : op_info.InputArgumentNames()) {
+    auto var_names = op_info.Input(arg_name);
+    if (var_names.empty()) continue;
+    const auto* param_type = ParamTypeRegistry::Global().RetrieveInArgument(
+        kernel.place(), kernel.GenParamTypeKey(), arg_name);
+    if (param_type == nullptr) return false;
+    const Type* decl_type = param_type->type;
+    if (!decl_type->IsTensor()) return false;
+    for (auto& var_name : var_names) {
+      auto* tensor = FindTensor(scope, var_name);
+      if (tensor == nullptr) return false;
+      if (decl_type->precision() != PRECISION(kAny) &&
+          decl_type->precision() != tensor->precision()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+void ConstantFoldingPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+#ifdef LITE_ON_MODEL_OPTIMIZE_TOOL
+  // The kernels are the placeholders in opt, which can't compute anything.
+  VLOG(3) << "Skip constant_folding_pass since the kernels are not compiled.";
+  return;
+#endif
+  const int64_t max_bytes =
+      GetIntFromEnv(CONSTANT_FOLDING_MAX_BYTES, 1024 * 1024);
+  int folded_count = 0;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!IsFoldable(graph.get(), node)) continue;
+    if (!Fold(node, max_bytes)) continue;
+    // Only keep the outputs which are used by the other ops, the others
+    // like XShape are dropped with the op.
+    std::set<const Node*> nodes2rm{node};
+    for (auto* out_node : node->outlinks) {
+      if (out_node->outlinks.empty()) {
+        nodes2rm.insert(out_node);
+        continue;
+      }
+      FindTensor(node->AsStmt().op()->scope(), out_node->arg()->name)
+          ->set_persistable(true);
+      out_node->arg()->is_weight = true;
+      out_node->arg()->is_persist = true;
+    }
+    GraphSafeRemoveNodes(graph.get(), nodes2rm);
+    folded_count++;
+  }
+  VLOG(3) << "Folded " << folded_count << " constant ops.";
+}
+
+bool ConstantFoldingPass::IsFoldable(SSAGraph* graph, Node* node) {
+  if (!node->IsStmt()) return false;
+  auto& stmt = node->AsStmt();
+  if (kUnfoldableOps.count(stmt.op_type())) return false;
+  auto* scope = stmt.op()->scope();
+  std::set<std::string> in_names;
+  for (auto* in_node : node->inlinks) {
+    if (!in_node->IsArg() || !in_node->arg()->is_weight) return false;
+    auto* tensor = FindTensor(scope, in_node->arg()->name);
+    if (tensor == nullptr || !tensor->persistable()) return false;
+    in_names.insert(in_node->arg()->name);
+  }
+  if (node->outlinks.empty()) return false;
+  for (auto* out_node : node->outlinks) {
+    const auto& name = out_node->arg()->name;
+    // The ops writing their inputs in place, and the vars written again, e.g.
+    // by the control flow ops, are runtime states instead of constants.
+    if (in_names.count(name) || FindTensor(scope, name) == nullptr ||
+        HasExtraProducers(graph, name, {})) {
+      return false;
+    }
+    for (auto* consumer : out_node->outlinks) {
+      if (kUnfoldableOps.count(consumer->AsStmt().op_type()) &&
+          consumer->AsStmt().op_type() != "fetch") {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool ConstantFoldingPass::Fold(Node* node, int64_t max_bytes) {
+  auto& stmt = node->AsStmt();
+  auto op = stmt.op();
+  auto* scope = op->scope();
+  if (!op->CheckShape() || !op->InferShape()) return false;
+
+  int64_t in_bytes = 0;
+  for (auto* in_node : node->inlinks) {
+    in_bytes += FindTensor(scope, in_node->arg()->name)->memory_size();
+  }
+  const int64_t limit = std::max(in_bytes, max_bytes);
+  // Check the number of the outputs before running, one byte per element at
+  // least.
+  int64_t out_elements = 0;
+  for (auto* out_node : node->outlinks) {
+    const auto& dims = FindTensor(scope, out_node->arg()->name)->dims();
+    if (dims.production() < 0) return false;
+    out_elements += dims.production();
+  }
+  if (out_elements > limit) return false;
+
+  std::unique_ptr<KernelBase> kernel;
+  for (auto& candidate : op->CreateKernels(FoldingPlaces())) {
+    if (KernelMatchesInputs(*candidate, *stmt.op_info(), scope)) {
+      kernel = std::move(candidate);
+      break;
+    }
+  }
+  if (!kernel) {
+    VLOG(4) << "No host kernel to fold " << stmt.op_type();
+    return false;
+  }
+  kernel->SetContext(ContextScheduler::Global().NewContext(kernel->target()));
+  kernel->Launch();
+
+  int64_t out_bytes = 0;
+  for (auto* out_node : node->outlinks) {
+    auto* tensor = FindTensor(scope, out_node->arg()->name);
+    if (!tensor->IsInitialized() && tensor->numel() > 0) return false;
+    out_bytes += tensor->memory_size();
+  }
+  if (out_bytes > limit) {
+    VLOG(4) << "Skip folding " << stmt.op_type() << " of " << out_bytes
+            << " bytes outputs.";
+    return false;
+  }
+  VLOG(4) << "Folded " << stmt.op_type() << " by " << kernel->summary();
+  return true;
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(constant_folding_pass, paddle::lite::mir::ConstantFoldingPass)
+    .BindTargets({TARGET(kAny)});
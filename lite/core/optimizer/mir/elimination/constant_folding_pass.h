@@ -0,0 +1,53 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/tensor.h"
+#include "lite/core/types.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Fold the ops whose inputs are all persistable, or which have no inputs,
+ * e.g. the chains of fill_constant, shape, slice, concat and reshape exported
+ * by the other frameworks. Each of them is run once by the registered host,
+ * x86 or arm kernel, then removed from the graph, and its outputs become the
+ * persistable vars of the model. Since the results of a folded op turn its
+ * consumers foldable, the whole constant subgraph is folded in one pass.
+ *
+ * The ops of random or side effects and the control flow ops are never folded.
+ * An op isn't folded if its outputs take more than
+ * CONSTANT_FOLDING_MAX_BYTES(see lite/utils/env.h) and more than its inputs,
+ * to avoid blowing up the model, e.g. by expand.
+ */
+class ConstantFoldingPass : public mir::StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  bool IsFoldable(SSAGraph* graph, Node* node);
+  bool Fold(Node* node, int64_t max_bytes);
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,165 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/constant_folding_pass.h"
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The helper functions for building the model manually.
+void AddVarDesc(cpp::BlockDesc* block_desc,
+                const std::string& name,
+                VarDescAPI::VarDataType data_type,
+                const std::vector<int64_t>& shape) {
+  auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+  var_desc->SetName(name);
+  var_desc->SetType(VarDescAPI::Type::LOD_TENSOR);
+  var_desc->SetDataType(data_type);
+  var_desc->SetShape(shape);
+  var_desc->SetPersistable(false);
+}
+
+void AddFillConstantDesc(cpp::BlockDesc* block_desc,
+                         const std::string& out,
+                         const std::vector<int64_t>& shape,
+                         float value) {
+  AddVarDesc(block_desc, out, VarDescAPI::VarDataType::FP32, shape);
+  auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+  op_desc->SetType("fill_constant");
+  op_desc->SetOutput("Out", {out});
+  op_desc->SetAttr<int>("dtype", static_cast<int>(core::FluidType::FP32));
+  op_desc->SetAttr<std::vector<int64_t>>("shape", shape);
+  op_desc->SetAttr<float>("value", value);
+  op_desc->SetAttr<bool>("force_cpu", false);
+}
+
+void AddFetchDesc(cpp::BlockDesc* block_desc, const std::string& x, int col) {
+  auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+  op_desc->SetType("fetch");
+  op_desc->SetInput("X", {x});
+  op_desc->SetOutput("Out", {"fetch"});
+  op_desc->SetAttr<int>("col", col);
+}
+
+std::vector<std::string> StmtTypes(SSAGraph* graph) {
+  std::vector<std::string> types;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    types.push_back(node->AsStmt().op_type());
+  }
+  return types;
+}
+
+bool HasStmt(SSAGraph* graph, const std::string& op_type) {
+  auto types = StmtTypes(graph);
+  return std::find(types.begin(), types.end(), op_type) != types.end();
+}
+
+TEST(ConstantFoldingPass, fold) {
+  // The outputs of expand over 1KB aren't folded.
+  setenv("CONSTANT_FOLDING_MAX_BYTES", "1024", 1);
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+  auto* sub_block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+  sub_block_desc->ClearOps();
+  sub_block_desc->ClearVars();
+  auto scope = std::make_shared<Scope>();
+
+  // fill_constant -> shape, collapsed to the persistable 'shape_out'.
+  AddFillConstantDesc(block_desc, "fill_out", {2, 3}, 1.f);
+  AddVarDesc(block_desc, "shape_out", VarDescAPI::VarDataType::INT32, {2});
+  auto* shape_desc = block_desc->AddOp<cpp::OpDesc>();
+  shape_desc->SetType("shape");
+  shape_desc->SetInput("Input", {"fill_out"});
+  shape_desc->SetOutput("Out", {"shape_out"});
+  AddFetchDesc(block_desc, "shape_out", 0);
+
+  // uniform_random is random, so it's kept.
+  AddVarDesc(block_desc, "random_out", VarDescAPI::VarDataType::FP32, {2, 2});
+  auto* random_desc = block_desc->AddOp<cpp::OpDesc>();
+  random_desc->SetType("uniform_random");
+  random_desc->SetOutput("Out", {"random_out"});
+  random_desc->SetAttr<std::vector<int64_t>>("shape", {2, 2});
+  random_desc->SetAttr<float>("min", -1.f);
+  random_desc->SetAttr<float>("max", 1.f);
+  random_desc->SetAttr<int>("seed", 0);
+  random_desc->SetAttr<int>("dtype", static_cast<int>(core::FluidType::FP32));
+  AddFetchDesc(block_desc, "random_out", 1);
+
+  // expand of 4 bytes to 16KB is kept.
+  AddFillConstantDesc(block_desc, "expand_in", {1}, 2.f);
+  AddVarDesc(block_desc, "expand_out", VarDescAPI::VarDataType::FP32, {4096});
+  auto* expand_desc = block_desc->AddOp<cpp::OpDesc>();
+  expand_desc->SetType("expand_v2");
+  expand_desc->SetInput("X", {"expand_in"});
+  expand_desc->SetOutput("Out", {"expand_out"});
+  expand_desc->SetAttr<std::vector<int>>("shape", {4096});
+  AddFetchDesc(block_desc, "expand_out", 2);
+
+  // 'counter' is written again by while, so its fill_constant is kept.
+  AddFillConstantDesc(block_desc, "counter", {1}, 0.f);
+  AddVarDesc(block_desc, "cond", VarDescAPI::VarDataType::BOOL, {1});
+  auto* while_desc = block_desc->AddOp<cpp::OpDesc>();
+  while_desc->SetType("while");
+  while_desc->SetInput("X", {"counter"});
+  while_desc->SetInput("Condition", {"cond"});
+  while_desc->SetOutput("Out", {"counter"});
+  while_desc->SetAttr<int32_t>("sub_block", 1);
+  AddFetchDesc(block_desc, "counter", 3);
+
+  std::vector<Place> valid_places{{TARGET(kHost), PRECISION(kFloat)},
+                                  {TARGET(kHost), PRECISION(kAny)}};
+  Program program(program_desc, scope, valid_places);
+  auto graph = std::unique_ptr<SSAGraph>(new SSAGraph());
+  graph->Build(program, valid_places);
+  ConstantFoldingPass pass;
+  pass.Apply(graph);
+  unsetenv("CONSTANT_FOLDING_MAX_BYTES");
+
+  EXPECT_FALSE(HasStmt(graph.get(), "shape"));
+  auto* shape_out =
+      program.exec_scope()->FindVar("shape_out")->GetMutable<Tensor>();
+  ASSERT_TRUE(shape_out->persistable());
+  ASSERT_EQ(shape_out->numel(), 2);
+  EXPECT_EQ(shape_out->data<int32_t>()[0], 2);
+  EXPECT_EQ(shape_out->data<int32_t>()[1], 3);
+
+  EXPECT_TRUE(HasStmt(graph.get(), "uniform_random"));
+  EXPECT_TRUE(HasStmt(graph.get(), "expand_v2"));
+  EXPECT_TRUE(
+      program.exec_scope()->FindVar("expand_in")->Get<Tensor>().persistable());
+  EXPECT_FALSE(
+      program.exec_scope()->FindVar("expand_out")->Get<Tensor>().persistable());
+  EXPECT_TRUE(HasStmt(graph.get(), "while"));
+  EXPECT_FALSE(
+      program.exec_scope()->FindVar("counter")->Get<Tensor>().persistable());
+  // Only the fill_constant of 'counter' is left.
+  auto types = StmtTypes(graph.get());
+  EXPECT_EQ(std::count(types.begin(), types.end(), "fill_constant"), 1);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -98,4 +98,5 @@ class ElementwiseMulConstantEliminatePass : public ProgramPass {
 
 REGISTER_MIR_PASS(elementwise_mul_constant_eliminate_pass,
                   paddle::lite::mir::ElementwiseMulConstantEliminatePass)
-    .BindTargets({TARGET(kAny)});
+    .BindTargets({TARGET(kAny)})
+    .BindAnchorOps({"elementwise_mul"});
@@ -0,0 +1,245 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fp16_precision_planning_pass.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+bool IsActivation(const Node* arg_node) {
+  return !(arg_node->arg()->is_weight || arg_node->arg()->is_persist);
+}
+
+Node* GetProducer(const Node* arg_node) {
+  for (auto* producer : arg_node->inlinks) {
+    if (producer->IsStmt()) return producer;
+  }
+  return nullptr;
+}
+
+Node* FindRoot(std::map<Node*, Node*>* parents, Node* node) {
+  while (parents->at(node) != node) {
+    (*parents)[node] = parents->at(parents->at(node));
+    node = parents->at(node);
+  }
+  return node;
+}
+
+}  // namespace
+
+FP16PrecisionPlanningPass::OpKind FP16PrecisionPlanningPass::GetOpKind(
+    Node* node) const {
+  auto& instruct = node->AsStmt();
+  if (fixed_ops_.count(instruct.op_type()) ||
+      instruct.op_info()->HasAttr("enable_int8")) {
+    return OpKind::kFixed;
+  }
+  bool has_fp16_kernel = false;
+  bool has_other_kernel = false;
+  for (auto& kernel : instruct.kernels()) {
+    if (kernel->target() == TARGET(kARM) &&
+        kernel->precision() == PRECISION(kFP16)) {
+      has_fp16_kernel = true;
+    } else if (kernel->precision() != PRECISION(kAny)) {
+      has_other_kernel = true;
+    }
+  }
+  if (has_fp16_kernel && has_other_kernel) return OpKind::kFlexible;
+  if (has_fp16_kernel) return OpKind::kFP16Only;
+  if (has_other_kernel) return OpKind::kFP32Only;
+  return OpKind::kPassThrough;
+}
+
+std::map<Node*, bool> FP16PrecisionPlanningPass::InferOutputPrecisions(
+    const std::vector<Node*>& nodes) const {
+  std::map<Node*, bool> is_fp16;
+  for (auto* node : nodes) {
+    bool fp16 = false;
+    switch (kinds_.at(node)) {
+      case OpKind::kFP16Only:
+        fp16 = true;
+        break;
+      case OpKind::kFlexible:
+        fp16 = plan_.at(node);
+        break;
+      case OpKind::kPassThrough:
+        // Follow the first non-persistable input
+        for (auto* in : node->inlinks) {
+          if (!in->IsArg() || !IsActivation(in)) continue;
+          auto* producer = GetProducer(in);
+          fp16 = producer && is_fp16.count(producer) && is_fp16.at(producer);
+          break;
+        }
+        break;
+      default:
+        break;
+    }
+    is_fp16[node] = fp16;
+  }
+  return is_fp16;
+}
+
+int FP16PrecisionPlanningPass::CountCasts(
+    const std::vector<Node*>& nodes) const {
+  auto is_fp16 = InferOutputPrecisions(nodes);
+  // The calib op is shared by all of the consumers of a variable which expect
+  // the same precision, see PrecisionCastPass::AddCastInst
+  std::set<std::pair<std::string, bool>> casts;
+  for (auto* node : nodes) {
+    bool expect_fp16 = false;
+    switch (kinds_.at(node)) {
+      case OpKind::kFP32Only:
+        expect_fp16 = false;
+        break;
+      case OpKind::kFP16Only:
+        expect_fp16 = true;
+        break;
+      case OpKind::kFlexible:
+        expect_fp16 = plan_.at(node);
+        break;
+      default:
+        // No cast is inserted for feed, fetch, control flow ops and
+        // the ops with PRECISION(kAny) kernels
+        continue;
+    }
+    for (auto* in : node->inlinks) {
+      if (!in->IsArg() || !IsActivation(in)) continue;
+      auto* producer = GetProducer(in);
+      bool in_fp16 = producer && is_fp16.count(producer) && is_fp16[producer];
+      if (in_fp16 != expect_fp16) {
+        casts.insert(std::make_pair(in->arg()->name, expect_fp16));
+      }
+    }
+  }
+  return static_cast<int>(casts.size());
+}
+
+int FP16PrecisionPlanningPass::CountFP16Regions(
+    const std::vector<Node*>& nodes) const {
+  auto is_fp16 = InferOutputPrecisions(nodes);
+  std::map<Node*, Node*> parents;
+  for (auto* node : nodes) {
+    if (is_fp16[node]) parents[node] = node;
+  }
+  for (auto* node : nodes) {
+    if (!is_fp16[node]) continue;
+    for (auto* in : node->inlinks) {
+      if (!in->IsArg() || !IsActivation(in)) continue;
+      auto* producer = GetProducer(in);
+      if (producer && parents.count(producer)) {
+        parents[FindRoot(&parents, node)] = FindRoot(&parents, producer);
+      }
+    }
+  }
+  int num_regions = 0;
+  for (auto& parent : parents) {
+    if (parent.first == parent.second) num_regions++;
+  }
+  return num_regions;
+}
+
+void FP16PrecisionPlanningPass::FilterKernels(Node* node, bool use_fp16) const {
+  auto& kernels = node->AsStmt().kernels();
+  kernels.erase(std::remove_if(kernels.begin(),
+                               kernels.end(),
+                               [&](const std::unique_ptr<KernelBase>& kernel) {
+                                 bool is_fp16 =
+                                     kernel->precision() == PRECISION(kFP16);
+                                 return use_fp16 != is_fp16;
+                               }),
+                kernels.end());
+  CHECK(!kernels.empty()) << "No kernels left for "
+                          << node->AsStmt().op_type();
+}
+
+void FP16PrecisionPlanningPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  kinds_.clear();
+  plan_.clear();
+  stats_ = Stats();
+
+  std::vector<Node*> nodes;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    nodes.push_back(node);
+    kinds_[node] = GetOpKind(node);
+    // Start from the maximal fp16 plan
+    plan_[node] = kinds_[node] == OpKind::kFlexible ||
+                  kinds_[node] == OpKind::kFP16Only;
+  }
+
+  // Greedily flip the cheap ops as long as the number of casts decreases, the
+  // number of casts is a non-negative integer, so it always terminates.
+  int num_casts = CountCasts(nodes);
+  stats_.num_casts_before_planning = num_casts;
+  bool changed = true;
+  while (changed && num_casts > 0) {
+    changed = false;
+    for (auto* node : nodes) {
+      if (kinds_[node] != OpKind::kFlexible ||
+          compute_intensive_ops_.count(node->AsStmt().op_type())) {
+        continue;
+      }
+      plan_[node] = !plan_[node];
+      int flipped_num_casts = CountCasts(nodes);
+      if (flipped_num_casts < num_casts) {
+        VLOG(4) << "Plan " << node->AsStmt().op_type() << " to run in "
+                << (plan_[node] ? "fp16" : "fp32") << ", casts: " << num_casts
+                << " -> " << flipped_num_casts;
+        num_casts = flipped_num_casts;
+        changed = true;
+      } else {
+        plan_[node] = !plan_[node];
+      }
+    }
+  }
+
+  for (auto* node : nodes) {
+    auto kind = kinds_[node];
+    if (kind == OpKind::kFlexible) {
+      FilterKernels(node, plan_[node]);
+    }
+    if (kind == OpKind::kFP32Only || kind == OpKind::kFlexible ||
+        kind == OpKind::kFP16Only) {
+      stats_.num_ops++;
+      if (plan_[node]) stats_.num_fp16_ops++;
+    }
+  }
+  stats_.num_casts = num_casts;
+  stats_.num_fp16_regions = CountFP16Regions(nodes);
+
+  LOG(INFO) << "FP16 precision planning for block " << graph->blockIdx()
+            << ": fp16 ops " << stats_.num_fp16_ops << "/" << stats_.num_ops
+            << " (coverage " << stats_.fp16_coverage() * 100.f << "%)"
+            << ", fp16 regions " << stats_.num_fp16_regions << ", casts "
+            << stats_.num_casts_before_planning << " -> " << stats_.num_casts;
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(fp16_precision_planning_pass,
+                  paddle::lite::mir::FP16PrecisionPlanningPass)
+    .BindTargets({TARGET(kARM)});
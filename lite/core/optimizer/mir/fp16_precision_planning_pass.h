@@ -0,0 +1,115 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * FP16PrecisionPlanningPass decides, before static_kernel_pick_pass, which
+ * ops of an ARM fp16 model run in fp16 and which ones run in fp32.
+ *
+ * Every op that owns an ARM fp16 kernel starts in fp16. Then the ops that are
+ * cheap to compute (activations, pooling, elementwise, ...) are greedily
+ * flipped between fp16 and fp32 as long as a flip reduces the number of the
+ * calib ops type_precision_cast_pass would insert, so isolated fp16 islands
+ * inside fp32 regions (and vice versa) are removed. The compute-intensive ops
+ * (conv, fc, matmul, ...) always stay in fp16. Ops whose kernels only accept
+ * PRECISION(kAny) inherit the precision of their producer.
+ *
+ * Finally, the candidate kernels of each op are filtered according to the
+ * plan, and the fp16 coverage, the number of fp16 regions and the number of
+ * casts are reported.
+ */
+class FP16PrecisionPlanningPass : public StmtPass {
+ public:
+  struct Stats {
+    // The number of ops which have fp16 or fp32 kernels.
+    int num_ops{0};
+    // The number of ops which are planned to run in fp16.
+    int num_fp16_ops{0};
+    // The number of connected fp16 regions.
+    int num_fp16_regions{0};
+    // The number of fp16<->fp32 casts to be inserted.
+    int num_casts{0};
+    // The number of casts if every fp16-capable op ran in fp16.
+    int num_casts_before_planning{0};
+
+    float fp16_coverage() const {
+      return num_ops > 0 ? static_cast<float>(num_fp16_ops) / num_ops : 0.f;
+    }
+  };
+
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  const Stats& stats() const { return stats_; }
+
+ private:
+  enum class OpKind {
+    // feed, fetch, control flow ops and quantized ops, always fp32.
+    kFixed = 0,
+    // Only fp32 kernels are available.
+    kFP32Only,
+    // Both fp16 and fp32 kernels are available.
+    kFlexible,
+    // Only fp16 kernels are available.
+    kFP16Only,
+    // Only PRECISION(kAny) kernels are available.
+    kPassThrough,
+  };
+
+  OpKind GetOpKind(Node* node) const;
+  // Propagate the precision through the pass-through ops and return whether
+  // the output of each op is fp16.
+  std::map<Node*, bool> InferOutputPrecisions(
+      const std::vector<Node*>& nodes) const;
+  // Count the casts that type_precision_cast_pass would insert for the
+  // current plan, a cast is shared by all of the consumers of a variable.
+  int CountCasts(const std::vector<Node*>& nodes) const;
+  int CountFP16Regions(const std::vector<Node*>& nodes) const;
+  void FilterKernels(Node* node, bool use_fp16) const;
+
+  std::map<Node*, OpKind> kinds_;
+  std::map<Node*, bool> plan_;
+  Stats stats_;
+
+  // The compute-intensive ops which are always kept in fp16 once they have an
+  // fp16 kernel, the casts around them are paid off by the fp16 compute.
+  const std::set<std::string> compute_intensive_ops_{
+      "conv2d",
+      "depthwise_conv2d",
+      "conv2d_transpose",
+      "depthwise_conv2d_transpose",
+      "fc",
+      "gru",
+      "sequence_conv",
+      "matmul",
+      "matmul_v2",
+      "mul"};
+  const std::set<std::string> fixed_ops_{
+      "feed", "fetch", "while", "conditional_block", "subgraph", "io_copy"};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -78,4 +78,5 @@ void ConvConvFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 }  // namespace paddle
 
 REGISTER_MIR_PASS(lite_conv_conv_fuse_pass, paddle::lite::mir::ConvConvFusePass)
-    .BindTargets({TARGET(kARM), TARGET(kOpenCL), TARGET(kX86)});
+    .BindTargets({TARGET(kARM), TARGET(kOpenCL), TARGET(kX86)})
+    .BindAnchorOps({"conv2d"});
@@ -0,0 +1,164 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/conv_elementwise_fuser.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void AddVarDesc(cpp::BlockDesc* block_desc,
+                const std::string& name,
+                bool persistable = false) {
+  auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+  var_desc->SetName(name);
+  var_desc->SetType(VarDescAPI::Type::LOD_TENSOR);
+  var_desc->SetDataType(VarDescAPI::VarDataType::FP32);
+  var_desc->SetPersistable(persistable);
+}
+
+void AddWeight(cpp::BlockDesc* block_desc,
+               Scope* scope,
+               const std::string& name,
+               const std::vector<int64_t>& shape) {
+  AddVarDesc(block_desc, name, true);
+  auto* tensor = scope->Var(name)->GetMutable<Tensor>();
+  tensor->Resize(shape);
+  auto* data = tensor->mutable_data<float>();
+  for (int64_t i = 0; i < tensor->numel(); i++) {
+    data[i] = static_cast<float>(i % 5) - 2.f;
+  }
+  tensor->set_persistable(true);
+}
+
+// x -> conv2d(filter_<suffix>) -> conv_<suffix>
+//   -> <eltwise_type>(bias_<suffix>) -> out_<suffix>
+void AddConvEltwise(cpp::BlockDesc* block_desc,
+                    Scope* scope,
+                    const std::string& suffix,
+                    const std::string& eltwise_type) {
+  AddWeight(block_desc, scope, "filter_" + suffix, {4, 4, 1, 1});
+  AddWeight(block_desc, scope, "bias_" + suffix, {4});
+  AddVarDesc(block_desc, "conv_" + suffix);
+  AddVarDesc(block_desc, "out_" + suffix);
+  auto* conv_desc = block_desc->AddOp<cpp::OpDesc>();
+  conv_desc->SetType("conv2d");
+  conv_desc->SetInput("Input", {"x"});
+  conv_desc->SetInput("Filter", {"filter_" + suffix});
+  conv_desc->SetOutput("Output", {"conv_" + suffix});
+  conv_desc->SetAttr<std::vector<int>>("strides", {1, 1});
+  conv_desc->SetAttr<std::vector<int>>("paddings", {0, 0});
+  conv_desc->SetAttr<std::vector<int>>("dilations", {1, 1});
+  conv_desc->SetAttr<int>("groups", 1);
+  auto* eltwise_desc = block_desc->AddOp<cpp::OpDesc>();
+  eltwise_desc->SetType(eltwise_type);
+  eltwise_desc->SetInput("X", {"conv_" + suffix});
+  eltwise_desc->SetInput("Y", {"bias_" + suffix});
+  eltwise_desc->SetOutput("Out", {"out_" + suffix});
+  eltwise_desc->SetAttr<int>("axis", 1);
+}
+
+// The statement nodes of the op type without the op type index.
+std::vector<Node*> ScanStmtNodesOfType(SSAGraph* graph,
+                                       const std::string& op_type) {
+  std::vector<Node*> nodes;
+  for (auto& node : graph->nodes()) {
+    if (node.IsStmt() && node.stmt()->op_type() == op_type) {
+      nodes.push_back(const_cast<Node*>(&node));
+    }
+  }
+  return nodes;
+}
+
+void ExpectOpTypeIndex(SSAGraph* graph) {
+  for (auto& op_type : {"conv2d", "elementwise_add", "elementwise_sub"}) {
+    EXPECT_EQ(graph->StmtNodesOfType(op_type),
+              ScanStmtNodesOfType(graph, op_type))
+        << op_type;
+  }
+}
+
+// The conv2d producing the output and its bias after the fusion.
+void ExpectFused(SSAGraph* graph, const std::string& suffix) {
+  Node* conv = nullptr;
+  for (auto* node : ScanStmtNodesOfType(graph, "conv2d")) {
+    if (node->stmt()->op_info()->Output("Output").front() == "out_" + suffix) {
+      conv = node;
+    }
+  }
+  ASSERT_NE(conv, nullptr) << suffix;
+  auto bias = conv->stmt()->op_info()->Input("Bias");
+  EXPECT_EQ(bias, std::vector<std::string>({"bias_" + suffix}));
+  ASSERT_EQ(conv->outlinks.size(), 1u);
+  EXPECT_EQ(conv->outlinks.front()->arg()->name, "out_" + suffix);
+  EXPECT_EQ(graph->RetrieveArgument("conv_" + suffix), nullptr);
+}
+
+TEST(ConvElementwiseFuser, op_type_index) {
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+  auto scope = std::make_shared<Scope>();
+  AddVarDesc(block_desc, "x");
+  AddConvEltwise(block_desc, scope.get(), "a", "elementwise_add");
+  AddConvEltwise(block_desc, scope.get(), "b", "elementwise_sub");
+
+  std::vector<Place> places{Place{TARGET(kX86), PRECISION(kFloat)}};
+  Program program(program_desc, scope, places);
+  std::unique_ptr<SSAGraph> graph(new SSAGraph);
+  graph->Build(program, places);
+  graph->SetValidPlaces(places);
+  ExpectOpTypeIndex(graph.get());
+
+  // Only the conv2d + elementwise_add of 'a' are matched from the index.
+  fusion::ConvElementwiseFuser fuser("conv2d", false);
+  EXPECT_EQ(fuser(graph.get()), 1u);
+  ExpectFused(graph.get(), "a");
+  ExpectOpTypeIndex(graph.get());
+  EXPECT_EQ(graph->StmtNodesOfType("conv2d").size(), 2u);
+  EXPECT_TRUE(graph->StmtNodesOfType("elementwise_add").empty());
+  ASSERT_EQ(graph->StmtNodesOfType("elementwise_sub").size(), 1u);
+
+  // The elementwise_sub of 'b' is retyped in place, which isn't seen by the
+  // index until it's invalidated.
+  auto* stmt = graph->StmtNodesOfType("elementwise_sub").front()->stmt();
+  auto op_desc = *stmt->op_info();
+  op_desc.SetType("elementwise_add");
+  stmt->ResetOp(op_desc, graph->valid_places());
+  EXPECT_TRUE(graph->StmtNodesOfType("elementwise_add").empty());
+  graph->InvalidateOpTypeIndex();
+  ExpectOpTypeIndex(graph.get());
+  EXPECT_EQ(graph->StmtNodesOfType("elementwise_add").size(), 1u);
+
+  fusion::ConvElementwiseFuser retyped_fuser("conv2d", false);
+  EXPECT_EQ(retyped_fuser(graph.get()), 1u);
+  ExpectFused(graph.get(), "a");
+  ExpectFused(graph.get(), "b");
+  ExpectOpTypeIndex(graph.get());
+  EXPECT_EQ(graph->StmtNodesOfType("conv2d").size(), 2u);
+  EXPECT_TRUE(graph->StmtNodesOfType("elementwise_add").empty());
+  EXPECT_TRUE(graph->StmtNodesOfType("elementwise_sub").empty());
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
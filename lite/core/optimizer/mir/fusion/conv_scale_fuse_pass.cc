@@ -73,4 +73,5 @@ void ConvScaleFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(lite_conv_scale_fuse_pass,
                   paddle::lite::mir::ConvScaleFusePass)
-    .BindTargets({TARGET(kOpenCL), TARGET(kARM), TARGET(kX86)});
+    .BindTargets({TARGET(kOpenCL), TARGET(kARM), TARGET(kX86)})
+    .BindAnchorOps({"scale"});
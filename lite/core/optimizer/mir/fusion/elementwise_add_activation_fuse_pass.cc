@@ -51,6 +51,16 @@ void ElementwiseActivationFusePass::Apply(
     act_types.push_back("gelu");
   }
 
+  // x86 fuses relu, tanh, sigmoid and abs into all of the elementwise ops
+  // which have a fusion op.
+  bool has_x86 = has_target(TARGET(kX86));
+  if (has_x86 && !has_arm && !has_opencl) {
+    elt_types.push_back("elementwise_div");
+    elt_types.push_back("elementwise_max");
+    elt_types.push_back("elementwise_min");
+    act_types.push_back("sigmoid");
+  }
+
   // start fuse using params
   for (auto elt_type : elt_types) {
     for (auto act_type : act_types) {
@@ -52,16 +52,8 @@ void ElementwiseActivationFuser::BuildPattern() {
 void ElementwiseActivationFuser::InsertNewNode(SSAGraph* graph,
                                                const key2nodes_t& matched) {
   auto op_desc = GenOpDesc(matched);
-  std::shared_ptr<lite::OpLite> op;
-  if (eltwise_type_ == "elementwise_add") {
-    op = LiteOpRegistry::Global().Create("fusion_elementwise_add_activation");
-  } else if (eltwise_type_ == "elementwise_sub") {
-    op = LiteOpRegistry::Global().Create("fusion_elementwise_sub_activation");
-  } else if (eltwise_type_ == "elementwise_mul") {
-    op = LiteOpRegistry::Global().Create("fusion_elementwise_mul_activation");
-  } else {
-    LOG(FATAL) << "not supported elementwise_type: " << eltwise_type_;
-  }
+  auto op = LiteOpRegistry::Global().Create(op_desc.Type());
+  CHECK(op) << "not supported elementwise_type: " << eltwise_type_;
 
   auto old_op = matched.at("elt")->stmt()->op();
   auto* scope = old_op->scope();
@@ -77,15 +69,8 @@ void ElementwiseActivationFuser::InsertNewNode(SSAGraph* graph,
 cpp::OpDesc ElementwiseActivationFuser::GenOpDesc(const key2nodes_t& matched) {
   auto op_desc = *matched.at("elt")->stmt()->op_info();
   auto* act_op_desc = matched.at("act")->stmt()->op_info();
-  if (eltwise_type_ == "elementwise_add") {
-    op_desc.SetType("fusion_elementwise_add_activation");
-  } else if (eltwise_type_ == "elementwise_sub") {
-    op_desc.SetType("fusion_elementwise_sub_activation");
-  } else if (eltwise_type_ == "elementwise_mul") {
-    op_desc.SetType("fusion_elementwise_mul_activation");
-  } else {
-    LOG(FATAL) << "not supported elementwise_type: " << eltwise_type_;
-  }
+  // i.e. elementwise_add -> fusion_elementwise_add_activation
+  op_desc.SetType("fusion_" + eltwise_type_ + "_activation");
   op_desc.SetAttr("act_type", act_type_);
   auto& out_name = matched.at("output")->arg()->name;
   op_desc.SetOutput("Out", {out_name});
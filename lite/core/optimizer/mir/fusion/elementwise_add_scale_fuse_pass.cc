@@ -40,4 +40,5 @@ void ElementwiseScaleFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(lite_elementwise_scale_fuse_pass,
                   paddle::lite::mir::ElementwiseScaleFusePass)
-    .BindTargets({TARGET(kOpenCL)});
+    .BindTargets({TARGET(kOpenCL)})
+    .BindAnchorOps({"elementwise_mul"});
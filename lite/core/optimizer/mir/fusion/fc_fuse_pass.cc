@@ -81,4 +81,5 @@ REGISTER_MIR_PASS(lite_fc_fuse_pass, paddle::lite::mir::FcFusePass)
     .ExcludeTargets({TARGET(kX86)})
 #endif
     .ExcludeTargets({TARGET(kBM)})
-    .BindKernel("fc");
+    .BindKernel("fc")
+    .BindAnchorOps({"mul", "matmul", "matmul_v2"});
@@ -33,4 +33,5 @@ void FcPreluFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(lite_fc_prelu_fuse_pass, paddle::lite::mir::FcPreluFusePass)
     .BindTargets({TARGET(kOpenCL)})
-    .BindKernel("fc");
+    .BindKernel("fc")
+    .BindAnchorOps({"prelu"});
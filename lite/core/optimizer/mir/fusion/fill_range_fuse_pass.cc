@@ -32,4 +32,5 @@ void FillRangeFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 }  // namespace paddle
 
 REGISTER_MIR_PASS(fill_range_fuse_pass, paddle::lite::mir::FillRangeFusePass)
-    .BindTargets({TARGET(kNNAdapter)});
+    .BindTargets({TARGET(kNNAdapter)})
+    .BindAnchorOps({"range"});
@@ -37,4 +37,5 @@ void FlattenFcFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 REGISTER_MIR_PASS(lite_flatten_fc_fuse_pass,
                   paddle::lite::mir::FlattenFcFusePass)
     .BindTargets({TARGET(kOpenCL), TARGET(kARM), TARGET(kX86)})
-    .BindKernel("fc");
+    .BindKernel("fc")
+    .BindAnchorOps({"flatten_contiguous_range"});
@@ -34,4 +34,5 @@ void GreaterThanCastFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 REGISTER_MIR_PASS(lite_greater_than_cast_fuse_pass,
                   paddle::lite::mir::GreaterThanCastFusePass)
     .BindTargets({TARGET(kOpenCL)})
-    .BindKernel("greater_than");
+    .BindKernel("greater_than")
+    .BindAnchorOps({"greater_than"});
@@ -43,4 +43,12 @@ void InplaceFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(lite_inplace_fuse_pass, paddle::lite::mir::InplaceFusePass)
     .BindTargets({TARGET(kAny)})
-    .ExcludeTargets({TARGET(kNPU)});
+    .ExcludeTargets({TARGET(kNPU)})
+    .BindAnchorOps({"reshape",
+                    "reshape2",
+                    "flatten",
+                    "flatten2",
+                    "squeeze",
+                    "squeeze2",
+                    "unsqueeze",
+                    "unsqueeze2"});
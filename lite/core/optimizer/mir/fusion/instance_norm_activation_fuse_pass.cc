@@ -37,4 +37,5 @@ void InstanceNormActivationFusePass::Apply(
 REGISTER_MIR_PASS(lite_instance_norm_activation_fuse_pass,
                   paddle::lite::mir::InstanceNormActivationFusePass)
     .BindTargets({TARGET(kOpenCL)})
-    .BindKernel("instance_norm");
+    .BindKernel("instance_norm")
+    .BindAnchorOps({"instance_norm"});
@@ -35,4 +35,5 @@ void MatchMatrixActFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(lite_match_matrix_activation_fuse_pass,
                   paddle::lite::mir::MatchMatrixActFusePass)
-    .BindTargets({TARGET(kCUDA)});
+    .BindTargets({TARGET(kCUDA)})
+    .BindAnchorOps({"match_matrix_tensor"});
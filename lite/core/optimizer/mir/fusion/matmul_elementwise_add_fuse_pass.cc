@@ -54,4 +54,5 @@ REGISTER_MIR_PASS(lite_matmul_element_add_fuse_pass,
                   paddle::lite::mir::MatmulElementwiseAddFusePass)
     .BindTargets({TARGET(kAny)})
     .ExcludeTargets({TARGET(kXPU)})
-    .BindKernel("fc");
+    .BindKernel("fc")
+    .BindAnchorOps({"matmul"});
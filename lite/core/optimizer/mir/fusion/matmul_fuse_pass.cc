@@ -33,4 +33,5 @@ void MatmulFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(lite_matmul_fuse_pass, paddle::lite::mir::MatmulFusePass)
     .BindTargets({TARGET(kAny)})
-    .ExcludeTargets({TARGET(kOpenCL)});
+    .ExcludeTargets({TARGET(kOpenCL)})
+    .BindAnchorOps({"matmul"});
@@ -33,4 +33,5 @@ void Reshape2MatmulFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(lite_reshape2_matmul_fuse_pass,
                   paddle::lite::mir::Reshape2MatmulFusePass)
-    .BindTargets({TARGET(kAny)});
+    .BindTargets({TARGET(kAny)})
+    .BindAnchorOps({"reshape2"});
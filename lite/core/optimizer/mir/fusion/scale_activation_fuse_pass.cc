@@ -37,4 +37,5 @@ REGISTER_MIR_PASS(lite_scale_activation_fuse_pass,
                   paddle::lite::mir::ScaleActivationFusePass)
     .BindTargets({TARGET(kARM)})
     .ExcludeTargets({TARGET(kNPU), TARGET(kXPU), TARGET(kNNAdapter)})
-    .BindKernel("scale");
+    .BindKernel("scale")
+    .BindAnchorOps({"scale"});
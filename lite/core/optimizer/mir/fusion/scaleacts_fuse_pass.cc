@@ -35,4 +35,5 @@ void ScaleactsFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(lite_scaleacts_fuse_pass,
                   paddle::lite::mir::ScaleactsFusePass)
-    .BindTargets({TARGET(kOpenCL)});
+    .BindTargets({TARGET(kOpenCL)})
+    .BindAnchorOps({"scale"});
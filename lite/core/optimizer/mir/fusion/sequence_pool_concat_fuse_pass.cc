@@ -36,4 +36,5 @@ void SequencePoolConcatFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(lite_sequence_pool_concat_fuse_pass,
                   paddle::lite::mir::SequencePoolConcatFusePass)
-    .BindTargets({TARGET(kCUDA)});
+    .BindTargets({TARGET(kCUDA)})
+    .BindAnchorOps({"sequence_pool"});
@@ -34,4 +34,5 @@ void SequenceReverseEmbeddingFusePass::Apply(
 
 REGISTER_MIR_PASS(lite_sequence_reverse_embedding_fuse_pass,
                   paddle::lite::mir::SequenceReverseEmbeddingFusePass)
-    .BindTargets({TARGET(kCUDA)});
+    .BindTargets({TARGET(kCUDA)})
+    .BindAnchorOps({"sequence_reverse"});
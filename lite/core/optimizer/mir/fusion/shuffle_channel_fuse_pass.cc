@@ -37,4 +37,5 @@ void ShuffleChannelFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 REGISTER_MIR_PASS(lite_shuffle_channel_fuse_pass,
                   paddle::lite::mir::ShuffleChannelFusePass)
     .BindTargets({TARGET(kAny)})
-    .BindKernel("shuffle_channel");
+    .BindKernel("shuffle_channel")
+    .BindAnchorOps({"transpose", "transpose2"});
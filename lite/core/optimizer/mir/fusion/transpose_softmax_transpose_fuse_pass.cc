@@ -37,4 +37,5 @@ void TransposeSoftmaxTransposeFusePass::Apply(
 
 REGISTER_MIR_PASS(lite_transpose_softmax_transpose_fuse_pass,
                   paddle::lite::mir::TransposeSoftmaxTransposeFusePass)
-    .BindTargets({TARGET(kAny)});
+    .BindTargets({TARGET(kAny)})
+    .BindAnchorOps({"softmax"});
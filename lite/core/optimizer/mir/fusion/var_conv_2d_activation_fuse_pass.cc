@@ -37,4 +37,5 @@ void VarConv2dActivationFusePass::Apply(
 
 REGISTER_MIR_PASS(lite_var_conv_2d_activation_fuse_pass,
                   paddle::lite::mir::VarConv2dActivationFusePass)
-    .BindTargets({TARGET(kCUDA)});
+    .BindTargets({TARGET(kCUDA)})
+    .BindAnchorOps({"var_conv_2d"});
@@ -0,0 +1,406 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/kernel_cost_table.h"
+#include <cctype>
+#include <cstdlib>
+#include "lite/core/op_lite.h"
+#include "lite/utils/io.h"
+#include "lite/utils/string.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+// The elements of a var whose size isn't measured, e.g. a feature map of
+// 64x32x32.
+constexpr int64_t kNominalVarSize = 1 << 16;
+// The costs per element in milliseconds of the casts if they aren't in the
+// tables, io_copy between the devices, calib between the precisions and
+// layout between the data layouts.
+constexpr double kIoCopyLatency = 1e-6;
+constexpr double kCalibLatency = 5e-7;
+constexpr double kLayoutLatency = 1e-6;
+
+std::string Trim(const std::string& str) {
+  size_t begin = str.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos) return "";
+  size_t end = str.find_last_not_of(" \t\r\n");
+  return str.substr(begin, end - begin + 1);
+}
+
+// All of the integers in 'str', e.g. [1 1], 3x3 or 1.
+std::vector<int64_t> ParseInts(const std::string& str) {
+  std::vector<int64_t> values;
+  const char* p = str.c_str();
+  while (*p) {
+    if (isdigit(*p) || (*p == '-' && isdigit(*(p + 1)))) {
+      char* end = nullptr;
+      values.push_back(strtoll(p, &end, 10));
+      p = end;
+    } else {
+      p++;
+    }
+  }
+  return values;
+}
+
+// The params of (key0=value0, key1=[v0 v1], ...).
+std::map<std::string, std::string> ParseParams(const std::string& str) {
+  std::map<std::string, std::string> params;
+  std::string item;
+  int depth = 0;
+  auto add_item = [&]() {
+    auto pos = item.find('=');
+    if (pos != std::string::npos) {
+      params[Trim(item.substr(0, pos))] = Trim(item.substr(pos + 1));
+    }
+    item.clear();
+  };
+  for (char c : str) {
+    if (c == '(' || c == ')') continue;
+    if (c == '[') depth++;
+    if (c == ']') depth--;
+    if (c == ',' && depth == 0) {
+      add_item();
+    } else {
+      item += c;
+    }
+  }
+  add_item();
+  return params;
+}
+
+template <typename T>
+bool ParseEnum(const std::string& str,
+               int num,
+               const std::string& (*to_str)(T),
+               T* value) {
+  for (int i = 0; i < num; i++) {
+    if (to_str(static_cast<T>(i)) == str) {
+      *value = static_cast<T>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+// The place of 'target/precision/layout', the omitted fields are kAny.
+Place ParsePlace(const std::string& str) {
+  Place place{TARGET(kAny), PRECISION(kAny), DATALAYOUT(kAny)};
+  auto fields = Split(str, "/");
+  if (fields.size() > 0) {
+    ParseEnum(fields[0],
+              static_cast<int>(TARGET(NUM)),
+              &lite_api::TargetToStr,
+              &place.target);
+  }
+  if (fields.size() > 1) {
+    ParseEnum(fields[1],
+              static_cast<int>(PRECISION(NUM)),
+              &lite_api::PrecisionToStr,
+              &place.precision);
+  }
+  if (fields.size() > 2) {
+    ParseEnum(fields[2],
+              static_cast<int>(DATALAYOUT(NUM)),
+              &lite_api::DataLayoutToStr,
+              &place.layout);
+  }
+  return place;
+}
+
+// The target of the armv7/v8 column of the header, e.g. armv8 or x86_64.
+TargetType ParseArch(const std::string& arch) {
+  if (arch.compare(0, 3, "arm") == 0 || arch == "aarch64") return TARGET(kARM);
+  if (arch == "x86_64" || arch == "AMD64" || arch == "x86" ||
+      arch == "i686") {
+    return TARGET(kX86);
+  }
+  return TARGET(kAny);
+}
+
+PrecisionType ParseDtype(const std::string& dtype) {
+  if (dtype == "float") return PRECISION(kFloat);
+  if (dtype == "fp16") return PRECISION(kFP16);
+  if (dtype.compare(0, 4, "int8") == 0) return PRECISION(kInt8);
+  return PRECISION(kAny);
+}
+
+bool PlaceMatch(const Place& row, const KernelBase& kernel) {
+  return (row.target == TARGET(kAny) || row.target == kernel.target()) &&
+         (row.precision == PRECISION(kAny) ||
+          row.precision == kernel.precision()) &&
+         (row.layout == DATALAYOUT(kAny) || row.layout == kernel.layout());
+}
+
+// The value of the row matches the values of the op, one value in the row
+// applies to all of the dims, e.g. stride=1 of [1 1].
+bool IntsMatch(const std::string& row_value,
+               const std::vector<int64_t>& values) {
+  auto row_values = ParseInts(row_value);
+  if (row_values.size() == 1) {
+    for (auto value : values) {
+      if (value != row_values[0]) return false;
+    }
+    return true;
+  }
+  return row_values == values;
+}
+
+template <typename T>
+std::vector<int64_t> ToInt64s(const std::vector<T>& values) {
+  return std::vector<int64_t>(values.begin(), values.end());
+}
+
+const Tensor* FindTensor(Node* node, const std::string& arg_name) {
+  auto& stmt = node->AsStmt();
+  auto* op_info = stmt.op_info();
+  if (!op_info->HasInput(arg_name) || op_info->Input(arg_name).empty()) {
+    return nullptr;
+  }
+  auto* scope = stmt.op() ? stmt.op()->scope() : nullptr;
+  auto* var = scope ? scope->FindVar(op_info->Input(arg_name).front())
+                    : nullptr;
+  if (!var || !var->IsType<Tensor>()) return nullptr;
+  return &var->Get<Tensor>();
+}
+
+}  // namespace
+
+bool KernelCostTable::Load(const std::string& paths) {
+  for (auto& path : Split(paths, ",")) {
+    path = Trim(path);
+    if (path.empty()) continue;
+    if (!IsFileExists(path)) {
+      LOG(WARNING) << "Missing the latency lookup table " << path;
+      continue;
+    }
+    ParseTable(ReadLines(path));
+  }
+  LOG(INFO) << "Load " << op_rows_.size() << " op rows and "
+            << layer_rows_.size() << " layers of the latency lookup tables "
+            << paths;
+  return !op_rows_.empty() || !layer_rows_.empty();
+}
+
+void KernelCostTable::ParseTable(const std::vector<std::string>& lines) {
+  TargetType target = TARGET(kAny);
+  for (size_t i = 0; i < lines.size(); i++) {
+    auto fields = Split(lines[i], "\t");
+    for (auto& field : fields) {
+      field = Trim(field);
+    }
+    if (fields.empty() || fields[0].empty() || fields[0][0] == '#' ||
+        fields[0] == "op_name") {
+      continue;
+    }
+    if (fields[0] == "dev_info") {
+      if (i + 1 < lines.size()) {
+        auto dev_fields = Split(lines[++i], "\t");
+        if (dev_fields.size() > 1) target = ParseArch(Trim(dev_fields[1]));
+      }
+      continue;
+    }
+    if (fields.size() < 7) {
+      LOG(WARNING) << "Skip the row of the latency lookup table: " << lines[i];
+      continue;
+    }
+    Row row;
+    row.op_name = fields[0];
+    row.input_dims = ParseInts(fields[1]);
+    row.output_dims = ParseInts(fields[2]);
+    row.params = ParseParams(fields[3]);
+    row.latency = atof(fields[6].c_str());
+    if (row.params.count("kernel") &&
+        row.params.at("kernel").find('/') != std::string::npos) {
+      row.place = ParsePlace(row.params.at("kernel"));
+    } else {
+      row.place = Place{target, PRECISION(kAny), DATALAYOUT(kAny)};
+      if (row.params.count("target")) {
+        row.place.target = ParsePlace(row.params.at("target")).target;
+      }
+      if (row.params.count("dtype")) {
+        row.place.precision = ParseDtype(row.params.at("dtype"));
+      }
+    }
+
+    if (row.op_name == "io_copy" || row.op_name == "calib" ||
+        row.op_name == "layout") {
+      int64_t size = 1;
+      for (auto dim : row.input_dims) size *= dim;
+      if (size > 0) cast_latencies_[row.op_name] = row.latency / size;
+    } else if (row.params.count("output")) {
+      auto output = row.params.at("output");
+      if (!row.output_dims.empty()) var_dims_[output] = row.output_dims;
+      layer_rows_[output].push_back(row);
+    } else {
+      op_rows_.push_back(row);
+    }
+  }
+}
+
+bool KernelCostTable::MatchRow(Node* node, const Row& row) const {
+  auto& stmt = node->AsStmt();
+  auto* op_info = stmt.op_info();
+  auto op_type = stmt.op_type();
+  auto& params = row.params;
+  auto has = [&](const std::string& key) { return params.count(key) > 0; };
+
+  if (row.op_name == "conv") {
+    if (op_type != "conv2d" && op_type != "depthwise_conv2d") return false;
+    if (has("stride") &&
+        !IntsMatch(params.at("stride"),
+                   ToInt64s(op_info->GetAttr<std::vector<int>>("strides")))) {
+      return false;
+    }
+    if (has("group") &&
+        !IntsMatch(params.at("group"), {op_info->GetAttr<int>("groups")})) {
+      return false;
+    }
+    if (has("dilation") && op_info->HasAttr("dilations") &&
+        !IntsMatch(
+            params.at("dilation"),
+            ToInt64s(op_info->GetAttr<std::vector<int>>("dilations")))) {
+      return false;
+    }
+    auto* filter = FindTensor(node, "Filter");
+    if (filter && filter->dims().size() == 4) {
+      auto dims = filter->dims().Vectorize();
+      if (has("ch_out") && !IntsMatch(params.at("ch_out"), {dims[0]})) {
+        return false;
+      }
+      if (has("kernel") &&
+          !IntsMatch(params.at("kernel"), {dims[2], dims[3]})) {
+        return false;
+      }
+    }
+  } else if (row.op_name == "pooling") {
+    if (op_type != "pool2d") return false;
+    if (has("pooling_type") &&
+        params.at("pooling_type") !=
+            op_info->GetAttr<std::string>("pooling_type")) {
+      return false;
+    }
+    bool global = op_info->HasAttr("global_pooling") &&
+                  op_info->GetAttr<bool>("global_pooling");
+    if (has("flag_global") &&
+        (ParseInts(params.at("flag_global")) != std::vector<int64_t>{0}) !=
+            global) {
+      return false;
+    }
+    if (!global && has("kernel") &&
+        !IntsMatch(params.at("kernel"),
+                   ToInt64s(op_info->GetAttr<std::vector<int>>("ksize")))) {
+      return false;
+    }
+    if (!global && has("stride") &&
+        !IntsMatch(params.at("stride"),
+                   ToInt64s(op_info->GetAttr<std::vector<int>>("strides")))) {
+      return false;
+    }
+  } else if (row.op_name == "fc") {
+    if (op_type != "fc") return false;
+    auto* w = FindTensor(node, "W");
+    if (w && has("param_dim") &&
+        !IntsMatch(params.at("param_dim"), w->dims().Vectorize())) {
+      return false;
+    }
+  } else if (row.op_name == "activation") {
+    if (!has("act_type") || op_type != params.at("act_type")) return false;
+  } else if (row.op_name == "elementwise") {
+    if (!has("elt_type") || op_type != "elementwise_" + params.at("elt_type")) {
+      return false;
+    }
+  } else if (row.op_name == "batchnorm") {
+    if (op_type != "batch_norm") return false;
+  } else if (row.op_name == "matmul" || row.op_name == "lookup_table") {
+    if (op_type != row.op_name && op_type != row.op_name + "_v2") return false;
+  } else if (op_type != row.op_name) {
+    return false;
+  }
+
+  // The shapes of the inputs are mostly unknown before running, they're only
+  // checked if known.
+  if (!row.input_dims.empty()) {
+    auto* input = FindTensor(node, "X");
+    if (!input) input = FindTensor(node, "Input");
+    if (input && input->dims().size() > 0 &&
+        input->dims().Vectorize() != row.input_dims) {
+      return false;
+    }
+  }
+  return true;
+}
+
+double KernelCostTable::KernelLatency(Node* node,
+                                      const KernelBase& kernel) const {
+  auto& stmt = node->AsStmt();
+  auto output_names = stmt.op_info()->output_names();
+  if (!output_names.empty()) {
+    auto it = layer_rows_.find(output_names.front());
+    if (it != layer_rows_.end()) {
+      for (auto& row : it->second) {
+        if (row.op_name == stmt.op_type() && PlaceMatch(row.place, kernel)) {
+          return row.latency;
+        }
+      }
+    }
+  }
+  // The mean of the rows of the same attributes but the different shapes.
+  double latency = 0;
+  int count = 0;
+  for (auto& row : op_rows_) {
+    if (PlaceMatch(row.place, kernel) && MatchRow(node, row)) {
+      latency += row.latency;
+      count++;
+    }
+  }
+  return count > 0 ? latency / count : -1;
+}
+
+int64_t KernelCostTable::VarSize(const std::string& name) const {
+  auto it = var_dims_.find(name);
+  if (it == var_dims_.end()) return kNominalVarSize;
+  int64_t size = 1;
+  for (auto dim : it->second) size *= dim;
+  return size;
+}
+
+double KernelCostTable::CastLatency(const std::string& name,
+                                    const Type& from,
+                                    const Type& to) const {
+  auto latency_of = [&](const std::string& op_name, double latency) {
+    auto it = cast_latencies_.find(op_name);
+    return (it != cast_latencies_.end() ? it->second : latency) *
+           VarSize(name);
+  };
+  double latency = 0;
+  if (!TargetCompatibleTo(from, to)) {
+    latency += latency_of("io_copy", kIoCopyLatency);
+  }
+  if (!PrecisionCompatibleTo(from, to)) {
+    latency += latency_of("calib", kCalibLatency);
+  }
+  if (!DataLayoutCompatibleTo(from, to)) {
+    latency += latency_of("layout", kLayoutLatency);
+  }
+  return latency;
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
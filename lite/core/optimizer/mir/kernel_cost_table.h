@@ -0,0 +1,87 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include "lite/core/kernel.h"
+#include "lite/core/optimizer/mir/node.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * The latencies of the kernels loaded from the latency lookup tables of
+ * lite/tests/benchmark, the cost model of StaticKernelPickPass picks the
+ * kernels by them.
+ *
+ * Two kinds of the op rows are looked up:
+ * 1. The layer rows measured on the model by benchmark_bin
+ *    --kernel_latency_table_out, whose op_name is the op type and the
+ *    param_info names the first output of the op and the place of the kernel,
+ *    e.g.
+ *    conv2d  []  [1 32 56 56]  (output=conv2d_1.tmp_0,kernel=arm/float/NCHW)
+ * 2. The rows of get_latency_lookup_table(_x86).py, e.g. conv and pooling,
+ *    which are matched by the attributes of the op. Their target comes from
+ *    the armv7/v8 column of the header of the table, or the 'target' param,
+ *    and the precision from the 'dtype' param.
+ * The rows named io_copy, calib and layout give the costs of the casts per
+ * element of their input_dims.
+ */
+class KernelCostTable {
+ public:
+  // Load the tables of 'paths' separated by ',', return false if none of the
+  // rows is loaded.
+  bool Load(const std::string& paths);
+
+  // The latency in milliseconds of 'kernel' running the op of 'node', -1 if
+  // it's unknown.
+  double KernelLatency(Node* node, const KernelBase& kernel) const;
+  // The latency in milliseconds of casting the var 'name' from 'from' to
+  // 'to', i.e. the io_copy, calib and layout ops inserted by the type cast
+  // passes, 0 if the types are compatible.
+  double CastLatency(const std::string& name,
+                     const Type& from,
+                     const Type& to) const;
+
+ private:
+  struct Row {
+    std::string op_name;
+    std::vector<int64_t> input_dims;
+    std::vector<int64_t> output_dims;
+    std::map<std::string, std::string> params;
+    Place place;
+    double latency{0};
+  };
+
+  void ParseTable(const std::vector<std::string>& lines);
+  bool MatchRow(Node* node, const Row& row) const;
+  // The elements of the var 'name' measured by the layer rows, or a nominal
+  // number if it's not measured.
+  int64_t VarSize(const std::string& name) const;
+
+  // The layer rows by the first output of the op.
+  std::map<std::string, std::vector<Row>> layer_rows_;
+  std::vector<Row> op_rows_;
+  std::map<std::string, std::vector<int64_t>> var_dims_;
+  // The costs of the casts per element by the op name.
+  std::map<std::string, double> cast_latencies_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,55 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/kernel_cost_table.h"
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+TEST(KernelCostTable, cast_latency) {
+  const std::string path = "kernel_cost_table_test.txt";
+  std::ofstream fs(path);
+  fs << "dev_info\tarmv7/v8\tcore_num\tthread_num\tpower_mode\n"
+     << "benchmark_bin\tx86_64\t4\t1\t0\n"
+     << "op_name\tinput_dims\toutput_dims\tparam_info\tmin_latency(ms)\t"
+        "max_latency(ms)\tavg_latency(ms)\n"
+     << "calib\t[1000]\t[1000]\t()\t0.01\t0.01\t0.01\n"
+     << "conv2d\t[]\t[1 8 10 10]\t(output=conv_out,kernel=x86/float/NCHW)\t-"
+        "\t0.2\t0.1\n";
+  fs.close();
+
+  KernelCostTable table;
+  ASSERT_TRUE(table.Load(path));
+  auto* fp32 = Type::GetTensorTy(
+      TARGET(kX86), PRECISION(kFloat), DATALAYOUT(kNCHW));
+  auto* int8 = Type::GetTensorTy(
+      TARGET(kX86), PRECISION(kInt8), DATALAYOUT(kNCHW));
+  auto* host_fp32 = Type::GetTensorTy(
+      TARGET(kHost), PRECISION(kFloat), DATALAYOUT(kNCHW));
+  // The calib of the 800 elements of conv_out measured by the layer row.
+  EXPECT_NEAR(table.CastLatency("conv_out", *fp32, *int8), 0.008, 1e-6);
+  // The host and x86 share the memory.
+  EXPECT_EQ(table.CastLatency("conv_out", *host_fp32, *fp32), 0.);
+
+  KernelCostTable empty_table;
+  EXPECT_FALSE(empty_table.Load("not_exist_table.txt"));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -32,6 +32,49 @@ typedef struct {
   std::set<std::string> adj;
 } MemNode;
 
+namespace {
+
+Node* FindArgNode(const std::list<Node*>& nodes, const std::string& name) {
+  for (auto* node : nodes) {
+    if (node->IsArg() && node->AsArg().name == name) return node;
+  }
+  return nullptr;
+}
+
+// The shapes of the vars are unknown before running, so the output of an
+// in-place capable op is proved to have the size of the input by the op.
+bool IsSizePreserved(Node* op_node) {
+  auto& stmt = op_node->AsStmt();
+  const auto* op_info = stmt.op_info();
+  const auto& op_type = op_info->Type();
+  if (op_type == "batch_norm") {
+    // Y is computed in place of X by the inference only.
+    return (op_info->HasAttr("is_test") && op_info->GetAttr<bool>("is_test")) ||
+           (op_info->HasAttr("use_global_stats") &&
+            op_info->GetAttr<bool>("use_global_stats"));
+  }
+  if (op_type.find("elementwise") != std::string::npos) {
+    // Out has the dims of X only if Y is a scalar weight. The broadcasting
+    // goes both ways, so a larger Y, even aligned by 'axis', or an activation
+    // may make Out larger than X.
+    if (!op_info->HasInput("Y") || op_info->Input("Y").size() != 1) {
+      return false;
+    }
+    auto y_name = op_info->Input("Y").front();
+    auto* y_node = FindArgNode(op_node->inlinks, y_name);
+    if (!y_node || !(y_node->AsArg().is_weight || y_node->AsArg().is_persist)) {
+      return false;
+    }
+    auto* y_var = stmt.op()->scope()->FindVar(y_name);
+    return y_var && y_var->IsType<Tensor>() &&
+           y_var->Get<Tensor>().numel() == 1;
+  }
+  // The activations and scale.
+  return true;
+}
+
+}  // namespace
+
 void MemoryOptimizePass::CollectLifeCycleByDevice(
     std::map<std::string, lifecycle_map_t>* lifecycles, SSAGraph* graph) {
   max_lifecycle_ = 0;
@@ -142,8 +185,13 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
         inplace = op_info->GetAttr<bool>("inplace");
       }
       if (inplace) {
-        for (auto& in_param_name : inplace_op_node->second.first) {
-          const auto& in_arg_names = op_info->Input(in_param_name);
+        // Out shares the buffer of X, so it's not reused itself, but extends
+        // the lifetime of X to its own.
+        const auto& in_arg_names = op_info->Input("X");
+        const auto& out_arg_names = op_info->Output("Out");
+        if (in_arg_names.size() == 1 && out_arg_names.size() == 1) {
+          shared_outputs_[out_arg_names.front()] = in_arg_names.front();
+        } else {
           invalid_var_names.insert(in_arg_names.begin(), in_arg_names.end());
         }
         for (auto& out_param_name : inplace_op_node->second.second) {
@@ -173,6 +221,9 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
         auto& arg = var_node->AsArg();
         if (arg.is_weight || arg.is_persist) continue;
         std::string var_name = arg.name;
+        while (shared_outputs_.count(var_name)) {
+          var_name = shared_outputs_.at(var_name);
+        }
         if (invalid_var_names.count(var_name)) continue;
         TargetType target_type = arg.type->target();
         if (is_host(target_type)) target_type = TARGET(kHost);
@@ -193,12 +244,99 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
   LOG(INFO) << "There are " << (*lifecycles).size() << " types device var.";
 }
 
+void MemoryOptimizePass::CollectInplaceOutputs(
+    SSAGraph* graph,
+    const std::map<std::string, lifecycle_map_t>& lifecycles,
+    std::map<std::string, std::map<std::string, std::string>>*
+        inplace_outputs) {
+  // The same order of the stmts as the lifecycles.
+  int op_idx = -1;
+  for (auto& op_node : graph->StmtTopologicalOrder()) {
+    if (!op_node->IsStmt()) continue;
+    op_idx++;
+    auto& stmt = op_node->AsStmt();
+    if (stmt.kernels().empty()) continue;
+    const auto& kernel = stmt.picked_kernel();
+    std::pair<std::string, std::string> args;
+    if (!ParamTypeRegistry::Global().RetrieveInplaceArgs(
+            kernel.op_type() + "/" + kernel.alias(), kernel.place(), &args)) {
+      continue;
+    }
+    const auto* op_info = stmt.op_info();
+    if (!op_info->HasInput(args.first) || !op_info->HasOutput(args.second)) {
+      continue;
+    }
+    const auto& in_arg_names = op_info->Input(args.first);
+    const auto& out_arg_names = op_info->Output(args.second);
+    if (in_arg_names.size() != 1 || out_arg_names.size() != 1) continue;
+    const auto& in_name = in_arg_names.front();
+    const auto& out_name = out_arg_names.front();
+    // The input whose buffer is shared by a reshape-like op lives longer than
+    // its own lifetime.
+    if (in_name == out_name || shared_outputs_.count(in_name)) continue;
+    auto* in_node = FindArgNode(op_node->inlinks, in_name);
+    auto* out_node = FindArgNode(op_node->outlinks, out_name);
+    if (!in_node || !out_node) continue;
+    const Type* in_type = in_node->AsArg().type;
+    const Type* out_type = out_node->AsArg().type;
+    if (!in_type || !out_type ||
+        in_type->precision() != out_type->precision() ||
+        in_type->layout() != out_type->layout()) {
+      continue;
+    }
+    if (!IsSizePreserved(op_node)) continue;
+    for (auto& device : lifecycles) {
+      auto in_lifecycle = device.second.find(in_name);
+      auto out_lifecycle = device.second.find(out_name);
+      if (in_lifecycle == device.second.end() ||
+          out_lifecycle == device.second.end()) {
+        continue;
+      }
+      // The input dies at the op, and the output is born at it.
+      if (in_lifecycle->second.second == op_idx &&
+          out_lifecycle->second.first == op_idx) {
+        (*inplace_outputs)[device.first][out_name] = in_name;
+        VLOG(4) << op_info->Type() << " writes " << out_name << " in place of "
+                << in_name;
+      }
+      break;
+    }
+  }
+  for (auto& device : *inplace_outputs) {
+    LOG(INFO) << "There are " << device.second.size()
+              << " outputs written in place of the inputs on " << device.first;
+  }
+}
+
 void MemoryOptimizePass::MakeReusePlan(
     const lifecycle_map_t& lifecycles,
+    const std::map<std::string, std::string>& inplace_outputs,
     std::map<std::string, std::string>* node2cluster) {
+  // The output written in place of the input joins the group of the input,
+  // and the group is planned as one var living over all of the members.
+  auto group_of = [&](std::string name) -> std::string {
+    auto iter = inplace_outputs.find(name);
+    while (iter != inplace_outputs.end()) {
+      name = iter->second;
+      iter = inplace_outputs.find(name);
+    }
+    return name;
+  };
+  lifecycle_map_t group_lifecycles;
+  for (auto& data : lifecycles) {
+    auto group = group_of(data.first);
+    auto iter = group_lifecycles.find(group);
+    if (iter == group_lifecycles.end()) {
+      group_lifecycles.emplace(group, data.second);
+    } else {
+      iter->second.first = (std::min)(iter->second.first, data.second.first);
+      iter->second.second = (std::max)(iter->second.second, data.second.second);
+    }
+  }
+
   std::vector<MemNode> mem_nodes;
   std::vector<std::string> cluster;
-  for (auto& data : lifecycles) {
+  for (auto& data : group_lifecycles) {
     MemNode temp_node;
     temp_node.name = data.first;
     temp_node.cluster = -1;
@@ -238,6 +376,9 @@ void MemoryOptimizePass::MakeReusePlan(
       }
     }
   }
+  for (auto& item : inplace_outputs) {
+    (*node2cluster)[item.first] = node2cluster->at(group_of(item.first));
+  }
   for (auto& name : cluster) {
     LOG(INFO) << "cluster: " << name;
   }
@@ -325,16 +466,20 @@ void MemoryOptimizePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   // 1. Collect all var's lifetime, then classify them according to the device.
   // Only the vars on the same device can be reused.
   // 2. Make reuse plan: the vars can be reused if there is no overlap between
-  // them.
+  // them. An output is planned as the same var as its input if the kernel can
+  // write in place of the dying input.
   // The final plan is a mapping table in which the key represents the original
   // name of var and the value in the table represents the current name of var.
   // 3. Perform reuse plan: Replace all var's name in the model according to the
   // mapping table.
   std::map<std::string, lifecycle_map_t> lifecycles;
+  shared_outputs_.clear();
   CollectLifeCycleByDevice(&lifecycles, graph.get());
+  std::map<std::string, std::map<std::string, std::string>> inplace_outputs;
+  CollectInplaceOutputs(graph.get(), lifecycles, &inplace_outputs);
   for (auto& ele : lifecycles) {
     std::map<std::string, std::string> node2cluster;
-    MakeReusePlan(ele.second, &node2cluster);
+    MakeReusePlan(ele.second, inplace_outputs[ele.first], &node2cluster);
     PerformReusePlan(graph.get(), node2cluster);
   }
 }
@@ -32,7 +32,13 @@ namespace lite {
 namespace mir {
 
 /*
- * MemoryOptimizePass will
+ * MemoryOptimizePass will reuse the memory of the vars whose lifetimes don't
+ * overlap on the same device, by renaming them to the same var.
+ *
+ * Besides, the output of a kernel registered with BindInplace is planned as
+ * the same var as its input if the input dies at the op and the output is
+ * proved to have the same size, so the kernel writes into the buffer of the
+ * input.
  */
 class MemoryOptimizePass : public ProgramPass {
  public:
@@ -43,13 +49,24 @@ class MemoryOptimizePass : public ProgramPass {
  private:
   void CollectLifeCycleByDevice(
       std::map<std::string, lifecycle_map_t>* lifecycles, SSAGraph*);
+  // Collect the outputs written in place of the inputs by device, the values
+  // are the names of the inputs by the names of the outputs.
+  void CollectInplaceOutputs(
+      SSAGraph* graph,
+      const std::map<std::string, lifecycle_map_t>& lifecycles,
+      std::map<std::string, std::map<std::string, std::string>>*
+          inplace_outputs);
   void MakeReusePlan(const lifecycle_map_t& lifecycles,
+                     const std::map<std::string, std::string>& inplace_outputs,
                      std::map<std::string, std::string>* node2cluster);
   void PerformReusePlan(SSAGraph* graph,
                         const std::map<std::string, std::string>& reuse_table);
 
  private:
   int max_lifecycle_{-1};
+  // The outputs of the inplace reshape-like ops, which share the buffers of
+  // the inputs, the values are the names of the inputs.
+  std::map<std::string, std::string> shared_outputs_;
 };
 
 }  // namespace mir
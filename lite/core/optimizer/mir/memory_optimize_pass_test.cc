@@ -0,0 +1,203 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/memory_optimize_pass.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/instruction_scheduler.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The helper functions for building the model manually.
+void AddVarDesc(cpp::BlockDesc* block_desc,
+                const std::string& name,
+                bool persistable = false) {
+  auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+  var_desc->SetName(name);
+  var_desc->SetType(VarDescAPI::Type::LOD_TENSOR);
+  var_desc->SetDataType(VarDescAPI::VarDataType::FP32);
+  var_desc->SetPersistable(persistable);
+}
+
+cpp::OpDesc* AddOpDesc(cpp::BlockDesc* block_desc,
+                       const std::string& type,
+                       const std::string& x,
+                       const std::string& out) {
+  AddVarDesc(block_desc, out);
+  auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+  op_desc->SetType(type);
+  op_desc->SetInput("X", {x});
+  op_desc->SetOutput(type == "batch_norm" ? "Y" : "Out", {out});
+  if (type == "scale") {
+    op_desc->SetAttr<float>("scale", 2.f);
+    op_desc->SetAttr<float>("bias", 0.f);
+    op_desc->SetAttr<bool>("bias_after_scale", true);
+  } else if (type == "reshape2") {
+    AddVarDesc(block_desc, out + "_xshape");
+    op_desc->SetOutput("XShape", {out + "_xshape"});
+    op_desc->SetAttr<std::vector<int>>("shape", {-1});
+    op_desc->SetAttr<bool>("inplace", true);
+  }
+  return op_desc;
+}
+
+// Add the weight 'name' of 'size' elements to the program and the scope.
+void AddWeight(cpp::BlockDesc* block_desc,
+               Scope* scope,
+               const std::string& name,
+               int64_t size) {
+  AddVarDesc(block_desc, name, true);
+  auto* tensor = scope->Var(name)->GetMutable<Tensor>();
+  tensor->Resize({size});
+  tensor->mutable_data<float>();
+  tensor->set_persistable(true);
+}
+
+std::vector<Place> ValidPlaces() {
+  return {{TARGET(kX86), PRECISION(kFloat)},
+          {TARGET(kHost), PRECISION(kFloat)},
+          {TARGET(kHost), PRECISION(kAny)}};
+}
+
+TEST(MemoryOptimizePass, inplace_outputs) {
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+  auto scope = std::make_shared<Scope>();
+
+  // bn -> relu -> scale are merged into the buffer of 'x'.
+  AddVarDesc(block_desc, "x");
+  auto* bn_desc = AddOpDesc(block_desc, "batch_norm", "x", "bn_out");
+  for (auto& arg : {"Scale", "Bias", "Mean", "Variance"}) {
+    AddWeight(block_desc, scope.get(), std::string("bn_") + arg, 4);
+    bn_desc->SetInput(arg, {std::string("bn_") + arg});
+  }
+  bn_desc->SetAttr<bool>("is_test", true);
+  bn_desc->SetAttr<float>("epsilon", 1e-5f);
+  bn_desc->SetAttr<float>("momentum", 0.9f);
+  bn_desc->SetAttr<std::string>("data_layout", "NCHW");
+  AddOpDesc(block_desc, "relu", "bn_out", "relu_out");
+  AddOpDesc(block_desc, "scale", "relu_out", "scale_out");
+  // Y of 4 elements may be broadcast to X, so Out isn't merged.
+  auto* add_desc =
+      AddOpDesc(block_desc, "elementwise_add", "scale_out", "add_out");
+  AddWeight(block_desc, scope.get(), "add_y", 4);
+  add_desc->SetInput("Y", {"add_y"});
+  add_desc->SetAttr<int>("axis", 1);
+  // 'add_out' is kept alive by the inplace reshape2, so relu doesn't write
+  // into it.
+  AddOpDesc(block_desc, "reshape2", "add_out", "reshape_out");
+  AddOpDesc(block_desc, "relu", "reshape_out", "relu2_out");
+  AddOpDesc(block_desc, "scale", "relu2_out", "out");
+  auto* fetch_desc = block_desc->AddOp<cpp::OpDesc>();
+  fetch_desc->SetType("fetch");
+  fetch_desc->SetInput("X", {"out"});
+  fetch_desc->SetOutput("Out", {"fetch"});
+  fetch_desc->SetAttr<int>("col", 0);
+
+  auto valid_places = ValidPlaces();
+  Program program(program_desc, scope, valid_places);
+  auto graph = std::unique_ptr<SSAGraph>(new SSAGraph());
+  graph->Build(program, valid_places);
+  // The x86 kernels aren't registered with BindInplace, so mark the picked
+  // kernels as the ARM ones.
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto& stmt = node->AsStmt();
+    const auto& kernel = stmt.picked_kernel();
+    const auto& op_type = stmt.op_type();
+    if (op_type == "fetch" || op_type == "reshape2") continue;
+    ParamTypeRegistry::Global().BindInplace(
+        kernel.op_type() + "/" + kernel.alias(),
+        kernel.place(),
+        "X",
+        op_type == "batch_norm" ? "Y" : "Out");
+  }
+  MemoryOptimizePass pass;
+  pass.Apply(graph);
+
+  std::vector<const OpInfo*> op_infos;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    op_infos.push_back(node->AsStmt().op_info());
+  }
+  ASSERT_EQ(op_infos.size(), 8u);
+  auto x = op_infos[0]->Input("X").front();
+  EXPECT_EQ(op_infos[0]->Output("Y").front(), x);
+  EXPECT_EQ(op_infos[1]->Input("X").front(), x);
+  EXPECT_EQ(op_infos[1]->Output("Out").front(), x);
+  EXPECT_EQ(op_infos[2]->Output("Out").front(), x);
+  EXPECT_EQ(op_infos[3]->Input("X").front(), x);
+  auto add_out = op_infos[3]->Output("Out").front();
+  EXPECT_NE(add_out, x);
+  EXPECT_EQ(op_infos[4]->Input("X").front(), add_out);
+  EXPECT_EQ(op_infos[5]->Input("X").front(), "reshape_out");
+  EXPECT_NE(op_infos[5]->Output("Out").front(), "reshape_out");
+  EXPECT_NE(op_infos[5]->Output("Out").front(), add_out);
+}
+
+// Build the instructions of relu(x) -> a, reshape2(a) -> b, scale(b) -> c and
+// relu(x) -> a, i.e. 'a' is reused by memory_optimize_pass after 'b'.
+std::vector<Instruction> BuildInstructions(bool inplace,
+                                           std::shared_ptr<Scope> scope,
+                                           std::unique_ptr<Program>* program) {
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+  AddVarDesc(block_desc, "x");
+  AddOpDesc(block_desc, "relu", "x", "a");
+  auto* reshape_desc = AddOpDesc(block_desc, "reshape2", "a", "b");
+  reshape_desc->SetAttr<bool>("inplace", inplace);
+  AddOpDesc(block_desc, "scale", "b", "c");
+  AddOpDesc(block_desc, "relu", "x", "a");
+
+  auto valid_places = ValidPlaces();
+  program->reset(new Program(program_desc, scope, valid_places));
+  std::vector<Instruction> insts;
+  for (auto& op : (*program)->ops()) {
+    auto kernels = op->CreateKernels(valid_places);
+    CHECK(!kernels.empty());
+    insts.emplace_back(op, std::move(kernels.front()));
+  }
+  return insts;
+}
+
+TEST(InstructionScheduler, shared_outputs) {
+  auto scope = std::make_shared<Scope>();
+  // scale and the second relu are independent without the shared output.
+  std::unique_ptr<Program> program;
+  auto insts = BuildInstructions(false, scope, &program);
+  auto scheduler = InstructionScheduler::Create(&insts, 2);
+  // The scheduler is disabled by some builds, e.g. with the thread pool.
+  if (!scheduler) return;
+  EXPECT_EQ(scheduler->width(), 2);
+  scheduler.reset();
+
+  // 'b' shares the buffer of 'a', so scale runs after reshape2, and the
+  // second relu writes 'a' after scale reads it, i.e. the instructions form
+  // a chain.
+  std::unique_ptr<Program> inplace_program;
+  auto inplace_insts = BuildInstructions(true, scope, &inplace_program);
+  EXPECT_FALSE(InstructionScheduler::Create(&inplace_insts, 2));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -115,6 +115,15 @@ class Pass {
     }
   }
 
+  // Some passes only rewrite the ops of some types, e.g. the fusion passes,
+  // bind these op types as the anchors so the optimizer skips the pass if
+  // none of them is in the graphs.
+  void BindAnchorOps(const std::set<std::string>& op_types) {
+    anchor_ops_.insert(op_types.begin(), op_types.end());
+  }
+  // Get the anchor op types, the pass always runs if it's empty.
+  const std::set<std::string>& AnchorOps() const { return anchor_ops_; }
+
   Kind kind() const { return kind_; }
   bool is_debug_pass() const { return kind_ == Kind::kDebug; }
   bool is_program_pass() const { return kind_ == Kind::kProgramWise; }
@@ -150,6 +159,7 @@ class Pass {
   std::set<TargetType> bound_targets_;
   std::set<TargetType> excluded_targets_;
   std::map<std::string, std::set<lite_api::Place>> bound_kernels_;
+  std::set<std::string> anchor_ops_;
   std::map<std::string, variant<Node, std::vector<Node*>>> pass_attrs_;
 };
 
@@ -48,6 +48,10 @@ class PassRegistry {
                       Place(TARGET(kAny), PRECISION(kAny), DATALAYOUT(kAny)));
     return *this;
   }
+  PassRegistry& BindAnchorOps(const std::set<std::string>& op_types) {
+    pass_->BindAnchorOps(op_types);
+    return *this;
+  }
   bool Touch() const { return true; }
 
  private:
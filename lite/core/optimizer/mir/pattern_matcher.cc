@@ -116,18 +116,77 @@ void PatternMatcher::operator()(SSAGraph *graph,
 bool PatternMatcher::MarkPMNodesInGraph(SSAGraph *graph) {
   VLOG(3) << "mark pmnodes in graph";
   if (graph->nodes().empty()) return false;
-  for (auto &node : graph->mutable_nodes()) {
-    for (const auto &pmnode : pattern_.nodes()) {
-      if (pmnode->Tell(&node)) {
-        pmnodes2nodes_[pmnode.get()].insert(&node);
+  // The PMNodes asserting the op types only start at the statements of the
+  // op types.
+  std::vector<PMNode *> unmarked;
+  for (const auto &pmnode : pattern_.nodes()) {
+    const auto &op_type = pmnode->anchor_op_type();
+    if (op_type.empty()) {
+      unmarked.push_back(pmnode.get());
+      continue;
+    }
+    for (auto *node : graph->StmtNodesOfType(op_type)) {
+      if (pmnode->Tell(node)) {
+        pmnodes2nodes_[pmnode.get()].insert(node);
+      }
+    }
+  }
+  // The PMNodes linked to an anchored PMNode only start at the inlinks or the
+  // outlinks of its matched Nodes, since the edge must be matched by a link.
+  std::vector<PMNode *> rest;
+  for (auto *pmnode : unmarked) {
+    const PMNode *anchor = nullptr;
+    bool is_inlink = false;
+    for (const auto &edge : pattern_.edges()) {
+      if (edge.first == pmnode && !edge.second->anchor_op_type().empty()) {
+        anchor = edge.second;
+        is_inlink = true;
+        break;
+      }
+      if (edge.second == pmnode && !edge.first->anchor_op_type().empty()) {
+        anchor = edge.first;
+        break;
+      }
+    }
+    if (anchor == nullptr) {
+      rest.push_back(pmnode);
+      continue;
+    }
+    auto it = pmnodes2nodes_.find(anchor);
+    if (it == pmnodes2nodes_.end()) continue;
+    for (auto *anchor_node : it->second) {
+      for (auto *node :
+           is_inlink ? anchor_node->inlinks : anchor_node->outlinks) {
+        if (pmnode->Tell(node)) {
+          pmnodes2nodes_[pmnode].insert(node);
+        }
+      }
+    }
+  }
+  // The others have to check all the Nodes. The const nodes() is used to keep
+  // the op type index of the graph, the Nodes aren't changed here.
+  if (!rest.empty()) {
+    for (auto &node : graph->nodes()) {
+      for (auto *pmnode : rest) {
+        if (pmnode->Tell(&node)) {
+          pmnodes2nodes_[pmnode].insert(const_cast<Node *>(&node));
+        }
       }
     }
   }
-  // Check to early stop if some PMNode can't find matched Node.
-  for (auto &pmnode : pattern_.nodes()) {
-    if (!pmnodes2nodes_.count(pmnode.get())) {
+  // Check to early stop if some PMNode of the edges can't find matched Node,
+  // then DetectPatterns() can't detect any subgraph.
+  for (const auto &pmnode : pattern_.nodes()) {
+    if (pmnodes2nodes_.count(pmnode.get())) continue;
+    bool linked = pattern_.edges().empty() &&
+                  pmnode.get() == pattern_.nodes().front().get();
+    for (const auto &edge : pattern_.edges()) {
+      linked = linked || edge.first == pmnode.get() ||
+               edge.second == pmnode.get();
+    }
+    if (linked) {
       VLOG(4) << pmnode->name() << " can't find matched Node, early stop";
-      // return false;
+      return false;
     }
   }
   VLOG(3) << pmnodes2nodes_.size() << " nodes marked";
@@ -371,6 +430,7 @@ PMNode *PMNode::assert_only_one_output() {
 }
 
 PMNode *PMNode::assert_is_op(const std::string &op_type) {
+  if (anchor_op_type_.empty()) anchor_op_type_ = op_type;
   asserts_.emplace_back([op_type](const Node *x) {
     if (x && x->IsStmt()) {
       auto *op_info = x->stmt()->op_info();
@@ -116,6 +116,14 @@ struct PMNode {
 
   void set_op_type(const std::string& op_type) { op_type_ = op_type; }
 
+  // The op type asserted first by assert_is_op(op_type), the matcher takes
+  // its candidates from the op type index of the graph. It's empty if the
+  // PMNode is told by a teller or doesn't assert the op type.
+  const std::string& anchor_op_type() const {
+    static const std::string kNone;
+    return teller_ ? kNone : anchor_op_type_;
+  }
+
   bool IsIntermediate() const { return role_ == Role::kIntermediate; }
   bool IsInput() const { return role_ == Role::kInput; }
   bool IsOutput() const { return role_ == Role::kOutput; }
@@ -195,6 +203,7 @@ struct PMNode {
   PMPattern* pattern_;
   std::string name_;
   std::string op_type_;
+  std::string anchor_op_type_;
   Type type_{};
   Role role_{Role::kUnknown};
 };
@@ -317,6 +326,7 @@ class PatternMatcher {
 
 #ifdef PADDLE_WITH_TESTING
   FRIEND_TEST(PatternMatcher, MarkPMNodesInGraph);
+  FRIEND_TEST(PatternMatcher, MarkPMNodesInGraphEarlyStop);
   FRIEND_TEST(PatternMatcher, DetectPatterns);
 #endif
 
@@ -143,6 +143,24 @@ TEST(PatternMatcher, MarkPMNodesInGraph) {
   ASSERT_EQ(subgraphs.size(), 1UL);
 }
 
+TEST(PatternMatcher, MarkPMNodesInGraphEarlyStop) {
+  PatternMatcher x;
+  // The pattern o2 -> v9 can't be matched, since there's no var9.
+  auto* o2 = x.pattern_.NewNode([](const Node* node) {
+    return node && node->IsStmt() && node->stmt()->desc == "op2";
+  });
+  auto* v9 = x.pattern_.NewNode([](const Node* node) {
+    return node && node->IsArg() && node->arg()->name == "var9";
+  });
+  x.pattern_.AddEdge(o2, v9);
+
+  SSAGraph graph;
+  BuildGraph(&graph);
+
+  ASSERT_FALSE(x.MarkPMNodesInGraph(&graph));
+  ASSERT_TRUE(x.DetectPatterns().empty());
+}
+
 TEST(PatternMatcher, MultiSubgraph) {
   SSAGraph graph;
   BuildGraph(&graph);
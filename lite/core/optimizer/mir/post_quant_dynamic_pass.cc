@@ -163,6 +163,43 @@ void PostQuantDynamicPerChannel(OpInfo* op_info,
   op_info->SetAttr(weight_name + "_quant_scale", scales);
 }
 
+// Whether the op runs the int8 weights by the dynamic quantization of the
+// x86 kernels, i.e. fc, mul or matmul(_v2) with a 2-D weight [K, N] only
+// used by this op, the X of matmul(_v2) may be 1-D. 'weight_name' is the
+// name of the weight.
+static bool IsDynamicQuantInt8Op(Node* node, std::string* weight_name) {
+  auto& stmt = node->AsStmt();
+  if (stmt.kernels().empty() ||
+      stmt.picked_kernel().target() != TARGET(kX86) ||
+      stmt.picked_kernel().precision() != PRECISION(kFloat)) {
+    return false;
+  }
+  const std::string op_type = stmt.op_type();
+  const OpInfo* op_info = stmt.op_info();
+  if (op_type == "fc") {
+    *weight_name = op_info->Input("W").front();
+  } else if (op_type == "mul") {
+    if (op_info->GetAttr<int>("y_num_col_dims") != 1) return false;
+    *weight_name = op_info->Input("Y").front();
+  } else if (op_type == "matmul" || op_type == "matmul_v2") {
+    const bool is_v2 = op_type == "matmul_v2";
+    if (op_info->GetAttr<bool>(is_v2 ? "trans_x" : "transpose_X") ||
+        op_info->GetAttr<bool>(is_v2 ? "trans_y" : "transpose_Y")) {
+      return false;
+    }
+    *weight_name = op_info->Input("Y").front();
+  } else {
+    return false;
+  }
+  for (auto* in_node : node->inlinks) {
+    if (!in_node->IsArg() || in_node->arg()->name != *weight_name) continue;
+    auto* var = stmt.op()->scope()->FindVar(*weight_name);
+    return in_node->arg()->is_weight && in_node->outlinks.size() == 1 &&
+           var != nullptr && var->Get<Tensor>().dims().size() == 2;
+  }
+  return false;
+}
+
 void PostQuantDynamicPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   int quant_bits = 16;
   if (quant_type_ == lite_api::QuantType::QUANT_INT8) {
@@ -173,12 +210,14 @@ void PostQuantDynamicPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     LOG(FATAL) << "Not support quant type:" << static_cast<int>(quant_type_);
   }
 
+  const std::vector<std::string>& ops =
+      selected_quant_ops_.empty() ? quant_ops : selected_quant_ops_;
   std::vector<mir::Node*> nodes;
   for (auto* node : graph->StmtTopologicalOrder()) {
     if (node->IsStmt()) {
       const std::string op_type = node->stmt()->op_type();
-      auto iter = std::find(quant_ops.begin(), quant_ops.end(), op_type);
-      if (iter != quant_ops.end()) {
+      auto iter = std::find(ops.begin(), ops.end(), op_type);
+      if (iter != ops.end()) {
         nodes.push_back(node);
       }
     }
@@ -188,10 +227,18 @@ void PostQuantDynamicPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     const std::string op_type = node->stmt()->op_type();
     OpInfo* op_info = node->stmt()->mutable_op_info();
     auto* scope = node->stmt()->op()->scope();
+    std::string dynamic_weight_name;
+    // Opt-in: only the op types named by SetQuantOps run the dynamic
+    // quantization, the other int8 weights are dequantized at load.
+    const bool dynamic_quant = quant_bits == 8 &&
+                               !selected_quant_ops_.empty() &&
+                               IsDynamicQuantInt8Op(node, &dynamic_weight_name);
     for (auto* in_node : node->inlinks) {
       CHECK(in_node->IsArg()) << "The input node should be variable.";
       if (in_node->arg()->is_weight) {
         std::string weight_name = in_node->arg()->name;
+        // The bias of the dynamic quantization is kept in fp32.
+        if (dynamic_quant && weight_name != dynamic_weight_name) continue;
         Tensor* weight = scope->FindVar(weight_name)->GetMutable<Tensor>();
         CHECK(weight) << "Can not find the weight in scope.";
         if (weight->precision() != PrecisionType::kFloat) {
@@ -209,6 +256,13 @@ void PostQuantDynamicPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
             op_info, weight, weight_name, quant_axis, quant_bits);
       }
     }
+    if (dynamic_quant &&
+        op_info->HasAttr(dynamic_weight_name + "_quant_scale")) {
+      op_info->SetAttr("dynamic_quant_int8", true);
+      node->stmt()->op()->Attach(*op_info, scope);
+      node->stmt()->op()->AttachKernel(&(node->stmt()->picked_kernel()));
+      VLOG(3) << "Run " << op_type << " by the dynamic quantization.";
+    }
   }
 }
 
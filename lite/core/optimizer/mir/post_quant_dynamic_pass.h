@@ -24,12 +24,24 @@
 namespace paddle {
 namespace lite {
 namespace mir {
+
+// The abs max of each channel of 'tensor' along 'quant_axis' 0 or 1.
+void FindAbsMaxPerChannel(const Tensor& tensor,
+                          int quant_axis,
+                          std::vector<float>* res);
+
 /*
  * Use post_quant_dynamic method to quantize the model.
  * In optimization stage, if the data type of weights is fp32, quantize the
  * weights to int8/16. So the size of the quantized weights is reduced 4x/2x.
  * In inference stage, the quantized weights are dequantized to fp32 and run
  * all ops to get output.
+ * For QUANT_INT8, if the op types are selected by SetQuantOps, the x86
+ * kernels of fc, mul and matmul(_v2) of these types whose weights are 2-D
+ * run the int8 weights directly, i.e. the dynamic quantization: the
+ * activations are quantized per row at each run, the GEMM is int8 and the
+ * output is dequantized with the bias and the activation fused. These ops
+ * are marked as 'dynamic_quant_int8', and their biases are kept in fp32.
  */
 class PostQuantDynamicPass : public ProgramPass {
  public:
@@ -47,8 +59,15 @@ class PostQuantDynamicPass : public ProgramPass {
     quant_type_ = quant_type;
   }
 
+  // Only quantize the ops of these types instead of quant_ops, empty for
+  // quant_ops.
+  void SetQuantOps(const std::vector<std::string>& quant_ops) {
+    selected_quant_ops_ = quant_ops;
+  }
+
  private:
   lite_api::QuantType quant_type_{lite_api::QuantType::QUANT_INT16};
+  std::vector<std::string> selected_quant_ops_;
 };
 
 }  // namespace mir
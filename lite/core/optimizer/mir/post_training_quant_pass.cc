@@ -0,0 +1,171 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/post_training_quant_pass.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/post_quant_dynamic_pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+const int kBitLength = 8;
+const float kRange = 127.f;
+
+// Quantize 'weight' to int8 in place per channel along 'quant_axis', return
+// the relative L2 error of the quantized weights.
+float QuantizeWeight(Tensor* weight,
+                     int quant_axis,
+                     std::vector<float>* scales) {
+  FindAbsMaxPerChannel(*weight, quant_axis, scales);
+  for (auto& scale : *scales) {
+    scale = std::max(scale, 1e-8f) / kRange;
+  }
+  Tensor origin;
+  origin.CopyDataFrom(*weight);
+  const float* origin_data = origin.data<float>();
+  int8_t* quantized_data = weight->mutable_data<int8_t>();
+  const auto& dims = origin.dims();
+  const int64_t channel = dims[quant_axis];
+  const int64_t inner_size =
+      quant_axis == 0 ? dims.production() / channel : 1;
+  double error = 0.0;
+  double norm = 0.0;
+  for (int64_t i = 0; i < dims.production(); i++) {
+    int64_t c = quant_axis == 0 ? i / inner_size : i % channel;
+    float scale = (*scales)[c];
+    float q = std::min(std::max(std::round(origin_data[i] / scale), -kRange),
+                       kRange);
+    quantized_data[i] = static_cast<int8_t>(q);
+    double diff = q * scale - origin_data[i];
+    error += diff * diff;
+    norm += static_cast<double>(origin_data[i]) * origin_data[i];
+  }
+  weight->set_persistable(true);
+  weight->set_precision(PRECISION(kInt8));
+  return norm > 0.0 ? static_cast<float>(std::sqrt(error / norm)) : 0.f;
+}
+
+// Return the axis along which the weight of the conv2d or mul stmt is
+// quantized, and set 'weight_name', or return -1 if the stmt isn't quantized.
+int QuantAxis(Node* node,
+              const std::map<std::string, float>& activation_scales,
+              std::string* weight_name) {
+  if (!node->IsStmt()) return -1;
+  const auto& op_type = node->AsStmt().op_type();
+  bool is_conv = op_type == "conv2d" || op_type == "depthwise_conv2d";
+  if (!is_conv && op_type != "mul") return -1;
+  const auto* op_info = node->AsStmt().op_info();
+  // The ops of the quantized model.
+  if (op_info->HasAttr("enable_int8")) return -1;
+  auto input_name = op_info->Input(is_conv ? "Input" : "X").front();
+  if (!activation_scales.count(input_name)) return -1;
+  *weight_name = op_info->Input(is_conv ? "Filter" : "Y").front();
+  if (is_conv) return 0;
+  // The weights of conv2d are [oc, ic / groups, kh, kw], the ones of mul are
+  // [ic, oc].
+  auto* weight_var = node->AsStmt().op()->scope()->FindVar(*weight_name);
+  if (weight_var == nullptr ||
+      weight_var->Get<Tensor>().dims().size() != 2 ||
+      op_info->GetAttr<int>("y_num_col_dims") != 1) {
+    return -1;
+  }
+  return 1;
+}
+
+}  // namespace
+
+void PostTrainingQuantPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  quantized_layers_.clear();
+  if (activation_scales_.empty()) return;
+  // The scales and the errors of the quantized weights.
+  std::map<std::string, std::pair<std::vector<float>, float>>
+      quantized_weights;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    std::string weight_name;
+    int quant_axis = QuantAxis(node, activation_scales_, &weight_name);
+    if (quant_axis < 0) continue;
+    auto op_info = *node->AsStmt().op_info();
+    const std::string op_type = op_info.Type();
+    bool is_conv = quant_axis == 0;
+    const std::string input_name =
+        op_info.Input(is_conv ? "Input" : "X").front();
+    const std::string output_name =
+        op_info.Output(is_conv ? "Output" : "Out").front();
+    const float input_scale = activation_scales_.at(input_name);
+
+    // The weights shared by the ops are quantized once.
+    auto weight_iter = quantized_weights.find(weight_name);
+    if (weight_iter == quantized_weights.end()) {
+      auto* weight_var = node->AsStmt().op()->scope()->FindVar(weight_name);
+      if (weight_var == nullptr) continue;
+      auto* weight = weight_var->GetMutable<Tensor>();
+      if (!weight->persistable() ||
+          weight->precision() != PRECISION(kFloat)) {
+        continue;
+      }
+      // The weight is quantized in place, so it's kept in fp32 if any of the
+      // ops using it isn't quantized along the same axis.
+      bool quantizable = true;
+      for (auto* weight_node : node->inlinks) {
+        if (!weight_node->IsArg() || weight_node->arg()->name != weight_name) {
+          continue;
+        }
+        for (auto* consumer : weight_node->outlinks) {
+          std::string name;
+          if (QuantAxis(consumer, activation_scales_, &name) != quant_axis ||
+              name != weight_name) {
+            quantizable = false;
+          }
+        }
+      }
+      if (!quantizable) {
+        VLOG(3) << "Keep the fp32 weight " << weight_name
+                << " shared by the ops which aren't quantized.";
+        continue;
+      }
+      auto& quantized = quantized_weights[weight_name];
+      quantized.second = QuantizeWeight(weight, quant_axis, &quantized.first);
+      weight_iter = quantized_weights.find(weight_name);
+    }
+
+    op_info.SetAttr("enable_int8", true);
+    op_info.SetAttr<int>("bit_length", kBitLength);
+    op_info.SetInputScale(input_name, {input_scale});
+    op_info.SetInputScale(weight_name, weight_iter->second.first);
+    node->AsStmt().ResetOp(op_info, graph->valid_places());
+    quantized_layers_.push_back({op_type,
+                                 input_name,
+                                 output_name,
+                                 input_scale,
+                                 weight_iter->second.second});
+  }
+  VLOG(3) << "Quantized " << quantized_layers_.size() << " ops to int8.";
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(post_training_quant_pass,
+                  paddle::lite::mir::PostTrainingQuantPass)
+    .BindTargets({TARGET(kX86), TARGET(kARM)});
@@ -0,0 +1,71 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Use the static post-training quantization to quantize the fp32 model.
+ * The scales of the activations are computed by the calibration of the fp32
+ * model, see lite/core/calibration.h. The weights of conv2d,
+ * depthwise_conv2d and mul whose input activation has a scale are quantized
+ * to int8 per output channel, and the ops are marked as 'enable_int8' with
+ * the scales of the input and the weights, in the same way as the ops of
+ * the quantized model after lite_quant_dequant_fuse_pass, so the following
+ * passes, e.g. the fusion passes and x86_int8_attribute_pass, and the int8
+ * kernels of x86 and arm handle them as usual. The weights are quantized in
+ * place, so a weight is kept in fp32 if it's also used by an op which isn't
+ * quantized along the same axis.
+ *
+ * It's a no-op if the scales aren't set, which is the default.
+ */
+class PostTrainingQuantPass : public ProgramPass {
+ public:
+  struct QuantizedLayer {
+    std::string op_type;
+    std::string input;
+    std::string output;
+    float input_scale;
+    // The relative L2 error of the weights quantized to int8.
+    float weight_error;
+  };
+
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  // The scales of the activations by the names of the vars.
+  void SetActivationScales(const std::map<std::string, float>& scales) {
+    activation_scales_ = scales;
+  }
+
+  // The ops quantized by the last Apply.
+  const std::vector<QuantizedLayer>& quantized_layers() const {
+    return quantized_layers_;
+  }
+
+ private:
+  std::map<std::string, float> activation_scales_;
+  std::vector<QuantizedLayer> quantized_layers_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
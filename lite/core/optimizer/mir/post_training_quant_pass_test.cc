@@ -0,0 +1,119 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/post_training_quant_pass.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The helper functions for building the model manually.
+void AddVarDesc(cpp::BlockDesc* block_desc,
+                const std::string& name,
+                bool persistable = false) {
+  auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+  var_desc->SetName(name);
+  var_desc->SetType(VarDescAPI::Type::LOD_TENSOR);
+  var_desc->SetDataType(VarDescAPI::VarDataType::FP32);
+  var_desc->SetPersistable(persistable);
+}
+
+void AddWeight(cpp::BlockDesc* block_desc,
+               Scope* scope,
+               const std::string& name) {
+  AddVarDesc(block_desc, name, true);
+  auto* tensor = scope->Var(name)->GetMutable<Tensor>();
+  tensor->Resize({4, 4});
+  auto* data = tensor->mutable_data<float>();
+  for (int64_t i = 0; i < tensor->numel(); i++) {
+    data[i] = static_cast<float>(i % 7) - 3.f;
+  }
+  tensor->set_persistable(true);
+}
+
+void AddMulDesc(cpp::BlockDesc* block_desc,
+                const std::string& x,
+                const std::string& y,
+                const std::string& out) {
+  AddVarDesc(block_desc, out);
+  auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+  op_desc->SetType("mul");
+  op_desc->SetInput("X", {x});
+  op_desc->SetInput("Y", {y});
+  op_desc->SetOutput("Out", {out});
+  op_desc->SetAttr<int>("x_num_col_dims", 1);
+  op_desc->SetAttr<int>("y_num_col_dims", 1);
+}
+
+TEST(PostTrainingQuantPass, shared_weights) {
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+  auto scope = std::make_shared<Scope>();
+  AddVarDesc(block_desc, "x");
+  for (auto& name : {"w_own", "w_mul", "w_scale"}) {
+    AddWeight(block_desc, scope.get(), name);
+  }
+  // The weight used by one mul is quantized.
+  AddMulDesc(block_desc, "x", "w_own", "own_out");
+  // The second mul of 'w_mul' has no scale of the input.
+  AddMulDesc(block_desc, "x", "w_mul", "mul_out");
+  AddMulDesc(block_desc, "mul_out", "w_mul", "mul_out2");
+  // 'w_scale' is also the input of scale.
+  AddMulDesc(block_desc, "x", "w_scale", "scale_mul_out");
+  AddVarDesc(block_desc, "scale_out");
+  auto* scale_desc = block_desc->AddOp<cpp::OpDesc>();
+  scale_desc->SetType("scale");
+  scale_desc->SetInput("X", {"w_scale"});
+  scale_desc->SetOutput("Out", {"scale_out"});
+  scale_desc->SetAttr<float>("scale", 2.f);
+  scale_desc->SetAttr<float>("bias", 0.f);
+  scale_desc->SetAttr<bool>("bias_after_scale", true);
+
+  std::vector<Place> valid_places{{TARGET(kX86), PRECISION(kFloat)},
+                                  {TARGET(kHost), PRECISION(kFloat)},
+                                  {TARGET(kHost), PRECISION(kAny)}};
+  Program program(program_desc, scope, valid_places);
+  auto graph = std::unique_ptr<SSAGraph>(new SSAGraph());
+  graph->Build(program, valid_places);
+  PostTrainingQuantPass pass;
+  pass.SetActivationScales({{"x", 0.1f}});
+  pass.Apply(graph);
+
+  ASSERT_EQ(pass.quantized_layers().size(), 1u);
+  EXPECT_EQ(pass.quantized_layers()[0].output, "own_out");
+  auto precision = [&](const std::string& name) {
+    return scope->FindVar(name)->Get<Tensor>().precision();
+  };
+  EXPECT_EQ(precision("w_own"), PRECISION(kInt8));
+  EXPECT_EQ(precision("w_mul"), PRECISION(kFloat));
+  EXPECT_EQ(precision("w_scale"), PRECISION(kFloat));
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    const auto* op_info = node->AsStmt().op_info();
+    bool quantized = op_info->Output("Out").front() == "own_out";
+    EXPECT_EQ(op_info->HasAttr("enable_int8"), quantized);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -136,6 +136,7 @@ std::vector<mir::Node *> SSAGraph::NodeTopologicalOrder() {
 
 Node *SSAGraph::GraphCreateInstructNode(
     const std::shared_ptr<OpLite> &op, const std::vector<Place> &valid_places) {
+  InvalidateOpTypeIndex();
   node_storage_.emplace_back();
   // TODO(Superjomn) remove one valid_places here.
   op->SetValidPlaces(valid_places);
@@ -222,9 +223,11 @@ void SSAGraph::RemoveNode(const mir::Node *node) {
                           [&node](mir::Node &n) { return &n == node; });
   CHECK(pos != node_storage_.end());
   node_storage_.erase(pos);
+  InvalidateOpTypeIndex();
 }
 
 void SSAGraph::CloneFrom(const SSAGraph &from) {
+  InvalidateOpTypeIndex();
   node_storage_.clear();
   arguments_.clear();
   valid_places_ = from.valid_places_;
@@ -319,6 +322,7 @@ bool SSAGraph::CheckLinksRoleSet() {
 }
 
 Node *SSAGraph::NewArgumentNode(const std::string &name) {
+  InvalidateOpTypeIndex();
   node_storage_.emplace_back();
   auto &arg_node = node_storage_.back();
   arg_node.AsArg(name, node_storage_.size() - 1);
@@ -327,11 +331,30 @@ Node *SSAGraph::NewArgumentNode(const std::string &name) {
 }
 
 Node *SSAGraph::NewInstructNode() {
+  InvalidateOpTypeIndex();
   node_storage_.emplace_back();
   node_storage_.back().set_id(num_node_created_++);
   return &node_storage_.back();
 }
 
+const std::vector<mir::Node *> &SSAGraph::StmtNodesOfType(
+    const std::string &op_type) {
+  static const std::vector<mir::Node *> kEmpty;
+  if (!op_type_index_valid_) BuildOpTypeIndex();
+  auto it = op_type_index_.find(op_type);
+  return it == op_type_index_.end() ? kEmpty : it->second;
+}
+
+void SSAGraph::BuildOpTypeIndex() {
+  op_type_index_.clear();
+  for (auto &node : node_storage_) {
+    // The statements without op, e.g. the ones of the tests, aren't indexed.
+    if (!node.IsStmt() || !node.stmt()->op()) continue;
+    op_type_index_[node.stmt()->op_type()].push_back(&node);
+  }
+  op_type_index_valid_ = true;
+}
+
 std::string SSAGraph::dump() {
   paddle::lite::mir::Dot dot;
   using Attr = paddle::lite::mir::Dot::Attr;
@@ -69,7 +69,21 @@ class SSAGraph : GraphBase {
   std::vector<mir::Node *> outputs();
 
   const std::list<mir::Node> &nodes() const { return node_storage_; }
-  std::list<mir::Node> &mutable_nodes() { return node_storage_; }
+  std::list<mir::Node> &mutable_nodes() {
+    // The nodes might be added or removed by the caller.
+    InvalidateOpTypeIndex();
+    return node_storage_;
+  }
+
+  // The statement nodes of the op type, in the order of the nodes. The index
+  // of the op types is built lazily, and dropped when the nodes are added or
+  // removed. Call InvalidateOpTypeIndex() after changing the op type of a
+  // statement in place, e.g. by Stmt::ResetOp().
+  const std::vector<mir::Node *> &StmtNodesOfType(const std::string &op_type);
+  bool HasOpType(const std::string &op_type) {
+    return !StmtNodesOfType(op_type).empty();
+  }
+  void InvalidateOpTypeIndex() { op_type_index_valid_ = false; }
 
   mir::Node *RetrieveArgument(const std::string &arg);
 
@@ -122,8 +136,13 @@ class SSAGraph : GraphBase {
       std::set<mir::Node *, NodeComp> *visited,
       std::vector<mir::Node *> *ret);
 
+  void BuildOpTypeIndex();
+
  private:
   std::list<mir::Node> node_storage_;
+  // The statement nodes by the op types, see StmtNodesOfType().
+  std::map<std::string, std::vector<mir::Node *>> op_type_index_;
+  bool op_type_index_valid_{false};
   std::map<std::string, mir::Node *> arguments_;
   std::vector<Place> valid_places_;
   int block_idx_ = kRootBlockIdx;
@@ -14,14 +14,18 @@
 
 #include "lite/core/optimizer/mir/static_kernel_pick_pass.h"
 #include <algorithm>
+#include <fstream>
+#include <limits>
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 #include "lite/core/optimizer/mir/graph_visualize_pass.h"
 #include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/utils/string.h"
 
 namespace paddle {
 namespace lite {
@@ -32,6 +36,261 @@ bool KernelScoreCmp(const std::pair<float, std::unique_ptr<KernelBase>>& a,
   return a.first > b.first;
 }
 
+namespace {
+
+bool IsControlFlowOp(const std::string& op_type) {
+  return op_type == "conditional_block" || op_type == "while" ||
+         op_type == "subgraph";
+}
+
+// The declared type of the var 'name' of the op bound to 'kernel', nullptr if
+// it's not declared.
+const Type* DeclType(const KernelBase& kernel,
+                     const OpInfo* op_info,
+                     const std::string& name,
+                     bool is_input) {
+  std::string arg_name;
+  const ParamType* type = nullptr;
+  if (is_input && op_info->GetInputArgname(name, &arg_name)) {
+    type = ParamTypeRegistry::Global().RetrieveInArgument(
+        kernel.place(), kernel.GenParamTypeKey(), arg_name);
+  } else if (!is_input && op_info->GetOutputArgname(name, &arg_name)) {
+    type = ParamTypeRegistry::Global().RetrieveOutArgument(
+        kernel.place(), kernel.GenParamTypeKey(), arg_name);
+  }
+  return type ? type->type : nullptr;
+}
+
+// Whether 'kernel' is in a blocked channel layout, i.e. NCHW8c or NCHW16c,
+// while an output of 'node' declared in it isn't 4-D. The blocks are of the
+// 4-D tensors, the tensors of the other ranks in them only add the reorders
+// around the kernel. The shapes are of the scope, which the program resized
+// to the shapes of the var descs.
+bool IsBlockedOnOtherRank(Node* node, const KernelBase& kernel) {
+  if (kernel.layout() != DATALAYOUT(kNCHW8c) &&
+      kernel.layout() != DATALAYOUT(kNCHW16c)) {
+    return false;
+  }
+  auto& stmt = node->AsStmt();
+  auto* scope = stmt.op()->scope();
+  if (!scope) return false;
+  for (auto* out : node->outlinks) {
+    if (!out->IsArg()) continue;
+    auto& name = out->AsArg().name;
+    auto* type = DeclType(kernel, stmt.op_info(), name, false);
+    if (!type || type->layout() != kernel.layout()) continue;
+    auto* var = scope->FindVar(name);
+    if (!var || !var->IsType<Tensor>()) continue;
+    auto rank = var->Get<Tensor>().dims().size();
+    if (rank != 0 && rank != 4) return true;
+  }
+  return false;
+}
+
+std::string KernelRepr(const KernelBase* kernel) {
+  if (!kernel) return "-";
+  return TargetToStr(kernel->target()) + "/" +
+         PrecisionToStr(kernel->precision()) + "/" +
+         DataLayoutToStr(kernel->layout()) + "/" + kernel->alias();
+}
+
+std::string LatencyRepr(double latency) {
+  return latency < 0 ? "-" : to_string_with_precision(latency, 5);
+}
+
+}  // namespace
+
+void StaticKernelPickPass::SetLatencyTable(const std::string& paths) {
+  cost_table_.reset();
+  if (paths.empty()) return;
+  std::unique_ptr<KernelCostTable> cost_table(new KernelCostTable);
+  if (cost_table->Load(paths)) {
+    cost_table_ = std::move(cost_table);
+  } else {
+    LOG(WARNING) << "No latencies are loaded from " << paths
+                 << ", the kernels are picked by the scores.";
+  }
+}
+
+bool StaticKernelPickPass::MatchValidPlaces(
+    const KernelBase& kernel, const std::vector<Place>& places) const {
+  for (auto& place : places) {
+    if ((place.target == kernel.target() || kernel.target() == TARGET(kAny) ||
+         place.target == TARGET(kAny)) &&
+        (place.precision == kernel.precision() ||
+         kernel.precision() == PRECISION(kAny) ||
+         place.precision == PRECISION(kAny)) &&
+        (place.layout == kernel.layout() ||
+         kernel.layout() == DATALAYOUT(kAny) ||
+         place.layout == DATALAYOUT(kAny))) {
+      // The int8 kernels are only for the quantized ops.
+      return kernel.precision() != PRECISION(kInt8);
+    }
+  }
+  return false;
+}
+
+void StaticKernelPickPass::PickByLatency(
+    SSAGraph* graph,
+    std::map<Node*, std::vector<std::unique_ptr<KernelBase>>>* candidates) {
+  // The index of the picked kernel of each op, and the latencies of its
+  // candidates, the ops lacking any of them keep the first one.
+  std::map<Node*, size_t> picks;
+  std::map<Node*, std::vector<double>> latencies;
+  std::set<Node*> tunable;
+  for (auto& it : *candidates) {
+    picks[it.first] = 0;
+    auto& node_latencies = latencies[it.first];
+    for (auto& kernel : it.second) {
+      node_latencies.push_back(cost_table_->KernelLatency(it.first, *kernel));
+    }
+    if (it.second.size() > 1 &&
+        *std::min_element(node_latencies.begin(), node_latencies.end()) >= 0) {
+      tunable.insert(it.first);
+    }
+  }
+  auto kernel_of = [&](Node* node) -> const KernelBase* {
+    auto it = candidates->find(node);
+    if (it != candidates->end()) return it->second[picks[node]].get();
+    auto& kernels = node->AsStmt().kernels();
+    return kernels.empty() ? nullptr : kernels.front().get();
+  };
+  auto latency_of = [&](Node* node) -> double {
+    auto it = latencies.find(node);
+    if (it != latencies.end()) return it->second[picks[node]];
+    auto* kernel = kernel_of(node);
+    return kernel ? cost_table_->KernelLatency(node, *kernel) : -1;
+  };
+  // The costs of the casts between 'kernel' of 'node' and the kernels of the
+  // producers of its inputs, and the consumers of its outputs if
+  // 'with_outputs'.
+  auto cast_latency_of = [&](Node* node,
+                             const KernelBase& kernel,
+                             bool with_outputs) -> double {
+    auto* op_info = node->AsStmt().op_info();
+    double latency = 0;
+    for (auto* in : node->inlinks) {
+      if (!in->IsArg() || in->AsArg().is_weight || in->AsArg().is_persist) {
+        continue;
+      }
+      auto& name = in->AsArg().name;
+      auto* to = DeclType(kernel, op_info, name, true);
+      if (!to) continue;
+      for (auto* producer : in->inlinks) {
+        auto* producer_kernel = kernel_of(producer);
+        if (!producer_kernel) continue;
+        auto* from = DeclType(
+            *producer_kernel, producer->AsStmt().op_info(), name, false);
+        if (from) latency += cost_table_->CastLatency(name, *from, *to);
+      }
+    }
+    if (!with_outputs) return latency;
+    for (auto* out : node->outlinks) {
+      if (!out->IsArg()) continue;
+      auto& name = out->AsArg().name;
+      auto* from = DeclType(kernel, op_info, name, false);
+      if (!from) continue;
+      for (auto* consumer : out->outlinks) {
+        auto* consumer_kernel = kernel_of(consumer);
+        if (!consumer_kernel) continue;
+        auto* to = DeclType(
+            *consumer_kernel, consumer->AsStmt().op_info(), name, true);
+        if (to) latency += cost_table_->CastLatency(name, *from, *to);
+      }
+    }
+    return latency;
+  };
+  auto nodes = graph->StmtTopologicalOrder();
+  // Each cast is counted by its consumer.
+  auto plan_latency = [&]() {
+    double total = 0;
+    for (auto* node : nodes) {
+      auto* kernel = kernel_of(node);
+      if (!kernel) continue;
+      total += std::max(latency_of(node), 0.) +
+               cast_latency_of(node, *kernel, false);
+    }
+    return total;
+  };
+
+  std::map<Node*, std::string> static_kernels;
+  for (auto* node : nodes) {
+    static_kernels[node] = KernelRepr(kernel_of(node));
+  }
+  double static_latency = plan_latency();
+  // Minimize the latency of the graph by the coordinate descent, i.e. pick the
+  // kernel of each op in turn with the kernels of its neighbors fixed, until
+  // none of the picks changes.
+  const int kMaxSweeps = 8;
+  for (int sweep = 0; sweep < kMaxSweeps; sweep++) {
+    bool changed = false;
+    for (auto* node : nodes) {
+      if (!tunable.count(node)) continue;
+      auto& kernels = candidates->at(node);
+      size_t last_pick = picks[node];
+      size_t best_pick = last_pick;
+      double best_latency = std::numeric_limits<double>::max();
+      for (size_t i = 0; i < kernels.size(); i++) {
+        picks[node] = i;
+        double latency =
+            latencies[node][i] + cast_latency_of(node, *kernels[i], true);
+        if (latency < best_latency) {
+          best_latency = latency;
+          best_pick = i;
+        }
+      }
+      picks[node] = best_pick;
+      changed = changed || best_pick != last_pick;
+    }
+    if (!changed) break;
+  }
+  double picked_latency = plan_latency();
+
+  std::vector<std::string> plan;
+  plan.push_back("# block " + std::to_string(graph->blockIdx()) +
+                 ": the kernels of the highest scores take " +
+                 LatencyRepr(static_latency) + " ms, the picked take " +
+                 LatencyRepr(picked_latency) + " ms");
+  plan.push_back(
+      "op_type\toutput\tstatic_kernel\tpicked_kernel\tlatency(ms)\tcast(ms)");
+  for (auto* node : nodes) {
+    auto* kernel = kernel_of(node);
+    auto& stmt = node->AsStmt();
+    auto output_names = stmt.op_info()->output_names();
+    plan.push_back(
+        stmt.op_type() + "\t" +
+        (output_names.empty() ? "-" : output_names.front()) + "\t" +
+        static_kernels[node] + "\t" + KernelRepr(kernel) + "\t" +
+        LatencyRepr(latency_of(node)) + "\t" +
+        LatencyRepr(kernel ? cast_latency_of(node, *kernel, false) : -1));
+  }
+  LOG(INFO) << plan.front();
+  if (plan_path_.empty()) {
+    for (size_t i = 1; i < plan.size(); i++) {
+      LOG(INFO) << plan[i];
+    }
+  } else {
+    // The plans of the sub-blocks follow the one of the main block.
+    std::ofstream file(plan_path_,
+                       graph->blockIdx() == 0 ? std::ios::out : std::ios::app);
+    if (file.is_open()) {
+      for (auto& line : plan) {
+        file << line << "\n";
+      }
+    } else {
+      LOG(WARNING) << "Failed to write the kernel pick plan to " << plan_path_;
+    }
+  }
+
+  for (auto& it : *candidates) {
+    auto& kernels = it.first->AsStmt().kernels();
+    kernels.clear();
+    kernels.emplace_back(std::move(it.second[picks[it.first]]));
+    VLOG(2) << "the final pick kernel by the latency is "
+            << kernels.front()->summary();
+  }
+}
+
 void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   kernel_pick_factors_.ConsiderTarget();
   kernel_pick_factors_.ConsiderPrecision();
@@ -44,6 +303,8 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   VLOG(2) << "graph block_idx: " << graph->blockIdx();
   VLOG(2) << "graph->mutable_nodes().size(): " << graph->mutable_nodes().size();
   size_t idx = 0;
+  // The candidate kernels of the ops picked by the cost model.
+  std::map<Node*, std::vector<std::unique_ptr<KernelBase>>> candidates;
   for (auto& node : graph->mutable_nodes()) {
     if (!node.IsStmt()) continue;
     auto& instruct = node.AsStmt();
@@ -82,6 +343,10 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
                                 out_types,
                                 instruct.op_info()->input_names(),
                                 instruct.op_info()->output_names());
+      if (IsBlockedOnOtherRank(&node, *kernel)) {
+        VLOG(2) << "the blocked layout is only for the 4-D outputs";
+        score = 0;
+      }
 
       scored.emplace_back(score, std::move(kernel));
     }
@@ -95,6 +360,19 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
       instruct.kernels().emplace_back(std::move(scored.front().second));
       VLOG(2) << "the final pick kernel is "
               << instruct.kernels().front()->summary() << "\n\n";
+      if (cost_table_ && !IsControlFlowOp(instruct.op_type())) {
+        std::vector<std::unique_ptr<KernelBase>> kernels;
+        kernels.emplace_back(std::move(instruct.kernels().front()));
+        for (auto& candidate : scored) {
+          if (candidate.second &&
+              MatchValidPlaces(*candidate.second, graph->valid_places()) &&
+              !IsBlockedOnOtherRank(&node, *candidate.second)) {
+            kernels.emplace_back(std::move(candidate.second));
+          }
+        }
+        instruct.kernels().clear();
+        candidates[&node] = std::move(kernels);
+      }
 
     } else {
       bool out_type_int8 = true;
@@ -185,6 +463,7 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
                                          << instruct.op_type();
     }
   }
+  if (cost_table_) PickByLatency(graph.get(), &candidates);
 }
 
 }  // namespace mir
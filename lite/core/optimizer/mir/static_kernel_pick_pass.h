@@ -19,6 +19,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "lite/core/optimizer/mir/kernel_cost_table.h"
 #include "lite/core/optimizer/mir/pass.h"
 #include "lite/core/types.h"
 
@@ -36,6 +37,14 @@ namespace mir {
  * - place, the target place.
  * - kernel_pick_factors, the factors to consider in picking kernels.
  * Set them first before execute the pass.
+ *
+ * With the latency lookup tables set by SetLatencyTable, the kernels matching
+ * the valid places are picked by the cost model instead: the latencies of the
+ * kernels plus the costs of the io_copy, calib and layout ops inserted between
+ * the kernels of the adjacent ops are minimized over the graph, starting from
+ * the kernels of the highest scores. The ops lacking the latencies of any
+ * candidate, the quantized ops and the control flow ops keep the kernels of
+ * the highest scores.
  */
 class StaticKernelPickPass : public mir::StmtPass {
  public:
@@ -48,6 +57,13 @@ class StaticKernelPickPass : public mir::StmtPass {
     return &kernel_pick_factors_;
   }
 
+  // The latency lookup tables separated by ',', the cost model is off if it's
+  // empty.
+  void SetLatencyTable(const std::string& paths);
+  // The file to dump the kernels picked by the cost model into, they're
+  // logged if it's empty.
+  void SetPlanPath(const std::string& path) { plan_path_ = path; }
+
  private:
   // Score the kernel.
   size_t KernelGrade(lite::mir::Node* node,
@@ -311,8 +327,20 @@ class StaticKernelPickPass : public mir::StmtPass {
     }
   }
 
+  // Whether the kernel matches one of the places in the target, precision and
+  // layout, i.e. it's a candidate of the cost model.
+  bool MatchValidPlaces(const KernelBase& kernel,
+                        const std::vector<Place>& places) const;
+  // Pick one of the 'candidates' of each op, sorted by the scores, by the
+  // cost model, and dump the plan.
+  void PickByLatency(
+      SSAGraph* graph,
+      std::map<Node*, std::vector<std::unique_ptr<KernelBase>>>* candidates);
+
  private:
   core::KernelPickFactor kernel_pick_factors_;
+  std::unique_ptr<KernelCostTable> cost_table_;
+  std::string plan_path_;
 };
 
 }  // namespace mir
@@ -0,0 +1,126 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/static_kernel_pick_pass.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// x -> relu -> r1 -> relu -> r2 -> relu -> r3
+std::unique_ptr<SSAGraph> BuildReluChain(const std::vector<Place>& places,
+                                         std::shared_ptr<Scope>* scope) {
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+  std::vector<std::string> names{"x", "r1", "r2", "r3"};
+  for (auto& name : names) {
+    auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+    var_desc->SetName(name);
+    var_desc->SetType(VarDescAPI::Type::LOD_TENSOR);
+    var_desc->SetDataType(VarDescAPI::VarDataType::FP32);
+  }
+  for (size_t i = 1; i < names.size(); i++) {
+    auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+    op_desc->SetType("relu");
+    op_desc->SetInput("X", {names[i - 1]});
+    op_desc->SetOutput("Out", {names[i]});
+  }
+  scope->reset(new Scope);
+  Program program(program_desc, *scope, places);
+  std::unique_ptr<SSAGraph> graph(new SSAGraph);
+  graph->Build(program, places);
+  graph->SetValidPlaces(places);
+  return graph;
+}
+
+std::vector<DataLayoutType> PickedLayouts(SSAGraph* graph) {
+  std::vector<DataLayoutType> layouts;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto& kernels = node->AsStmt().kernels();
+    EXPECT_EQ(kernels.size(), 1u);
+    layouts.push_back(kernels.front()->layout());
+  }
+  return layouts;
+}
+
+TEST(StaticKernelPickPass, pick_by_latency) {
+  // The NCHW8c kernels are faster than the NCHW ones except for r2, which
+  // would cost two layout casts of 0.08 ms to run in NCHW alone.
+  const std::string table_path = "static_kernel_pick_pass_test.txt";
+  std::ofstream fs(table_path);
+  fs << "dev_info\tarmv7/v8\tcore_num\tthread_num\tpower_mode\n"
+     << "benchmark_bin\tx86_64\t4\t1\t0\n"
+     << "op_name\tinput_dims\toutput_dims\tparam_info\tmin_latency(ms)\t"
+        "max_latency(ms)\tavg_latency(ms)\n"
+     << "layout\t[1000]\t[1000]\t()\t0.1\t0.1\t0.1\n";
+  const char* latencies[][3] = {{"r1", "1.0", "0.2"},
+                                {"r2", "0.5", "0.6"},
+                                {"r3", "1.0", "0.2"}};
+  for (auto& row : latencies) {
+    for (int i = 0; i < 2; i++) {
+      fs << "relu\t[]\t[1 8 10 10]\t(output=" << row[0]
+         << ",kernel=x86/float/" << (i == 0 ? "NCHW" : "NCHW8c") << ")\t"
+         << row[i + 1] << "\t" << row[i + 1] << "\t" << row[i + 1] << "\n";
+    }
+  }
+  fs.close();
+
+  std::vector<Place> places{
+      Place{TARGET(kX86), PRECISION(kFloat), DATALAYOUT(kNCHW)},
+      Place{TARGET(kX86), PRECISION(kFloat), DATALAYOUT(kNCHW8c)}};
+  const std::string plan_path = "static_kernel_pick_pass_test.plan";
+  std::shared_ptr<Scope> scope;
+  // The kernels of the highest scores are of the first place.
+  auto graph = BuildReluChain(places, &scope);
+  StaticKernelPickPass score_pass;
+  score_pass.Apply(graph);
+  EXPECT_EQ(PickedLayouts(graph.get()),
+            std::vector<DataLayoutType>(3, DATALAYOUT(kNCHW)));
+
+  // The cost model picks NCHW8c for r2 as well to save the casts, though
+  // its own kernel is slower.
+  graph = BuildReluChain(places, &scope);
+  StaticKernelPickPass latency_pass;
+  latency_pass.SetLatencyTable(table_path);
+  latency_pass.SetPlanPath(plan_path);
+  latency_pass.Apply(graph);
+  EXPECT_EQ(PickedLayouts(graph.get()),
+            std::vector<DataLayoutType>(3, DATALAYOUT(kNCHW8c)));
+  std::ifstream plan(plan_path);
+  std::string header;
+  ASSERT_TRUE(std::getline(plan, header));
+  EXPECT_NE(header.find("the kernels of the highest scores take 2.5 ms"),
+            std::string::npos)
+      << header;
+  EXPECT_NE(header.find("the picked take 1 ms"), std::string::npos) << header;
+  plan.close();
+
+  std::remove(table_path.c_str());
+  std::remove(plan_path.c_str());
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -88,6 +88,17 @@ void TypeLayoutTransformPass::ComplementInputs(
     return x == TARGET(kHost) || x == TARGET(kX86) || x == TARGET(kARM);
   };
   auto* in_arg_type = const_cast<Type*>(in->AsArg().type);
+  // The kernels of any layout read the tensors as the plain ones, so the
+  // blocked channel layouts are reordered to NCHW at the boundary of the
+  // blocked kernels.
+  if (decl_arg_type->IsTensor() &&
+      decl_arg_type->layout() == DATALAYOUT(kAny) &&
+      (in_arg_type->layout() == DATALAYOUT(kNCHW8c) ||
+       in_arg_type->layout() == DATALAYOUT(kNCHW16c))) {
+    decl_arg_type = LiteType::GetTensorTy(decl_arg_type->target(),
+                                          decl_arg_type->precision(),
+                                          DATALAYOUT(kNCHW));
+  }
   if (is_host(in_arg_type->target()) &&
       (in_arg_type->layout() == DATALAYOUT(kImageDefault) ||
        in_arg_type->layout() == DATALAYOUT(kImageFolder))) {
@@ -0,0 +1,181 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/x86_sparse_weight_detect_pass.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+// The cost of a non-zero weight in the sparse gemm relative to the dense
+// gemm, the unstructured format loads an index for every weight and can't
+// reuse the input in registers, while the 4x4 blocks reuse every loaded input
+// for four output channels.
+const float kUnstructuredCost = 2.0f;
+const float kBlock1x4Cost = 1.0f;
+const float kBlock4x4Cost = 0.75f;
+
+const lite::Tensor* GetWeightTensor(Node* node, const std::string& name) {
+  auto* scope = node->stmt()->op()->scope();
+  auto* var = scope->FindVar(name);
+  if (!var) return nullptr;
+  for (auto* in : node->inlinks) {
+    if (in->IsArg() && in->arg()->name == name) {
+      if (!in->arg()->is_weight) return nullptr;
+      return &var->Get<lite::Tensor>();
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+float X86SparseWeightDetectPass::ComputeBlockDensity(const float* weights,
+                                                     int rows,
+                                                     int cols,
+                                                     bool transposed,
+                                                     int block_h,
+                                                     int block_w) {
+  if (rows <= 0 || cols <= 0) return 1.f;
+  int64_t num_nonzero_blocks = 0;
+  for (int r0 = 0; r0 < rows; r0 += block_h) {
+    for (int c0 = 0; c0 < cols; c0 += block_w) {
+      bool is_zero = true;
+      for (int r = r0; r < std::min(r0 + block_h, rows) && is_zero; r++) {
+        for (int c = c0; c < std::min(c0 + block_w, cols); c++) {
+          float v = transposed ? weights[c * rows + r] : weights[r * cols + c];
+          if (v != 0.f) {
+            is_zero = false;
+            break;
+          }
+        }
+      }
+      if (!is_zero) num_nonzero_blocks++;
+    }
+  }
+  return static_cast<float>(num_nonzero_blocks * block_h * block_w) /
+         (static_cast<float>(rows) * cols);
+}
+
+std::string X86SparseWeightDetectPass::DetectSparseWeightType(
+    const float* weights, int rows, int cols, bool transposed) const {
+  float density = ComputeBlockDensity(weights, rows, cols, transposed, 1, 1);
+  float block1x4_density =
+      ComputeBlockDensity(weights, rows, cols, transposed, 1, 4);
+  float block4x4_density =
+      ComputeBlockDensity(weights, rows, cols, transposed, 4, 4);
+  std::vector<std::pair<float, std::string>> costs{
+      {density * kUnstructuredCost, "unstructured"},
+      {block1x4_density * kBlock1x4Cost, "1x4"},
+      {block4x4_density * kBlock4x4Cost, "4x4"}};
+  auto best = *std::min_element(costs.begin(), costs.end());
+  VLOG(4) << "sparsity: " << 1.f - density
+          << ", 1x4 block sparsity: " << 1.f - block1x4_density
+          << ", 4x4 block sparsity: " << 1.f - block4x4_density
+          << ", estimated relative cost: " << best.first << " (" << best.second
+          << ")";
+  if (1.f - best.first < sparse_threshold_) {
+    return "";
+  }
+  return best.second;
+}
+
+void X86SparseWeightDetectPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // The threshold above 1 turns off the pass, skip measuring the weights.
+  if (sparse_threshold_ > 1.f) return;
+  for (auto& node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    auto op_type = node->AsStmt().op_type();
+    auto* op_info = node->stmt()->mutable_op_info();
+    if (op_info->HasAttr("enable_int8") &&
+        op_info->GetAttr<bool>("enable_int8")) {
+      continue;
+    }
+    std::string w_name;
+    int rows = 0;
+    int cols = 0;
+    bool transposed = false;
+    if (op_type == "conv2d") {
+      w_name = op_info->Input("Filter").front();
+      auto* w_tensor = GetWeightTensor(node, w_name);
+      if (!w_tensor) continue;
+      auto w_dims = w_tensor->dims();
+      auto strides = op_info->GetAttr<std::vector<int>>("strides");
+      auto paddings = op_info->GetAttr<std::vector<int>>("paddings");
+      int groups = op_info->GetAttr<int>("groups");
+      bool pad_zero = std::all_of(
+          paddings.begin(), paddings.end(), [](int p) { return p == 0; });
+      if (!(w_dims.size() == 4 && w_dims[2] == 1 && w_dims[3] == 1 &&
+            strides[0] == 1 && strides[1] == 1 && pad_zero && groups == 1)) {
+        VLOG(4) << "Only conv2d 1x1 with stride 1, padding 0 and group 1 can "
+                   "use the sparse weights";
+        continue;
+      }
+      rows = w_dims[0];
+      cols = w_dims[1];
+    } else if (op_type == "fc") {
+      if (op_info->HasAttr("padding_weights") &&
+          op_info->GetAttr<bool>("padding_weights")) {
+        continue;
+      }
+      if (op_info->HasAttr("activation_type")) {
+        auto act_type = op_info->GetAttr<std::string>("activation_type");
+        if (!act_type.empty() && act_type != "relu") continue;
+      }
+      w_name = op_info->Input("W").front();
+      auto* w_tensor = GetWeightTensor(node, w_name);
+      if (!w_tensor || w_tensor->dims().size() != 2) continue;
+      rows = w_tensor->dims()[1];
+      cols = w_tensor->dims()[0];
+      transposed = true;
+    } else if (op_type == "mul") {
+      w_name = op_info->Input("Y").front();
+      auto* w_tensor = GetWeightTensor(node, w_name);
+      if (!w_tensor) continue;
+      auto w_dims =
+          w_tensor->dims().Flatten2D(op_info->GetAttr<int>("y_num_col_dims"));
+      rows = w_dims[1];
+      cols = w_dims[0];
+      transposed = true;
+    } else {
+      continue;
+    }
+    auto* w_tensor = GetWeightTensor(node, w_name);
+    if (w_tensor->precision() != PRECISION(kFloat) || rows <= 0 || cols <= 0) {
+      continue;
+    }
+    auto sparse_type = DetectSparseWeightType(
+        w_tensor->data<float>(), rows, cols, transposed);
+    if (sparse_type.empty()) continue;
+    VLOG(3) << "Use " << sparse_type << " sparse weights for " << op_type
+            << ", weight: " << w_name;
+    op_info->SetAttr<std::string>("sparse_weight_type", sparse_type);
+    auto updated_op_info = *op_info;
+    node->stmt()->ResetOp(updated_op_info, graph->valid_places());
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(x86_sparse_weight_detect_pass,
+                  paddle::lite::mir::X86SparseWeightDetectPass)
+    .BindTargets({TARGET(kX86)});
@@ -0,0 +1,67 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * X86SparseWeightDetectPass measures the sparsity of the fp32 weights of
+ * conv2d(1x1), fc and mul, and marks the ops whose weights are sparse enough
+ * with the 'sparse_weight_type' attribute, the x86 kernels pack the weights
+ * into the block sparse format in PrepareForRun and run the sparse gemm.
+ *
+ * The weights are viewed as a [rows, cols] matrix, where rows is the output
+ * channels, and the density of the unstructured, 1x4 and 4x4 block formats
+ * are measured, the format with the lowest estimated cost is picked, the
+ * weights are kept dense if it doesn't reach the sparse threshold.
+ */
+class X86SparseWeightDetectPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  void SetSparseThreshold(float sparse_threshold) {
+    sparse_threshold_ = sparse_threshold;
+  }
+
+  // Return the fraction of the non-zero blocks, the weights is a row-major
+  // [rows, cols] matrix, or [cols, rows] if 'transposed' is true.
+  static float ComputeBlockDensity(const float* weights,
+                                   int rows,
+                                   int cols,
+                                   bool transposed,
+                                   int block_h,
+                                   int block_w);
+
+  // Return the sparse format of the weights, or an empty string if the dense
+  // gemm is expected to be faster.
+  std::string DetectSparseWeightType(const float* weights,
+                                     int rows,
+                                     int cols,
+                                     bool transposed) const;
+
+ private:
+  float sparse_threshold_{0.5f};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -13,6 +13,10 @@
 // limitations under the License.
 
 #include "lite/core/optimizer/optimizer.h"
+#ifdef __linux__
+#include <malloc.h>
+#endif
+#include <algorithm>
 #include <fstream>
 #ifdef LITE_WITH_XPU
 #include "lite/core/optimizer/mir/__xpu__static_kernel_pick_pass.h"
@@ -21,10 +25,41 @@
 #include "lite/core/optimizer/mir/type_target_cast_pass.h"
 #include "lite/model_parser/model_parser.h"
 #include "lite/utils/all.h"
+#include "lite/utils/timer.h"
 
 namespace paddle {
 namespace lite {
 
+namespace {
+
+// The in-use size of the memory allocated by malloc, or 0 if it's not
+// supported.
+int64_t InUseMallocBytes() {
+#ifdef __linux__
+#if defined(__GLIBC__) && __GLIBC_MINOR__ >= 33
+  const auto mem = mallinfo2();
+#else
+  const auto mem = mallinfo();
+#endif
+  return static_cast<int64_t>(mem.uordblks);
+#else
+  return 0;
+#endif
+}
+
+// Whether any op type the pass is anchored at is in the graphs.
+bool HasAnchorOps(const mir::Pass& pass,
+                  std::vector<std::unique_ptr<mir::SSAGraph>>* graphes) {
+  for (auto& graph : *graphes) {
+    for (const auto& op_type : pass.AnchorOps()) {
+      if (graph->HasOpType(op_type)) return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 void Optimizer::AddPass(const std::string& pass_name) {
   mir::Pass* pass = mir::PassManager::Global().LookUp(pass_name);
   passes_.push_back(pass);
@@ -106,6 +141,9 @@ void Optimizer::InitControlFlowOpSharedInputsAndOutputsPlaceSyncPass() {
 
 void Optimizer::ApplyPasses(
     std::vector<std::unique_ptr<mir::SSAGraph>>* graphes) {
+  // The wall time of the passes in us.
+  std::vector<std::pair<uint64_t, std::string>> pass_times;
+  const uint64_t start = lite::Timer::GetCurrentUS();
   for (auto& pass : passes_) {
     LOG(INFO) << "== Running pass: " << pass->name();
     std::set<TargetType> targets;
@@ -117,18 +155,50 @@ void Optimizer::ApplyPasses(
     if (!matched) {
       LOG(INFO) << "   - Skip " << pass->name()
                 << " because the target or kernel does not match.";
+      continue;
+    }
+    // The op types might be changed in place by the previous passes.
+    for (auto& graph : *graphes) {
+      graph->InvalidateOpTypeIndex();
+    }
+    if (!pass->AnchorOps().empty() && !HasAnchorOps(*pass, graphes)) {
+      LOG(INFO) << "   - Skip " << pass->name()
+                << " because none of its anchor ops is in the graph.";
+      continue;
+    }
+    const uint64_t pass_start = lite::Timer::GetCurrentUS();
+    const int64_t pass_start_bytes = InUseMallocBytes();
+    // Check the pass whether it is supported for processing subblocks
+    if (kSubblockUnsupportedPasses.count(pass->name()) ||
+        kSubblockSkippedPasses.count(pass->name())) {
+      pass->Apply((*graphes)[kRootBlockIdx]);
     } else {
-      // Check the pass whether it is supported for processing subblocks
-      if (kSubblockUnsupportedPasses.count(pass->name()) ||
-          kSubblockSkippedPasses.count(pass->name())) {
-        pass->Apply((*graphes)[kRootBlockIdx]);
-      } else {
-        for (auto& graph : *graphes) {
-          pass->Apply(graph);
-        }
+      for (auto& graph : *graphes) {
+        pass->Apply(graph);
       }
-      LOG(INFO) << "== Finished running: " << pass->name();
     }
+    const uint64_t pass_time = lite::Timer::GetCurrentUS() - pass_start;
+    pass_times.emplace_back(pass_time, pass->name());
+    LOG(INFO) << "== Finished running: " << pass->name() << ", "
+              << pass_time / 1000.0 << " ms, in-use memory "
+              << (InUseMallocBytes() - pass_start_bytes) / 1024.0 << " KB";
+  }
+  // Summarize the slowest passes.
+  const int kNumSlowestPasses = 5;
+  std::stable_sort(pass_times.begin(),
+                   pass_times.end(),
+                   [](const std::pair<uint64_t, std::string>& a,
+                      const std::pair<uint64_t, std::string>& b) {
+                     return a.first > b.first;
+                   });
+  LOG(INFO) << "== Applied " << pass_times.size() << " of " << passes_.size()
+            << " passes in "
+            << (lite::Timer::GetCurrentUS() - start) / 1000.0 << " ms";
+  for (size_t i = 0;
+       i < pass_times.size() && i < static_cast<size_t>(kNumSlowestPasses);
+       i++) {
+    LOG(INFO) << "   - " << pass_times[i].second << ": "
+              << pass_times[i].first / 1000.0 << " ms";
   }
 }
 
@@ -142,6 +212,9 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
 
   std::vector<std::string> passes_local{
       {"lite_quant_dequant_fuse_pass",
+       // Quantize the fp32 model by the scales of the calibration, see
+       // lite/core/calibration.h.
+       "post_training_quant_pass",
        "weight_quantization_preprocess_pass",
        "op_transformation_pass",
        "assign_value_calc_offline_pass",
@@ -152,6 +225,8 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "unsqueeze_calc_offline_pass",
        "reshape_calc_offline_pass",
        "ssd_boxes_calc_offline_pass",
+       // Run the ops of the constant inputs once and save their outputs.
+       "constant_folding_pass",
        // A minimal set of op fusion pass.
        "op_fusion_minimal_set_pass",
        // For the fully quantization model, the quantization parameters of the
@@ -205,6 +280,7 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "fill_range_fuse_pass",
        "identity_dropout_eliminate_pass",
        "sparse_conv_detect_pass",
+       "x86_sparse_weight_detect_pass",
        "keepdims_convert_pass",
        "__xpu__max_pooling_pad_zero_detect_fuse_pass",
        "__xpu__graph_dedup_pass",
@@ -323,6 +399,7 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
   const std::string pqd_pass{"post_quant_dynamic_pass"};
   const std::string pqd_depend_pass{"lite_quant_dequant_fuse_pass"};
   const std::string fp16_pass{"fp16_attribute_pass"};
+  const std::string fp16_planning_pass{"fp16_precision_planning_pass"};
 
   for (const std::string& pass : passes) {
     if (pass == msa_pass) {
@@ -343,6 +420,11 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
   for (auto place : valid_places) {
     if (place.target == TARGET(kARM)) {
       if (place.precision == PRECISION(kFP16)) {
+        // Plan the fp16 regions before picking kernels to minimize the casts
+        auto iter = std::find(
+            passes_local.begin(), passes_local.end(), "static_kernel_pick_pass");
+        CHECK(iter != passes_local.end()) << "No find static_kernel_pick_pass";
+        passes_local.insert(iter, fp16_planning_pass);
         passes_local.push_back(fp16_pass);
         break;
       }
@@ -18,6 +18,8 @@
 #include <map>
 #include <set>
 
+#include "lite/core/autotune.h"
+#include "lite/core/tracer.h"
 #include "lite/model_parser/cpp_desc.h"
 #include "lite/operators/conditional_block_op.h"
 #include "lite/operators/subgraph_op.h"
@@ -263,6 +265,29 @@ void RuntimeProgram::SaveRuntimProgramIntoProgramDesc(
     }
   }
 }
+
+void RuntimeProgram::SaveTunedAlgosIntoProgramDesc(
+    std::shared_ptr<cpp::ProgramDesc> program_desc) {
+  size_t block_size =
+      std::min(program_desc->BlocksSize(), instructions_.size());
+  for (size_t block_idx = 0; block_idx < block_size; ++block_idx) {
+    auto* block_desc = program_desc->GetBlock<cpp::BlockDesc>(block_idx);
+    auto& insts = instructions_[block_idx];
+    if (block_desc->OpsSize() != insts.size()) {
+      LOG(WARNING) << "The ops of block " << block_idx
+                   << " don't match the instructions, skip saving the tuned "
+                      "algorithms";
+      continue;
+    }
+    for (size_t op_idx = 0; op_idx < insts.size(); ++op_idx) {
+      auto& tuned_algo = insts[op_idx].kernel()->tuned_algo();
+      if (tuned_algo.empty()) continue;
+      auto* op_desc = block_desc->GetOp<cpp::OpDesc>(op_idx);
+      op_desc->SetAttr<std::string>(kAutotuneAlgoAttr, tuned_algo);
+      op_desc->SetAttr<std::string>(kAutotuneCpuAttr, CpuModelName());
+    }
+  }
+}
 #endif
 
 // Create runtime program from sub_block desc according to block_idx and
@@ -407,7 +432,63 @@ void RuntimeProgram::SaveOutput() {
 }
 #endif
 
+void RuntimeProgram::set_inter_op_threads(int inter_op_threads) {
+  scheduler_.reset();
+  scheduler_ = InstructionScheduler::Create(&instructions_[kRootBlockIdx],
+                                            inter_op_threads);
+}
+
+void RuntimeProgram::set_op_stats_interval(int interval) {
+  if (!sampling_profiler_) {
+    if (interval <= 0) return;
+    sampling_profiler_.reset(
+        new SamplingProfiler(&instructions_[kRootBlockIdx]));
+  }
+  sampling_profiler_->set_interval(interval);
+}
+
+void RuntimeProgram::set_autotune(bool autotune) {
+  for (auto& insts : instructions_) {
+    for (auto& inst : insts) {
+      inst.mutable_kernel()->set_autotune(autotune);
+    }
+  }
+}
+
+void RuntimeProgram::set_frozen(bool frozen) {
+  frozen_program_.reset();
+  if (frozen) {
+    frozen_program_ = FrozenProgram::Create(&instructions_[kRootBlockIdx]);
+  }
+}
+
+std::vector<lite_api::OpStats> RuntimeProgram::GetOpStats() const {
+  if (!sampling_profiler_) return std::vector<lite_api::OpStats>();
+  return sampling_profiler_->Stats();
+}
+
+void RuntimeProgram::ResetOpStats() {
+  if (sampling_profiler_) sampling_profiler_->Reset();
+}
+
 void RuntimeProgram::Run() {
+  if (sampling_profiler_) {
+    sampling_profiler_->BeginRun();
+  }
+  if (scheduler_ && !observer_) {
+    scheduler_->Run();
+    return;
+  }
+  // The sampled runs, the traced runs and the observed runs need the hooks
+  // of the instructions.
+  bool use_frozen =
+      frozen_program_ && !observer_ &&
+      !(sampling_profiler_ && sampling_profiler_->sampling()) &&
+      !Tracer::Enabled();
+  if (use_frozen && frozen_program_->Run()) {
+    return;
+  }
+
 #ifdef LITE_WITH_PRECISION_PROFILE
   auto inst_precision_profiler = paddle::lite::profile::PrecisionProfiler();
   std::string precision_profiler_summary =
@@ -458,6 +539,9 @@ void RuntimeProgram::Run() {
     inst.Flush(idx);
 #endif
 
+    if (observer_) {
+      observer_(&inst);
+    }
     inst.Run();
 
 #ifdef LITE_WITH_FPGA
@@ -474,6 +558,10 @@ void RuntimeProgram::Run() {
 #endif  // LITE_WITH_PRECISION_PROFILE
   }
 
+  if (use_frozen) {
+    frozen_program_->Freeze();
+  }
+
 #ifdef LITE_WITH_METAL
   if (metal_ctx_) {
     MetalContext* wait_ctx = (*metal_ctx_).As<MTLContext>().context();
@@ -666,7 +754,20 @@ void Instruction::Run() {
   }
 
   op_->InferShape();
-  kernel_->Launch();
+  bool sampling = sampling_profiler_ && sampling_profiler_->sampling();
+  if (sampling || Tracer::Enabled()) {
+    int64_t start = Tracer::Now();
+    kernel_->Launch();
+    int64_t end = Tracer::Now();
+    if (sampling) {
+      sampling_profiler_->Record(sampling_index_, end - start);
+    }
+    if (Tracer::Enabled()) {
+      Tracer::Global().AddSpan("op", op_->Type(), start, end, kernel_->name());
+    }
+  } else {
+    kernel_->Launch();
+  }
   has_run_ = true;
 
 #ifdef LITE_WITH_PROFILE
@@ -13,15 +13,19 @@
 // limitations under the License.
 
 #pragma once
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
+#include "lite/core/frozen_program.h"
+#include "lite/core/instruction_scheduler.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/sampling_profiler.h"
 #include "lite/model_parser/cpp_desc.h"
 #ifdef LITE_WITH_PROFILE
 #include "lite/core/profile/profiler.h"
@@ -131,11 +135,17 @@ struct Instruction {
   friend STL::ostream& operator<<(STL::ostream& os, const Instruction& other);
 
   const OpLite* op() const { return op_.get(); }
+  OpLite* mutable_op() { return op_.get(); }
   const KernelBase* kernel() const { return kernel_.get(); }
   KernelBase* mutable_kernel() { return kernel_.get(); }
 
   bool is_feed_fetch_op() const { return is_feed_fetch_op_; }
 
+  void set_sampling_profiler(SamplingProfiler* profiler, int index) {
+    sampling_profiler_ = profiler;
+    sampling_index_ = index;
+  }
+
 #ifdef LITE_WITH_CUDA
   bool need_sync() const {
     if (kernel_->target() == TargetType::kCUDA) {
@@ -191,6 +201,8 @@ struct Instruction {
   bool is_feed_fetch_op_{false};
   bool first_epoch_{true};
   bool has_run_{false};
+  SamplingProfiler* sampling_profiler_{nullptr};
+  int sampling_index_{-1};
 
 #ifdef LITE_WITH_PROFILE
   profile::Profiler* profiler_;
@@ -306,6 +318,40 @@ class LITE_API RuntimeProgram {
 
   size_t block_size() { return instructions_.size(); }
 
+  // Run the independent instructions of the root block concurrently on at
+  // most 'inter_op_threads' threads, the intra-op threads are partitioned
+  // among them. Fall back to the sequential run if the instructions form a
+  // chain or can't run concurrently.
+  void set_inter_op_threads(int inter_op_threads);
+  int inter_op_threads() const {
+    return scheduler_ ? scheduler_->workers() : 1;
+  }
+
+  // Sample the run time of the instructions of the root block in one of every
+  // 'interval' runs, the sampling is off if it's 0.
+  void set_op_stats_interval(int interval);
+  std::vector<lite_api::OpStats> GetOpStats() const;
+  void ResetOpStats();
+
+  // Compile the instructions of the root block into a flat array of kernel
+  // calls after the first run on a signature of the input shapes, the static
+  // ops skip InferShape in the following runs on the same signature. The
+  // shapes of the ops must only depend on the shapes of the inputs.
+  void set_frozen(bool frozen);
+  bool frozen() const { return frozen_program_ != nullptr; }
+
+  // Let the kernels time their eligible algorithms in the first run, see
+  // lite/core/autotune.h.
+  void set_autotune(bool autotune);
+
+  // Call 'observer' before running each instruction of the root block, e.g.
+  // to collect the statistics of the inputs for the calibration. The
+  // instructions run one by one in order while it's set.
+  using InstructionObserver = std::function<void(Instruction*)>;
+  void set_observer(const InstructionObserver& observer) {
+    observer_ = observer;
+  }
+
   void set_version(const int64_t version) { version_ = version; }
 
   const int64_t get_version() const { return version_; }
@@ -315,6 +361,11 @@ class LITE_API RuntimeProgram {
   // according to the instructions
   void SaveRuntimProgramIntoProgramDesc(
       std::shared_ptr<cpp::ProgramDesc> program_desc);
+  // Record the algorithms picked by the autotuning into the op descs, the
+  // program_desc is expected to be updated by
+  // SaveRuntimProgramIntoProgramDesc.
+  void SaveTunedAlgosIntoProgramDesc(
+      std::shared_ptr<cpp::ProgramDesc> program_desc);
 #endif
 
 #ifdef LITE_WITH_METAL
@@ -330,6 +381,10 @@ class LITE_API RuntimeProgram {
   std::vector<std::vector<Instruction>> instructions_;
   Scope* exec_scope_{};
   int64_t version_{0};
+  std::unique_ptr<InstructionScheduler> scheduler_;
+  std::unique_ptr<SamplingProfiler> sampling_profiler_;
+  std::unique_ptr<FrozenProgram> frozen_program_;
+  InstructionObserver observer_;
 
 #ifdef LITE_WITH_METAL
   std::unique_ptr<KernelContext> metal_ctx_{nullptr};
@@ -0,0 +1,179 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/sampling_profiler.h"
+#include <algorithm>
+#include <string>
+#include "lite/core/program.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+const Tensor* FindTensor(Scope* scope, const std::string& name) {
+  auto* var = scope->FindVar(name);
+  if (!var || !var->IsType<Tensor>()) return nullptr;
+  return &var->Get<Tensor>();
+}
+
+const Tensor* GetInputTensor(Scope* scope,
+                             const OpInfo& op_info,
+                             const std::string& param) {
+  if (!op_info.HasInput(param) || op_info.Input(param).empty()) {
+    return nullptr;
+  }
+  return FindTensor(scope, op_info.Input(param).front());
+}
+
+const Tensor* GetOutputTensor(Scope* scope,
+                              const OpInfo& op_info,
+                              const std::string& param) {
+  if (!op_info.HasOutput(param) || op_info.Output(param).empty()) {
+    return nullptr;
+  }
+  return FindTensor(scope, op_info.Output(param).front());
+}
+
+int64_t TouchedBytes(Scope* scope, const OpInfo& op_info) {
+  int64_t bytes = 0;
+  for (auto& names : {op_info.input_names(), op_info.output_names()}) {
+    for (auto& name : names) {
+      auto* tensor = FindTensor(scope, name);
+      if (!tensor) continue;
+      size_t element_size = PrecisionTypeLength(tensor->precision());
+      bytes += element_size > 0 ? tensor->dims().production() * element_size
+                                : tensor->memory_size();
+    }
+  }
+  return bytes;
+}
+
+// The floating point operations of the ops which dominate the compute. The
+// macs of OpLite::GetOpRuntimeInfo are only built with LITE_WITH_PROFILE, so
+// the same formulas are evaluated on the tensors of the last run.
+double EstimateFlops(Scope* scope, const OpInfo& op_info) {
+  auto op_type = op_info.Type();
+  if (op_type == "conv2d" || op_type == "depthwise_conv2d") {
+    // The filter is [oc, ic / groups, kh, kw].
+    auto* filter = GetInputTensor(scope, op_info, "Filter");
+    auto* output = GetOutputTensor(scope, op_info, "Output");
+    if (!filter || !output || filter->dims().size() != 4) return 0;
+    auto& filter_dims = filter->dims();
+    return 2.0 * output->dims().production() * filter_dims[1] *
+           filter_dims[2] * filter_dims[3];
+  }
+  if (op_type == "conv2d_transpose" ||
+      op_type == "depthwise_conv2d_transpose") {
+    // The filter is [ic, oc / groups, kh, kw].
+    auto* filter = GetInputTensor(scope, op_info, "Filter");
+    auto* input = GetInputTensor(scope, op_info, "Input");
+    if (!filter || !input || filter->dims().size() != 4) return 0;
+    auto& filter_dims = filter->dims();
+    return 2.0 * input->dims().production() * filter_dims[1] *
+           filter_dims[2] * filter_dims[3];
+  }
+  if (op_type == "fc") {
+    auto* w = GetInputTensor(scope, op_info, "W");
+    auto* out = GetOutputTensor(scope, op_info, "Out");
+    if (!w || !out || w->dims().size() != 2) return 0;
+    return 2.0 * out->dims().production() * w->dims()[0];
+  }
+  if (op_type == "mul" || op_type == "matmul" || op_type == "matmul_v2") {
+    auto* x = GetInputTensor(scope, op_info, "X");
+    auto* out = GetOutputTensor(scope, op_info, "Out");
+    if (!x || !out || x->dims().size() == 0) return 0;
+    auto& x_dims = x->dims();
+    int rank = static_cast<int>(x_dims.size());
+    int64_t k = x_dims[rank - 1];
+    if (op_type == "mul") {
+      int x_num_col_dims = op_info.GetAttr<int>("x_num_col_dims");
+      k = x_dims.count(x_num_col_dims, rank);
+    } else if (rank > 1) {
+      bool transpose_x = op_type == "matmul"
+                             ? op_info.GetAttr<bool>("transpose_X")
+                             : op_info.GetAttr<bool>("trans_x");
+      if (transpose_x) k = x_dims[rank - 2];
+    }
+    return 2.0 * out->dims().production() * k;
+  }
+  return 0;
+}
+
+}  // namespace
+
+SamplingProfiler::SamplingProfiler(std::vector<Instruction>* insts)
+    : insts_(insts), slots_(insts->size()) {
+  for (size_t i = 0; i < insts_->size(); i++) {
+    slots_[i].window.resize(kWindowSize);
+    insts_->at(i).set_sampling_profiler(this, static_cast<int>(i));
+  }
+}
+
+std::vector<lite_api::OpStats> SamplingProfiler::Stats() const {
+  std::vector<lite_api::OpStats> stats;
+  for (size_t i = 0; i < slots_.size(); i++) {
+    auto& slot = slots_[i];
+    if (slot.count == 0) continue;
+    auto& inst = insts_->at(i);
+    auto* op = const_cast<OpLite*>(inst.op());
+    auto* op_info = op->op_info();
+    lite_api::OpStats op_stats;
+    op_stats.op_type = op_info->Type();
+    op_stats.kernel_name = inst.kernel()->name();
+    auto output_names = op_info->output_names();
+    if (!output_names.empty()) op_stats.output_name = output_names.front();
+    op_stats.count = slot.count;
+    op_stats.avg_ms = slot.total_ns / 1e6 / slot.count;
+    op_stats.max_ms = slot.max_ns / 1e6;
+    int64_t size = std::min<int64_t>(slot.count, kWindowSize);
+    std::vector<int64_t> window(slot.window.begin(),
+                                slot.window.begin() + size);
+    // The nearest rank, i.e. ceil(0.99 * size) - 1.
+    int64_t rank = (size * 99 + 99) / 100 - 1;
+    std::nth_element(window.begin(), window.begin() + rank, window.end());
+    op_stats.p99_ms = window[rank] / 1e6;
+    if (op->scope()) {
+      auto* output = output_names.empty()
+                         ? nullptr
+                         : FindTensor(op->scope(), output_names.front());
+      if (output) op_stats.output_shape = output->dims().Vectorize();
+      op_stats.bytes = TouchedBytes(op->scope(), *op_info);
+      op_stats.flops = EstimateFlops(op->scope(), *op_info);
+    }
+    if (op_stats.avg_ms > 0) {
+      op_stats.gflops = op_stats.flops / op_stats.avg_ms / 1e6;
+    }
+    stats.push_back(op_stats);
+  }
+  std::stable_sort(
+      stats.begin(),
+      stats.end(),
+      [](const lite_api::OpStats& a, const lite_api::OpStats& b) {
+        return a.avg_ms * a.count > b.avg_ms * b.count;
+      });
+  return stats;
+}
+
+void SamplingProfiler::Reset() {
+  for (auto& slot : slots_) {
+    slot.count = 0;
+    slot.total_ns = 0;
+    slot.max_ns = 0;
+  }
+  runs_ = 0;
+}
+
+}  // namespace lite
+}  // namespace paddle
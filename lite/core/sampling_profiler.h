@@ -0,0 +1,89 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <vector>
+#include "lite/api/paddle_api.h"
+
+namespace paddle {
+namespace lite {
+
+struct Instruction;
+
+/*
+ * The per-op counters of the release builds, unlike profile::Profiler it
+ * doesn't need LITE_WITH_PROFILE.
+ *
+ * One of every 'interval' runs of the program is sampled, and the sampled
+ * instructions stamp the steady clock around the kernel launch. The latencies
+ * are recorded into a ring buffer of each instruction which is allocated when
+ * the profiler is created, so nothing is allocated on the hot path. The bytes
+ * and the flops of the ops are computed from the tensors of the last run when
+ * the stats are queried.
+ */
+class SamplingProfiler {
+ public:
+  // The number of the latest samples of an instruction to compute the p99.
+  static constexpr int kWindowSize = 128;
+
+  explicit SamplingProfiler(std::vector<Instruction>* insts);
+
+  void set_interval(int interval) { interval_ = interval > 0 ? interval : 0; }
+  int interval() const { return interval_; }
+
+  // Called before each run of the program to decide whether it's sampled.
+  void BeginRun() {
+    sampling_ = interval_ > 0 && runs_++ % interval_ == 0;
+  }
+  bool sampling() const { return sampling_; }
+
+  static int64_t Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+  // The instructions of a run record the different slots, so they may run
+  // concurrently.
+  void Record(int index, int64_t duration_ns) {
+    auto& slot = slots_[index];
+    slot.window[slot.count % kWindowSize] = duration_ns;
+    slot.count++;
+    slot.total_ns += duration_ns;
+    if (duration_ns > slot.max_ns) slot.max_ns = duration_ns;
+  }
+
+  // Don't call them during a run of the program.
+  std::vector<lite_api::OpStats> Stats() const;
+  void Reset();
+
+ private:
+  struct Slot {
+    int64_t count{0};
+    int64_t total_ns{0};
+    int64_t max_ns{0};
+    std::vector<int64_t> window;
+  };
+
+  std::vector<Instruction>* insts_;
+  std::vector<Slot> slots_;
+  int interval_{0};
+  int64_t runs_{0};
+  bool sampling_{false};
+};
+
+}  // namespace lite
+}  // namespace paddle
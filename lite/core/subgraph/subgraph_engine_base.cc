@@ -17,6 +17,7 @@
 #include <time.h>
 #include <algorithm>
 #include <utility>
+#include "lite/core/tracer.h"
 
 namespace paddle {
 namespace lite {
@@ -49,8 +50,10 @@ bool SubgraphEngineBase::Run() {
     is_first_epoch_ = false;
   }
   if (InputShapeChanged()) {
+    TraceSpan span("subgraph", "build");
     BuildDeviceProgram();
   }
+  TraceSpan span("subgraph", "launch");
   return LaunchDeviceProgram();
 }
 
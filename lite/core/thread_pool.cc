@@ -14,6 +14,7 @@
 
 #include "lite/core/thread_pool.h"
 #include <string.h>
+#include "lite/core/tracer.h"
 #include "lite/utils/log/logging.h"
 
 namespace paddle {
@@ -52,7 +53,10 @@ ThreadPool::ThreadPool(int number) {
         while (!(*tasks_.second[thread_index])) {
           std::this_thread::yield();
         }
-        tasks_.first(thread_index, thread_index);
+        {
+          TraceSpan span("thread_pool", "task");
+          tasks_.first(thread_index, thread_index);
+        }
         *tasks_.second[thread_index] = false;
       }
     });
@@ -113,7 +117,10 @@ void ThreadPool::Enqueue(TASK_BASIC&& task) {
   }
   // invoke tid 0 callback in main thread
   // other tid task is invoked in child thread
-  gInstance->tasks_.first(0, 0);
+  {
+    TraceSpan span("thread_pool", "task");
+    gInstance->tasks_.first(0, 0);
+  }
   bool complete = true;
   // check tid 1 to thread_num - 1 all work completed in child thread
   do {
@@ -159,7 +166,10 @@ void ThreadPool::Enqueue(TASK_COMMON&& task) {
   }
   // invoke tid 0 callback in main thread
   // other tid task is invoked in new thread
-  gInstance->tasks_.first(0, 0);
+  {
+    TraceSpan span("thread_pool", "task");
+    gInstance->tasks_.first(0, 0);
+  }
   bool complete = true;
   // check tid 1 to thread_num - 1 all work completed in new thread
   do {
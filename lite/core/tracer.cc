@@ -0,0 +1,158 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/tracer.h"
+#include <cstdio>
+#include "lite/utils/log/cp_logging.h"
+#include "lite/utils/macros.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+std::string EscapeJson(const std::string& str) {
+  std::string escaped;
+  for (auto c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped += ' ';
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+}  // namespace
+
+std::atomic<bool> Tracer::enabled_{false};
+
+Tracer& Tracer::Global() {
+  static Tracer* tracer = new Tracer;
+  return *tracer;
+}
+
+Tracer::ThreadBuffer* Tracer::LocalBuffer() {
+  static LITE_THREAD_LOCAL ThreadBuffer* buffer = nullptr;
+  if (!buffer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.emplace_back(new ThreadBuffer);
+    buffer = buffers_.back().get();
+    buffer->tid = static_cast<int>(buffers_.size()) - 1;
+  }
+  return buffer;
+}
+
+void Tracer::Start() {
+#ifdef LITE_WITHOUT_THREAD_LOCAL
+  LOG(WARNING) << "The tracer needs the thread local storage.";
+  return;
+#endif
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& buffer : buffers_) {
+    buffer->events.clear();
+  }
+  allocated_bytes_ = 0;
+  start_ns_ = Now();
+  enabled_ = true;
+}
+
+bool Tracer::Stop(const std::string& path) {
+  enabled_ = false;
+  std::lock_guard<std::mutex> lock(mutex_);
+  FILE* file = fopen(path.c_str(), "w");
+  if (!file) {
+    LOG(WARNING) << "Failed to open the trace file " << path;
+    return false;
+  }
+  fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+  bool first = true;
+  for (auto& buffer : buffers_) {
+    if (buffer->events.empty()) continue;
+    fprintf(file,
+            "%s{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": 0, "
+            "\"tid\": %d, \"args\": {\"name\": \"thread %d\"}}",
+            first ? "" : ",\n",
+            buffer->tid,
+            buffer->tid);
+    first = false;
+    for (auto& event : buffer->events) {
+      double ts_us = (event.ts_ns - start_ns_) / 1e3;
+      fprintf(file,
+              ",\n{\"ph\": \"%c\", \"cat\": \"%s\", \"name\": \"%s\", "
+              "\"pid\": 0, \"tid\": %d, \"ts\": %.3f",
+              event.phase,
+              event.category,
+              EscapeJson(event.name).c_str(),
+              buffer->tid,
+              ts_us);
+      switch (event.phase) {
+        case 'X':
+          fprintf(file,
+                  ", \"dur\": %.3f, \"args\": {\"detail\": \"%s\"}}",
+                  event.dur_ns / 1e3,
+                  EscapeJson(event.detail).c_str());
+          break;
+        case 'i':
+          fprintf(file,
+                  ", \"s\": \"t\", \"args\": {\"bytes\": %lld}}",
+                  static_cast<long long>(event.value));  // NOLINT
+          break;
+        case 'C':
+          fprintf(file,
+                  ", \"args\": {\"%s\": %lld}}",
+                  EscapeJson(event.detail).c_str(),
+                  static_cast<long long>(event.value));  // NOLINT
+          break;
+        default:
+          fprintf(file, "}");
+          break;
+      }
+    }
+  }
+  fprintf(file, "\n]}\n");
+  fclose(file);
+  return true;
+}
+
+void Tracer::AddSpan(const char* category,
+                     const std::string& name,
+                     int64_t start_ns,
+                     int64_t end_ns,
+                     const std::string& detail) {
+  LocalBuffer()->events.push_back(
+      {'X', category, name, detail, start_ns, end_ns - start_ns, 0});
+}
+
+void Tracer::AddAllocation(const std::string& target, size_t size) {
+  int64_t now = Now();
+  int64_t total = allocated_bytes_.fetch_add(static_cast<int64_t>(size)) +
+                  static_cast<int64_t>(size);
+  auto* buffer = LocalBuffer();
+  buffer->events.push_back({'i',
+                            "memory",
+                            "malloc " + target,
+                            "",
+                            now,
+                            0,
+                            static_cast<int64_t>(size)});
+  buffer->events.push_back(
+      {'C', "memory", "allocated", "bytes", now, 0, total});
+}
+
+}  // namespace lite
+}  // namespace paddle
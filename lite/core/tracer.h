@@ -0,0 +1,117 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+/*
+ * Record the timeline of the execution and export it in the Chrome Trace
+ * Event format, which can be opened by chrome://tracing or Perfetto.
+ *
+ * The events are appended to a buffer of the calling thread, so the threads
+ * don't contend while tracing, and each thread is a row of the timeline.
+ * The recording is a relaxed atomic load when the tracer is stopped. Start
+ * and Stop are expected to be called between the runs of the predictors.
+ */
+class Tracer {
+ public:
+  static Tracer& Global();
+
+  static bool Enabled() { return enabled_.load(std::memory_order_relaxed); }
+  // The timestamps of the events, in nanoseconds of the steady clock.
+  static int64_t Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  // Drop the events of the last trace and start recording.
+  void Start();
+  // Stop recording and write the events to 'path', return false if the file
+  // can't be written.
+  bool Stop(const std::string& path);
+
+  // A complete event of [start_ns, end_ns) on the calling thread.
+  void AddSpan(const char* category,
+               const std::string& name,
+               int64_t start_ns,
+               int64_t end_ns,
+               const std::string& detail = "");
+  // An allocation of the memory of 'target', the total allocated bytes since
+  // the start are recorded as a counter.
+  void AddAllocation(const std::string& target, size_t size);
+
+ private:
+  struct Event {
+    char phase;
+    const char* category;
+    std::string name;
+    std::string detail;
+    int64_t ts_ns;
+    int64_t dur_ns;
+    int64_t value;
+  };
+  struct ThreadBuffer {
+    int tid;
+    std::vector<Event> events;
+  };
+
+  Tracer() = default;
+  ThreadBuffer* LocalBuffer();
+
+  static std::atomic<bool> enabled_;
+  std::mutex mutex_;
+  // The buffers live as long as the process, so the threads which exit
+  // during the trace keep their events.
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+  int64_t start_ns_{0};
+  std::atomic<int64_t> allocated_bytes_{0};
+};
+
+// Record a span of the enclosing scope on the calling thread.
+class TraceSpan {
+ public:
+  TraceSpan(const char* category, const char* name)
+      : enabled_(Tracer::Enabled()) {
+    if (enabled_) {
+      category_ = category;
+      name_ = name;
+      start_ns_ = Tracer::Now();
+    }
+  }
+  ~TraceSpan() {
+    if (enabled_) {
+      Tracer::Global().AddSpan(category_, name_, start_ns_, Tracer::Now());
+    }
+  }
+
+ private:
+  bool enabled_;
+  const char* category_{nullptr};
+  const char* name_{nullptr};
+  int64_t start_ns_{0};
+};
+
+}  // namespace lite
+}  // namespace paddle
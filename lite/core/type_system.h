@@ -24,6 +24,7 @@
 #include <set>
 #include <string>
 #include <typeinfo>
+#include <utility>
 #include <vector>
 #include "lite/core/kernel_version.h"
 #include "lite/core/tensor.h"
@@ -185,22 +186,23 @@ static bool TargetCompatibleTo(const Type& a, const Type& b) {
   return true;
 }
 
+// The data of the opencl images and the blocked channel layouts can't be read
+// as the plain ones, so they are not compatible with kAny.
+static bool IsOpaqueLayout(DataLayoutType layout) {
+  return layout == DATALAYOUT(kImageDefault) ||
+         layout == DATALAYOUT(kImageFolder) ||
+         layout == DATALAYOUT(kNCHW8c) || layout == DATALAYOUT(kNCHW16c);
+}
 static bool DataLayoutCompatibleTo(const Type& a, const Type& b) {
   return a.IsVoid() ||                 //
          (a.layout() == b.layout() ||  //
-          ((b.layout() == DATALAYOUT(kAny)) &&
-           (a.layout() != DATALAYOUT(kImageDefault) &&
-            a.layout() != DATALAYOUT(kImageFolder))));
+          ((b.layout() == DATALAYOUT(kAny)) && !IsOpaqueLayout(a.layout())));
 }
 static bool DataLayoutCompatible(const Type& a, const Type& b) {
   return a.IsVoid() || b.IsVoid() ||   //
          (a.layout() == b.layout() ||  //
-          ((b.layout() == DATALAYOUT(kAny)) &&
-           (a.layout() != DATALAYOUT(kImageDefault) &&
-            a.layout() != DATALAYOUT(kImageFolder))) ||
-          ((a.layout() == DATALAYOUT(kAny)) &&
-           (b.layout() != DATALAYOUT(kImageDefault) &&
-            b.layout() != DATALAYOUT(kImageFolder))));
+          ((b.layout() == DATALAYOUT(kAny)) && !IsOpaqueLayout(a.layout())) ||
+          ((a.layout() == DATALAYOUT(kAny)) && !IsOpaqueLayout(b.layout())));
 }
 
 static bool PrecisionCompatibleTo(const Type& a, const Type& b) {
@@ -318,6 +320,17 @@ class ParamTypeRegistry {
       return *this;
     }
 
+    // Mark the kernel as able to write the output 'out_arg' into the buffer
+    // of the input 'in_arg' of the same size, i.e. each element of the output
+    // only depends on the same element of the input, so memory_optimize_pass
+    // may plan them as one var.
+    NewInstance& BindInplace(const std::string& in_arg,
+                             const std::string& out_arg) {
+      ParamTypeRegistry::Global().BindInplace(
+          kernel_type_, Place{target, precision, layout}, in_arg, out_arg);
+      return *this;
+    }
+
     bool Finalize() { return true; }
 
    private:
@@ -350,6 +363,26 @@ class ParamTypeRegistry {
     return -1;
   }
 
+  void BindInplace(const std::string& kernel_type,
+                   const Place& place,
+                   const std::string& in_arg,
+                   const std::string& out_arg) {
+    KernelIdTy key{kernel_type, place, IO(), std::string()};
+    inplace_args_[key] = std::make_pair(in_arg, out_arg);
+  }
+
+  // Get the input and the output args bound by BindInplace, return false if
+  // the kernel isn't in-place capable.
+  bool RetrieveInplaceArgs(const std::string& kernel_type,
+                           const Place& place,
+                           std::pair<std::string, std::string>* args) const {
+    KernelIdTy key{kernel_type, place, IO(), std::string()};
+    auto it = inplace_args_.find(key);
+    if (it == inplace_args_.end()) return false;
+    *args = it->second;
+    return true;
+  }
+
 #ifndef LITE_ON_TINY_PUBLISH
   ///////////////////////////////////////////////////////////////////////
   // Funtion name: BindPaddleOpVersion
@@ -455,6 +488,10 @@ class ParamTypeRegistry {
   std::map<key_t, ParamType, ParamTypeRegistry::KeyCmp> types_;
   std::map<key_t, KernelVersion, ParamTypeRegistry::KeyCmp> kernel_versions_;
   std::map<key_t, int64_t, ParamTypeRegistry::KeyCmp> versions_;
+  std::map<key_t,
+           std::pair<std::string, std::string>,
+           ParamTypeRegistry::KeyCmp>
+      inplace_args_;
 };
 
 }  // namespace lite
@@ -214,6 +214,7 @@ REGISTER_LITE_KERNEL(relu,
                      def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 
 REGISTER_LITE_KERNEL(leaky_relu,
@@ -226,6 +227,7 @@ REGISTER_LITE_KERNEL(leaky_relu,
     .BindInput("alpha", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindPaddleOpVersion("leaky_relu", 1)
+    .BindInplace("X", "Out")
     .Finalize();
 REGISTER_LITE_KERNEL(
     prelu,
@@ -238,6 +240,7 @@ REGISTER_LITE_KERNEL(
     .BindInput("mode", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Alpha", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 REGISTER_LITE_KERNEL(sigmoid,
                      kARM,
@@ -247,6 +250,7 @@ REGISTER_LITE_KERNEL(sigmoid,
                      def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 REGISTER_LITE_KERNEL(tanh,
                      kARM,
@@ -256,11 +260,13 @@ REGISTER_LITE_KERNEL(tanh,
                      def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 REGISTER_LITE_KERNEL(
     relu6, kARM, kFloat, kNCHW, paddle::lite::kernels::arm::Relu6Compute, def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 REGISTER_LITE_KERNEL(thresholded_relu,
                      kARM,
@@ -298,6 +298,7 @@ REGISTER_LITE_KERNEL(
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("beta", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 REGISTER_LITE_KERNEL(
     log, kARM, kFloat, kNCHW, paddle::lite::kernels::arm::LogCompute, def)
@@ -320,6 +321,7 @@ using fp32_hardsigmoid =
 REGISTER_LITE_KERNEL(hard_sigmoid, kARM, kFloat, kNCHW, fp32_hardsigmoid, def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInplace("X", "Out")
     .Finalize();
 REGISTER_LITE_KERNEL(
     sqrt, kARM, kFloat, kNCHW, paddle::lite::kernels::arm::SqrtCompute, def)
@@ -345,6 +347,7 @@ REGISTER_LITE_KERNEL(
     def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 REGISTER_LITE_KERNEL(reciprocal,
                      kARM,
@@ -127,6 +127,7 @@ REGISTER_LITE_KERNEL(batch_norm, kARM, kFloat, kNCHW, BnFp32, def)
     .BindOutput("VarianceOut", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("SavedMean", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("SavedVariance", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Y")
     .Finalize();
 
 REGISTER_LITE_KERNEL(sync_batch_norm, kARM, kFloat, kNCHW, BnFp32, def)
@@ -13,7 +13,12 @@
 // limitations under the License.
 
 #include "lite/kernels/arm/conv_compute.h"
+#include <map>
+#include <memory>
+#include <string>
 #include <utility>
+#include <vector>
+#include "lite/core/autotune.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/type_system.h"
 #include "lite/kernels/arm/conv_depthwise.h"
@@ -60,28 +65,76 @@ namespace arm {
   bool flag_dw_5x5 = (kw == 5) && (kh == 5) && (stride == 1 || stride == 2); \
   bool flag_dw = flag_dw_3x3 || flag_dw_5x5;
 
+namespace {
+
+KernelLite<TARGET(kARM), PRECISION(kFloat)>* CreateConvImplFp32(
+    const std::string& algo) {
+  if (algo == "depthwise") {
+    return new DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>;
+  } else if (algo == "winograd") {
+    return new WinogradConv<PRECISION(kFloat), PRECISION(kFloat)>;
+  } else if (algo == "direct") {
+    return new DirectConv<PRECISION(kFloat), PRECISION(kFloat)>;
+  }
+  return new GemmLikeConv<PRECISION(kFloat), PRECISION(kFloat)>;
+}
+
+}  // namespace
+
 template <>
 void ConvCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
   PARAM_INIT
-  /// select conv impl
-  if (param.groups == ic && ic == oc && ks_equal && no_dilation && flag_dw) {
-    impl_ = new DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>;
-    // VLOG(3) << "invoking dw conv";
-  } else if (param.groups == 1 && kw == 3 && stride == 1 && ks_equal &&
-             no_dilation) {
-    impl_ = new WinogradConv<PRECISION(kFloat), PRECISION(kFloat)>;
-    // VLOG(3) << "invoking winograd conv";
-  } else if (param.groups == 1 && kw == 3 && stride == 2 &&
-             chin * chout < 4 * hin * win && ks_equal && no_dilation) {
-    impl_ = new DirectConv<PRECISION(kFloat), PRECISION(kFloat)>;
-    // VLOG(3) << "invoking direct conv";
+  bool flag_depthwise =
+      param.groups == ic && ic == oc && ks_equal && no_dilation && flag_dw;
+  bool flag_3x3 = param.groups == 1 && kw == 3 && ks_equal && no_dilation;
+  /// the eligible conv impls, the first one is picked by the heuristics
+  std::vector<std::string> algos;
+  if (flag_depthwise) algos.push_back("depthwise");
+  if (flag_3x3 && stride == 1) algos.push_back("winograd");
+  if (flag_3x3 && stride == 2) algos.push_back("direct");
+  algos.push_back("gemm");
+  std::string heuristic = algos.front();
+  if (heuristic == "direct" && chin * chout >= 4 * hin * win) {
+    heuristic = "gemm";
+  }
+
+  /// time each impl on its own context, the winner is kept
+  std::map<std::string,
+           std::unique_ptr<KernelLite<TARGET(kARM), PRECISION(kFloat)>>>
+      tuned_impls;
+  auto measure = [&](const std::string& algo) -> double {
+    std::unique_ptr<KernelLite<TARGET(kARM), PRECISION(kFloat)>> impl(
+        CreateConvImplFp32(algo));
+    impl->SetContext(ContextScheduler::Global().NewContext(TARGET(kARM)));
+    impl->SetParam(param);
+    impl->PrepareForRun();
+    impl->ReInitWhenNeeded();
+    double ms = MeasureMs([&]() {
+      KernelBase::ResetWorkSpace();
+      impl->Run();
+    });
+    tuned_impls[algo] = std::move(impl);
+    return ms;
+  };
+  auto algo = SelectAlgo(algos,
+                         heuristic,
+                         param.autotune_algo,
+                         param.autotune_cpu,
+                         this->autotune_,
+                         measure);
+  if (this->autotune_) {
+    this->tuned_algo_ = algo;
+  }
+  VLOG(3) << "invoking " << algo << " conv";
+  auto it = tuned_impls.find(algo);
+  if (it != tuned_impls.end()) {
+    impl_ = it->second.release();
   } else {
-    impl_ = new GemmLikeConv<PRECISION(kFloat), PRECISION(kFloat)>;
-    // VLOG(3) << "invoking gemm like conv";
+    impl_ = CreateConvImplFp32(algo);
+    impl_->SetContext(std::move(this->ctx_));
+    impl_->SetParam(param);
+    impl_->PrepareForRun();
   }
-  impl_->SetContext(std::move(this->ctx_));
-  impl_->SetParam(param);
-  impl_->PrepareForRun();
   is_first_epoch_ = false;
 }
 
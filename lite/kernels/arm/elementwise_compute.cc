@@ -803,6 +803,7 @@ REGISTER_LITE_KERNEL(
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 
 using elementwise_add_int32_t =
@@ -859,6 +860,7 @@ REGISTER_LITE_KERNEL(fusion_elementwise_add_activation,
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 
 using elementwise_sub_float_t =
@@ -868,6 +870,7 @@ REGISTER_LITE_KERNEL(
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 
 using elementwise_sub_int32_t =
@@ -914,6 +917,7 @@ REGISTER_LITE_KERNEL(fusion_elementwise_sub_activation,
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 
 using elementwise_mul_float_t =
@@ -923,6 +927,7 @@ REGISTER_LITE_KERNEL(
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 
 using elementwise_mul_int32_t =
@@ -979,6 +984,7 @@ REGISTER_LITE_KERNEL(fusion_elementwise_mul_activation,
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 
 using fusion_elementwise_mul_activation_int64_t = paddle::lite::kernels::arm::
@@ -1048,6 +1054,7 @@ REGISTER_LITE_KERNEL(
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 
 using elementwise_div_int32_t =
@@ -1082,6 +1089,7 @@ REGISTER_LITE_KERNEL(fusion_elementwise_div_activation,
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInplace("X", "Out")
     .Finalize();
 
 using elementwise_mod_int64_t =
@@ -87,6 +87,7 @@ using scale_float =
 REGISTER_LITE_KERNEL(scale, kARM, kFloat, kNCHW, scale_float, def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInplace("X", "Out")
     .Finalize();
 
 using scale_int32 =
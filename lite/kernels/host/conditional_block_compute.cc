@@ -22,10 +22,7 @@ namespace host {
 
 void ConditionalBlockCompute::PrepareForRun() {
   auto& param = this->Param<param_t>();
-  if (program_ == nullptr) {
-    program_.reset(new RuntimeProgram(
-        param.program_desc, param.exec_scope, param.block_idx));
-  }
+  program_.Init(param.program_desc, param.exec_scope, param.block_idx);
 }
 
 void ConditionalBlockCompute::Run() {
@@ -35,6 +32,8 @@ void ConditionalBlockCompute::Run() {
     need_run = GetCondData(param.cond);
   } else {
     for (auto input : param.inputs) {
+      // The lazy params are materialized when the sub-block runs.
+      if (input != nullptr && program_.IsLazyParam(input)) continue;
       if (input == nullptr || !input->IsInitialized() ||
           input->dims().empty()) {
         need_run = false;
@@ -43,7 +42,7 @@ void ConditionalBlockCompute::Run() {
     }
   }
   if (need_run) {
-    program_->Run();
+    program_.Run();
   }
 }
 
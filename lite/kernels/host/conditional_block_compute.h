@@ -21,6 +21,7 @@
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/program.h"
+#include "lite/kernels/host/while_compute.h"
 
 namespace paddle {
 namespace lite {
@@ -37,11 +38,11 @@ class ConditionalBlockCompute
   void Run() override;
 
   void SetRuntimeProgram(std::unique_ptr<RuntimeProgram>* program) {
-    program_ = std::move(*program);
+    program_.Set(program);
   }
 
  private:
-  std::unique_ptr<RuntimeProgram> program_;
+  SubBlockProgram program_;
 };
 
 }  // namespace host
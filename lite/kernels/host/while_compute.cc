@@ -45,19 +45,57 @@ bool GetCondData(const Tensor *cond) {
   return flag;
 }
 
-void WhileCompute::PrepareForRun() {
-  auto &param = this->Param<param_t>();
+SubBlockProgram::~SubBlockProgram() {
+  if (lazy_params_ && evict_listener_id_ >= 0) {
+    lazy_params_->RemoveEvictListener(evict_listener_id_);
+  }
+}
+
+void SubBlockProgram::Init(
+    const std::shared_ptr<const cpp::ProgramDesc> &program_desc,
+    Scope *exec_scope,
+    int block_idx) {
+  // The program is set by GenerateProgramPass for XPU.
+  if (program_ != nullptr || program_desc_ != nullptr) return;
+  program_desc_ = program_desc;
+  exec_scope_ = exec_scope;
+  block_idx_ = block_idx;
+  lazy_params_ = LazyParams::Get(exec_scope);
+  if (lazy_params_) {
+    for (auto &name : GetBlockInputs(*program_desc, block_idx)) {
+      if (!lazy_params_->Contains(name)) continue;
+      lazy_param_names_.push_back(name);
+      lazy_tensors_.insert(exec_scope->FindVar(name)->GetMutable<Tensor>());
+    }
+  }
+  if (lazy_param_names_.empty()) {
+    lazy_params_ = nullptr;
+    program_.reset(new RuntimeProgram(program_desc, exec_scope, block_idx));
+    return;
+  }
+  evict_listener_id_ =
+      lazy_params_->AddEvictListener([this] { program_.reset(); });
+}
+
+void SubBlockProgram::Run() {
   if (program_ == nullptr) {
-    program_.reset(new RuntimeProgram(
-        param.program_desc, param.exec_scope, param.block_idx));
+    CHECK(lazy_params_);
+    lazy_params_->Load(lazy_param_names_, exec_scope_);
+    program_.reset(new RuntimeProgram(program_desc_, exec_scope_, block_idx_));
   }
+  program_->Run();
+}
+
+void WhileCompute::PrepareForRun() {
+  auto &param = this->Param<param_t>();
+  program_.Init(param.program_desc, param.exec_scope, param.block_idx);
 }
 
 void WhileCompute::Run() {
   auto &param = this->Param<param_t>();
   auto cond = param.cond;
   while (GetCondData(cond)) {
-    program_->Run();
+    program_.Run();
   }
 }
 
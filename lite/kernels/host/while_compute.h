@@ -15,10 +15,12 @@
 #pragma once
 #include <algorithm>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 #include "lite/core/kernel.h"
+#include "lite/core/lazy_params.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/program.h"
 
@@ -27,6 +29,42 @@ namespace lite {
 namespace kernels {
 namespace host {
 
+/*
+ * The program of the sub-block of while and conditional_block. If the
+ * sub-block uses the lazy params, the program is built and the params are
+ * materialized when it runs for the first time, and the program is released
+ * when the lazy params are evicted, then it's built again on the next run.
+ */
+class SubBlockProgram {
+ public:
+  ~SubBlockProgram();
+
+  void Init(const std::shared_ptr<const cpp::ProgramDesc>& program_desc,
+            Scope* exec_scope,
+            int block_idx);
+
+  void Set(std::unique_ptr<RuntimeProgram>* program) {
+    program_ = std::move(*program);
+  }
+
+  // Whether the tensor is a lazy param used by the sub-block.
+  bool IsLazyParam(const Tensor* tensor) const {
+    return lazy_tensors_.count(tensor) > 0;
+  }
+
+  void Run();
+
+ private:
+  std::unique_ptr<RuntimeProgram> program_;
+  std::shared_ptr<const cpp::ProgramDesc> program_desc_;
+  Scope* exec_scope_{nullptr};
+  int block_idx_{-1};
+  std::shared_ptr<LazyParams> lazy_params_;
+  std::vector<std::string> lazy_param_names_;
+  std::set<const Tensor*> lazy_tensors_;
+  int evict_listener_id_{-1};
+};
+
 class WhileCompute
     : public KernelLite<TARGET(kHost), PRECISION(kAny), DATALAYOUT(kAny)> {
  public:
@@ -37,13 +75,13 @@ class WhileCompute
   void PrepareForRun() override;
 
   void SetRuntimeProgram(std::unique_ptr<RuntimeProgram>* program) {
-    program_ = std::move(*program);
+    program_.Set(program);
   }
 
   virtual ~WhileCompute() = default;
 
  private:
-  std::unique_ptr<RuntimeProgram> program_;
+  SubBlockProgram program_;
 };
 
 bool GetCondData(const Tensor* cond);
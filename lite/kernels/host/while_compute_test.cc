@@ -0,0 +1,133 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/host/while_compute.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/lazy_params.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+void AddWhileDesc(cpp::BlockDesc* block_desc,
+                  const std::string& cond,
+                  int sub_block) {
+  auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+  op_desc->SetType("while");
+  op_desc->SetInput("X", {});
+  op_desc->SetInput("Condition", {cond});
+  op_desc->SetOutput("Out", {});
+  op_desc->SetOutput("StepScopes", {});
+  op_desc->SetAttr<int32_t>("sub_block", sub_block);
+}
+
+void AddScaleDesc(cpp::BlockDesc* block_desc,
+                  const std::string& x,
+                  const std::string& out) {
+  auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+  op_desc->SetType("scale");
+  op_desc->SetInput("X", {x});
+  op_desc->SetOutput("Out", {out});
+  op_desc->SetAttr<float>("scale", 2.f);
+  op_desc->SetAttr<float>("bias", 0.f);
+  op_desc->SetAttr<bool>("bias_after_scale", true);
+}
+
+void AddAssignDesc(cpp::BlockDesc* block_desc,
+                   const std::string& x,
+                   const std::string& out) {
+  auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+  op_desc->SetType("assign");
+  op_desc->SetInput("X", {x});
+  op_desc->SetOutput("Out", {out});
+}
+
+void SetCond(Scope* scope, const std::string& name, bool value) {
+  auto* tensor = scope->Var(name)->GetMutable<Tensor>();
+  tensor->Resize({1});
+  tensor->mutable_data<bool>()[0] = value;
+}
+
+TEST(WhileCompute, evict_nested_lazy_params) {
+  // while(cond0) {          // block 1
+  //   y1 = scale(w1)
+  //   while(cond1) {        // block 2
+  //     y2 = scale(w2)
+  //     cond1 = false
+  //   }
+  //   cond0 = false
+  // }
+  // Both of the sub-block programs use the lazy params, so they're released
+  // by the evict listeners, and the outer one releases the inner while.
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  auto* block0 = program_desc->AddBlock<cpp::BlockDesc>();
+  auto* block1 = program_desc->AddBlock<cpp::BlockDesc>();
+  auto* block2 = program_desc->AddBlock<cpp::BlockDesc>();
+  AddWhileDesc(block0, "cond0", 1);
+  AddScaleDesc(block1, "w1", "y1");
+  AddWhileDesc(block1, "cond1", 2);
+  AddAssignDesc(block1, "false", "cond0");
+  AddScaleDesc(block2, "w2", "y2");
+  AddAssignDesc(block2, "false", "cond1");
+
+  Scope scope;
+  for (auto& name : {"cond0", "cond1", "false"}) {
+    SetCond(&scope, name, false);
+  }
+  scope.Var("y1")->GetMutable<Tensor>();
+  scope.Var("y2")->GetMutable<Tensor>();
+  auto lazy_params = std::make_shared<LazyParams>();
+  int num_loads = 0;
+  for (auto& name : {"w1", "w2"}) {
+    auto* w = scope.Var(name)->GetMutable<Tensor>();
+    w->Resize({4});
+    w->set_persistable(true);
+    lazy_params->Register(name, [&num_loads](Tensor* tensor) {
+      auto* data = tensor->mutable_data<float>();
+      for (int64_t i = 0; i < tensor->numel(); ++i) {
+        data[i] = static_cast<float>(i);
+      }
+      ++num_loads;
+    });
+  }
+  LazyParams::Set(&scope, lazy_params);
+
+  RuntimeProgram program(program_desc, &scope, 0);
+  for (int i = 0; i < 3; ++i) {
+    SetCond(&scope, "cond0", true);
+    SetCond(&scope, "cond1", true);
+    program.Run();
+    EXPECT_EQ(num_loads, 2 * (i + 1));
+    for (auto& name : {"y1", "y2"}) {
+      const auto& y = scope.FindVar(name)->Get<Tensor>();
+      ASSERT_EQ(y.numel(), 4);
+      EXPECT_EQ(y.data<float>()[3], 6.f);
+    }
+    lazy_params->Evict(&scope);
+    EXPECT_FALSE(scope.FindVar("w1")->Get<Tensor>().IsInitialized());
+    EXPECT_FALSE(scope.FindVar("w2")->Get<Tensor>().IsInitialized());
+  }
+}
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
@@ -18,6 +18,7 @@
 #include <functional>
 #include <utility>
 #include "lite/core/op_registry.h"
+#include "lite/core/tracer.h"
 #include "lite/kernels/nnadapter/converter/converter.h"
 #include "lite/utils/env.h"
 #include "lite/utils/md5.h"
@@ -240,6 +241,7 @@ int Program::Execute() {
     return 1e+6 * time.tv_sec + time.tv_usec;
   };
   auto start_time = GetCurrentUS();
+  TraceSpan span("nnadapter", "execute");
   int result = NNAdapterExecution_compute_invoke(execution_);
   if (result != NNADAPTER_NO_ERROR) {
     LOG(WARNING) << "Warning: Failed to run the execution(" << result << ")!";
@@ -360,6 +362,7 @@ bool Engine::Run() {
     NNAdapterDevice_getName_invoke(device, &name);
     device_names.push_back(name);
   }
+  TraceSpan span("nnadapter", "build");
   auto program = std::make_shared<Program>(context_);
   // Take the model cache buffer from the scope
   std::vector<char> model_cache_buffer;
@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include "lite/kernels/x86/conv_compute.h"
+#include <map>
+#include <memory>
 #include <utility>
+#include "lite/core/autotune.h"
 #include "lite/backends/x86/math/fill_bias_activate.h"
 #include "lite/kernels/x86/conv_depthwise.h"
 #include "lite/kernels/x86/conv_direct.h"
@@ -79,6 +82,22 @@ namespace x86 {
   bool pads_equal =                                                 \
       ((paddings[0] == paddings[1]) && (paddings[2] == paddings[3]));
 
+// The im2col + gemm of Run is timed by the autotuning in PrepareForRun.
+template <>
+void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run();
+
+namespace {
+
+KernelLite<TARGET(kX86), PRECISION(kFloat)>* CreateConvImplFp32(
+    const std::string& algo) {
+  if (algo == "depthwise") {
+    return new DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>;
+  }
+  return new DirectConv<PRECISION(kFloat), PRECISION(kFloat)>();
+}
+
+}  // namespace
+
 template <>
 void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
   PREPARE_PARAM
@@ -91,6 +110,21 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
     flag_1x1gemm_ = false;
   }
 
+  auto sparse_type =
+      lite::x86::math::SparseBlockTypeFromStr(param.sparse_weight_type);
+  flag_sparse_ = flag_1x1gemm_ && groups == 1 &&
+                 sparse_type != lite::x86::math::SparseBlockType::kNone;
+  if (flag_sparse_) {
+    lite::x86::math::PackBlockSparseMatrix(param.filter->data<float>(),
+                                           output_channel,
+                                           input_channel,
+                                           false,
+                                           sparse_type,
+                                           &sparse_weights_);
+    VLOG(3) << "invoking sparse conv1x1 with " << param.sparse_weight_type
+            << " weights, " << sparse_weights_.num_blocks() << " blocks";
+  }
+
   bool nodilations = true;
   for (auto ele : *(param.dilations))
     if (ele != 1) nodilations = false;
@@ -100,13 +134,9 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
                        (paddings[2] == paddings[3]);
   bool flag_p = paddings[0] <= stride_h;
 
-  //! select conv impl
-  if (dw_kernel && kps_equal && flag_dw && pads_equal &&
-      ((flag_dw_5x5 && no_dilation) || (flag_dw_3x3 && (groups & 3) == 0))) {
-    impl_ = new DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>;
-    VLOG(3) << "invoking conv_depthwise_3x3p0p1 or conv_depthwise_5x5";
-  }
-
+  //! the eligible conv impls, the first one is picked by the heuristics and
+  //! "gemm" is the im2col + gemm of Run
+  std::vector<std::string> algos;
   // support 3x3s1p01,5x5s1p01,7x7s1p01
   //  3x3s2p012,5x5s1p012,7x7s1p012
   if (output_channel % 8 == 0 && groups == 1 &&
@@ -115,17 +145,60 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
       pad_all_equal && flag_p) {
 #if defined(_WIN64) || defined(__MINGW64__) || \
     (defined(__CYGWIN__) && defined(__x86_64__)) || defined(__x86_64__)
-    impl_ = new DirectConv<PRECISION(kFloat), PRECISION(kFloat)>();
-    VLOG(3) << "invoking directConv";
+    algos.push_back("direct");
 #endif
   }
-
-  if (impl_) {
+  if (dw_kernel && kps_equal && flag_dw && pads_equal &&
+      ((flag_dw_5x5 && no_dilation) || (flag_dw_3x3 && (groups & 3) == 0))) {
+    algos.push_back("depthwise");
+  }
+  algos.push_back("gemm");
+
+  //! time each impl on its own context, the winner is kept
+  std::map<std::string,
+           std::unique_ptr<KernelLite<TARGET(kX86), PRECISION(kFloat)>>>
+      tuned_impls;
+  auto measure = [&](const std::string& algo) -> double {
+    if (algo == "gemm") {
+      return MeasureMs([&]() {
+        KernelBase::ResetWorkSpace();
+        this->Run();
+      });
+    }
+    std::unique_ptr<KernelLite<TARGET(kX86), PRECISION(kFloat)>> impl(
+        CreateConvImplFp32(algo));
+    impl->SetContext(ContextScheduler::Global().NewContext(TARGET(kX86)));
+    impl->SetParam(param);
+    impl->PrepareForRun();
+    impl->ReInitWhenNeeded();
+    double ms = MeasureMs([&]() {
+      KernelBase::ResetWorkSpace();
+      impl->Run();
+    });
+    tuned_impls[algo] = std::move(impl);
+    return ms;
+  };
+  auto algo = SelectAlgo(algos,
+                         algos.front(),
+                         param.autotune_algo,
+                         param.autotune_cpu,
+                         this->autotune_,
+                         measure);
+  if (this->autotune_) {
+    this->tuned_algo_ = algo;
+  }
+  VLOG(3) << "invoking " << algo << " conv";
+  if (algo == "gemm") return;
+  auto it = tuned_impls.find(algo);
+  if (it != tuned_impls.end()) {
+    impl_ = it->second.release();
+  } else {
+    impl_ = CreateConvImplFp32(algo);
     impl_->SetContext(std::move(this->ctx_));
     impl_->SetParam(param);
     impl_->PrepareForRun();
-    is_first_epoch_ = false;
   }
+  is_first_epoch_ = false;
 }
 
 template <>
@@ -186,7 +259,10 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
       const float* col_data_group = din_data + g * group_size_coldata;
       const float* weights_group = weights + g * group_size_weights;
       float* dout_group = dout_batch + g * group_size_out;
-      if (n == 1) {
+      if (flag_sparse_) {
+        lite::x86::math::SparseDenseGemm(
+            sparse_weights_, col_data_group, n, dout_group);
+      } else if (n == 1) {
         matmul.GEMV<float>(
             false, m, k, 1.f, weights_group, col_data_group, 0.f, dout_group);
       } else {
@@ -21,6 +21,7 @@
 #include "lite/backends/x86/math/conv_bias.h"
 #include "lite/backends/x86/math/gemm_s8u8_compute.h"
 #include "lite/backends/x86/math/im2col.h"
+#include "lite/backends/x86/math/sparse_gemm.h"
 #include "lite/backends/x86/math/vol2col.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
@@ -83,6 +84,9 @@ class Conv2dCompute : public KernelLite<TARGET(kX86), Ptype> {
   Context<TargetType::kX86>* device_ctx;
   bool flag_1x1gemm_{false};
   bool flag_trans_bias_{true};
+  // the 1x1 filter packed in the block sparse format
+  bool flag_sparse_{false};
+  lite::x86::math::BlockSparseMatrix sparse_weights_;
   std::vector<float> w_scale_;
   Tensor weights_;
   Tensor bias_;
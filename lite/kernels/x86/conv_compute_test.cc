@@ -15,9 +15,11 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "lite/core/autotune.h"
 #include "lite/core/op_registry.h"
 #include "lite/kernels/x86/conv_compute.h"
 
@@ -92,6 +94,64 @@ TEST(conv2d_x86, run_test) {
   }
 }
 
+TEST(conv2d_x86, autotune) {
+  // Both of the direct conv and the im2col + gemm are eligible.
+  lite::Tensor x, filter, b;
+  x.Resize({1, 8, 12, 12});
+  filter.Resize({8, 8, 3, 3});
+  b.Resize({8});
+  auto x_data = x.mutable_data<float>();
+  auto filter_data = filter.mutable_data<float>();
+  auto b_data = b.mutable_data<float>();
+  for (int64_t i = 0; i < x.dims().production(); i++) {
+    x_data[i] = (i % 13) * 0.1f - 0.6f;
+  }
+  for (int64_t i = 0; i < filter.dims().production(); i++) {
+    filter_data[i] = (i % 7) * 0.05f - 0.15f;
+  }
+  for (int64_t i = 0; i < b.dims().production(); i++) {
+    b_data[i] = i * 0.1f;
+  }
+
+  auto run = [&](bool autotune,
+                 const std::string& recorded_algo,
+                 lite::Tensor* out) {
+    out->Resize({1, 8, 12, 12});
+    Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)> conv2d;
+    operators::ConvParam param;
+    param.x = &x;
+    param.filter = &filter;
+    param.bias = &b;
+    param.output = out;
+    param.strides = {1, 1};
+    param.groups = 1;
+    param.paddings = std::make_shared<std::vector<int>>(
+        std::vector<int>({1, 1, 1, 1}));
+    param.dilations =
+        std::make_shared<std::vector<int>>(std::vector<int>({1, 1}));
+    param.autotune_algo = recorded_algo;
+    param.autotune_cpu = CpuModelName();
+    std::unique_ptr<KernelContext> ctx(new KernelContext);
+    ctx->As<X86Context>();
+    conv2d.SetContext(std::move(ctx));
+    conv2d.SetParam(param);
+    conv2d.set_autotune(autotune);
+    conv2d.Launch();
+    return conv2d.tuned_algo();
+  };
+
+  lite::Tensor out, tuned_out, recorded_out;
+  EXPECT_TRUE(run(false, "", &out).empty());
+  auto tuned_algo = run(true, "", &tuned_out);
+  EXPECT_TRUE(tuned_algo == "direct" || tuned_algo == "gemm");
+  // The algorithm recorded on the same CPU model is reused.
+  EXPECT_EQ(run(true, "gemm", &recorded_out), "gemm");
+  for (int64_t i = 0; i < out.dims().production(); i++) {
+    EXPECT_NEAR(out.data<float>()[i], tuned_out.data<float>()[i], 1e-4);
+    EXPECT_NEAR(out.data<float>()[i], recorded_out.data<float>()[i], 1e-4);
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
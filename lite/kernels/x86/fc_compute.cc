@@ -139,6 +139,60 @@ class FCFunctor {
   }
 };
 
+template <>
+void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  flag_dynamic_quant_ = param.dynamic_quant_int8 &&
+                        param.w->precision() == PRECISION(kInt8);
+  if (flag_dynamic_quant_) {
+    const auto& w_dims = param.w->dims();
+    const int ld = w_dims[1];
+    const int k = param.padding_weights ? w_dims[0] - 4 : w_dims[0];
+    const int n = param.padding_weights ? w_dims[1] - 4 : w_dims[1];
+    CHECK(param.weight_scale.size() == 1 ||
+          param.weight_scale.size() == static_cast<size_t>(ld))
+        << "The size of the weight scales should be 1 or " << ld;
+    std::vector<float> scales(n);
+    for (int j = 0; j < n; j++) {
+      scales[j] = param.weight_scale.size() == 1 ? param.weight_scale[0]
+                                                 : param.weight_scale[j];
+    }
+    // The weights without the padding are packed once.
+    std::vector<int8_t> weights(static_cast<size_t>(k) * n);
+    const int8_t* w_data = param.w->data<int8_t>();
+    for (int i = 0; i < k; i++) {
+      memcpy(weights.data() + i * n, w_data + i * ld, n);
+    }
+    dynamic_quant_gemm_.reset(new lite::x86::math::DynamicQuantGemm(
+        n, k, weights.data(), scales.data()));
+    if (param.activation_type != "" && param.activation_type != "relu") {
+      LOG(FATAL) << "The dynamic quantization of fc only supports relu, but "
+                    "receive "
+                 << param.activation_type;
+    }
+    return;
+  }
+  auto sparse_type =
+      lite::x86::math::SparseBlockTypeFromStr(param.sparse_weight_type);
+  flag_sparse_ = !param.padding_weights &&
+                 sparse_type != lite::x86::math::SparseBlockType::kNone;
+  if (flag_sparse_) {
+    const auto& w_dims = param.w->dims();
+    lite::x86::math::PackBlockSparseMatrix(param.w->data<float>(),
+                                           w_dims[1],
+                                           w_dims[0],
+                                           true,
+                                           sparse_type,
+                                           &sparse_weights_);
+  }
+}
+
+template <>
+void FcCompute<PRECISION(kInt8), PRECISION(kInt8)>::PrepareForRun() {}
+
+template <>
+void FcCompute<PRECISION(kInt8), PRECISION(kFloat)>::PrepareForRun() {}
+
 template <>
 void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   auto& param = *param_.get_mutable<param_t>();
@@ -156,9 +210,29 @@ void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   int M = output->dims().production() / w_dims1;
 
   const float* input_data = input->template data<float>();
-  const float* w_data = w->template data<float>();
   float* output_data = output->template mutable_data<float>();
 
+  if (flag_dynamic_quant_) {
+    dynamic_quant_gemm_->Run(M,
+                             input_data,
+                             bias ? bias->template data<float>() : nullptr,
+                             with_relu,
+                             output_data);
+    return;
+  }
+
+  const float* w_data = w->template data<float>();
+
+  if (flag_sparse_) {
+    lite::x86::math::DenseSparseGemm(input_data,
+                                     M,
+                                     sparse_weights_,
+                                     bias ? bias->template data<float>() : NULL,
+                                     with_relu,
+                                     output_data);
+    return;
+  }
+
   auto& context = ctx_->As<X86Context>();
   FCFunctor<lite::TargetType::kX86, float> fc;
   fc(context,
@@ -14,11 +14,14 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include "lite/backends/x86/jit/helper.h"
 #include "lite/backends/x86/jit/kernel_base.h"
 #include "lite/backends/x86/jit/kernels.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/dynamic_quant_gemm.h"
+#include "lite/backends/x86/math/sparse_gemm.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
@@ -35,9 +38,19 @@ class FcCompute : public KernelLite<TARGET(kX86), PType> {
  public:
   using param_t = operators::FcParam;
 
+  virtual void PrepareForRun();
+
   virtual void Run();
 
   virtual ~FcCompute() = default;
+
+ private:
+  // the transposed weights packed in the block sparse format
+  bool flag_sparse_{false};
+  lite::x86::math::BlockSparseMatrix sparse_weights_;
+  // the GEMM of the dynamic quantization with the int8 weights packed
+  bool flag_dynamic_quant_{false};
+  std::unique_ptr<lite::x86::math::DynamicQuantGemm> dynamic_quant_gemm_;
 };
 
 }  // namespace x86
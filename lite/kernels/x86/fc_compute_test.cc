@@ -0,0 +1,138 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fc_compute.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+typedef FcCompute<PRECISION(kFloat), PRECISION(kFloat)> FcComputeFP32;
+
+static void RunFc(const operators::FcParam& param) {
+  FcComputeFP32 fc;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  fc.SetContext(std::move(ctx));
+  fc.SetParam(param);
+  fc.PrepareForRun();
+  fc.Run();
+}
+
+TEST(fc_x86, dynamic_quant_int8) {
+  std::default_random_engine engine(0);
+  std::normal_distribution<float> dist(0.f, 1.f);
+  for (auto& shape : std::vector<std::vector<int>>{
+           {1, 64, 32}, {3, 100, 17}, {16, 256, 128}}) {
+    const int m = shape[0];
+    const int k = shape[1];
+    const int n = shape[2];
+    std::vector<float> w_data(k * n);
+    for (auto& value : w_data) value = dist(engine) * 0.1f;
+    // Quantize the weights per column as post_quant_dynamic_pass does.
+    std::vector<float> scales(n, 0.f);
+    for (int i = 0; i < k * n; i++) {
+      scales[i % n] = std::max(scales[i % n], std::fabs(w_data[i]));
+    }
+    for (auto& scale : scales) scale /= 127.f;
+
+    lite::Tensor x, bias;
+    x.Resize({m, k});
+    for (int i = 0; i < m * k; i++) {
+      x.mutable_data<float>()[i] = dist(engine);
+    }
+    bias.Resize({n});
+    for (int i = 0; i < n; i++) {
+      bias.mutable_data<float>()[i] = dist(engine);
+    }
+
+    for (bool padding_weights : {false, true}) {
+      // The padded weights are [k + 4, n + 4] by fc_fuse_pass, whose padding
+      // is filled with the large values which must never be read.
+      const int pad = padding_weights ? 4 : 0;
+      const int ld = n + pad;
+      lite::Tensor w, w_int8;
+      w.Resize({k + pad, ld});
+      w_int8.Resize({k + pad, ld});
+      auto* w_fp32_data = w.mutable_data<float>();
+      auto* w_int8_data = w_int8.mutable_data<int8_t>();
+      std::fill(w_fp32_data, w_fp32_data + (k + pad) * ld, 100.f);
+      std::fill(w_int8_data, w_int8_data + (k + pad) * ld, 127);
+      for (int i = 0; i < k; i++) {
+        for (int j = 0; j < n; j++) {
+          w_fp32_data[i * ld + j] = w_data[i * n + j];
+          w_int8_data[i * ld + j] = static_cast<int8_t>(
+              std::round(w_data[i * n + j] / scales[j]));
+        }
+      }
+      // The scales are of the padded columns too.
+      std::vector<float> weight_scale(scales);
+      weight_scale.resize(ld, 1.f);
+
+      for (std::string activation_type : {"", "relu"}) {
+        lite::Tensor out, out_int8;
+        out.Resize({m, n});
+        out_int8.Resize({m, n});
+        operators::FcParam param;
+        param.input = &x;
+        param.w = &w;
+        param.bias = &bias;
+        param.output = &out;
+        param.activation_type = activation_type;
+        param.padding_weights = padding_weights;
+        RunFc(param);
+
+        param.w = &w_int8;
+        param.output = &out_int8;
+        param.dynamic_quant_int8 = true;
+        param.weight_scale = weight_scale;
+        RunFc(param);
+
+        // The error against fp32 includes the one of the int8 weights.
+        const float* ref = out.data<float>();
+        const float* res = out_int8.data<float>();
+        double error = 0.0;
+        double norm = 0.0;
+        for (int i = 0; i < m * n; i++) {
+          if (activation_type == "relu") {
+            EXPECT_GE(res[i], 0.f);
+          }
+          error += (res[i] - ref[i]) * (res[i] - ref[i]);
+          norm += ref[i] * ref[i];
+        }
+        EXPECT_LT(std::sqrt(error / norm), 0.02)
+            << "fc [" << m << ", " << k << "] x [" << k << ", " << n
+            << "], padding_weights " << padding_weights << ", activation "
+            << activation_type;
+      }
+    }
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fc, kX86, kFloat, kNCHW, def);
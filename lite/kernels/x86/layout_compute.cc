@@ -0,0 +1,131 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/layout_compute.h"
+#include <cstring>
+#include "lite/backends/x86/math/nchwc.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+template <int Block>
+void NCHWToNCHWcCompute<Block>::Run() {
+  auto& param = this->template Param<param_t>();
+  const auto& dims = param.x->dims();
+  const float* input = param.x->template data<float>();
+  float* output = lite::x86::math::nchwc_mutable_data(param.y, Block);
+  // Only the tensors of 4 dims are blocked.
+  if (dims.size() != 4) {
+    memcpy(output, input, sizeof(float) * dims.production());
+    return;
+  }
+  lite::x86::math::nchw_to_nchwc(
+      input, output, dims[0], dims[1], dims[2] * dims[3], Block);
+}
+
+template <int Block>
+void NCHWcToNCHWCompute<Block>::Run() {
+  auto& param = this->template Param<param_t>();
+  const auto& dims = param.x->dims();
+  const float* input = param.x->template data<float>();
+  float* output = param.y->template mutable_data<float>(TARGET(kX86));
+  if (dims.size() != 4) {
+    memcpy(output, input, sizeof(float) * dims.production());
+    return;
+  }
+  lite::x86::math::nchwc_to_nchw(
+      input, output, dims[0], dims[1], dims[2] * dims[3], Block);
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+typedef paddle::lite::kernels::x86::NCHWToNCHWcCompute<8> NCHW_to_NCHW8c;
+typedef paddle::lite::kernels::x86::NCHWToNCHWcCompute<16> NCHW_to_NCHW16c;
+typedef paddle::lite::kernels::x86::NCHWcToNCHWCompute<8> NCHW8c_to_NCHW;
+typedef paddle::lite::kernels::x86::NCHWcToNCHWCompute<16> NCHW16c_to_NCHW;
+
+REGISTER_LITE_KERNEL(layout, kX86, kFloat, kNCHW, NCHW_to_NCHW8c, nchw2nchw8c)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(layout, kX86, kFloat, kNCHW, NCHW8c_to_NCHW, nchw8c2nchw)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    layout, kX86, kFloat, kNCHW, NCHW_to_NCHW16c, nchw2nchw16c)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    layout, kX86, kFloat, kNCHW, NCHW16c_to_NCHW, nchw16c2nchw)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    layout_once, kX86, kFloat, kNCHW, NCHW_to_NCHW8c, nchw2nchw8c)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    layout_once, kX86, kFloat, kNCHW, NCHW_to_NCHW16c, nchw2nchw16c)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
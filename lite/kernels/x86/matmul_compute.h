@@ -13,7 +13,11 @@
 // limitations under the License.
 #pragma once
 
+#include <memory>
+#include <type_traits>
+#include <vector>
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/dynamic_quant_gemm.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -49,9 +53,51 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
   using param_t = operators::MatMulParam;
 
+  void PrepareForRun() override {
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    flag_dynamic_quant_ = std::is_same<T, float>::value &&
+                          param.dynamic_quant_int8 &&
+                          param.Y->precision() == PRECISION(kInt8);
+    if (flag_dynamic_quant_) {
+      CHECK(!param.transpose_X && !param.transpose_Y &&
+            param.Y->dims().size() == 2)
+          << "The dynamic quantization of matmul only supports the 2-D "
+             "weights without the transposes.";
+      const int n = param.Y->dims()[1];
+      CHECK(param.weight_scale.size() == 1 ||
+            param.weight_scale.size() == static_cast<size_t>(n))
+          << "The size of the weight scales should be 1 or " << n;
+      // alpha is folded into the scales of the weights.
+      std::vector<float> scales(n);
+      for (int j = 0; j < n; j++) {
+        scales[j] = param.alpha * (param.weight_scale.size() == 1
+                                       ? param.weight_scale[0]
+                                       : param.weight_scale[j]);
+      }
+      dynamic_quant_gemm_.reset(new lite::x86::math::DynamicQuantGemm(
+          n,
+          param.Y->dims()[0],
+          param.Y->template data<int8_t>(),
+          scales.data()));
+    }
+  }
+
   void Run() override {
     auto &context = ctx_->As<X86Context>();
     auto &param = *param_.get_mutable<operators::MatMulParam>();
+    if (flag_dynamic_quant_) {
+      // x: [..., M, K] or the vector [K], y: [K, N], out: [..., M, N] or
+      // [N], the vector x runs as a row.
+      auto &x_dims = param.X->dims();
+      const int k = param.Y->dims()[0];
+      CHECK_EQ(x_dims[x_dims.size() - 1], k);
+      dynamic_quant_gemm_->Run(x_dims.production() / k,
+                               param.X->template data<float>(),
+                               nullptr,
+                               false,
+                               param.Out->template mutable_data<T>());
+      return;
+    }
 
     auto *x = param.X;
     auto *y = param.Y;
@@ -68,6 +114,12 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   }
 
   virtual ~MatMulCompute() = default;
+
+ private:
+  // the GEMM of the dynamic quantization with the int8 weights packed, the
+  // scales of the weights include alpha
+  bool flag_dynamic_quant_{false};
+  std::unique_ptr<lite::x86::math::DynamicQuantGemm> dynamic_quant_gemm_;
 };
 
 }  // namespace x86
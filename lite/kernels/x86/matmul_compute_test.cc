@@ -80,6 +80,42 @@ TEST(matmul_x86, run_test) {
   }
 }
 
+TEST(matmul_x86, dynamic_quant_int8_vector_x) {
+  // The vector x runs as a row, the values are exact in int8.
+  lite::Tensor x, y, out;
+  x.Resize({2});
+  y.Resize({2, 4});
+  out.Resize({4});
+  auto x_data = x.mutable_data<float>();
+  x_data[0] = 63.f;
+  x_data[1] = 21.f;
+  auto y_data = y.mutable_data<int8_t>();
+  for (int64_t i = 0; i < y.dims().production(); i++) {
+    y_data[i] = static_cast<int8_t>(i);
+  }
+  MatMulCompute<float> matmul;
+  operators::MatMulParam param;
+  param.X = &x;
+  param.Y = &y;
+  param.Out = &out;
+  param.alpha = 0.5f;
+  param.dynamic_quant_int8 = true;
+  param.weight_scale = {1.f};
+
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  matmul.SetContext(std::move(ctx));
+  matmul.SetParam(param);
+  matmul.PrepareForRun();
+  matmul.Run();
+
+  std::vector<float> ref_result = {42, 84, 126, 168};
+  auto out_data = out.data<float>();
+  for (int i = 0; i < out.dims().production(); i++) {
+    EXPECT_NEAR(out_data[i], ref_result[i], 1e-3);
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -13,7 +13,12 @@
 // limitations under the License.
 #pragma once
 
+#include <memory>
+#include <type_traits>
+#include <vector>
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/dynamic_quant_gemm.h"
+#include "lite/backends/x86/math/sparse_gemm.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -39,6 +44,40 @@ class MulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
   using param_t = operators::MulParam;
 
+  void PrepareForRun() override {
+    auto& param = *param_.get_mutable<operators::MulParam>();
+    auto sparse_type =
+        lite::x86::math::SparseBlockTypeFromStr(param.sparse_weight_type);
+    flag_sparse_ = std::is_same<T, float>::value &&
+                   sparse_type != lite::x86::math::SparseBlockType::kNone;
+    if (flag_sparse_) {
+      auto y_dims = param.y->dims().Flatten2D(param.y_num_col_dims);
+      lite::x86::math::PackBlockSparseMatrix(param.y->template data<float>(),
+                                             y_dims[1],
+                                             y_dims[0],
+                                             true,
+                                             sparse_type,
+                                             &sparse_weights_);
+    }
+    flag_dynamic_quant_ = std::is_same<T, float>::value &&
+                          param.dynamic_quant_int8 &&
+                          param.y->precision() == PRECISION(kInt8);
+    if (flag_dynamic_quant_) {
+      auto y_dims = param.y->dims().Flatten2D(param.y_num_col_dims);
+      const int n = y_dims[1];
+      CHECK(param.weight_scale.size() == 1 ||
+            param.weight_scale.size() == static_cast<size_t>(n))
+          << "The size of the weight scales should be 1 or " << n;
+      std::vector<float> scales(n);
+      for (int j = 0; j < n; j++) {
+        scales[j] = param.weight_scale.size() == 1 ? param.weight_scale[0]
+                                                   : param.weight_scale[j];
+      }
+      dynamic_quant_gemm_.reset(new lite::x86::math::DynamicQuantGemm(
+          n, y_dims[0], param.y->template data<int8_t>(), scales.data()));
+    }
+  }
+
   void Run() override {
     auto& context = ctx_->As<X86Context>();
     auto& param = *param_.get_mutable<operators::MulParam>();
@@ -70,15 +109,38 @@ class MulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
       z->Resize({x_matrix.dims()[0], y_matrix.dims()[1]});
     }
 
-    auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
-
-    blas.MatMul(x_matrix, y_matrix, z);
+    if (flag_dynamic_quant_) {
+      dynamic_quant_gemm_->Run(x_matrix.dims()[0],
+                               x_matrix.template data<float>(),
+                               nullptr,
+                               false,
+                               z->template mutable_data<float>());
+    } else if (flag_sparse_) {
+      lite::x86::math::DenseSparseGemm(x_matrix.template data<float>(),
+                                       x_matrix.dims()[0],
+                                       sparse_weights_,
+                                       nullptr,
+                                       false,
+                                       z->template mutable_data<float>());
+    } else {
+      auto blas =
+          lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
+      blas.MatMul(x_matrix, y_matrix, z);
+    }
     if (z_dim.size() != 2) {
       z->Resize(z_dim);
     }
   }
 
   virtual ~MulCompute() = default;
+
+ private:
+  // the transposed weights packed in the block sparse format
+  bool flag_sparse_{false};
+  lite::x86::math::BlockSparseMatrix sparse_weights_;
+  // the GEMM of the dynamic quantization with the int8 weights packed
+  bool flag_dynamic_quant_{false};
+  std::unique_ptr<lite::x86::math::DynamicQuantGemm> dynamic_quant_gemm_;
 };
 
 }  // namespace x86
@@ -14,13 +14,18 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <random>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "lite/core/op_registry.h"
 #include "lite/kernels/x86/mul_compute.h"
+#include "lite/utils/timer.h"
 
 namespace paddle {
 namespace lite {
@@ -80,6 +85,114 @@ TEST(mul_x86, run_test) {
   }
 }
 
+// Run mul and return the average latency in us.
+static double RunMul(MulCompute<float>* mul,
+                     const operators::MulParam& param,
+                     int repeats) {
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  mul->SetContext(std::move(ctx));
+  mul->SetParam(param);
+  mul->PrepareForRun();
+  mul->Run();
+  auto start = lite::Timer::GetCurrentUS();
+  for (int i = 0; i < repeats; i++) {
+    mul->Run();
+  }
+  return static_cast<double>(lite::Timer::GetCurrentUS() - start) / repeats;
+}
+
+// The activations of the dynamic quantization test: "gaussian", "relu" for
+// the non-negative ones after relu, and "outliers" for a few channels 20x
+// larger than the others, as the hidden states of the transformers.
+static void FillActivations(const std::string& kind,
+                            int m,
+                            int k,
+                            std::default_random_engine* engine,
+                            float* x) {
+  std::normal_distribution<float> dist(0.f, 1.f);
+  for (int i = 0; i < m * k; i++) {
+    x[i] = dist(*engine);
+    if (kind == "relu") {
+      x[i] = std::max(x[i], 0.f);
+    } else if (kind == "outliers" && i % k % 97 == 0) {
+      x[i] *= 20.f;
+    }
+  }
+}
+
+TEST(mul_x86, dynamic_quant_int8) {
+  std::default_random_engine engine(0);
+  std::normal_distribution<float> dist(0.f, 1.f);
+  for (auto& shape : std::vector<std::vector<int>>{{1, 64, 32},
+                                                   {3, 100, 17},
+                                                   {1, 768, 768},
+                                                   {64, 512, 512},
+                                                   {128, 768, 768},
+                                                   {128, 768, 3072}}) {
+    const int m = shape[0];
+    const int k = shape[1];
+    const int n = shape[2];
+    // About 1G multiply-adds of each kernel for a stable latency.
+    const int repeats = std::max(1000000000 / (m * k * n), 5);
+    lite::Tensor y, y_int8;
+    y.Resize({k, n});
+    y_int8.Resize({k, n});
+    auto* y_data = y.mutable_data<float>();
+    for (int i = 0; i < k * n; i++) y_data[i] = dist(engine) * 0.1f;
+
+    // Quantize the weights per column as post_quant_dynamic_pass does.
+    std::vector<float> scales(n, 0.f);
+    for (int i = 0; i < k * n; i++) {
+      scales[i % n] = std::max(scales[i % n], std::fabs(y_data[i]));
+    }
+    for (auto& scale : scales) scale /= 127.f;
+    auto* y_int8_data = y_int8.mutable_data<int8_t>();
+    for (int i = 0; i < k * n; i++) {
+      y_int8_data[i] =
+          static_cast<int8_t>(std::round(y_data[i] / scales[i % n]));
+    }
+
+    for (std::string kind : {"gaussian", "relu", "outliers"}) {
+      lite::Tensor x, out, out_int8;
+      x.Resize({m, k});
+      out.Resize({m, n});
+      out_int8.Resize({m, n});
+      FillActivations(kind, m, k, &engine, x.mutable_data<float>());
+
+      operators::MulParam param;
+      param.x = &x;
+      param.y = &y;
+      param.output = &out;
+      MulCompute<float> mul;
+      double fp32_us = RunMul(&mul, param, repeats);
+
+      param.y = &y_int8;
+      param.output = &out_int8;
+      param.dynamic_quant_int8 = true;
+      param.weight_scale = scales;
+      MulCompute<float> mul_int8;
+      double int8_us = RunMul(&mul_int8, param, repeats);
+
+      // The error against fp32 includes the one of the int8 weights. The
+      // outliers take most of the range of the rows of the activations.
+      const float* ref = out.data<float>();
+      const float* res = out_int8.data<float>();
+      double error = 0.0;
+      double norm = 0.0;
+      for (int i = 0; i < m * n; i++) {
+        error += (res[i] - ref[i]) * (res[i] - ref[i]);
+        norm += ref[i] * ref[i];
+      }
+      double relative_error = std::sqrt(error / norm);
+      LOG(INFO) << "mul [" << m << ", " << k << "] x [" << k << ", " << n
+                << "] " << kind << ": fp32 " << fp32_us << " us, dynamic int8 "
+                << int8_us << " us, relative error " << relative_error;
+      EXPECT_LT(relative_error, kind == "outliers" ? 0.1 : 0.02);
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
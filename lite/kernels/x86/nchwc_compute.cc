@@ -0,0 +1,1510 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/nchwc_compute.h"
+#include <cmath>
+#include <cstring>
+#include <string>
+#include "lite/backends/x86/math/avx/conv_utils.h"
+#include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/fill_bias_activate.h"
+#include "lite/backends/x86/math/interpolate.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+namespace math = lite::x86::math;
+
+template <DataLayoutType Layout>
+void Conv2dNCHWcCompute<Layout>::PrepareForRun() {
+  auto& param = this->template Param<param_t>();
+  CHECK(param.second_x == nullptr && param.fuse_elementwise_op_type.empty())
+      << "The fused elementwise of conv2d isn't supported in the blocked "
+         "channel layout.";
+  const int block = math::nchwc_block(Layout);
+  const auto& w_dims = param.filter->dims();
+  const int oc = w_dims[0];
+  const int oc_padded = (oc + block - 1) / block * block;
+  const int ic = param.x->dims()[1];
+  const int ic_per_group = w_dims[1];
+  const int kh = w_dims[2];
+  const int kw = w_dims[3];
+  const int groups = param.groups;
+  const int stride_h = param.strides[0];
+  const int stride_w = param.strides[1];
+  auto paddings = *param.paddings;
+  auto dilations = *param.dilations;
+  bool no_dilation = dilations[0] == 1 && dilations[1] == 1;
+  bool pad_all_equal = paddings[0] == paddings[1] &&
+                       paddings[1] == paddings[2] &&
+                       paddings[2] == paddings[3];
+  // The shapes of the JIT direct conv, see Conv2dCompute::PrepareForRun.
+  bool direct = oc % 8 == 0 && groups == 1 && kh == kw &&
+                (kh == 3 || kh == 5 || kh == 7) && stride_h == stride_w &&
+                (stride_h == 1 || stride_h == 2) && no_dilation &&
+                pad_all_equal && paddings[0] <= stride_h;
+  if (groups == ic && groups == oc) {
+    algo_ = "depthwise";
+  } else if (direct && block == 8) {
+#if defined(__AVX__) &&                                                \
+    (defined(_WIN64) || defined(__MINGW64__) ||                        \
+     (defined(__CYGWIN__) && defined(__x86_64__)) || defined(__x86_64__))
+    algo_ = "direct";
+#else
+    algo_ = "gemm";
+#endif
+  } else {
+    algo_ = "gemm";
+  }
+  VLOG(3) << "invoking " << algo_ << " conv in the blocked channel layout";
+
+  if (algo_ != "gemm") {
+    weights_.Resize({oc_padded, ic_per_group, kh, kw});
+    math::conv_nchwc_pack_weights(param.filter->template data<float>(),
+                                  weights_.mutable_data<float>(),
+                                  oc,
+                                  ic_per_group,
+                                  kh * kw,
+                                  block);
+  }
+  if (param.bias) {
+    bias_.Resize({oc_padded});
+    float* bias_data = bias_.mutable_data<float>();
+    memset(bias_data, 0, sizeof(float) * oc_padded);
+    memcpy(bias_data, param.bias->template data<float>(), sizeof(float) * oc);
+  }
+  if (algo_ == "direct") {
+    const auto& x_dims = param.x->dims();
+    const auto& o_dims = param.output->dims();
+    direct_.reset(new math::conv_direct());
+    direct_->generate_code(ic,
+                           x_dims[2],
+                           x_dims[3],
+                           oc,
+                           oc_padded,
+                           o_dims[2],
+                           o_dims[3],
+                           paddings[0],
+                           paddings[2],
+                           kh,
+                           kw,
+                           stride_w);
+    direct_->ready();
+  }
+}
+
+template <DataLayoutType Layout>
+void Conv2dNCHWcCompute<Layout>::Run() {
+  if (algo_ == "direct") {
+    return RunDirect();
+  }
+  if (algo_ == "gemm") {
+    return RunGemm();
+  }
+  auto& param = this->template Param<param_t>();
+  const int block = math::nchwc_block(Layout);
+  const auto& in_dims = param.x->dims();
+  const auto& w_dims = param.filter->dims();
+  const auto& out_dims = param.output->dims();
+  auto paddings = *param.paddings;
+  auto dilations = *param.dilations;
+  math::conv_nchwc(param.x->template data<float>(),
+                   math::nchwc_mutable_data(param.output, block),
+                   weights_.data<float>(),
+                   param.bias ? bias_.data<float>() : nullptr,
+                   in_dims[0],
+                   in_dims[1],
+                   in_dims[2],
+                   in_dims[3],
+                   out_dims[1],
+                   out_dims[2],
+                   out_dims[3],
+                   w_dims[2],
+                   w_dims[3],
+                   param.strides[0],
+                   param.strides[1],
+                   paddings[0],
+                   paddings[2],
+                   dilations[0],
+                   dilations[1],
+                   param.groups,
+                   block,
+                   param.activation_param);
+}
+
+template <DataLayoutType Layout>
+void Conv2dNCHWcCompute<Layout>::RunDirect() {
+  auto& param = this->template Param<param_t>();
+  const int block = math::nchwc_block(Layout);
+  const auto& in_dims = param.x->dims();
+  const auto& w_dims = param.filter->dims();
+  const auto& out_dims = param.output->dims();
+  const int num = in_dims[0];
+  const int ic = in_dims[1];
+  const int oc = out_dims[1];
+  const int size = out_dims[2] * out_dims[3];
+  plain_x_.Resize(in_dims);
+  float* x_data = plain_x_.mutable_data<float>();
+  math::nchwc_to_nchw(param.x->template data<float>(),
+                      x_data,
+                      num,
+                      ic,
+                      in_dims[2] * in_dims[3],
+                      block);
+  // The direct conv accumulates to the output blocks, which start from the
+  // bias.
+  float* out_data = math::nchwc_mutable_data(param.output, block);
+  const float* bias_data = param.bias ? bias_.data<float>() : nullptr;
+  for (int nb = 0; nb < num * oc / block; nb++) {
+    float* out_block = out_data + nb * size * block;
+    if (bias_data == nullptr) {
+      memset(out_block, 0, sizeof(float) * size * block);
+      continue;
+    }
+    const float* bias_block = bias_data + nb % (oc / block) * block;
+    for (int i = 0; i < size; i++) {
+      memcpy(out_block + i * block, bias_block, sizeof(float) * block);
+    }
+  }
+  auto paddings = *param.paddings;
+  direct_->run(x_data,
+               weights_.data<float>(),
+               out_data,
+               num,
+               ic,
+               in_dims[2],
+               in_dims[3],
+               oc,
+               oc,
+               out_dims[2],
+               out_dims[3],
+               paddings[0],
+               paddings[2],
+               w_dims[2],
+               w_dims[3],
+               param.strides[0]);
+  math::act_nchwc(out_data,
+                  out_data,
+                  math::nchwc_size(out_dims, block),
+                  param.activation_param);
+}
+
+template <DataLayoutType Layout>
+void Conv2dNCHWcCompute<Layout>::RunGemm() {
+  auto& param = this->template Param<param_t>();
+  auto& ctx = this->ctx_->template As<X86Context>();
+  const int block = math::nchwc_block(Layout);
+  const auto& in_dims = param.x->dims();
+  const auto& w_dims = param.filter->dims();
+  const auto& out_dims = param.output->dims();
+  const int num = in_dims[0];
+  const int ic = in_dims[1];
+  const int ih = in_dims[2];
+  const int iw = in_dims[3];
+  const int oc = out_dims[1];
+  const int groups = param.groups;
+  const int kh = w_dims[2];
+  const int kw = w_dims[3];
+  const int m = oc / groups;
+  const int n = out_dims[2] * out_dims[3];
+  const int k = ic / groups * kh * kw;
+  auto paddings = *param.paddings;
+  auto dilations = *param.dilations;
+  bool is_1x1 = kh == 1 && kw == 1 && param.strides[0] == 1 &&
+                param.strides[1] == 1 && paddings[0] == 0 &&
+                paddings[1] == 0 && paddings[2] == 0 && paddings[3] == 0;
+
+  plain_x_.Resize(in_dims);
+  float* x_data = plain_x_.mutable_data<float>();
+  math::nchwc_to_nchw(
+      param.x->template data<float>(), x_data, num, ic, ih * iw, block);
+  plain_out_.Resize(out_dims);
+  float* out_data = plain_out_.mutable_data<float>();
+  float* col_data = nullptr;
+  if (!is_1x1) {
+    col_.Resize({groups * k, n});
+    col_data = col_.mutable_data<float>();
+  }
+  const float* weights = param.filter->template data<float>();
+  const float* bias = param.bias ? param.bias->template data<float>() : nullptr;
+  auto act_param = param.activation_param;
+  math::Blas<lite::TargetType::kX86> matmul(ctx);
+  for (int i = 0; i < num; i++) {
+    const float* x_batch = x_data + i * ic * ih * iw;
+    float* out_batch = out_data + i * oc * n;
+    const float* cols = x_batch;
+    if (!is_1x1) {
+      math::im2col<float>(x_batch,
+                          ic,
+                          ih,
+                          iw,
+                          kh,
+                          kw,
+                          paddings[0],
+                          paddings[1],
+                          paddings[2],
+                          paddings[3],
+                          param.strides[0],
+                          param.strides[1],
+                          dilations[0],
+                          dilations[1],
+                          col_data);
+      cols = col_data;
+    }
+    for (int g = 0; g < groups; g++) {
+      matmul.GEMM<float>(false,
+                         false,
+                         m,
+                         n,
+                         k,
+                         1.f,
+                         weights + g * m * k,
+                         k,
+                         cols + g * k * n,
+                         n,
+                         0.f,
+                         out_batch + g * m * n,
+                         n);
+    }
+    math::fill_bias_act(out_batch, bias, oc, n, bias != nullptr, &act_param);
+  }
+  math::nchw_to_nchwc(out_data,
+                      math::nchwc_mutable_data(param.output, block),
+                      num,
+                      oc,
+                      n,
+                      block);
+}
+
+template <DataLayoutType Layout>
+void Pool2dNCHWcCompute<Layout>::Run() {
+  auto& param = this->template Param<param_t>();
+  const int block = math::nchwc_block(Layout);
+  const auto& in_dims = param.x->dims();
+  const auto& out_dims = param.output->dims();
+  std::vector<int> ksize = param.ksize;
+  std::vector<int> paddings = *param.paddings;
+  if (param.global_pooling) {
+    ksize = {static_cast<int>(in_dims[2]), static_cast<int>(in_dims[3])};
+    paddings = {0, 0, 0, 0};
+  }
+  math::pool_nchwc(param.x->template data<float>(),
+                   math::nchwc_mutable_data(param.output, block),
+                   in_dims[0],
+                   in_dims[1],
+                   in_dims[2],
+                   in_dims[3],
+                   out_dims[2],
+                   out_dims[3],
+                   ksize,
+                   param.strides,
+                   paddings,
+                   param.pooling_type,
+                   param.exclusive,
+                   param.adaptive,
+                   block);
+}
+
+template <DataLayoutType Layout>
+void ActivationNCHWcCompute<Layout>::Run() {
+  auto& param = this->template Param<param_t>();
+  const int block = math::nchwc_block(Layout);
+  operators::ActivationParam act_param = param;
+  // relu6 keeps its clip in 'threshold'.
+  if (act_param.active_type == lite_api::ActivationType::kRelu6) {
+    act_param.Relu_clipped_coef = param.threshold;
+  }
+  const auto& dims = param.X->dims();
+  int64_t size = dims.size() == 4 ? math::nchwc_size(dims, block)
+                                  : dims.production();
+  math::act_nchwc(param.X->template data<float>(),
+                  math::nchwc_mutable_data(param.Out, block),
+                  size,
+                  act_param);
+}
+
+template <DataLayoutType Layout>
+void BatchNormNCHWcCompute<Layout>::PrepareForRun() {
+  auto& param = this->template Param<param_t>();
+  CHECK(param.is_test || param.use_global_stats)
+      << "Only the inference of batch_norm is supported in the blocked "
+         "channel layout.";
+  const int block = math::nchwc_block(Layout);
+  const int channel = param.scale->dims()[0];
+  const int channel_padded = (channel + block - 1) / block * block;
+  const float* scale = param.scale->template data<float>();
+  const float* bias = param.bias->template data<float>();
+  const float* mean = param.mean->template data<float>();
+  const float* variance = param.variance->template data<float>();
+  scale_.assign(channel_padded, 0.f);
+  bias_.assign(channel_padded, 0.f);
+  for (int c = 0; c < channel; c++) {
+    scale_[c] = scale[c] / std::sqrt(variance[c] + param.epsilon);
+    bias_[c] = bias[c] - mean[c] * scale_[c];
+  }
+}
+
+template <DataLayoutType Layout>
+void BatchNormNCHWcCompute<Layout>::Run() {
+  auto& param = this->template Param<param_t>();
+  const int block = math::nchwc_block(Layout);
+  const auto& dims = param.x->dims();
+  const float* din = param.x->template data<float>();
+  float* dout = math::nchwc_mutable_data(param.y, block);
+  if (dims.size() == 4) {
+    math::scale_bias_nchwc(din,
+                           dout,
+                           scale_.data(),
+                           bias_.data(),
+                           dims[0],
+                           dims[1],
+                           dims[2] * dims[3],
+                           block);
+    return;
+  }
+  // The tensors of the other ranks are plain NC[...].
+  const int64_t num = dims[0];
+  const int64_t channel = dims[1];
+  const int64_t size = dims.count(2, dims.size());
+  for (int64_t n = 0; n < num; n++) {
+    for (int64_t c = 0; c < channel; c++) {
+      const int64_t offset = (n * channel + c) * size;
+      for (int64_t i = 0; i < size; i++) {
+        dout[offset + i] = din[offset + i] * scale_[c] + bias_[c];
+      }
+    }
+  }
+}
+
+inline std::string FusedActType(const operators::ElementwiseParam& param) {
+  return "";
+}
+
+inline std::string FusedActType(
+    const operators::FusionElementwiseActivationParam& param) {
+  return param.act_type;
+}
+
+template <DataLayoutType Layout,
+          lite::x86::math::NCHWcEltwiseType Type,
+          typename ParamType>
+void ElementwiseNCHWcCompute<Layout, Type, ParamType>::Run() {
+  auto& param = this->template Param<param_t>();
+  const int block = math::nchwc_block(Layout);
+  math::elementwise_nchwc(param.X, param.Y, param.Out, param.axis, Type, block);
+  std::string act_type = FusedActType(param);
+  if (act_type.empty()) return;
+  operators::ActivationParam act_param;
+  if (act_type == "relu") {
+    act_param.active_type = lite_api::ActivationType::kRelu;
+  } else if (act_type == "tanh") {
+    act_param.active_type = lite_api::ActivationType::kTanh;
+  } else if (act_type == "sigmoid") {
+    act_param.active_type = lite_api::ActivationType::kSigmoid;
+  } else if (act_type == "abs") {
+    act_param.active_type = lite_api::ActivationType::kAbs;
+  } else {
+    LOG(FATAL) << "Unsupported fused activation " << act_type
+               << " in the blocked channel layout.";
+  }
+  const auto& dims = param.Out->dims();
+  int64_t size = dims.size() == 4 ? math::nchwc_size(dims, block)
+                                  : dims.production();
+  float* out = param.Out->template mutable_data<float>();
+  math::act_nchwc(out, out, size, act_param);
+}
+
+template <DataLayoutType Layout>
+void ConcatNCHWcCompute<Layout>::Run() {
+  auto& param = this->template Param<param_t>();
+  const int block = math::nchwc_block(Layout);
+  int axis = param.axis;
+  if (param.axis_tensor != nullptr) {
+    axis = param.axis_tensor->template data<int>()[0];
+  }
+  if (axis < 0) {
+    axis += static_cast<int>(param.x[0]->dims().size());
+  }
+  math::concat_nchwc(param.x, param.output, axis, block);
+}
+
+template <DataLayoutType Layout>
+void InterpolateNCHWcCompute<Layout>::Run() {
+  auto& param = this->template Param<param_t>();
+  const int block = math::nchwc_block(Layout);
+  const std::string& op_type = this->op_type();
+  std::string interp_method =
+      op_type.compare(0, 8, "bilinear") == 0 ? "Bilinear" : "Nearest";
+  // Follow the plain kernels, which run bilinear_interp_v2 as the v1 op.
+  if (param.version_2 && interp_method == "Nearest") {
+    math::interpolate_v2(param.X,
+                         param.OutSize,
+                         param.SizeTensor,
+                         param.Scale,
+                         param.Out,
+                         param.scale,
+                         param.scale_v,
+                         param.out_h,
+                         param.out_w,
+                         param.align_mode,
+                         param.align_corners,
+                         interp_method,
+                         block);
+  } else {
+    math::interpolate(param.X,
+                      param.OutSize,
+                      param.SizeTensor,
+                      param.Scale,
+                      param.Out,
+                      param.scale,
+                      param.scale_v,
+                      param.out_h,
+                      param.out_w,
+                      param.align_mode,
+                      param.align_corners,
+                      interp_method,
+                      block);
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+typedef paddle::lite::kernels::x86::Conv2dNCHWcCompute<DATALAYOUT(kNCHW8c)>
+    ConvNCHW8c;
+typedef paddle::lite::kernels::x86::Pool2dNCHWcCompute<DATALAYOUT(kNCHW8c)>
+    PoolNCHW8c;
+typedef paddle::lite::kernels::x86::ActivationNCHWcCompute<
+    DATALAYOUT(kNCHW8c)>
+    ActNCHW8c;
+typedef paddle::lite::kernels::x86::BatchNormNCHWcCompute<
+    DATALAYOUT(kNCHW8c)>
+    BatchNormNCHW8c;
+typedef paddle::lite::kernels::x86::ConcatNCHWcCompute<DATALAYOUT(kNCHW8c)>
+    ConcatNCHW8c;
+typedef paddle::lite::kernels::x86::InterpolateNCHWcCompute<
+    DATALAYOUT(kNCHW8c)>
+    InterpNCHW8c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW8c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kAdd,
+    paddle::lite::operators::ElementwiseParam>
+    ElementwiseAddNCHW8c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW8c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kSub,
+    paddle::lite::operators::ElementwiseParam>
+    ElementwiseSubNCHW8c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW8c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kMul,
+    paddle::lite::operators::ElementwiseParam>
+    ElementwiseMulNCHW8c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW8c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kDiv,
+    paddle::lite::operators::ElementwiseParam>
+    ElementwiseDivNCHW8c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW8c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kMax,
+    paddle::lite::operators::ElementwiseParam>
+    ElementwiseMaxNCHW8c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW8c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kMin,
+    paddle::lite::operators::ElementwiseParam>
+    ElementwiseMinNCHW8c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW8c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kAdd,
+    paddle::lite::operators::FusionElementwiseActivationParam>
+    ElementwiseAddActNCHW8c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW8c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kSub,
+    paddle::lite::operators::FusionElementwiseActivationParam>
+    ElementwiseSubActNCHW8c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW8c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kMul,
+    paddle::lite::operators::FusionElementwiseActivationParam>
+    ElementwiseMulActNCHW8c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW8c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kDiv,
+    paddle::lite::operators::FusionElementwiseActivationParam>
+    ElementwiseDivActNCHW8c;
+typedef paddle::lite::kernels::x86::Conv2dNCHWcCompute<DATALAYOUT(kNCHW16c)>
+    ConvNCHW16c;
+typedef paddle::lite::kernels::x86::Pool2dNCHWcCompute<DATALAYOUT(kNCHW16c)>
+    PoolNCHW16c;
+typedef paddle::lite::kernels::x86::ActivationNCHWcCompute<
+    DATALAYOUT(kNCHW16c)>
+    ActNCHW16c;
+typedef paddle::lite::kernels::x86::BatchNormNCHWcCompute<
+    DATALAYOUT(kNCHW16c)>
+    BatchNormNCHW16c;
+typedef paddle::lite::kernels::x86::ConcatNCHWcCompute<DATALAYOUT(kNCHW16c)>
+    ConcatNCHW16c;
+typedef paddle::lite::kernels::x86::InterpolateNCHWcCompute<
+    DATALAYOUT(kNCHW16c)>
+    InterpNCHW16c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW16c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kAdd,
+    paddle::lite::operators::ElementwiseParam>
+    ElementwiseAddNCHW16c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW16c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kSub,
+    paddle::lite::operators::ElementwiseParam>
+    ElementwiseSubNCHW16c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW16c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kMul,
+    paddle::lite::operators::ElementwiseParam>
+    ElementwiseMulNCHW16c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW16c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kDiv,
+    paddle::lite::operators::ElementwiseParam>
+    ElementwiseDivNCHW16c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW16c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kMax,
+    paddle::lite::operators::ElementwiseParam>
+    ElementwiseMaxNCHW16c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW16c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kMin,
+    paddle::lite::operators::ElementwiseParam>
+    ElementwiseMinNCHW16c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW16c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kAdd,
+    paddle::lite::operators::FusionElementwiseActivationParam>
+    ElementwiseAddActNCHW16c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW16c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kSub,
+    paddle::lite::operators::FusionElementwiseActivationParam>
+    ElementwiseSubActNCHW16c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW16c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kMul,
+    paddle::lite::operators::FusionElementwiseActivationParam>
+    ElementwiseMulActNCHW16c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHWcCompute<
+    DATALAYOUT(kNCHW16c),
+    paddle::lite::x86::math::NCHWcEltwiseType::kDiv,
+    paddle::lite::operators::FusionElementwiseActivationParam>
+    ElementwiseDivActNCHW16c;
+
+REGISTER_LITE_KERNEL(conv2d, kX86, kFloat, kNCHW8c, ConvNCHW8c, def)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .BindPaddleOpVersion("conv2d", 1)
+    .Finalize();
+
+REGISTER_LITE_KERNEL(depthwise_conv2d, kX86, kFloat, kNCHW8c, ConvNCHW8c, def)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .BindPaddleOpVersion("depthwise_conv2d", 1)
+    .Finalize();
+
+REGISTER_LITE_KERNEL(pool2d, kX86, kFloat, kNCHW8c, PoolNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(relu, kX86, kFloat, kNCHW8c, ActNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(relu6, kX86, kFloat, kNCHW8c, ActNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(leaky_relu, kX86, kFloat, kNCHW8c, ActNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(sigmoid, kX86, kFloat, kNCHW8c, ActNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(tanh, kX86, kFloat, kNCHW8c, ActNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(swish, kX86, kFloat, kNCHW8c, ActNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(hard_swish, kX86, kFloat, kNCHW8c, ActNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(hard_sigmoid, kX86, kFloat, kNCHW8c, ActNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(abs, kX86, kFloat, kNCHW8c, ActNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(batch_norm, kX86, kFloat, kNCHW8c, BatchNormNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Mean", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Variance", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Y",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .BindOutput("MeanOut", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("VarianceOut", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("SavedMean", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("SavedVariance", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_add,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     ElementwiseAddNCHW8c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_sub,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     ElementwiseSubNCHW8c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_mul,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     ElementwiseMulNCHW8c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_div,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     ElementwiseDivNCHW8c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_max,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     ElementwiseMaxNCHW8c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_min,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     ElementwiseMinNCHW8c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_elementwise_add_activation,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     ElementwiseAddActNCHW8c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_elementwise_sub_activation,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     ElementwiseSubActNCHW8c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_elementwise_mul_activation,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     ElementwiseMulActNCHW8c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_elementwise_div_activation,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     ElementwiseDivActNCHW8c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(concat, kX86, kFloat, kNCHW8c, ConcatNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("AxisTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(bilinear_interp, kX86, kFloat, kNCHW8c, InterpNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("OutSize",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("SizeTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(nearest_interp, kX86, kFloat, kNCHW8c, InterpNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("OutSize",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("SizeTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(bilinear_interp_v2,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     InterpNCHW8c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("OutSize",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("SizeTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(nearest_interp_v2,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     InterpNCHW8c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("OutSize",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("SizeTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(conv2d, kX86, kFloat, kNCHW16c, ConvNCHW16c, def)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .BindPaddleOpVersion("conv2d", 1)
+    .Finalize();
+
+REGISTER_LITE_KERNEL(depthwise_conv2d, kX86, kFloat, kNCHW16c, ConvNCHW16c, def)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .BindPaddleOpVersion("depthwise_conv2d", 1)
+    .Finalize();
+
+REGISTER_LITE_KERNEL(pool2d, kX86, kFloat, kNCHW16c, PoolNCHW16c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(relu, kX86, kFloat, kNCHW16c, ActNCHW16c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(relu6, kX86, kFloat, kNCHW16c, ActNCHW16c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(leaky_relu, kX86, kFloat, kNCHW16c, ActNCHW16c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(sigmoid, kX86, kFloat, kNCHW16c, ActNCHW16c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(tanh, kX86, kFloat, kNCHW16c, ActNCHW16c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(swish, kX86, kFloat, kNCHW16c, ActNCHW16c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(hard_swish, kX86, kFloat, kNCHW16c, ActNCHW16c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(hard_sigmoid, kX86, kFloat, kNCHW16c, ActNCHW16c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(abs, kX86, kFloat, kNCHW16c, ActNCHW16c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(batch_norm, kX86, kFloat, kNCHW16c, BatchNormNCHW16c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Mean", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Variance", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Y",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .BindOutput("MeanOut", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("VarianceOut", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("SavedMean", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("SavedVariance", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_add,
+                     kX86,
+                     kFloat,
+                     kNCHW16c,
+                     ElementwiseAddNCHW16c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_sub,
+                     kX86,
+                     kFloat,
+                     kNCHW16c,
+                     ElementwiseSubNCHW16c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_mul,
+                     kX86,
+                     kFloat,
+                     kNCHW16c,
+                     ElementwiseMulNCHW16c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_div,
+                     kX86,
+                     kFloat,
+                     kNCHW16c,
+                     ElementwiseDivNCHW16c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_max,
+                     kX86,
+                     kFloat,
+                     kNCHW16c,
+                     ElementwiseMaxNCHW16c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_min,
+                     kX86,
+                     kFloat,
+                     kNCHW16c,
+                     ElementwiseMinNCHW16c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_elementwise_add_activation,
+                     kX86,
+                     kFloat,
+                     kNCHW16c,
+                     ElementwiseAddActNCHW16c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_elementwise_sub_activation,
+                     kX86,
+                     kFloat,
+                     kNCHW16c,
+                     ElementwiseSubActNCHW16c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_elementwise_mul_activation,
+                     kX86,
+                     kFloat,
+                     kNCHW16c,
+                     ElementwiseMulActNCHW16c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_elementwise_div_activation,
+                     kX86,
+                     kFloat,
+                     kNCHW16c,
+                     ElementwiseDivActNCHW16c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(concat, kX86, kFloat, kNCHW16c, ConcatNCHW16c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("AxisTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(bilinear_interp,
+                     kX86,
+                     kFloat,
+                     kNCHW16c,
+                     InterpNCHW16c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("OutSize",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("SizeTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(nearest_interp, kX86, kFloat, kNCHW16c, InterpNCHW16c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("OutSize",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("SizeTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(bilinear_interp_v2,
+                     kX86,
+                     kFloat,
+                     kNCHW16c,
+                     InterpNCHW16c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("OutSize",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("SizeTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(nearest_interp_v2,
+                     kX86,
+                     kFloat,
+                     kNCHW16c,
+                     InterpNCHW16c,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW16c))})
+    .BindInput("OutSize",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("SizeTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW16c))})
+    .Finalize();
@@ -0,0 +1,135 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/backends/x86/math/conv_direct_fp32.h"
+#include "lite/backends/x86/math/nchwc.h"
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+/*
+ * The kernels of the CNN ops on the tensors in the layouts of the channels
+ * blocked, i.e. NCHW8c and NCHW16c, see
+ * lite/backends/x86/math/nchwc.h. They're picked if the place of the layout
+ * comes first in the valid places, and type_layout_cast_pass reorders the
+ * tensors only at the boundaries of the regions of these kernels, so a CNN
+ * backbone stays blocked from its first conv to its last pool.
+ */
+template <DataLayoutType Layout>
+class Conv2dNCHWcCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat), Layout> {
+ public:
+  using param_t = operators::ConvParam;
+  void PrepareForRun() override;
+  void Run() override;
+  virtual ~Conv2dNCHWcCompute() = default;
+
+ private:
+  void RunGemm();
+  void RunDirect();
+
+  // "depthwise" runs math::conv_nchwc on the blocks, "direct" runs the JIT
+  // direct conv of DirectConv, whose output is NCHW8c already, and "gemm"
+  // runs the im2col + GEMM of Conv2dCompute on the input reordered to NCHW.
+  std::string algo_;
+  // The weights packed to [oc / block, ic / groups, kh, kw, block], it's the
+  // layout of the weights of the direct conv too.
+  Tensor weights_;
+  // The bias padded to the blocks.
+  Tensor bias_;
+  // The input reordered to NCHW for "direct" and "gemm", the columns and the
+  // NCHW output of "gemm".
+  Tensor plain_x_;
+  Tensor col_;
+  Tensor plain_out_;
+  std::unique_ptr<lite::x86::math::conv_direct> direct_;
+};
+
+template <DataLayoutType Layout>
+class Pool2dNCHWcCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat), Layout> {
+ public:
+  using param_t = operators::PoolParam;
+  void Run() override;
+  virtual ~Pool2dNCHWcCompute() = default;
+};
+
+template <DataLayoutType Layout>
+class ActivationNCHWcCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat), Layout> {
+ public:
+  using param_t = operators::ActivationParam;
+  void Run() override;
+  virtual ~ActivationNCHWcCompute() = default;
+};
+
+template <DataLayoutType Layout>
+class BatchNormNCHWcCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat), Layout> {
+ public:
+  using param_t = operators::BatchNormParam;
+  void PrepareForRun() override;
+  void Run() override;
+  virtual ~BatchNormNCHWcCompute() = default;
+
+ private:
+  // The scale and the bias folded from the statistics, padded to the blocks.
+  std::vector<float> scale_;
+  std::vector<float> bias_;
+};
+
+// 'ParamType' is ElementwiseParam, or FusionElementwiseActivationParam for the
+// fused activation.
+template <DataLayoutType Layout,
+          lite::x86::math::NCHWcEltwiseType Type,
+          typename ParamType>
+class ElementwiseNCHWcCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat), Layout> {
+ public:
+  using param_t = ParamType;
+  void Run() override;
+  virtual ~ElementwiseNCHWcCompute() = default;
+};
+
+template <DataLayoutType Layout>
+class ConcatNCHWcCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat), Layout> {
+ public:
+  using param_t = operators::ConcatParam;
+  void Run() override;
+  virtual ~ConcatNCHWcCompute() = default;
+};
+
+template <DataLayoutType Layout>
+class InterpolateNCHWcCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat), Layout> {
+ public:
+  using param_t = operators::InterpolateParam;
+  void Run() override;
+  virtual ~InterpolateNCHWcCompute() = default;
+};
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
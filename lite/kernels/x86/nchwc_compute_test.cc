@@ -0,0 +1,262 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "lite/core/op_registry.h"
+#include "lite/kernels/x86/nchwc_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+namespace math = lite::x86::math;
+
+// Fill the plain 'data' of 'dims' and store it blocked in 'tensor'.
+void FillBlocked(Tensor* tensor,
+                 const DDim& dims,
+                 int block,
+                 std::vector<float>* data) {
+  data->resize(dims.production());
+  for (size_t i = 0; i < data->size(); i++) {
+    (*data)[i] = static_cast<float>((i * 7) % 19) / 19.f - 0.5f;
+  }
+  tensor->Resize(dims);
+  math::nchw_to_nchwc(data->data(),
+                      math::nchwc_mutable_data(tensor, block),
+                      dims[0],
+                      dims[1],
+                      dims[2] * dims[3],
+                      block);
+}
+
+std::vector<float> ToPlain(const Tensor& tensor, int block) {
+  const auto& dims = tensor.dims();
+  std::vector<float> data(dims.production());
+  math::nchwc_to_nchw(tensor.data<float>(),
+                      data.data(),
+                      dims[0],
+                      dims[1],
+                      dims[2] * dims[3],
+                      block);
+  return data;
+}
+
+TEST(nchwc_x86, retrive_op) {
+  auto conv2d = KernelRegistry::Global().Create("conv2d");
+  ASSERT_FALSE(conv2d.empty());
+  bool found = false;
+  for (auto& kernel : conv2d) {
+    found |= kernel->layout() == DATALAYOUT(kNCHW8c);
+  }
+  ASSERT_TRUE(found);
+}
+
+TEST(nchwc_x86, reorder) {
+  for (int block : {8, 16}) {
+    Tensor x;
+    std::vector<float> data;
+    FillBlocked(&x, DDim({2, 19, 3, 5}), block, &data);
+    auto plain = ToPlain(x, block);
+    for (size_t i = 0; i < data.size(); i++) {
+      EXPECT_EQ(plain[i], data[i]);
+    }
+  }
+}
+
+template <DataLayoutType Layout>
+void TestConv(int ic, int oc, int groups, int stride) {
+  const int block = math::nchwc_block(Layout);
+  const int n = 2, ih = 9, iw = 7, kh = 3, kw = 3, pad = 1;
+  const int oh = (ih + 2 * pad - kh) / stride + 1;
+  const int ow = (iw + 2 * pad - kw) / stride + 1;
+  const int icg = ic / groups, ocg = oc / groups;
+  Tensor x, filter, bias, out;
+  std::vector<float> x_data;
+  FillBlocked(&x, DDim({n, ic, ih, iw}), block, &x_data);
+  filter.Resize({oc, icg, kh, kw});
+  float* w = filter.mutable_data<float>();
+  for (int i = 0; i < filter.numel(); i++) {
+    w[i] = static_cast<float>((i * 5) % 11) / 11.f - 0.5f;
+  }
+  bias.Resize({oc});
+  float* b = bias.mutable_data<float>();
+  for (int i = 0; i < oc; i++) {
+    b[i] = 0.1f * i;
+  }
+  out.Resize({n, oc, oh, ow});
+
+  operators::ConvParam param;
+  param.x = &x;
+  param.filter = &filter;
+  param.bias = &bias;
+  param.output = &out;
+  param.strides = {stride, stride};
+  param.paddings = std::make_shared<std::vector<int>>(
+      std::vector<int>{pad, pad, pad, pad});
+  param.dilations = std::make_shared<std::vector<int>>(std::vector<int>{1, 1});
+  param.groups = groups;
+  param.activation_param.has_active = true;
+  param.activation_param.active_type = lite_api::ActivationType::kRelu;
+
+  Conv2dNCHWcCompute<Layout> conv;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  conv.SetContext(std::move(ctx));
+  conv.SetParam(param);
+  conv.PrepareForRun();
+  conv.Run();
+
+  auto result = ToPlain(out, block);
+  for (int bn = 0; bn < n; bn++) {
+    for (int o = 0; o < oc; o++) {
+      for (int y = 0; y < oh; y++) {
+        for (int xx = 0; xx < ow; xx++) {
+          float sum = b[o];
+          for (int i = 0; i < icg; i++) {
+            int c = o / ocg * icg + i;
+            for (int ky = 0; ky < kh; ky++) {
+              for (int kx = 0; kx < kw; kx++) {
+                int iy = y * stride - pad + ky;
+                int ix = xx * stride - pad + kx;
+                if (iy < 0 || iy >= ih || ix < 0 || ix >= iw) continue;
+                sum += x_data[((bn * ic + c) * ih + iy) * iw + ix] *
+                       w[((o * icg + i) * kh + ky) * kw + kx];
+              }
+            }
+          }
+          EXPECT_NEAR(result[((bn * oc + o) * oh + y) * ow + xx],
+                      std::max(sum, 0.f),
+                      1e-4);
+        }
+      }
+    }
+  }
+}
+
+TEST(nchwc_x86, conv2d) {
+  TestConv<DATALAYOUT(kNCHW8c)>(3, 12, 1, 1);
+  TestConv<DATALAYOUT(kNCHW8c)>(20, 20, 20, 2);
+  TestConv<DATALAYOUT(kNCHW8c)>(12, 20, 4, 1);
+  // The shape of the direct conv.
+  TestConv<DATALAYOUT(kNCHW8c)>(6, 16, 1, 2);
+  TestConv<DATALAYOUT(kNCHW16c)>(16, 32, 2, 1);
+  TestConv<DATALAYOUT(kNCHW16c)>(24, 24, 24, 1);
+}
+
+TEST(nchwc_x86, pool2d) {
+  Tensor x, out;
+  std::vector<float> x_data;
+  const int c = 10, ih = 7, iw = 7, oh = 3, ow = 3;
+  FillBlocked(&x, DDim({1, c, ih, iw}), 8, &x_data);
+  out.Resize({1, c, oh, ow});
+  operators::PoolParam param;
+  param.x = &x;
+  param.output = &out;
+  param.pooling_type = "max";
+  param.ksize = {3, 3};
+  param.strides = {2, 2};
+  param.paddings =
+      std::make_shared<std::vector<int>>(std::vector<int>{0, 0, 0, 0});
+
+  Pool2dNCHWcCompute<DATALAYOUT(kNCHW8c)> pool;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  pool.SetContext(std::move(ctx));
+  pool.SetParam(param);
+  pool.Run();
+
+  auto result = ToPlain(out, 8);
+  for (int ch = 0; ch < c; ch++) {
+    for (int y = 0; y < oh; y++) {
+      for (int xx = 0; xx < ow; xx++) {
+        float max_value = x_data[(ch * ih + y * 2) * iw + xx * 2];
+        for (int ky = 0; ky < 3; ky++) {
+          for (int kx = 0; kx < 3; kx++) {
+            max_value = std::max(
+                max_value, x_data[(ch * ih + y * 2 + ky) * iw + xx * 2 + kx]);
+          }
+        }
+        EXPECT_EQ(result[(ch * oh + y) * ow + xx], max_value);
+      }
+    }
+  }
+}
+
+TEST(nchwc_x86, elementwise_add) {
+  Tensor x, y, out;
+  std::vector<float> x_data;
+  const int n = 2, c = 10, size = 6;
+  FillBlocked(&x, DDim({n, c, 2, 3}), 16, &x_data);
+  y.Resize({c});
+  float* y_data = y.mutable_data<float>();
+  for (int i = 0; i < c; i++) {
+    y_data[i] = static_cast<float>(i);
+  }
+  out.Resize({n, c, 2, 3});
+  operators::ElementwiseParam param;
+  param.X = &x;
+  param.Y = &y;
+  param.Out = &out;
+  param.axis = 1;
+
+  ElementwiseNCHWcCompute<DATALAYOUT(kNCHW16c),
+                          math::NCHWcEltwiseType::kAdd,
+                          operators::ElementwiseParam>
+      add;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  add.SetContext(std::move(ctx));
+  add.SetParam(param);
+  add.Run();
+
+  auto result = ToPlain(out, 16);
+  for (int i = 0; i < n * c * size; i++) {
+    EXPECT_NEAR(result[i], x_data[i] + y_data[i / size % c], 1e-6);
+  }
+}
+
+TEST(nchwc_x86, concat) {
+  for (int block : {8, 16}) {
+    Tensor a, b, out;
+    std::vector<float> a_data, b_data;
+    FillBlocked(&a, DDim({2, 5, 2, 2}), block, &a_data);
+    FillBlocked(&b, DDim({2, 12, 2, 2}), block, &b_data);
+    out.Resize({2, 17, 2, 2});
+    math::concat_nchwc({&a, &b}, &out, 1, block);
+    auto result = ToPlain(out, block);
+    for (int n = 0; n < 2; n++) {
+      for (int c = 0; c < 17; c++) {
+        for (int i = 0; i < 4; i++) {
+          float expect = c < 5 ? a_data[(n * 5 + c) * 4 + i]
+                               : b_data[(n * 12 + c - 5) * 4 + i];
+          EXPECT_EQ(result[(n * 17 + c) * 4 + i], expect);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(conv2d, kX86, kFloat, kNCHW8c, def);
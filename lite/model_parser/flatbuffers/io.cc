@@ -13,12 +13,18 @@
 // limitations under the License.
 
 #include "lite/model_parser/flatbuffers/io.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>  // NOLINT
 #include <cstring>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <utility>
 #include <vector>
 #include "lite/core/model/base/io.h"
+#include "lite/model_parser/flatbuffers/param_codec.h"
 #include "lite/model_parser/flatbuffers/traits.h"
 
 namespace paddle {
@@ -95,6 +101,23 @@ void ParamSerializer::ForwardWrite(const lite::Scope& scope,
     fbs::ParamDesc param;
     auto& tensor = scope.FindVar(name)->Get<lite::Tensor>();
     FillParam(name, tensor, &param);
+    if (compress_) {
+      size_t element_size = lite_api::PrecisionTypeLength(tensor.precision());
+      if (element_size == 0 || tensor.memory_size() % element_size != 0) {
+        element_size = 1;
+      }
+      std::vector<int8_t> compressed;
+      if (CompressParamData(param.GetData(),
+                            param.byte_size(),
+                            element_size,
+                            &compressed)) {
+        VLOG(4) << "compress param " << name << ": " << param.byte_size()
+                << " -> " << compressed.size() << " bytes";
+        param.SetCompressedData(std::move(compressed),
+                                proto::ParamDesc_::CompressType_BYTE_SHUFFLE,
+                                param.byte_size());
+      }
+    }
     param.CopyDataToBuffer(buf_.get());
 
     const size_t param_bytes = buf_->size();
@@ -115,6 +138,103 @@ void ParamSerializer::WriteHeader() {
 }
 #endif
 
+namespace {
+// The uncompressed params smaller than this are copied by the reader thread,
+// and each task of the larger ones copies at most this size of data.
+constexpr size_t kParamCopyChunkSize = 4 * 1024 * 1024;
+
+// Materialize the params on the workers of ParamWorkerPool while the reader
+// thread keeps reading the following params, the bytes of the params which
+// are read but not yet materialized are bounded by 'max_inflight_bytes'.
+class ParamLoadPipeline {
+ public:
+  explicit ParamLoadPipeline(size_t max_inflight_bytes)
+      : max_inflight_bytes_(max_inflight_bytes) {}
+  ~ParamLoadPipeline() { Finish(); }
+
+  // Wait until 'bytes' fits in the budget, a param larger than the budget is
+  // still accepted if nothing else is in flight.
+  void Acquire(size_t bytes) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    released_.wait(lock, [&] {
+      return inflight_bytes_ == 0 ||
+             inflight_bytes_ + bytes <= max_inflight_bytes_;
+    });
+    inflight_bytes_ += bytes;
+  }
+
+  void Release(size_t bytes) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      inflight_bytes_ -= bytes;
+    }
+    released_.notify_all();
+  }
+
+  void Submit(std::function<void()>&& task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_tasks_++;
+    }
+    ParamWorkerPool::Global().Submit([this, task] {
+      task();
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--pending_tasks_ == 0) finished_.notify_all();
+    });
+  }
+
+  // Wait for all of the submitted tasks.
+  void Finish() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_.wait(lock, [&] { return pending_tasks_ == 0; });
+  }
+
+ private:
+  size_t max_inflight_bytes_{0};
+  size_t inflight_bytes_{0};
+  size_t pending_tasks_{0};
+  std::mutex mutex_;
+  std::condition_variable released_;
+  std::condition_variable finished_;
+};
+
+// A param whose buffer is released after all of its tasks are done.
+struct LoadingParam {
+  std::unique_ptr<model_parser::Buffer> buf;
+  std::unique_ptr<ParamDataDecoder> decoder;
+  size_t bytes{0};
+  std::atomic<size_t> pending_tasks{0};
+};
+
+void* ResizeTensor(lite::Tensor* tensor,
+                   const ParamDescView& param,
+                   size_t byte_size) {
+  tensor->Resize(param.Dim());
+  tensor->set_precision(lite::ConvertPrecisionType(param.GetDataType()));
+  auto* dst = tensor->mutable_data(byte_size);
+  CHECK(dst);
+  tensor->set_persistable(true);
+  return dst;
+}
+
+void LoadParamFromFile(const std::string& model_file,
+                       size_t offset,
+                       size_t size,
+                       lite::Tensor* tensor) {
+  model_parser::BinaryFileReader reader(model_file, offset);
+  model_parser::Buffer buf(size);
+  reader.Read(buf.data(), size);
+  ParamDescView param(&buf);
+  if (param.compress_type() == proto::ParamDesc_::CompressType_NONE) {
+    FillTensor(tensor, param);
+  } else {
+    ParamDataDecoder decoder(param.GetData(), param.byte_size());
+    CHECK_EQ(decoder.raw_size(), param.raw_size());
+    decoder.Decode(ResizeTensor(tensor, param, param.raw_size()));
+  }
+}
+}  // namespace
+
 void ParamDeserializer::ForwardRead(lite::Scope* scope) {
   CHECK(scope) << "The pointer of scope is nullptr";
   uint16_t header_size = reader_->Read<uint16_t>();
@@ -124,23 +244,94 @@ void ParamDeserializer::ForwardRead(lite::Scope* scope) {
   uint32_t max_tensor_size =
       *reinterpret_cast<uint32_t const*>(data + sizeof(uint16_t));
 
+  // The reader thread reads the params and creates the tensors, the workers
+  // copy or decode the data into the tensors.
+  ParamLoadPipeline pipeline(max_inflight_bytes_);
+
   buf_->ResetLazy(max_tensor_size);
   for (size_t i = 0; i < params_size; ++i) {
     uint32_t total_size = reader_->Read<uint32_t>();
     uint32_t offset = reader_->Read<uint32_t>();
     uint32_t param_bytes = total_size - offset;
     ReadBytesToBuffer(offset - sizeof(offset));
+    pipeline.Acquire(param_bytes);
+    size_t param_offset = reader_->current();
     ReadBytesToBuffer(param_bytes);
     fbs::ParamDescView param(buf_.get());
-    FillTensor(scope->Var(param.Name())->GetMutable<lite::Tensor>(), param);
+    auto* tensor = scope->Var(param.Name())->GetMutable<lite::Tensor>();
+    if (lazy_params_ && lazy_names_.count(param.Name())) {
+      // Only the dims and precision are set until it's materialized.
+      tensor->Resize(param.Dim());
+      tensor->set_precision(lite::ConvertPrecisionType(param.GetDataType()));
+      tensor->set_persistable(true);
+      std::string model_file = model_file_;
+      lazy_params_->Register(
+          param.Name(), [model_file, param_offset, param_bytes](Tensor* t) {
+            LoadParamFromFile(model_file, param_offset, param_bytes, t);
+          });
+      pipeline.Release(param_bytes);
+      continue;
+    }
+    const bool compressed =
+        param.compress_type() != proto::ParamDesc_::CompressType_NONE;
+    if (!compressed && param.byte_size() < kParamCopyChunkSize) {
+      FillTensor(tensor, param);
+      pipeline.Release(param_bytes);
+      continue;
+    }
+
+    std::shared_ptr<LoadingParam> loading(new LoadingParam);
+    loading->bytes = param_bytes;
+    std::vector<std::function<void()>> tasks;
+    if (compressed) {
+      CHECK_GE(version_, kCompressedParamsVersion)
+          << "File format error: compressed param " << param.Name()
+          << " in the params of version " << version_;
+      CHECK_EQ(param.compress_type(),
+               proto::ParamDesc_::CompressType_BYTE_SHUFFLE)
+          << "Unsupported compress type of param " << param.Name();
+      loading->decoder.reset(
+          new ParamDataDecoder(param.GetData(), param.byte_size()));
+      CHECK_EQ(loading->decoder->raw_size(), param.raw_size())
+          << "The raw size of param " << param.Name() << " mismatches.";
+      void* dst = ResizeTensor(tensor, param, param.raw_size());
+      const ParamDataDecoder* decoder = loading->decoder.get();
+      for (size_t j = 0; j < decoder->num_blocks(); ++j) {
+        tasks.emplace_back([=] { decoder->DecodeBlock(j, dst); });
+      }
+    } else {
+      char* dst = static_cast<char*>(
+          ResizeTensor(tensor, param, param.byte_size()));
+      const char* src = static_cast<const char*>(param.GetData());
+      size_t size = param.byte_size();
+      for (size_t begin = 0; begin < size; begin += kParamCopyChunkSize) {
+        size_t chunk = std::min(kParamCopyChunkSize, size - begin);
+        tasks.emplace_back(
+            [=] { std::memcpy(dst + begin, src + begin, chunk); });
+      }
+    }
+    // The buffer is handed over to the tasks.
+    loading->buf = std::move(buf_);
+    buf_.reset(new model_parser::Buffer);
+    loading->pending_tasks = tasks.size();
+    for (auto& task : tasks) {
+      pipeline.Submit([loading, task, &pipeline] {
+        task();
+        if (--loading->pending_tasks == 0) {
+          loading->buf.reset();
+          pipeline.Release(loading->bytes);
+        }
+      });
+    }
   }
+  pipeline.Finish();
 }
 
 void ParamDeserializer::ReadHeader() {
   // 1. version id
-  uint16_t version = reader_->Read<uint16_t>();
-  CHECK_EQ(version, 0U)
-      << "File format error: The version of params must be zero.";
+  version_ = reader_->Read<uint16_t>();
+  CHECK_LE(version_, kCompressedParamsVersion)
+      << "File format error: Unsupported version of params " << version_;
   // 2. meta version
   uint16_t meta_size = reader_->Read<uint16_t>();
   ReadBytesToBuffer(meta_size);
@@ -18,6 +18,7 @@
 #include <set>
 #include <string>
 #include <vector>
+#include "lite/core/lazy_params.h"
 #include "lite/core/scope.h"
 #include "lite/core/variable.h"
 #include "lite/model_parser/flatbuffers/param_desc.h"
@@ -33,12 +34,20 @@ void FillParam(const std::string& name,
 
 void FillTensor(lite::Tensor* tensor, const ParamDescReadAPI& param);
 
+// The version of the params stream, the params may be compressed since
+// version 1, which can't be loaded by the former runtime.
+constexpr uint16_t kParamsVersion = 0;
+constexpr uint16_t kCompressedParamsVersion = 1;
+
 #ifdef LITE_WITH_FLATBUFFERS_DESC
 class ParamSerializer {
  public:
   explicit ParamSerializer(model_parser::ByteWriter* writer,
-                           uint16_t version = 0)
-      : writer_(writer), version_{version}, buf_(new model_parser::Buffer) {
+                           bool compress = false)
+      : writer_(writer),
+        version_{compress ? kCompressedParamsVersion : kParamsVersion},
+        compress_{compress},
+        buf_(new model_parser::Buffer) {
     CHECK(writer_)
         << "A valid writer should be passed in the ctor of param serializer.";
     WriteHeader();
@@ -49,21 +58,40 @@ class ParamSerializer {
  private:
   void WriteHeader();
   model_parser::ByteWriter* writer_{nullptr};
-  uint16_t version_{0};
+  uint16_t version_{kParamsVersion};
+  bool compress_{false};
   std::unique_ptr<model_parser::Buffer> buf_;
 };
 #endif
 
+// The params are materialized in parallel while the following ones are being
+// read, at most 'max_inflight_bytes' of the read params wait for it.
+constexpr size_t kMaxInflightParamBytes = 256 * 1024 * 1024;
+
 class ParamDeserializer {
  public:
-  explicit ParamDeserializer(model_parser::ByteReader* reader)
-      : reader_(reader), buf_(new model_parser::Buffer) {
+  explicit ParamDeserializer(
+      model_parser::ByteReader* reader,
+      size_t max_inflight_bytes = kMaxInflightParamBytes)
+      : reader_(reader),
+        max_inflight_bytes_(max_inflight_bytes),
+        buf_(new model_parser::Buffer) {
     CHECK(reader_)
         << "A valid reader should be passed in the ctor of param deserializer.";
     ReadHeader();
   }
   void ForwardRead(lite::Scope* scope);
 
+  // The params in 'names' are not materialized by ForwardRead, they are
+  // registered into 'lazy_params' and read from 'model_file' on demand.
+  void SetLazyParams(const std::set<std::string>& names,
+                     const std::string& model_file,
+                     const std::shared_ptr<LazyParams>& lazy_params) {
+    lazy_names_ = names;
+    model_file_ = model_file;
+    lazy_params_ = lazy_params;
+  }
+
  private:
   void ReadBytesToBuffer(size_t size) {
     buf_->ResetLazy(size);
@@ -71,7 +99,12 @@ class ParamDeserializer {
   }
   void ReadHeader();
   model_parser::ByteReader* reader_{nullptr};
+  size_t max_inflight_bytes_{kMaxInflightParamBytes};
+  uint16_t version_{kParamsVersion};
   std::unique_ptr<model_parser::Buffer> buf_;
+  std::set<std::string> lazy_names_;
+  std::string model_file_;
+  std::shared_ptr<LazyParams> lazy_params_;
 };
 
 namespace deprecated {
@@ -14,10 +14,12 @@
 
 #include "lite/model_parser/flatbuffers/io.h"
 #include <gtest/gtest.h>
+#include <cstdio>
 #include <functional>
 #include <string>
 #include <utility>
 #include <vector>
+#include "lite/model_parser/flatbuffers/param_codec.h"
 #include "lite/model_parser/model_parser.h"
 
 namespace paddle {
@@ -128,9 +130,110 @@ TEST(CombinedParamsDesc, Scope) {
     deserializer.ForwardRead(&scope_3);
     check_params(scope_3);
   }
+  std::remove(path.c_str());
+}
+
+TEST(CombinedParamsDesc, CompressedStream) {
+  Scope scope;
+  // The sparse weights larger than a block of the codec
+  Tensor* weights = scope.Var("weights")->GetMutable<Tensor>();
+  set_tensor<float>(weights, std::vector<int64_t>({256, 512}));
+  auto* weights_data = weights->mutable_data<float>();
+  for (int64_t i = 0; i < weights->numel(); ++i) {
+    if (i % 3) weights_data[i] = 0.f;
+  }
+  Tensor* bias = scope.Var("bias")->GetMutable<Tensor>();
+  set_tensor<int8_t>(bias, std::vector<int64_t>({3}));
+  std::set<std::string> params_set({"weights", "bias"});
+
+  const std::string raw_path{"io_test.raw_params.fbs"};
+  const std::string path{"io_test.compressed_params.fbs"};
+  {
+    model_parser::BinaryFileWriter raw_writer{raw_path};
+    fbs::ParamSerializer raw_serializer{&raw_writer};
+    raw_serializer.ForwardWrite(scope, params_set);
+    model_parser::BinaryFileWriter writer{path};
+    fbs::ParamSerializer serializer{&writer, true};
+    serializer.ForwardWrite(scope, params_set);
+  }
+
+  Scope loaded_scope;
+  model_parser::BinaryFileReader raw_reader(raw_path);
+  model_parser::BinaryFileReader reader(path);
+  ASSERT_LT(reader.length(), raw_reader.length());
+  fbs::ParamDeserializer deserializer(&reader);
+  deserializer.ForwardRead(&loaded_scope);
+  for (const auto& name : params_set) {
+    const Tensor& tensor = loaded_scope.FindVar(name)->Get<Tensor>();
+    ASSERT_TRUE(tensor.persistable());
+    ASSERT_TRUE(TensorCompareWith(scope.FindVar(name)->Get<Tensor>(), tensor));
+  }
+  std::remove(raw_path.c_str());
+  std::remove(path.c_str());
+}
+
+TEST(CombinedParamsDesc, PipelinedStream) {
+  Scope scope;
+  std::vector<std::string> param_names;
+  // The params larger than a copy chunk are split into several tasks.
+  for (int i = 0; i < 4; ++i) {
+    param_names.push_back("var_" + std::to_string(i));
+    Tensor* tensor = scope.Var(param_names.back())->GetMutable<Tensor>();
+    set_tensor<float>(tensor, std::vector<int64_t>({1024 + i, 1024 + i}));
+  }
+  param_names.push_back("small");
+  set_tensor<int8_t>(scope.Var("small")->GetMutable<Tensor>(),
+                     std::vector<int64_t>({5}));
+  std::set<std::string> params_set(param_names.begin(), param_names.end());
+
+  for (bool compress : {false, true}) {
+    const std::string path{"io_test.pipelined_params.fbs"};
+    {
+      model_parser::BinaryFileWriter writer{path};
+      fbs::ParamSerializer serializer{&writer, compress};
+      serializer.ForwardWrite(scope, params_set);
+    }
+    // A tiny budget makes the reader wait for each param.
+    for (size_t max_inflight_bytes : {size_t(1), kMaxInflightParamBytes}) {
+      Scope loaded_scope;
+      model_parser::BinaryFileReader reader(path);
+      fbs::ParamDeserializer deserializer(&reader, max_inflight_bytes);
+      deserializer.ForwardRead(&loaded_scope);
+      for (const auto& name : param_names) {
+        const Tensor& tensor = loaded_scope.FindVar(name)->Get<Tensor>();
+        ASSERT_TRUE(
+            TensorCompareWith(scope.FindVar(name)->Get<Tensor>(), tensor));
+      }
+    }
+    std::remove(path.c_str());
+  }
 }
 #endif  // LITE_WITH_FLATBUFFERS_DESC
 
+TEST(ParamCodec, Roundtrip) {
+  std::vector<int16_t> data(kParamCodecBlockSize);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<int16_t>(i % 7 == 0 ? i : 0);
+  }
+  std::vector<int8_t> compressed;
+  ASSERT_TRUE(CompressParamData(data.data(),
+                                data.size() * sizeof(int16_t),
+                                sizeof(int16_t),
+                                &compressed));
+  ParamDataDecoder decoder(compressed.data(), compressed.size());
+  ASSERT_EQ(decoder.raw_size(), data.size() * sizeof(int16_t));
+  ASSERT_EQ(decoder.num_blocks(), 2u);
+  std::vector<int16_t> decoded(data.size());
+  ParallelRun(decoder.num_blocks(), [&](size_t idx) {
+    decoder.DecodeBlock(idx, decoded.data());
+  });
+  ASSERT_EQ(decoded, data);
+
+  // The incompressible data is kept as it is.
+  std::vector<int8_t> single(1, 1);
+  ASSERT_FALSE(CompressParamData(single.data(), 1, 1, &compressed));
+}
+
 }  // namespace fbs
 }  // namespace lite
 }  // namespace paddle
@@ -0,0 +1,509 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/model_parser/flatbuffers/param_codec.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace fbs {
+
+namespace {
+
+constexpr uint8_t kCodecVersion = 1;
+// version(1) + element size(1) + block size(4) + raw size(8) + blocks(4)
+constexpr size_t kHeaderSize = 18;
+
+enum PlaneMode : uint8_t {
+  kRawPlane = 0,
+  kLZPlane = 1,
+  kRansPlane = 2,
+};
+
+template <typename T>
+void Append(std::vector<uint8_t>* out, T value) {
+  for (size_t i = 0; i < sizeof(T); i++) {
+    out->push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+template <typename T>
+T Load(const uint8_t* ptr) {
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); i++) {
+    value |= static_cast<T>(ptr[i]) << (8 * i);
+  }
+  return value;
+}
+
+/* ---------- LZ ----------
+ * A sequence is a token, the literals and a match, the high 4 bits of the
+ * token is the literal length and the low 4 bits is the match length minus
+ * kMinMatch, 15 means the length is continued by the following bytes. The
+ * match is a 2 bytes offset, the last sequence only has literals.
+ */
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashBits = 14;
+
+void LZWriteLength(size_t length, std::vector<uint8_t>* out) {
+  while (length >= 255) {
+    out->push_back(255);
+    length -= 255;
+  }
+  out->push_back(static_cast<uint8_t>(length));
+}
+
+size_t LZReadLength(const uint8_t** ip, const uint8_t* iend) {
+  size_t length = 0;
+  uint8_t byte = 255;
+  while (byte == 255) {
+    CHECK_LT(*ip, iend) << "Corrupted LZ param data.";
+    byte = *(*ip)++;
+    length += byte;
+  }
+  return length;
+}
+
+void LZEncode(const uint8_t* src, size_t size, std::vector<uint8_t>* out) {
+  std::vector<int64_t> table(1 << kHashBits, -1);
+  size_t anchor = 0;
+  auto emit = [&](size_t literals, size_t match, size_t offset) {
+    uint8_t token = static_cast<uint8_t>(std::min<size_t>(literals, 15) << 4);
+    if (match > 0) {
+      token |= static_cast<uint8_t>(std::min<size_t>(match - kMinMatch, 15));
+    }
+    out->push_back(token);
+    if (literals >= 15) LZWriteLength(literals - 15, out);
+    out->insert(out->end(), src + anchor, src + anchor + literals);
+    if (match > 0) {
+      Append<uint16_t>(out, static_cast<uint16_t>(offset));
+      if (match - kMinMatch >= 15) LZWriteLength(match - kMinMatch - 15, out);
+    }
+  };
+  size_t i = 0;
+  while (i + kMinMatch <= size) {
+    uint32_t seq = Load<uint32_t>(src + i);
+    uint32_t hash = (seq * 2654435761u) >> (32 - kHashBits);
+    int64_t candidate = table[hash];
+    table[hash] = static_cast<int64_t>(i);
+    if (candidate >= 0 && i - candidate <= kMaxOffset &&
+        Load<uint32_t>(src + candidate) == seq) {
+      size_t match = kMinMatch;
+      while (i + match < size && src[candidate + match] == src[i + match]) {
+        match++;
+      }
+      emit(i - anchor, match, i - candidate);
+      i += match;
+      anchor = i;
+    } else {
+      i++;
+    }
+  }
+  emit(size - anchor, 0, 0);
+}
+
+void LZDecode(const uint8_t* src, size_t size, uint8_t* dst, size_t dst_size) {
+  const uint8_t* ip = src;
+  const uint8_t* iend = src + size;
+  uint8_t* op = dst;
+  uint8_t* oend = dst + dst_size;
+  while (true) {
+    CHECK_LT(ip, iend) << "Corrupted LZ param data.";
+    uint8_t token = *ip++;
+    size_t literals = token >> 4;
+    if (literals == 15) literals += LZReadLength(&ip, iend);
+    CHECK(literals <= static_cast<size_t>(iend - ip) &&
+          literals <= static_cast<size_t>(oend - op))
+        << "Corrupted LZ param data.";
+    std::memcpy(op, ip, literals);
+    op += literals;
+    ip += literals;
+    if (ip == iend) break;
+    CHECK_GE(iend - ip, 2) << "Corrupted LZ param data.";
+    size_t offset = Load<uint16_t>(ip);
+    ip += 2;
+    size_t match = (token & 15) + kMinMatch;
+    if ((token & 15) == 15) match += LZReadLength(&ip, iend);
+    CHECK(offset > 0 && offset <= static_cast<size_t>(op - dst) &&
+          match <= static_cast<size_t>(oend - op))
+        << "Corrupted LZ param data.";
+    const uint8_t* ref = op - offset;
+    if (offset >= match) {
+      std::memcpy(op, ref, match);
+    } else {
+      // The match overlaps with the output, e.g. a run of the same byte.
+      for (size_t k = 0; k < match; k++) op[k] = ref[k];
+    }
+    op += match;
+  }
+  CHECK(op == oend) << "Corrupted LZ param data.";
+}
+
+/* ---------- rANS ----------
+ * Order-0 byte-wise rANS, the normalized frequencies (256 x uint16) are
+ * followed by the initial state (uint32) and the renormalization bytes.
+ */
+constexpr uint32_t kProbBits = 12;
+constexpr uint32_t kProbScale = 1u << kProbBits;
+constexpr uint32_t kRansL = 1u << 23;
+
+void NormalizeFrequencies(const uint8_t* src, size_t size, uint32_t* freqs) {
+  uint64_t counts[256] = {0};
+  for (size_t i = 0; i < size; i++) counts[src[i]]++;
+  uint32_t total = 0;
+  int max_symbol = 0;
+  for (int s = 0; s < 256; s++) {
+    freqs[s] = 0;
+    if (counts[s] == 0) continue;
+    freqs[s] = std::max<uint32_t>(
+        1, static_cast<uint32_t>(counts[s] * kProbScale / size));
+    total += freqs[s];
+    if (counts[s] > counts[max_symbol]) max_symbol = s;
+  }
+  if (total < kProbScale) {
+    freqs[max_symbol] += kProbScale - total;
+  }
+  // The rare symbols are rounded up to 1, take them back from the most
+  // frequent ones.
+  while (total > kProbScale) {
+    int largest = 0;
+    for (int s = 1; s < 256; s++) {
+      if (freqs[s] > freqs[largest]) largest = s;
+    }
+    CHECK_GT(freqs[largest], 1u);
+    freqs[largest]--;
+    total--;
+  }
+}
+
+void RansEncode(const uint8_t* src, size_t size, std::vector<uint8_t>* out) {
+  uint32_t freqs[256];
+  uint32_t starts[256];
+  NormalizeFrequencies(src, size, freqs);
+  uint32_t start = 0;
+  for (int s = 0; s < 256; s++) {
+    starts[s] = start;
+    start += freqs[s];
+    Append<uint16_t>(out, static_cast<uint16_t>(freqs[s]));
+  }
+  // At most kProbBits bits are emitted for each symbol.
+  std::vector<uint8_t> buffer(size * 2 + 8);
+  uint8_t* end = buffer.data() + buffer.size();
+  uint8_t* ptr = end;
+  uint32_t x = kRansL;
+  for (size_t i = size; i > 0; i--) {
+    uint8_t s = src[i - 1];
+    uint32_t freq = freqs[s];
+    uint32_t x_max = ((kRansL >> kProbBits) << 8) * freq;
+    while (x >= x_max) {
+      *--ptr = static_cast<uint8_t>(x & 0xff);
+      x >>= 8;
+    }
+    x = ((x / freq) << kProbBits) + (x % freq) + starts[s];
+  }
+  ptr -= 4;
+  for (int i = 0; i < 4; i++) ptr[i] = static_cast<uint8_t>(x >> (8 * i));
+  out->insert(out->end(), ptr, end);
+}
+
+void RansDecode(const uint8_t* src,
+                size_t size,
+                uint8_t* dst,
+                size_t dst_size) {
+  CHECK_GE(size, 256 * sizeof(uint16_t) + 4) << "Corrupted rANS param data.";
+  uint32_t freqs[256];
+  uint32_t starts[256];
+  std::vector<uint8_t> cum2sym(kProbScale);
+  uint32_t start = 0;
+  for (int s = 0; s < 256; s++) {
+    freqs[s] = Load<uint16_t>(src + s * sizeof(uint16_t));
+    starts[s] = start;
+    CHECK_LE(start + freqs[s], kProbScale) << "Corrupted rANS param data.";
+    std::fill(cum2sym.begin() + start,
+              cum2sym.begin() + start + freqs[s],
+              static_cast<uint8_t>(s));
+    start += freqs[s];
+  }
+  CHECK_EQ(start, kProbScale) << "Corrupted rANS param data.";
+  const uint8_t* ip = src + 256 * sizeof(uint16_t);
+  const uint8_t* iend = src + size;
+  uint32_t x = Load<uint32_t>(ip);
+  ip += 4;
+  for (size_t i = 0; i < dst_size; i++) {
+    uint32_t slot = x & (kProbScale - 1);
+    uint8_t s = cum2sym[slot];
+    dst[i] = s;
+    x = freqs[s] * (x >> kProbBits) + slot - starts[s];
+    while (x < kRansL) {
+      CHECK_LT(ip, iend) << "Corrupted rANS param data.";
+      x = (x << 8) | *ip++;
+    }
+  }
+}
+
+void EncodeBlock(const uint8_t* src,
+                 size_t num_elements,
+                 size_t element_size,
+                 std::vector<uint8_t>* out) {
+  std::vector<uint8_t> plane(num_elements);
+  std::vector<uint8_t> lz;
+  std::vector<uint8_t> rans;
+  for (size_t p = 0; p < element_size; p++) {
+    for (size_t i = 0; i < num_elements; i++) {
+      plane[i] = src[i * element_size + p];
+    }
+    lz.clear();
+    rans.clear();
+    LZEncode(plane.data(), num_elements, &lz);
+    RansEncode(plane.data(), num_elements, &rans);
+    const std::vector<uint8_t>* best = &plane;
+    uint8_t mode = kRawPlane;
+    if (lz.size() < best->size()) {
+      best = &lz;
+      mode = kLZPlane;
+    }
+    if (rans.size() < best->size()) {
+      best = &rans;
+      mode = kRansPlane;
+    }
+    out->push_back(mode);
+    Append<uint32_t>(out, static_cast<uint32_t>(best->size()));
+    out->insert(out->end(), best->begin(), best->end());
+  }
+}
+
+}  // namespace
+
+bool CompressParamData(const void* src,
+                       size_t size,
+                       size_t element_size,
+                       std::vector<int8_t>* dst) {
+  CHECK(src);
+  CHECK(dst);
+  CHECK_GT(element_size, 0u);
+  CHECK_EQ(size % element_size, 0u)
+      << "The byte size of param must be a multiple of the element size.";
+  if (size == 0) return false;
+  const size_t block_elements =
+      std::max<size_t>(1, kParamCodecBlockSize / element_size);
+  const size_t block_size = block_elements * element_size;
+  const size_t num_blocks = (size + block_size - 1) / block_size;
+
+  std::vector<std::vector<uint8_t>> blocks(num_blocks);
+  const uint8_t* data = static_cast<const uint8_t*>(src);
+  ParallelRun(num_blocks, [&](size_t idx) {
+    size_t begin = idx * block_size;
+    size_t bytes = std::min(block_size, size - begin);
+    EncodeBlock(data + begin, bytes / element_size, element_size, &blocks[idx]);
+  });
+
+  std::vector<uint8_t> out;
+  out.push_back(kCodecVersion);
+  out.push_back(static_cast<uint8_t>(element_size));
+  Append<uint32_t>(&out, static_cast<uint32_t>(block_size));
+  Append<uint64_t>(&out, static_cast<uint64_t>(size));
+  Append<uint32_t>(&out, static_cast<uint32_t>(num_blocks));
+  uint64_t offset = 0;
+  for (auto& block : blocks) {
+    offset += block.size();
+    CHECK_LT(offset, (std::numeric_limits<uint32_t>::max)());
+    Append<uint32_t>(&out, static_cast<uint32_t>(offset));
+  }
+  for (auto& block : blocks) {
+    out.insert(out.end(), block.begin(), block.end());
+  }
+  if (out.size() >= size) return false;
+  dst->assign(out.begin(), out.end());
+  return true;
+}
+
+ParamDataDecoder::ParamDataDecoder(const void* src, size_t size) {
+  CHECK(src);
+  CHECK_GE(size, kHeaderSize) << "Corrupted compressed param data.";
+  const uint8_t* data = static_cast<const uint8_t*>(src);
+  CHECK_EQ(data[0], kCodecVersion)
+      << "Unsupported param codec version " << static_cast<int>(data[0]);
+  element_size_ = data[1];
+  block_size_ = Load<uint32_t>(data + 2);
+  raw_size_ = Load<uint64_t>(data + 6);
+  uint32_t num_blocks = Load<uint32_t>(data + 14);
+  CHECK(element_size_ > 0 && block_size_ > 0 &&
+        block_size_ % element_size_ == 0 && raw_size_ % element_size_ == 0)
+      << "Corrupted compressed param data.";
+  CHECK_EQ(num_blocks, (raw_size_ + block_size_ - 1) / block_size_)
+      << "Corrupted compressed param data.";
+  size_t index_size = num_blocks * sizeof(uint32_t);
+  CHECK_GE(size, kHeaderSize + index_size)
+      << "Corrupted compressed param data.";
+  block_offsets_.resize(num_blocks + 1, 0);
+  for (uint32_t i = 0; i < num_blocks; i++) {
+    block_offsets_[i + 1] =
+        Load<uint32_t>(data + kHeaderSize + i * sizeof(uint32_t));
+    CHECK_GE(block_offsets_[i + 1], block_offsets_[i]);
+  }
+  blocks_ = data + kHeaderSize + index_size;
+  CHECK_LE(block_offsets_.back(), size - kHeaderSize - index_size)
+      << "Corrupted compressed param data.";
+}
+
+void ParamDataDecoder::DecodeBlock(size_t idx, void* dst) const {
+  CHECK_LT(idx, num_blocks());
+  const uint8_t* ip = blocks_ + block_offsets_[idx];
+  const uint8_t* iend = blocks_ + block_offsets_[idx + 1];
+  size_t begin = idx * block_size_;
+  size_t num_elements =
+      std::min(block_size_, raw_size_ - begin) / element_size_;
+  uint8_t* out = static_cast<uint8_t*>(dst) + begin;
+  std::vector<uint8_t> plane(element_size_ > 1 ? num_elements : 0);
+  for (size_t p = 0; p < element_size_; p++) {
+    CHECK_GE(iend - ip, 5) << "Corrupted compressed param data.";
+    uint8_t mode = ip[0];
+    size_t plane_size = Load<uint32_t>(ip + 1);
+    ip += 5;
+    CHECK_LE(plane_size, static_cast<size_t>(iend - ip))
+        << "Corrupted compressed param data.";
+    // The single plane of the 1-byte elements is decoded in place.
+    uint8_t* plane_data = element_size_ > 1 ? plane.data() : out;
+    switch (mode) {
+      case kRawPlane:
+        CHECK_EQ(plane_size, num_elements);
+        std::memcpy(plane_data, ip, num_elements);
+        break;
+      case kLZPlane:
+        LZDecode(ip, plane_size, plane_data, num_elements);
+        break;
+      case kRansPlane:
+        RansDecode(ip, plane_size, plane_data, num_elements);
+        break;
+      default:
+        LOG(FATAL) << "Unknown plane mode " << static_cast<int>(mode);
+    }
+    ip += plane_size;
+    if (element_size_ > 1) {
+      for (size_t i = 0; i < num_elements; i++) {
+        out[i * element_size_ + p] = plane_data[i];
+      }
+    }
+  }
+}
+
+void ParamDataDecoder::Decode(void* dst) const {
+  for (size_t i = 0; i < num_blocks(); i++) {
+    DecodeBlock(i, dst);
+  }
+}
+
+ParamWorkerPool& ParamWorkerPool::Global() {
+  static ParamWorkerPool pool(
+      static_cast<int>(std::thread::hardware_concurrency()) - 1);
+  return pool;
+}
+
+ParamWorkerPool::ParamWorkerPool(int num_workers) {
+  for (int i = 0; i < num_workers; i++) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+ParamWorkerPool::~ParamWorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ParamWorkerPool::Submit(std::function<void()>&& task) {
+  if (workers_.empty()) {
+    task();
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void ParamWorkerPool::WorkerLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) return;
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    task();
+  }
+}
+
+void ParallelRun(size_t num_tasks,
+                 const std::function<void(size_t)>& func,
+                 int num_threads) {
+  auto& pool = ParamWorkerPool::Global();
+  int helpers = pool.num_workers();
+  if (num_threads > 0) helpers = std::min(helpers, num_threads - 1);
+  helpers = static_cast<int>(std::min<size_t>(
+      std::max(helpers, 0), num_tasks > 0 ? num_tasks - 1 : 0));
+  if (helpers == 0) {
+    for (size_t i = 0; i < num_tasks; i++) func(i);
+    return;
+  }
+  // The helpers which haven't started when the calling thread runs out of
+  // tasks are skipped, so it never waits for the busy workers.
+  struct State {
+    std::atomic<size_t> next{0};
+    int running{0};
+    bool closed{false};
+    std::mutex mutex;
+    std::condition_variable cv;
+  };
+  std::shared_ptr<State> state(new State);
+  auto run = [state, num_tasks, &func]() {
+    for (size_t i = state->next++; i < num_tasks; i = state->next++) {
+      func(i);
+    }
+  };
+  for (int i = 0; i < helpers; i++) {
+    pool.Submit([state, run]() {
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->closed) return;
+        state->running++;
+      }
+      run();
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (--state->running == 0) state->cv.notify_all();
+    });
+  }
+  run();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->closed = true;
+  state->cv.wait(lock, [&] { return state->running == 0; });
+}
+
+}  // namespace fbs
+}  // namespace lite
+}  // namespace paddle
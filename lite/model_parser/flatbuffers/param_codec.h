@@ -0,0 +1,114 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>  // NOLINT
+#include <queue>
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace fbs {
+
+/*
+ * The lossless codec of the param data, which is stored in the 'data' field of
+ * LoDTensorDesc with compress_type = BYTE_SHUFFLE.
+ *
+ * The data is split into blocks of kParamCodecBlockSize bytes, which are
+ * encoded and decoded independently. In a block, the i-th bytes of all of the
+ * elements are gathered into the i-th byte plane, the sign and exponent
+ * planes of fp32 weights are highly redundant while the mantissa planes are
+ * nearly random. Each plane is stored raw, LZ compressed or rANS (order-0
+ * entropy) compressed, whichever is the smallest.
+ *
+ * Layout (little-endian):
+ *   uint8  codec version
+ *   uint8  element size
+ *   uint32 block size
+ *   uint64 raw size
+ *   uint32 number of blocks
+ *   uint32 end offsets of the blocks, relative to the first block
+ *   blocks, each block has 'element size' planes:
+ *     uint8  plane mode (raw, LZ or rANS)
+ *     uint32 plane size
+ *     plane data
+ */
+constexpr size_t kParamCodecBlockSize = 256 * 1024;
+
+// Compress 'size' bytes of 'src' whose element size is 'element_size' into
+// 'dst', return false if the compressed data isn't smaller than 'src'.
+bool CompressParamData(const void* src,
+                       size_t size,
+                       size_t element_size,
+                       std::vector<int8_t>* dst);
+
+// Decode the compressed param data, the blocks can be decoded concurrently.
+class ParamDataDecoder {
+ public:
+  ParamDataDecoder(const void* src, size_t size);
+
+  size_t raw_size() const { return raw_size_; }
+  size_t num_blocks() const { return block_offsets_.size() - 1; }
+
+  // Decode the idx-th block into 'dst', which holds raw_size() bytes.
+  void DecodeBlock(size_t idx, void* dst) const;
+  // Decode all of the blocks sequentially.
+  void Decode(void* dst) const;
+
+ private:
+  const uint8_t* blocks_{nullptr};
+  size_t element_size_{1};
+  size_t block_size_{kParamCodecBlockSize};
+  size_t raw_size_{0};
+  std::vector<uint32_t> block_offsets_;
+};
+
+// The persistent workers of the param encoding and loading, which are created
+// once on the first use, instead of the threads of each load.
+class ParamWorkerPool {
+ public:
+  static ParamWorkerPool& Global();
+  ~ParamWorkerPool();
+
+  int num_workers() const { return static_cast<int>(workers_.size()); }
+  // Run 'task' on a worker, or on the calling thread if there is no worker.
+  void Submit(std::function<void()>&& task);
+
+ private:
+  explicit ParamWorkerPool(int num_workers);
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_{false};
+};
+
+// Run func(0) ~ func(num_tasks - 1) on the calling thread and at most
+// 'num_threads' - 1 workers of ParamWorkerPool, all of the workers are used if
+// 'num_threads' is not positive.
+void ParallelRun(size_t num_tasks,
+                 const std::function<void(size_t)>& func,
+                 int num_threads = 0);
+
+}  // namespace fbs
+}  // namespace lite
+}  // namespace paddle
@@ -75,6 +75,13 @@ class ParamDescView : public ParamDescReadAPI {
 
   size_t byte_size() const override { return tensor_desc_->data()->size(); }
 
+  // The data is encoded by CompressParamData if it's not NONE, and
+  // raw_size() is the byte size of the decoded data.
+  proto::ParamDesc_::CompressType compress_type() const {
+    return tensor_desc_->compress_type();
+  }
+  uint64_t raw_size() const { return tensor_desc_->raw_size(); }
+
   ParamDescView() = default;
 
  private:
@@ -167,6 +174,14 @@ class ParamDesc : public ParamDescAPI {
     model_parser::memcpy(lod_tensor_->data.data(), data, byte_size);
   }
 
+  void SetCompressedData(std::vector<int8_t>&& data,
+                         proto::ParamDesc_::CompressType compress_type,
+                         uint64_t raw_size) {
+    lod_tensor_->data = std::move(data);
+    lod_tensor_->compress_type = compress_type;
+    lod_tensor_->raw_size = raw_size;
+  }
+
   const proto::ParamDescT* raw_desc() const { return desc_; }
 
   void CopyDataToBuffer(model_parser::Buffer* buffer) {
@@ -20,12 +20,14 @@
 #include <utility>
 
 #include "lite/api/paddle_api.h"
+#include "lite/core/lazy_params.h"
 #include "lite/core/model/base/apis.h"
 #include "lite/core/scope.h"
 #include "lite/core/tensor.h"
 #include "lite/core/variable.h"
 #include "lite/core/version.h"
 #include "lite/model_parser/flatbuffers/io.h"
+#include "lite/model_parser/flatbuffers/param_codec.h"
 #include "lite/model_parser/pb/tensor_io.h"
 #ifndef LITE_ON_TINY_PUBLISH
 #include <cstdio>
@@ -498,7 +500,8 @@ void AppendToFile(const std::string &filename,
 /* ---------- Flatbuffers ---------- */
 void SaveModelNaive(const std::string &model_file,
                     const Scope &exec_scope,
-                    const cpp::ProgramDesc &cpp_prog) {
+                    const cpp::ProgramDesc &cpp_prog,
+                    bool compress_weights) {
   model_parser::Buffer buffer;
   /* 1. Save model to model.fbs */
   const std::string prog_path = model_file + ".nb";
@@ -555,7 +558,7 @@ void SaveModelNaive(const std::string &model_file,
       break;
     }
     case 2: {
-      fbs::ParamSerializer serializer{&writer};
+      fbs::ParamSerializer serializer{&writer, compress_weights};
       // 3.2 Save params into naive model
       serializer.ForwardWrite(exec_scope, unique_var_names);
       break;
@@ -579,16 +582,9 @@ void SetTensorDataNaive(T *out, size_t size, const std::vector<T> &src) {
   }
 }
 
-void GetParamInfoNaive(const naive_buffer::ParamDesc &desc,
-                       lite::Scope *scope,
-                       const std::string &name) {
-  CHECK(scope);
-  CHECK_EQ(desc.Name(), name)
-      << "Var name not equal: ParamDesc.name=" << desc.Name()
-      << "vs filename=" << name;
-
-  auto *tensor = scope->Var(name)->GetMutable<lite::Tensor>();
-
+void SetTensorWithParamNaive(const naive_buffer::ParamDesc &desc,
+                             lite::Tensor *tensor) {
+  CHECK(tensor);
   VLOG(3) << "model version " << desc.ModelVersion();
   CHECK_EQ(desc.TensorVersion(), 0U) << "Only version 0 is supported";
 
@@ -624,6 +620,16 @@ void GetParamInfoNaive(const naive_buffer::ParamDesc &desc,
   tensor->set_persistable(true);
 }
 
+void GetParamInfoNaive(const naive_buffer::ParamDesc &desc,
+                       lite::Scope *scope,
+                       const std::string &name) {
+  CHECK(scope);
+  CHECK_EQ(desc.Name(), name)
+      << "Var name not equal: ParamDesc.name=" << desc.Name()
+      << "vs filename=" << name;
+  SetTensorWithParamNaive(desc, scope->Var(name)->GetMutable<lite::Tensor>());
+}
+
 void LoadParamNaive(const std::string &path,
                     lite::Scope *scope,
                     const std::string &name) {
@@ -651,12 +657,20 @@ void LoadCombinedParamsNaive(const std::string &path,
   pt_desc.Load();
   naive_buffer::CombinedParamsDesc desc(&pt_desc);
 
+  // The tensors are created in the scope sequentially, then their data are
+  // filled in parallel.
   std::set<std::string> param_names;
+  std::vector<naive_buffer::ParamDesc> param_descs;
+  std::vector<lite::Tensor *> tensors;
   for (size_t i = 0; i < desc.ParamsSize(); ++i) {
-    naive_buffer::ParamDesc param_desc(desc.GetParam(i));
-    GetParamInfoNaive(param_desc, scope, param_desc.Name());
-    param_names.insert(param_desc.Name());
+    param_descs.emplace_back(desc.GetParam(i));
+    const std::string name = param_descs.back().Name();
+    tensors.push_back(scope->Var(name)->GetMutable<lite::Tensor>());
+    param_names.insert(name);
   }
+  fbs::ParallelRun(param_descs.size(), [&](size_t idx) {
+    SetTensorWithParamNaive(param_descs[idx], tensors[idx]);
+  });
 
   // Check all params loaded
   auto &prog = cpp_prog;
@@ -773,7 +787,8 @@ void LoadModelNaiveFromMemory(const std::string &model_buffer,
 
 void LoadModelNaiveFromFile(const std::string &filename,
                             Scope *scope,
-                            cpp::ProgramDesc *cpp_prog) {
+                            cpp::ProgramDesc *cpp_prog,
+                            bool lazy_sub_block_params) {
   CHECK(cpp_prog);
   CHECK(scope);
   // ModelFile
@@ -800,7 +815,11 @@ void LoadModelNaiveFromFile(const std::string &filename,
       LoadModelFbsFromFile(&reader, scope, cpp_prog, 1);
       break;
     case 2:
-      LoadModelFbsFromFile(&reader, scope, cpp_prog, 2);
+      LoadModelFbsFromFile(&reader,
+                           scope,
+                           cpp_prog,
+                           2,
+                           lazy_sub_block_params ? filename : std::string());
       break;
     default:
       LOG(FATAL) << "The model format cannot be recognized. Please make sure "
@@ -868,7 +887,8 @@ void LoadModelNaiveV0FromFile(const std::string &filename,
 void LoadModelFbsFromFile(model_parser::BinaryFileReader *reader,
                           Scope *scope,
                           cpp::ProgramDesc *cpp_prog,
-                          uint16_t meta_version) {
+                          uint16_t meta_version,
+                          const std::string &lazy_params_file) {
   CHECK(cpp_prog);
   CHECK(scope);
   CHECK_EQ(cpp_prog->BlocksSize(), 0);
@@ -921,7 +941,16 @@ void LoadModelFbsFromFile(model_parser::BinaryFileReader *reader,
     case 2: {
       /* load scope from param.fbs with meta_version=2 */
       fbs::ParamDeserializer deserializer(reader);
+      std::shared_ptr<LazyParams> lazy_params;
+      if (!lazy_params_file.empty()) {
+        lazy_params = std::make_shared<LazyParams>();
+        deserializer.SetLazyParams(
+            GetLazyParamNames(*cpp_prog), lazy_params_file, lazy_params);
+      }
       deserializer.ForwardRead(scope);
+      if (lazy_params && !lazy_params->empty()) {
+        LazyParams::Set(scope, lazy_params);
+      }
       break;
     }
     default:
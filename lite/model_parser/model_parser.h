@@ -98,9 +98,12 @@ void SaveCombinedParamsNaive(const std::string& path,
                              const lite::Scope& exec_scope,
                              const cpp::ProgramDesc& cpp_prog);
 
+// The params are compressed losslessly if compress_weights is true, which
+// needs the runtime supporting the params of version 1.
 void SaveModelNaive(const std::string& model_dir,
                     const Scope& exec_scope,
-                    const cpp::ProgramDesc& cpp_prog);
+                    const cpp::ProgramDesc& cpp_prog,
+                    bool compress_weights = false);
 
 void SaveModelFbs(const std::string& model_dir,
                   const Scope& exec_scope,
@@ -139,14 +142,18 @@ void LoadNonCombinedParamsPb(const std::string& model_dir,
                              const lite_api::CxxModelBuffer& model_buffer,
                              Scope* scope);
 #endif  // LITE_ON_TINY_PUBLISH
+// If lazy_params_file is not empty, the params which are only used by the
+// sub-blocks are registered as LazyParams and read from it on demand.
 void LoadModelFbsFromFile(model_parser::BinaryFileReader* reader,
                           Scope* scope,
                           cpp::ProgramDesc* cpp_prog,
-                          uint16_t meta_version);
+                          uint16_t meta_version,
+                          const std::string& lazy_params_file = "");
 
 void LoadModelNaiveFromFile(const std::string& filename,
                             lite::Scope* scope,
-                            cpp::ProgramDesc* prog);
+                            cpp::ProgramDesc* prog,
+                            bool lazy_sub_block_params = false);
 
 void LoadModelNaiveFromMemory(const std::string& model_buffer,
                               lite::Scope* scope,
@@ -16,6 +16,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "lite/core/autotune.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/scope.h"
@@ -191,6 +192,15 @@ class ConvOpLite : public OpLite {
     if (op_desc.HasAttr("padding_algorithm")) {
       padding_algorithm_ = op_desc.GetAttr<std::string>("padding_algorithm");
     }
+    if (op_desc.HasAttr("sparse_weight_type")) {
+      param_.sparse_weight_type =
+          op_desc.GetAttr<std::string>("sparse_weight_type");
+    }
+    if (op_desc.HasAttr(kAutotuneAlgoAttr) &&
+        op_desc.HasAttr(kAutotuneCpuAttr)) {
+      param_.autotune_algo = op_desc.GetAttr<std::string>(kAutotuneAlgoAttr);
+      param_.autotune_cpu = op_desc.GetAttr<std::string>(kAutotuneCpuAttr);
+    }
     // For Int8
     const OpInfo* op_info = static_cast<const OpInfo*>(&op_desc);
     if (op_info != nullptr && op_info->HasAttr("enable_int8")) {
@@ -118,6 +118,10 @@ bool FcOpLite::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
   } else {
     param_.padding_weights = false;
   }
+  if (op_desc.HasAttr("sparse_weight_type")) {
+    param_.sparse_weight_type =
+        op_desc.GetAttr<std::string>("sparse_weight_type");
+  }
 
   if (param_.activation_type == "prelu") {
     param_.Prelu_mode = op_desc.GetAttr<std::string>("prelu_mode");
@@ -144,6 +148,13 @@ bool FcOpLite::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
     if (op_info->HasOutputScale(out_scale_name, true))
       param_.output_scale = op_info->GetOutputScale(out_scale_name, true)[0];
   }
+  // For the dynamic quantization of post_quant_dynamic_pass
+  if (op_desc.HasAttr("dynamic_quant_int8") &&
+      op_desc.GetAttr<bool>("dynamic_quant_int8")) {
+    param_.dynamic_quant_int8 = true;
+    param_.weight_scale =
+        op_desc.GetAttr<std::vector<float>>(W + "_quant_scale");
+  }
   if (op_desc.HasAttr("op_type")) {
     param_.op_type = op_desc.GetAttr<std::string>("op_type");
   }
@@ -152,6 +152,13 @@ bool MatMulV2OpLite::AttachImpl(const cpp::OpDesc &op_desc,
     if (op_info->HasOutputScale(out_scale_name, true))
       param_.output_scale = op_info->GetOutputScale(out_scale_name, true)[0];
   }
+  // For the dynamic quantization of post_quant_dynamic_pass
+  if (op_desc.HasAttr("dynamic_quant_int8") &&
+      op_desc.GetAttr<bool>("dynamic_quant_int8")) {
+    param_.dynamic_quant_int8 = true;
+    param_.weight_scale =
+        op_desc.GetAttr<std::vector<float>>(Y + "_quant_scale");
+  }
   return true;
 }
 
@@ -58,6 +58,10 @@ class MulOpLite : public OpLite {
     param_.output = var->GetMutable<Tensor>();
     param_.x_num_col_dims = op_desc.GetAttr<int>("x_num_col_dims");
     param_.y_num_col_dims = op_desc.GetAttr<int>("y_num_col_dims");
+    if (op_desc.HasAttr("sparse_weight_type")) {
+      param_.sparse_weight_type =
+          op_desc.GetAttr<std::string>("sparse_weight_type");
+    }
 
     const OpInfo *op_info = static_cast<const OpInfo *>(&op_desc);
     if (op_info != nullptr && op_info->HasAttr("enable_int8")) {
@@ -72,6 +76,13 @@ class MulOpLite : public OpLite {
       if (op_info->HasOutputScale(out_scale_name, true))
         param_.output_scale = op_info->GetOutputScale(out_scale_name, true)[0];
     }
+    // For the dynamic quantization of post_quant_dynamic_pass
+    if (op_desc.HasAttr("dynamic_quant_int8") &&
+        op_desc.GetAttr<bool>("dynamic_quant_int8")) {
+      param_.dynamic_quant_int8 = true;
+      param_.weight_scale =
+          op_desc.GetAttr<std::vector<float>>(W + "_quant_scale");
+    }
     input_tensor_ptrs_cache_.push_back(param_.x);
     input_tensor_ptrs_cache_.push_back(param_.y);
     output_tensor_ptrs_cache_.push_back(param_.output);
@@ -107,6 +107,12 @@ struct FcParam : ParamBase {
       "channel"};  // prelu param, can be "all", "channel" or "element"
   std::string op_type{"mul"};
   float alpha{6.f};
+  // "unstructured", "1x4" or "4x4" if the weights are sparse, only used in x86
+  std::string sparse_weight_type{""};
+  // The int8 weights of post_quant_dynamic_pass run with the activations
+  // quantized per row at runtime, the scales of the weights are weight_scale,
+  // only used in x86
+  bool dynamic_quant_int8{false};
   // for int8
   WITH_INT8_CONFIG
 };
@@ -146,6 +152,12 @@ struct MulParam : ParamBase {
 
   int x_num_col_dims{1};
   int y_num_col_dims{1};
+  // "unstructured", "1x4" or "4x4" if the weights are sparse, only used in x86
+  std::string sparse_weight_type{""};
+  // The int8 weights of post_quant_dynamic_pass run with the activations
+  // quantized per row at runtime, the scales of the weights are weight_scale,
+  // only used in x86
+  bool dynamic_quant_int8{false};
   // for int8
   WITH_INT8_CONFIG
 };
@@ -411,6 +423,13 @@ struct ConvParam : ParamBase {
   // only used in conv_transpose.
   std::vector<int> output_size;
   std::vector<int> output_padding;
+  // "unstructured", "1x4" or "4x4" if the 1x1 filter is sparse, only used in
+  // x86
+  std::string sparse_weight_type{""};
+  // The algorithm tuned on the CPU of 'autotune_cpu', e.g. "winograd", see
+  // lite/core/autotune.h.
+  std::string autotune_algo{""};
+  std::string autotune_cpu{""};
 
 #ifdef LITE_WITH_FPGA
   lite::Tensor* scale{nullptr};
@@ -1389,6 +1408,10 @@ struct MatMulParam : ParamBase {
   bool transpose_X{false};
   bool transpose_Y{false};
   float alpha{1.0f};
+  // The int8 weights of post_quant_dynamic_pass run with the activations
+  // quantized per row at runtime, the scales of the weights are weight_scale,
+  // only used in x86
+  bool dynamic_quant_int8{false};
   WITH_INT8_CONFIG
 };
 
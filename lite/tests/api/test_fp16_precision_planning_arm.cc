@@ -0,0 +1,149 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <vector>
+#include "lite/api/paddle_api.h"
+#include "lite/api/test/lite_api_test_helper.h"
+#include "lite/api/test/test_helper.h"
+#include "lite/tests/api/ILSVRC2012_utility.h"
+#include "lite/utils/log/cp_logging.h"
+
+DEFINE_string(data_dir, "", "data dir");
+DEFINE_int32(iteration, 100, "iteration times to run");
+DEFINE_int32(batch, 1, "batch of image");
+DEFINE_int32(channel, 3, "image channel");
+DEFINE_double(max_accuracy_drop,
+              0.01,
+              "the max top1 accuracy drop of fp16 compared with fp32");
+
+namespace paddle {
+namespace lite {
+
+// Run the model with the given valid places and return the average latency in
+// ms, the outputs are always converted to fp32.
+double RunClassificationModel(
+    const std::vector<lite_api::Place>& valid_places,
+    const std::string& optimized_model,
+    const std::vector<std::vector<float>>& raw_data,
+    const std::vector<int>& input_shape,
+    std::vector<std::vector<float>>* out_rets) {
+  lite_api::CxxConfig cxx_config;
+  cxx_config.set_model_dir(FLAGS_model_dir);
+  cxx_config.set_valid_places(valid_places);
+  auto predictor = lite_api::CreatePaddlePredictor(cxx_config);
+  predictor->SaveOptimizedModel(optimized_model,
+                                paddle::lite_api::LiteModelType::kNaiveBuffer);
+
+  lite_api::MobileConfig mobile_config;
+  mobile_config.set_model_from_file(optimized_model + ".nb");
+  mobile_config.set_threads(FLAGS_threads);
+  mobile_config.set_power_mode(
+      static_cast<lite_api::PowerMode>(FLAGS_power_mode));
+  predictor = lite_api::CreatePaddlePredictor(mobile_config);
+
+  int input_size = 1;
+  for (auto i : input_shape) {
+    input_size *= i;
+  }
+
+  for (int i = 0; i < FLAGS_warmup; ++i) {
+    auto input_tensor = predictor->GetInput(0);
+    input_tensor->Resize(
+        std::vector<int64_t>(input_shape.begin(), input_shape.end()));
+    auto* data = input_tensor->mutable_data<float>();
+    for (int j = 0; j < input_size; j++) {
+      data[j] = 0.f;
+    }
+    predictor->Run();
+  }
+
+  out_rets->clear();
+  out_rets->resize(raw_data.size());
+  double cost_time = 0;
+  for (size_t i = 0; i < raw_data.size(); ++i) {
+    auto input_tensor = predictor->GetInput(0);
+    input_tensor->Resize(
+        std::vector<int64_t>(input_shape.begin(), input_shape.end()));
+    auto* data = input_tensor->mutable_data<float>();
+    memcpy(data, raw_data[i].data(), sizeof(float) * input_size);
+
+    double start = GetCurrentUS();
+    predictor->Run();
+    cost_time += GetCurrentUS() - start;
+
+    auto output_tensor = predictor->GetOutput(0);
+    auto output_shape = output_tensor->shape();
+    int64_t output_size = 1;
+    for (auto dim : output_shape) {
+      output_size *= dim;
+    }
+    (*out_rets)[i].resize(output_size);
+    if (output_tensor->precision() == PRECISION(kFP16)) {
+      auto* output_data = output_tensor->data<__fp16>();
+      for (int64_t j = 0; j < output_size; j++) {
+        (*out_rets)[i][j] = static_cast<float>(output_data[j]);
+      }
+    } else {
+      memcpy(&((*out_rets)[i].at(0)),
+             output_tensor->data<float>(),
+             sizeof(float) * output_size);
+    }
+  }
+  return cost_time / raw_data.size() / 1000.0;
+}
+
+TEST(FP16PrecisionPlanning, test_fp16_precision_planning_arm) {
+  std::string raw_data_dir = FLAGS_data_dir + std::string("/raw_data");
+  std::vector<int> input_shape{
+      FLAGS_batch, FLAGS_channel, FLAGS_im_width, FLAGS_im_height};
+  auto raw_data = ReadRawData(raw_data_dir, input_shape, FLAGS_iteration);
+  std::string labels_dir = FLAGS_data_dir + std::string("/labels.txt");
+
+  std::vector<std::vector<float>> fp32_out_rets;
+  double fp32_latency = RunClassificationModel(
+      {lite_api::Place{TARGET(kARM), PRECISION(kFloat)}},
+      FLAGS_model_dir + "_fp32",
+      raw_data,
+      input_shape,
+      &fp32_out_rets);
+  float fp32_accuracy = CalOutAccuracy(fp32_out_rets, labels_dir);
+
+  // fp16_precision_planning_pass is enabled by the fp16 place
+  std::vector<std::vector<float>> fp16_out_rets;
+  double fp16_latency = RunClassificationModel(
+      {lite_api::Place{TARGET(kARM), PRECISION(kFP16)},
+       lite_api::Place{TARGET(kARM), PRECISION(kFloat)}},
+      FLAGS_model_dir + "_fp16",
+      raw_data,
+      input_shape,
+      &fp16_out_rets);
+  float fp16_accuracy = CalOutAccuracy(fp16_out_rets, labels_dir);
+
+  LOG(INFO) << "================== Speed Report ===================";
+  LOG(INFO) << "Model: " << FLAGS_model_dir << ", threads num " << FLAGS_threads
+            << ", warmup: " << FLAGS_warmup << ", batch: " << FLAGS_batch
+            << ", iteration: " << FLAGS_iteration;
+  LOG(INFO) << "fp32: " << fp32_latency << " ms in average, top1 accuracy "
+            << fp32_accuracy;
+  LOG(INFO) << "fp16: " << fp16_latency << " ms in average, top1 accuracy "
+            << fp16_accuracy;
+  LOG(INFO) << "speedup: " << fp32_latency / fp16_latency;
+
+  ASSERT_GE(fp16_accuracy, fp32_accuracy - FLAGS_max_accuracy_drop);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -43,6 +43,7 @@ TEST(InceptionV4, test_inception_v4_fp32_arm) {
   paddle::lite_api::MobileConfig mobile_config;
   mobile_config.set_model_from_file(FLAGS_model_dir + ".nb");
   mobile_config.set_threads(FLAGS_threads);
+  mobile_config.set_inter_op_threads(FLAGS_inter_op_threads);
   mobile_config.set_power_mode(
       static_cast<lite_api::PowerMode>(FLAGS_power_mode));
   predictor = paddle::lite_api::CreatePaddlePredictor(mobile_config);
@@ -96,6 +97,7 @@ TEST(InceptionV4, test_inception_v4_fp32_arm) {
 
   LOG(INFO) << "================== Speed Report ===================";
   LOG(INFO) << "Model: " << FLAGS_model_dir << ", threads num " << FLAGS_threads
+            << ", inter_op_threads " << FLAGS_inter_op_threads
             << ", warmup: " << FLAGS_warmup << ", batch: " << FLAGS_batch
             << ", iteration: " << FLAGS_iteration << ", spend "
             << cost_time / FLAGS_iteration / 1000.0 << " ms in average.";
@@ -0,0 +1,186 @@
+# Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Generate latency_lookup_table.txt of the x86 ops in ops_x86.txt."""
+from __future__ import print_function
+import os
+import sys
+import re
+import argparse
+import platform
+import subprocess
+
+
+def get_args():
+    """Get arguments.
+
+    Returns:
+        Namespace, arguments.
+    """
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        '--ops_path', default='ops_x86.txt', help='Input ops path.')
+    parser.add_argument(
+        '--latency_lookup_table_path',
+        default='latency_lookup_table_x86.txt',
+        help='Output ops latency path.')
+    parser.add_argument(
+        '--bin_path',
+        default='../../../build.lite.x86/lite/tests/benchmark/get_op_latency_x86',
+        help='Path of get_op_latency_x86.')
+    parser.add_argument('--threads', type=int, default=1, help='Threads.')
+    parser.add_argument(
+        '--first_core',
+        type=int,
+        default=0,
+        help='Pin the threads from this core, -1 to disable.')
+    parser.add_argument(
+        '--warmup_times',
+        type=int,
+        default=10,
+        help='Warm up times of op when estimating latency.')
+    parser.add_argument(
+        '--min_repeats_times',
+        type=int,
+        default=20,
+        help='Minimum running times of op when estimating latency.')
+    parser.add_argument(
+        '--max_repeats_times',
+        type=int,
+        default=1000,
+        help='Maximum running times of op when estimating latency.')
+    parser.add_argument(
+        '--max_time_ms',
+        type=float,
+        default=2000.0,
+        help='Maximum measuring time of op in ms.')
+    parser.add_argument(
+        '--rel_ci',
+        type=float,
+        default=0.02,
+        help='Stop when the 95%% confidence interval is within +-rel_ci*mean.')
+    args = parser.parse_args()
+    return args
+
+
+def get_dev_info():
+    dev_info = platform.processor() or 'UNKNOWN CPU'
+    if os.path.exists('/proc/cpuinfo'):
+        with open('/proc/cpuinfo') as f:
+            for line in f:
+                if line.startswith('model name'):
+                    dev_info = line.split(':', 1)[1].strip()
+                    break
+    core_num = os.cpu_count() if hasattr(os, 'cpu_count') else 1
+    arch = platform.machine() or 'x86_64'
+    arch_type = [arch.upper()] * min(core_num, 8)
+    return dev_info, arch, core_num, arch_type
+
+
+def get_value(out, key):
+    lines = [_ for _ in out.split('\n') if key in _]
+    if not lines:
+        print('Failed to get {} from the output:\n{}'.format(key, out))
+        sys.exit(1)
+    return lines[-1]
+
+
+def get_op_latency(op_name, input_dims, param_info, args):
+    """Get op latency.
+
+    Returns:
+        tuple, (avg, min, max) latency and the output dims.
+    """
+    commands = [
+        args.bin_path, op_name, input_dims, param_info,
+        '--threads={}'.format(args.threads),
+        '--first_core={}'.format(args.first_core),
+        '--warmup={}'.format(args.warmup_times),
+        '--min_repeats={}'.format(args.min_repeats_times),
+        '--max_repeats={}'.format(args.max_repeats_times),
+        '--max_time_ms={}'.format(args.max_time_ms),
+        '--rel_ci={}'.format(args.rel_ci)
+    ]
+    proc = subprocess.Popen(
+        commands, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    out = proc.communicate()[0].decode()
+    latency = []
+    for key in ['Avg Latency', 'Min Latency', 'Max Latency']:
+        value = re.findall(r'\d+\.?\d*', get_value(out, key))[0]
+        latency.append(float(value))
+    output_dims = re.findall(r'\[.*\]', get_value(out, 'Output Dims'))[0]
+    return latency[0], latency[1], latency[2], output_dims
+
+
+def main():
+    args = get_args()
+    if not os.path.exists(args.bin_path):
+        print('{} is not found, please build the x86 tests first'.format(
+            args.bin_path))
+        sys.exit(1)
+    fid = open(args.ops_path, 'r')
+    handle = open(args.latency_lookup_table_path, 'w')
+    handle.write('{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\n'.format(
+        'dev_info'.ljust(30), 'armv7/v8'.ljust(10), 'core_num'.ljust(10),
+        'thread_num'.ljust(10), 'power_mode'.ljust(10), 'core0 arch'.ljust(10),
+        'core1 arch'.ljust(10), 'core2 arch'.ljust(10), 'core3 arch'.ljust(
+            10), 'core4 arch'.ljust(10), 'core5 arch'.ljust(
+                10), 'core6 arch'.ljust(10), 'core7 arch'.ljust(10)))
+    dev_info, arch, core_num, arch_type = get_dev_info()
+    # There is no power mode on x86, the threads are pinned from first_core.
+    handle.write('{}\t{}\t{}\t{}\t{}'.format(
+        dev_info.ljust(30),
+        str(arch).ljust(10),
+        str(core_num).ljust(10),
+        str(args.threads).ljust(10), str(0).ljust(10)))
+    for i in arch_type:
+        handle.write('\t{}'.format(i).ljust(10))
+    handle.write('\n')
+    handle.write('{}\t{}\t{}\t{}\t{}\t{}\t{}\n'.format('op_name'.ljust(
+        10), 'input_dims'.ljust(10), 'output_dims'.ljust(
+            10), 'param_info'.ljust(80), 'min_latency(ms)'.ljust(
+                10), 'max_latency(ms)'.ljust(10), 'avg_latency(ms)'.ljust(10)))
+    for line in fid.readlines():
+        line = line.strip()
+        if not line or line.startswith('#'):
+            continue
+        data_item = [_.strip() for _ in line.split('\t') if _.strip()]
+        cur_op_name = data_item[0]
+        input_dims = data_item[1]
+        param_info = data_item[2] if len(data_item) > 2 else '()'
+        params = [
+            _.strip()
+            for _ in re.split(r',\s*(?![^\[]*\])', param_info.strip('()'))
+            if _.strip()
+        ]
+        if not [_ for _ in params if _.startswith('dtype=')]:
+            params.append('dtype=float')
+        param_info = '(' + ','.join(params) + ')'
+        avg_latency, min_latency, max_latency, output_dims = get_op_latency(
+            cur_op_name, input_dims, param_info, args)
+        handle.write('{}\t{}\t{}\t{}\t{}\t{}\t{}\n'.format(
+            cur_op_name.ljust(10),
+            input_dims.ljust(10),
+            output_dims.ljust(10),
+            param_info.ljust(80),
+            str(min_latency).ljust(10),
+            str(max_latency).ljust(10), str(avg_latency).ljust(10)))
+        print('{}\t{}\t{}ms'.format(cur_op_name, input_dims, avg_latency))
+
+    fid.close()
+    handle.close()
+    print('Congratulations! Get Latency LookUp Table is Completed.')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,531 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measure the latency of an x86 op described by a line of ops_x86.txt, e.g.
+//   ./get_op_latency_x86 conv "[1 96 112 112]" "(ch_out=48, kernel=1x1)"
+//     --threads=1 --first_core=0
+// The op is created with its x86 kernel as the runtime program does, so all of
+// the implementations selected by the kernel (e.g. the impl_ of conv2d) are
+// covered by choosing the shapes and the params.
+
+#include <gflags/gflags.h>
+#include <stdio.h>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "lite/tests/benchmark/src/x86/op_latency_harness.h"
+
+DEFINE_int32(threads, 1, "The number of the threads.");
+DEFINE_int32(first_core,
+             0,
+             "Pin the threads to the cores from first_core, -1 to disable.");
+DEFINE_int32(warmup, 10, "The warmup times.");
+DEFINE_int32(min_repeats, 20, "The minimum repeat times.");
+DEFINE_int32(max_repeats, 1000, "The maximum repeat times.");
+DEFINE_double(max_time_ms, 2000.0, "The maximum measuring time in ms.");
+DEFINE_double(rel_ci,
+              0.02,
+              "Stop when the 95% confidence interval of the mean latency is "
+              "within +-rel_ci * mean.");
+
+namespace paddle {
+namespace lite {
+namespace benchmark {
+
+using OpBuilder = std::function<std::unique_ptr<OpRunner>(
+    const std::vector<int64_t>&, const OpParams&)>;
+
+// The name of the output var which is reported in the lookup table.
+const char kOutputName[] = "out";
+
+int64_t Production(const std::vector<int64_t>& dims) {
+  int64_t production = 1;
+  for (auto dim : dims) production *= dim;
+  return production;
+}
+
+// Zero out the weights randomly to make the sparse kernels meaningful.
+void Sparsify(Tensor* tensor, float sparsity) {
+  if (sparsity <= 0.f) return;
+  std::mt19937 rng(2021);
+  std::uniform_real_distribution<float> dist(0.f, 1.f);
+  auto* data = tensor->mutable_data<float>();
+  for (int64_t i = 0; i < tensor->numel(); i++) {
+    if (dist(rng) < sparsity) data[i] = 0.f;
+  }
+}
+
+// dtype: float, int8_float(int8 in, fp32 out) or int8_int8.
+void ParseDtype(const OpParams& params,
+                PrecisionType* precision,
+                std::string* alias) {
+  auto dtype = params.GetString("dtype", "float");
+  if (dtype == "float") {
+    *precision = PRECISION(kFloat);
+    *alias = "def";
+  } else if (dtype == "int8_float") {
+    *precision = PRECISION(kInt8);
+    *alias = "fp32_out";
+  } else if (dtype == "int8_int8") {
+    *precision = PRECISION(kInt8);
+    *alias = "int8_out";
+  } else {
+    LOG(FATAL) << "Unsupported dtype " << dtype;
+  }
+}
+
+std::unique_ptr<OpRunner> BuildConv(const std::vector<int64_t>& dims,
+                                    const OpParams& params) {
+  CHECK_EQ(dims.size(), 4UL);
+  int64_t ch_out = params.GetInt("ch_out", 1);
+  int group = params.GetInt("group", 1);
+  auto kernel = params.GetInts("kernel", 2, {3, 3});
+  auto strides = params.GetInts("stride", 2, {1, 1});
+  auto paddings = params.GetInts("pad", 4, {0, 0, 0, 0});
+  auto dilations = params.GetInts("dilation", 2, {1, 1});
+  bool flag_bias = params.GetInt("flag_bias", 0) != 0;
+  // 1: relu, 2: relu6, 4: leaky_relu, the same as the arm suite.
+  int flag_act = params.GetInt("flag_act", 0);
+  PrecisionType precision;
+  std::string alias;
+  ParseDtype(params, &precision, &alias);
+  bool int8 = precision == PRECISION(kInt8);
+  bool depthwise = group > 1 && group == dims[1] && group == ch_out;
+  std::unique_ptr<OpRunner> runner(new OpRunner(
+      depthwise ? "depthwise_conv2d" : "conv2d", precision, alias));
+  std::vector<int64_t> filter_dims{
+      ch_out, dims[1] / group, kernel[0], kernel[1]};
+  if (int8) {
+    runner->SetInput<int8_t>("Input", "input", dims, -127, 127);
+    runner->SetInput<int8_t>("Filter", "filter", filter_dims, -127, 127, true);
+  } else {
+    runner->SetInput<float>("Input", "input", dims, -1.f, 1.f);
+    auto* filter = runner->SetInput<float>(
+        "Filter", "filter", filter_dims, -1.f, 1.f, true);
+    Sparsify(filter, params.GetFloat("sparsity", 0.f));
+  }
+  if (flag_bias) {
+    runner->SetInput<float>("Bias", "bias", {ch_out}, -1.f, 1.f, true);
+  }
+  runner->AddOutput("Output", kOutputName);
+  auto* desc = runner->desc();
+  desc->SetAttr("strides", strides);
+  desc->SetAttr("paddings", paddings);
+  desc->SetAttr("dilations", dilations);
+  desc->SetAttr("groups", group);
+  if (flag_act > 0) {
+    desc->SetAttr("with_act", true);
+    if (flag_act == 1) {
+      desc->SetAttr<std::string>("act_type", "relu");
+    } else if (flag_act == 2) {
+      desc->SetAttr<std::string>("act_type", "relu6");
+      desc->SetAttr("fuse_brelu_threshold", 6.f);
+    } else if (flag_act == 4) {
+      desc->SetAttr<std::string>("act_type", "leaky_relu");
+      desc->SetAttr("leaky_relu_alpha", 0.1f);
+    } else {
+      LOG(FATAL) << "Unsupported flag_act " << flag_act;
+    }
+  }
+  if (params.Has("sparse")) {
+    desc->SetAttr("sparse_weight_type", params.GetString("sparse", ""));
+  }
+  if (int8) {
+    desc->SetAttr("enable_int8", true);
+    desc->SetAttr("Input0_scale", std::vector<float>{1.f / 127});
+    desc->SetAttr("Filter0_scale", std::vector<float>(ch_out, 1.f / 127));
+    desc->SetAttr("Output0_scale",
+                  std::vector<float>{Production(filter_dims) / ch_out / 127.f});
+  }
+  return runner;
+}
+
+std::unique_ptr<OpRunner> BuildFc(const std::vector<int64_t>& dims,
+                                  const OpParams& params) {
+  int in_num_col_dims = params.GetInt("in_num_col_dims", 1);
+  CHECK_LT(in_num_col_dims, static_cast<int>(dims.size()));
+  auto param_dim = params.GetInts("param_dim", 2, {1, 1});
+  int64_t k = param_dim[0];
+  int64_t n = param_dim[1];
+  CHECK_EQ(Production(std::vector<int64_t>(dims.begin() + in_num_col_dims,
+                                           dims.end())),
+           k)
+      << "The input dims mismatch with param_dim " << k << "x" << n;
+  bool flag_bias = params.GetInt("flag_bias", 1) != 0;
+  PrecisionType precision;
+  std::string alias;
+  ParseDtype(params, &precision, &alias);
+  bool int8 = precision == PRECISION(kInt8);
+  std::unique_ptr<OpRunner> runner(new OpRunner("fc", precision, alias));
+  if (int8) {
+    runner->SetInput<int8_t>("Input", "input", dims, -127, 127);
+    runner->SetInput<int8_t>("W", "w", {k, n}, -127, 127, true);
+  } else {
+    runner->SetInput<float>("Input", "input", dims, -1.f, 1.f);
+    auto* w = runner->SetInput<float>("W", "w", {k, n}, -1.f, 1.f, true);
+    Sparsify(w, params.GetFloat("sparsity", 0.f));
+  }
+  if (flag_bias) {
+    runner->SetInput<float>("Bias", "bias", {n}, -1.f, 1.f, true);
+  }
+  runner->AddOutput("Out", kOutputName);
+  auto* desc = runner->desc();
+  desc->SetAttr("in_num_col_dims", in_num_col_dims);
+  if (params.GetInt("flag_act", 0) == 1) {
+    desc->SetAttr<std::string>("activation_type", "relu");
+  }
+  if (params.Has("sparse")) {
+    desc->SetAttr("sparse_weight_type", params.GetString("sparse", ""));
+  }
+  if (int8) {
+    desc->SetAttr("enable_int8", true);
+    desc->SetAttr("Input0_scale", std::vector<float>{1.f / 127});
+    desc->SetAttr("W0_scale", std::vector<float>(n, 1.f / 127));
+    desc->SetAttr("Out0_scale", std::vector<float>{k / 127.f});
+  }
+  return runner;
+}
+
+std::unique_ptr<OpRunner> BuildMul(const std::vector<int64_t>& dims,
+                                   const OpParams& params) {
+  auto param_dim = params.GetInts("param_dim", 2, {1, 1});
+  std::unique_ptr<OpRunner> runner(new OpRunner("mul"));
+  runner->SetInput<float>("X", "x", dims, -1.f, 1.f);
+  auto* y = runner->SetInput<float>(
+      "Y", "y", {param_dim[0], param_dim[1]}, -1.f, 1.f, true);
+  Sparsify(y, params.GetFloat("sparsity", 0.f));
+  runner->AddOutput("Out", kOutputName);
+  auto* desc = runner->desc();
+  desc->SetAttr("x_num_col_dims", params.GetInt("x_num_col_dims", 1));
+  desc->SetAttr("y_num_col_dims", 1);
+  if (params.Has("sparse")) {
+    desc->SetAttr("sparse_weight_type", params.GetString("sparse", ""));
+  }
+  return runner;
+}
+
+std::unique_ptr<OpRunner> BuildMatmul(const std::vector<int64_t>& dims,
+                                      const OpParams& params) {
+  auto y_dims = ParseDims(params.GetString("y_dims", "[1 1]"));
+  std::unique_ptr<OpRunner> runner(new OpRunner("matmul"));
+  runner->SetInput<float>("X", "x", dims, -1.f, 1.f);
+  runner->SetInput<float>("Y", "y", y_dims, -1.f, 1.f);
+  runner->AddOutput("Out", kOutputName);
+  auto* desc = runner->desc();
+  desc->SetAttr("transpose_X", params.GetInt("transpose_x", 0) != 0);
+  desc->SetAttr("transpose_Y", params.GetInt("transpose_y", 0) != 0);
+  desc->SetAttr("alpha", params.GetFloat("alpha", 1.f));
+  return runner;
+}
+
+std::unique_ptr<OpRunner> BuildPooling(const std::vector<int64_t>& dims,
+                                       const OpParams& params) {
+  CHECK_EQ(dims.size(), 4UL);
+  std::unique_ptr<OpRunner> runner(new OpRunner("pool2d"));
+  runner->SetInput<float>("X", "x", dims, -1.f, 1.f);
+  runner->AddOutput("Out", kOutputName);
+  auto* desc = runner->desc();
+  desc->SetAttr<std::string>("pooling_type",
+                             params.GetString("pooling_type", "max"));
+  desc->SetAttr("ksize", params.GetInts("kernel", 2, {2, 2}));
+  desc->SetAttr("global_pooling", params.GetInt("flag_global", 0) != 0);
+  desc->SetAttr("strides", params.GetInts("stride", 2, {2, 2}));
+  desc->SetAttr("paddings", params.GetInts("pad", 4, {0, 0, 0, 0}));
+  desc->SetAttr("exclusive", params.GetInt("exclusive", 1) != 0);
+  desc->SetAttr("ceil_mode", params.GetInt("ceil_mode", 0) != 0);
+  desc->SetAttr("adaptive", params.GetInt("adaptive", 0) != 0);
+  return runner;
+}
+
+std::unique_ptr<OpRunner> BuildElementwise(const std::vector<int64_t>& dims,
+                                           const OpParams& params) {
+  // The broadcast is decided by y_dims and axis, the same as the op.
+  auto y_dims =
+      params.Has("y_dims") ? ParseDims(params.GetString("y_dims", "")) : dims;
+  auto elt_type = params.GetString("elt_type", "add");
+  auto act_type = params.GetString("act_type", "");
+  auto op_type = "elementwise_" + elt_type;
+  if (!act_type.empty()) {
+    op_type = "fusion_" + op_type + "_activation";
+  }
+  std::unique_ptr<OpRunner> runner(new OpRunner(op_type));
+  runner->SetInput<float>("X", "x", dims, 1.f, 2.f);
+  runner->SetInput<float>("Y", "y", y_dims, 1.f, 2.f);
+  runner->AddOutput("Out", kOutputName);
+  runner->desc()->SetAttr("axis", params.GetInt("axis", -1));
+  if (!act_type.empty()) {
+    runner->desc()->SetAttr("act_type", act_type);
+  }
+  return runner;
+}
+
+std::unique_ptr<OpRunner> BuildSoftmax(const std::vector<int64_t>& dims,
+                                       const OpParams& params) {
+  std::unique_ptr<OpRunner> runner(new OpRunner("softmax"));
+  runner->SetInput<float>("X", "x", dims, -1.f, 1.f);
+  runner->AddOutput("Out", kOutputName);
+  runner->desc()->SetAttr("axis", params.GetInt("axis", -1));
+  return runner;
+}
+
+std::unique_ptr<OpRunner> BuildLayerNorm(const std::vector<int64_t>& dims,
+                                         const OpParams& params) {
+  int begin_norm_axis = params.GetInt("begin_norm_axis", 1);
+  CHECK(begin_norm_axis > 0 &&
+        begin_norm_axis < static_cast<int>(dims.size()));
+  int64_t norm_size = Production(
+      std::vector<int64_t>(dims.begin() + begin_norm_axis, dims.end()));
+  std::unique_ptr<OpRunner> runner(new OpRunner("layer_norm"));
+  runner->SetInput<float>("X", "x", dims, -1.f, 1.f);
+  runner->SetInput<float>("Scale", "scale", {norm_size}, -1.f, 1.f, true);
+  runner->SetInput<float>("Bias", "bias", {norm_size}, -1.f, 1.f, true);
+  runner->AddOutput("Y", kOutputName);
+  runner->AddOutput("Mean", "mean");
+  runner->AddOutput("Variance", "variance");
+  auto* desc = runner->desc();
+  desc->SetAttr("begin_norm_axis", begin_norm_axis);
+  desc->SetAttr("epsilon", params.GetFloat("epsilon", 1e-5f));
+  return runner;
+}
+
+// input_dims are the dims of the ids, e.g. [128 1].
+std::unique_ptr<OpRunner> BuildLookupTable(const std::vector<int64_t>& dims,
+                                           const OpParams& params) {
+  int64_t vocab_size = params.GetInt("vocab_size", 10000);
+  int64_t emb_dim = params.GetInt("emb_dim", 128);
+  std::unique_ptr<OpRunner> runner(new OpRunner("lookup_table"));
+  runner->SetInput<float>("W", "w", {vocab_size, emb_dim}, -1.f, 1.f, true);
+  runner->SetInput<int64_t>("Ids", "ids", dims, 0, vocab_size - 1);
+  runner->AddOutput("Out", kOutputName);
+  runner->desc()->SetAttr<int64_t>("padding_idx",
+                                   params.GetInt("padding_idx", -1));
+  return runner;
+}
+
+// input_dims are [total_steps 3*hidden_size] which are split into seq_num
+// sequences of the same length.
+std::unique_ptr<OpRunner> BuildGru(const std::vector<int64_t>& dims,
+                                   const OpParams& params) {
+  CHECK_EQ(dims.size(), 2UL);
+  CHECK_EQ(dims[1] % 3, 0) << "The width of the input should be 3 * hidden.";
+  int64_t hidden_size = dims[1] / 3;
+  int64_t seq_num = params.GetInt("seq_num", 1);
+  CHECK_EQ(dims[0] % seq_num, 0);
+  std::unique_ptr<OpRunner> runner(new OpRunner("gru"));
+  auto* input = runner->SetInput<float>("Input", "input", dims, -1.f, 1.f);
+  LoD lod(1);
+  for (int64_t i = 0; i <= seq_num; i++) {
+    lod[0].push_back(i * dims[0] / seq_num);
+  }
+  input->set_lod(lod);
+  runner->SetInput<float>(
+      "Weight", "weight", {hidden_size, 3 * hidden_size}, -1.f, 1.f, true);
+  runner->SetInput<float>(
+      "Bias", "bias", {1, 3 * hidden_size}, -1.f, 1.f, true);
+  runner->desc()->SetInput("H0", {});
+  runner->AddOutput("BatchGate", "batch_gate");
+  runner->AddOutput("BatchResetHiddenPrev", "batch_reset_hidden_prev");
+  runner->AddOutput("BatchHidden", "batch_hidden");
+  runner->AddOutput("Hidden", kOutputName);
+  auto* desc = runner->desc();
+  desc->SetAttr<std::string>("gate_activation", "sigmoid");
+  desc->SetAttr<std::string>("activation", "tanh");
+  desc->SetAttr("is_reverse", params.GetInt("is_reverse", 0) != 0);
+  desc->SetAttr("origin_mode", params.GetInt("origin_mode", 0) != 0);
+  return runner;
+}
+
+// input_dims are [seq_len batch input_size] of the rnn op in the LSTM mode.
+std::unique_ptr<OpRunner> BuildLstm(const std::vector<int64_t>& dims,
+                                    const OpParams& params) {
+  CHECK_EQ(dims.size(), 3UL);
+  int hidden_size = params.GetInt("hidden_size", 128);
+  int num_layers = params.GetInt("num_layers", 1);
+  bool is_bidirec = params.GetInt("is_bidirec", 0) != 0;
+  int direction_num = is_bidirec ? 2 : 1;
+  const int gate_num = 4;
+  std::unique_ptr<OpRunner> runner(new OpRunner("rnn"));
+  runner->SetInput<float>("Input", "input", dims, -1.f, 1.f);
+  // [FWhi, FWhh, BWhi, BWhh] * num_layers + [FBhi, FBhh, BBhi, BBhh] *
+  // num_layers
+  for (int layer = 0; layer < num_layers; layer++) {
+    int64_t input_size = layer == 0 ? dims[2] : hidden_size * direction_num;
+    for (int d = 0; d < direction_num; d++) {
+      auto prefix = "w_" + std::to_string(layer) + "_" + std::to_string(d);
+      runner->SetInput<float>("WeightList",
+                              prefix + "_ih",
+                              {gate_num * hidden_size, input_size},
+                              -0.1f,
+                              0.1f,
+                              true);
+      runner->SetInput<float>("WeightList",
+                              prefix + "_hh",
+                              {gate_num * hidden_size, hidden_size},
+                              -0.1f,
+                              0.1f,
+                              true);
+    }
+  }
+  for (int layer = 0; layer < num_layers; layer++) {
+    for (int d = 0; d < direction_num; d++) {
+      auto prefix = "b_" + std::to_string(layer) + "_" + std::to_string(d);
+      for (auto suffix : {"_ih", "_hh"}) {
+        runner->SetInput<float>("WeightList",
+                                prefix + suffix,
+                                {gate_num * hidden_size},
+                                -0.1f,
+                                0.1f,
+                                true);
+      }
+    }
+  }
+  std::vector<int64_t> state_dims{num_layers * direction_num, dims[1],
+                                  hidden_size};
+  runner->SetInput<float>("PreState", "init_h", state_dims, -1.f, 1.f);
+  runner->SetInput<float>("PreState", "init_c", state_dims, -1.f, 1.f);
+  runner->AddOutput("Out", kOutputName);
+  runner->AddOutput("State", "last_h");
+  runner->AddOutput("State", "last_c");
+  runner->AddOutput("DropoutState", "dropout_state");
+  runner->AddOutput("Reserve", "reserve");
+  auto* desc = runner->desc();
+  desc->SetAttr("dropout_prob", 0.f);
+  desc->SetAttr("is_bidirec", is_bidirec);
+  desc->SetAttr("input_size", static_cast<int>(dims[2]));
+  desc->SetAttr("hidden_size", hidden_size);
+  desc->SetAttr("num_layers", num_layers);
+  desc->SetAttr<std::string>("mode", "LSTM");
+  desc->SetAttr("is_test", true);
+  desc->SetAttr("seed", 0);
+  return runner;
+}
+
+std::unique_ptr<OpRunner> BuildBatchNorm(const std::vector<int64_t>& dims,
+                                         const OpParams& params) {
+  CHECK_GE(dims.size(), 2UL);
+  std::vector<int64_t> channel_dims{dims[1]};
+  std::unique_ptr<OpRunner> runner(new OpRunner("batch_norm"));
+  runner->SetInput<float>("X", "x", dims, -1.f, 1.f);
+  runner->SetInput<float>("Scale", "scale", channel_dims, -1.f, 1.f, true);
+  runner->SetInput<float>("Bias", "bias", channel_dims, -1.f, 1.f, true);
+  runner->SetInput<float>("Mean", "mean", channel_dims, -1.f, 1.f, true);
+  runner->SetInput<float>(
+      "Variance", "variance", channel_dims, 0.5f, 1.f, true);
+  runner->AddOutput("Y", kOutputName);
+  auto* desc = runner->desc();
+  desc->SetAttr("is_test", true);
+  desc->SetAttr("use_global_stats", true);
+  desc->SetAttr("epsilon", params.GetFloat("epsilon", 1e-4f));
+  desc->SetAttr("momentum", params.GetFloat("momentum", 0.9f));
+  desc->SetAttr<std::string>("data_layout", "NCHW");
+  return runner;
+}
+
+std::unique_ptr<OpRunner> BuildActivation(const std::vector<int64_t>& dims,
+                                          const OpParams& params) {
+  auto act_type = params.GetString("act_type", "relu");
+  std::unique_ptr<OpRunner> runner(new OpRunner(act_type));
+  runner->SetInput<float>("X", "x", dims, -1.f, 1.f);
+  runner->AddOutput("Out", kOutputName);
+  auto* desc = runner->desc();
+  if (act_type == "leaky_relu") {
+    desc->SetAttr("alpha", 0.1f);
+  } else if (act_type == "relu6") {
+    desc->SetAttr("threshold", 6.f);
+  } else if (act_type == "mish") {
+    desc->SetAttr("threshold", 20.f);
+  } else if (act_type == "hard_swish") {
+    desc->SetAttr("threshold", 6.f);
+    desc->SetAttr("scale", 6.f);
+    desc->SetAttr("offset", 3.f);
+  }
+  return runner;
+}
+
+const std::map<std::string, OpBuilder>& GetOpBuilders() {
+  static const std::map<std::string, OpBuilder> builders{
+      {"conv", BuildConv},
+      {"fc", BuildFc},
+      {"mul", BuildMul},
+      {"matmul", BuildMatmul},
+      {"pooling", BuildPooling},
+      {"elementwise", BuildElementwise},
+      {"softmax", BuildSoftmax},
+      {"layer_norm", BuildLayerNorm},
+      {"lookup_table", BuildLookupTable},
+      {"gru", BuildGru},
+      {"lstm", BuildLstm},
+      {"batchnorm", BuildBatchNorm},
+      {"activation", BuildActivation}};
+  return builders;
+}
+
+}  // namespace benchmark
+}  // namespace lite
+}  // namespace paddle
+
+int main(int argc, char** argv) {
+  using paddle::lite::benchmark::GetOpBuilders;
+  gflags::SetUsageMessage(
+      "get_op_latency_x86 <op_name> <input_dims> <param_info> [--threads=1] "
+      "[--first_core=0] [--warmup=10] [--min_repeats=20] "
+      "[--max_repeats=1000] [--max_time_ms=2000] [--rel_ci=0.02]");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  if (argc != 4) {
+    std::cerr << gflags::ProgramUsage() << "\n  op_name: ";
+    for (auto& builder : GetOpBuilders()) {
+      std::cerr << builder.first << " ";
+    }
+    std::cerr << std::endl;
+    return 0;
+  }
+  auto& builders = GetOpBuilders();
+  auto it = builders.find(argv[1]);
+  if (it == builders.end()) {
+    std::cerr << "Unsupported op " << argv[1] << std::endl;
+    return 1;
+  }
+  paddle::lite::benchmark::BenchmarkOptions options;
+  options.threads = FLAGS_threads;
+  options.first_core = FLAGS_first_core;
+  options.warmup = FLAGS_warmup;
+  options.min_repeats = FLAGS_min_repeats;
+  options.max_repeats = std::max(FLAGS_max_repeats, FLAGS_min_repeats);
+  options.max_time_ms = FLAGS_max_time_ms;
+  options.rel_ci = FLAGS_rel_ci;
+  paddle::lite::benchmark::PinThreads(options.threads, options.first_core);
+
+  auto runner = it->second(paddle::lite::benchmark::ParseDims(argv[2]),
+                           paddle::lite::benchmark::OpParams(argv[3]));
+  runner->Prepare();
+  auto* output = runner->GetOutput(paddle::lite::benchmark::kOutputName);
+  CHECK(output);
+  auto output_dims = output->dims().Vectorize();
+  std::string output_dims_str;
+  for (auto dim : output_dims) {
+    output_dims_str += (output_dims_str.empty() ? "" : " ") +
+                       std::to_string(dim);
+  }
+  printf("Kernel is %s\n", runner->kernel_summary().c_str());
+  printf("Output Dims is [%s]\n", output_dims_str.c_str());
+  auto stats = paddle::lite::benchmark::MeasureLatency(
+      [&]() { runner->Run(); }, options);
+  paddle::lite::benchmark::PrintLatency(stats);
+  return 0;
+}
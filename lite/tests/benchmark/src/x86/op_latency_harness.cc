@@ -0,0 +1,272 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/tests/benchmark/src/x86/op_latency_harness.h"
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cmath>
+#include <sstream>
+#include <utility>
+#include "lite/backends/x86/parallel.h"
+#include "lite/core/context.h"
+
+namespace paddle {
+namespace lite {
+namespace benchmark {
+
+namespace {
+
+bool PinCurrentThread(int core) {
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(core, &mask);
+  return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+  return false;
+#endif
+}
+
+std::string Trim(const std::string& str) {
+  auto begin = str.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos) return "";
+  auto end = str.find_last_not_of(" \t\r\n");
+  return str.substr(begin, end - begin + 1);
+}
+
+}  // namespace
+
+bool PinThreads(int threads, int first_core) {
+  threads = std::max(threads, 1);
+  x86::SetNumThreads(threads);
+  if (first_core < 0) return true;
+  bool success = PinCurrentThread(first_core);
+#if defined(_OPENMP)
+  int failures = 0;
+#pragma omp parallel num_threads(threads) reduction(+ : failures)
+  {
+    if (!PinCurrentThread(first_core + omp_get_thread_num())) failures++;
+  }
+  success = success && failures == 0;
+#endif
+  if (!success) {
+    LOG(WARNING) << "Failed to pin " << threads << " threads from core "
+                 << first_core;
+  }
+  return success;
+}
+
+LatencyStats MeasureLatency(const std::function<void()>& func,
+                            const BenchmarkOptions& options) {
+  using Clock = std::chrono::steady_clock;
+  for (int i = 0; i < options.warmup; i++) {
+    func();
+  }
+  std::vector<double> laps;
+  double sum = 0;
+  double square_sum = 0;
+  auto begin = Clock::now();
+  while (static_cast<int>(laps.size()) < options.max_repeats) {
+    auto start = Clock::now();
+    func();
+    auto stop = Clock::now();
+    double lap =
+        std::chrono::duration<double, std::milli>(stop - start).count();
+    laps.push_back(lap);
+    sum += lap;
+    square_sum += lap * lap;
+    int n = laps.size();
+    if (n < options.min_repeats) continue;
+    double mean = sum / n;
+    double variance = std::max(square_sum / n - mean * mean, 0.0);
+    double half_width = 1.96 * std::sqrt(variance / n);
+    if (half_width <= options.rel_ci * mean) break;
+    double elapsed =
+        std::chrono::duration<double, std::milli>(stop - begin).count();
+    if (elapsed >= options.max_time_ms) break;
+  }
+  LatencyStats stats;
+  stats.repeats = laps.size();
+  if (laps.empty()) return stats;
+  stats.avg = sum / stats.repeats;
+  stats.stddev =
+      std::sqrt(std::max(square_sum / stats.repeats - stats.avg * stats.avg,
+                         0.0));
+  std::sort(laps.begin(), laps.end());
+  stats.min = laps.front();
+  stats.max = laps.back();
+  stats.median = laps[laps.size() / 2];
+  return stats;
+}
+
+void PrintLatency(const LatencyStats& stats) {
+  printf("Repeats is %d\n", stats.repeats);
+  printf("Median Latency is %f\n", stats.median);
+  printf("Stddev Latency is %f\n", stats.stddev);
+  printf("Avg Latency is %f\n", stats.avg);
+  printf("Min Latency is %f\n", stats.min);
+  printf("Max Latency is %f\n", stats.max);
+}
+
+std::vector<int64_t> ParseDims(const std::string& str) {
+  std::string dims_str = str;
+  std::replace(dims_str.begin(), dims_str.end(), '[', ' ');
+  std::replace(dims_str.begin(), dims_str.end(), ']', ' ');
+  std::replace(dims_str.begin(), dims_str.end(), ',', ' ');
+  std::stringstream ss(dims_str);
+  std::vector<int64_t> dims;
+  int64_t dim;
+  while (ss >> dim) {
+    dims.push_back(dim);
+  }
+  return dims;
+}
+
+OpParams::OpParams(const std::string& str) {
+  auto params_str = Trim(str);
+  if (!params_str.empty() && params_str.front() == '(') {
+    params_str = params_str.substr(1);
+  }
+  if (!params_str.empty() && params_str.back() == ')') {
+    params_str.pop_back();
+  }
+  // Split by the commas outside of the brackets.
+  int depth = 0;
+  std::string item;
+  auto add_item = [&]() {
+    auto pos = item.find('=');
+    if (pos != std::string::npos) {
+      params_[Trim(item.substr(0, pos))] = Trim(item.substr(pos + 1));
+    }
+    item.clear();
+  };
+  for (auto c : params_str) {
+    if (c == '[') depth++;
+    if (c == ']') depth--;
+    if (c == ',' && depth == 0) {
+      add_item();
+    } else {
+      item.push_back(c);
+    }
+  }
+  add_item();
+}
+
+std::string OpParams::GetString(const std::string& key,
+                                const std::string& def) const {
+  auto it = params_.find(key);
+  return it == params_.end() ? def : it->second;
+}
+
+int OpParams::GetInt(const std::string& key, int def) const {
+  auto it = params_.find(key);
+  return it == params_.end() ? def : std::stoi(it->second);
+}
+
+float OpParams::GetFloat(const std::string& key, float def) const {
+  auto it = params_.find(key);
+  if (it == params_.end()) return def;
+  auto value = it->second;
+  if (!value.empty() && (value.back() == 'f' || value.back() == 'F')) {
+    value.pop_back();
+  }
+  return std::stof(value);
+}
+
+std::vector<int> OpParams::GetInts(const std::string& key,
+                                   size_t size,
+                                   const std::vector<int>& def) const {
+  auto it = params_.find(key);
+  if (it == params_.end()) return def;
+  auto value = it->second;
+  std::replace(value.begin(), value.end(), 'x', ' ');
+  auto dims = ParseDims(value);
+  std::vector<int> values(dims.begin(), dims.end());
+  if (values.size() == 1 && size > 1) {
+    values.resize(size, values[0]);
+  }
+  CHECK_EQ(values.size(), size) << "Invalid value '" << it->second
+                                << "' of the param " << key;
+  return values;
+}
+
+OpRunner::OpRunner(const std::string& op_type,
+                   PrecisionType precision,
+                   const std::string& alias)
+    : op_type_(op_type),
+      place_(TARGET(kX86), precision),
+      alias_(alias),
+      scope_(new Scope) {
+  desc_.SetType(op_type);
+}
+
+void OpRunner::AddInput(const std::string& arg_name,
+                        const std::string& var_name) {
+  auto names = desc_.HasInput(arg_name) ? desc_.Input(arg_name)
+                                        : std::vector<std::string>();
+  names.push_back(var_name);
+  desc_.SetInput(arg_name, names);
+  scope_->Var(var_name);
+}
+
+void OpRunner::AddOutput(const std::string& arg_name,
+                         const std::string& var_name) {
+  auto names = desc_.HasOutput(arg_name) ? desc_.Output(arg_name)
+                                         : std::vector<std::string>();
+  names.push_back(var_name);
+  desc_.SetOutput(arg_name, names);
+  scope_->Var(var_name)->GetMutable<Tensor>();
+}
+
+void OpRunner::Prepare() {
+  auto op = LiteOpRegistry::Global().Create(op_type_);
+  CHECK(op) << "No op found for " << op_type_;
+  op->Attach(desc_, scope_.get());
+  auto kernels = op->CreateKernels({place_});
+  auto it = std::find_if(
+      kernels.begin(), kernels.end(), [&](std::unique_ptr<KernelBase>& k) {
+        return k->alias() == alias_;
+      });
+  CHECK(it != kernels.end()) << "No kernel found for " << op_type_ << " in "
+                             << place_.DebugString()
+                             << " with alias: " << alias_;
+  (*it)->SetContext(ContextScheduler::Global().NewContext(TARGET(kX86)));
+  instruction_.reset(new Instruction(op, std::move(*it)));
+#ifdef LITE_WITH_PROFILE
+  profiler_.reset(new profile::Profiler());
+  instruction_->set_profiler(profiler_.get());
+#endif
+  // The kernel is prepared in the first run.
+  Run();
+}
+
+const Tensor* OpRunner::GetOutput(const std::string& var_name) const {
+  return scope_->FindTensor(var_name);
+}
+
+std::string OpRunner::kernel_summary() const {
+  CHECK(instruction_);
+  return instruction_->kernel()->summary();
+}
+
+}  // namespace benchmark
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,151 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/program.h"
+#include "lite/core/scope.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace benchmark {
+
+struct BenchmarkOptions {
+  int threads{1};
+  // Pin the i-th worker thread to the core 'first_core + i', -1 to disable.
+  int first_core{0};
+  int warmup{10};
+  int min_repeats{20};
+  int max_repeats{1000};
+  // Stop early once the measurement has been running for max_time_ms.
+  double max_time_ms{2000.0};
+  // Stop once the half width of the 95% confidence interval of the mean is
+  // less than rel_ci * mean.
+  double rel_ci{0.02};
+};
+
+struct LatencyStats {
+  double min{0};
+  double max{0};
+  double avg{0};
+  double median{0};
+  double stddev{0};
+  int repeats{0};
+};
+
+// Set the number of the threads of the x86 kernels and bind the calling thread
+// and the OpenMP workers to the successive cores. Return false if the threads
+// can't be pinned on this platform.
+bool PinThreads(int threads, int first_core);
+
+// Run 'func' for the warmup times, then measure it until the statistical
+// stopping criterion of 'options' is satisfied. The latencies are in ms.
+LatencyStats MeasureLatency(const std::function<void()>& func,
+                            const BenchmarkOptions& options);
+
+// Print the latencies in the format parsed by get_latency_lookup_table*.py.
+void PrintLatency(const LatencyStats& stats);
+
+// Parse '[1 3 224 224]' into the dims.
+std::vector<int64_t> ParseDims(const std::string& str);
+
+/*
+ * Parse the param info of ops.txt, e.g. '(ch_out=48, stride=[1 1], kernel=3x3)'
+ * and provide the typed accessors with the default values.
+ */
+class OpParams {
+ public:
+  explicit OpParams(const std::string& str);
+
+  bool Has(const std::string& key) const { return params_.count(key) > 0; }
+  std::string GetString(const std::string& key, const std::string& def) const;
+  int GetInt(const std::string& key, int def) const;
+  float GetFloat(const std::string& key, float def) const;
+  // '[1 2]', '1' (repeated for 'size' times) or '3x3' are supported.
+  std::vector<int> GetInts(const std::string& key,
+                           size_t size,
+                           const std::vector<int>& def) const;
+
+ private:
+  std::map<std::string, std::string> params_;
+};
+
+/*
+ * Create a single op with its x86 kernel, the inputs are filled with random
+ * values and the outputs are resized by the InferShape of the op, so each Run
+ * measures the same work as an instruction of the runtime program.
+ */
+class OpRunner {
+ public:
+  OpRunner(const std::string& op_type,
+           PrecisionType precision = PRECISION(kFloat),
+           const std::string& alias = "def");
+
+  cpp::OpDesc* desc() { return &desc_; }
+  Scope* scope() { return scope_.get(); }
+
+  template <typename T>
+  Tensor* SetInput(const std::string& arg_name,
+                   const std::string& var_name,
+                   const std::vector<int64_t>& dims,
+                   T min,
+                   T max,
+                   bool persistable = false) {
+    auto* tensor = scope_->NewTensor(var_name);
+    tensor->Resize(dims);
+    auto* data = tensor->mutable_data<T>();
+    std::uniform_real_distribution<double> dist(static_cast<double>(min),
+                                                static_cast<double>(max));
+    for (int64_t i = 0; i < tensor->numel(); i++) {
+      data[i] = static_cast<T>(dist(rng_));
+    }
+    tensor->set_persistable(persistable);
+    AddInput(arg_name, var_name);
+    return tensor;
+  }
+  void AddInput(const std::string& arg_name, const std::string& var_name);
+  void AddOutput(const std::string& arg_name, const std::string& var_name);
+
+  // Create the op and pick the kernel by the alias, then run it once.
+  void Prepare();
+  void Run() { instruction_->Run(); }
+
+  const Tensor* GetOutput(const std::string& var_name) const;
+  std::string kernel_summary() const;
+
+ private:
+  std::string op_type_;
+  Place place_;
+  std::string alias_;
+  std::mt19937 rng_{2021};
+  cpp::OpDesc desc_;
+  std::unique_ptr<Scope> scope_;
+#ifdef LITE_WITH_PROFILE
+  // Declared before the instruction, which refers to it until destroyed.
+  std::unique_ptr<profile::Profiler> profiler_;
+#endif
+  std::unique_ptr<Instruction> instruction_;
+};
+
+}  // namespace benchmark
+}  // namespace lite
+}  // namespace paddle
@@ -157,7 +157,7 @@ class ElementwiseComputeTester : public arena::TestCase {
         act_type_(act_type) {}
 
   void RunBaseline(Scope* scope) override {
-    if (axis_ < 0) {
+    if (axis_ < 0 || x_dims_.size() == y_dims_.size()) {
       axis_ = x_dims_.size() - y_dims_.size();
     }
     auto x_shape = x_dims_.Vectorize();
@@ -224,6 +224,9 @@ class ElementwiseComputeTester : public arena::TestCase {
       } else if (act_type_ == "sigmoid") {
         for (int i = 0; i < x_dims_.production(); i++)
           out_data[i] = NaiveSigmoid(out_data[i]);
+      } else if (act_type_ == "abs") {
+        for (int i = 0; i < x_dims_.production(); i++)
+          out_data[i] = std::abs(out_data[i]);
       } else {
         LOG(FATAL) << "unsupported act_type:" << act_type_;
       }
@@ -389,7 +392,33 @@ void TestEltFuseActFloat(Place place, float abs_error) {
     TestElt<float>(place, abs_error, elt_type, {2, 3, 14, 5}, {3}, 1, "tanh");
     TestElt<float>(
         place, abs_error, elt_type, {2, 3, 14, 5}, {3}, 1, "sigmoid");
+    TestElt<float>(place, abs_error, elt_type, {2, 16, 64}, {64}, -1, "abs");
+  }
+}
+
+void TestEltBroadcastX86(Place place, float abs_error) {
+  for (auto elt_type : std::vector<std::string>{"add", "sub", "mul", "div"}) {
+    // The bias, the scale and the scalar of (batch, seq_len, hidden).
+    TestElt<float>(place, abs_error, elt_type, {2, 16, 67}, {67}, -1);
+    TestElt<float>(place, abs_error, elt_type, {2, 16, 67}, {2, 16, 1}, -1);
+    TestElt<float>(place, abs_error, elt_type, {2, 16, 67}, {1}, -1);
+    // The attention mask of (batch, heads, seq_len, seq_len).
+    TestElt<float>(place, abs_error, elt_type, {2, 4, 9, 9}, {2, 1, 1, 9}, -1);
+    TestElt<float>(place, abs_error, elt_type, {2, 3, 4, 5}, {2, 1, 4, 1}, 0);
+    // The axis is ignored by the same shape.
+    TestElt<float>(place, abs_error, elt_type, {2, 3, 4}, {2, 3, 4}, 1);
+    TestElt<float>(
+        place, abs_error, elt_type, {2, 16, 67}, {2, 16, 1}, -1, "relu");
   }
+  TestElt<int>(place, abs_error, "add", {2, 16, 67}, {67}, -1, "", "int32");
+  TestElt<int>(place,
+               abs_error,
+               "mul",
+               {2, 4, 9, 9},
+               {2, 1, 1, 9},
+               -1,
+               "",
+               "int32");
 }
 #endif
 
@@ -499,6 +528,7 @@ TEST(Elementwise, precision) {
   TestEltFuseAct(place, abs_error);
 #ifdef LITE_WITH_X86
   TestEltFuseActFloat(place, abs_error);
+  TestEltBroadcastX86(place, abs_error);
 #endif
 }
 
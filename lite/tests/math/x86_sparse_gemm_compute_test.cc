@@ -0,0 +1,229 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef LITE_WITH_X86
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/sparse_gemm.h"
+#include "lite/core/context.h"
+#include "lite/core/optimizer/mir/x86_sparse_weight_detect_pass.h"
+#include "lite/core/profile/timer.h"
+#include "lite/core/tensor.h"
+#include "lite/tests/utils/fill_data.h"
+
+typedef paddle::lite::Tensor Tensor;
+using paddle::lite::profile::Timer;
+using paddle::lite::x86::math::BlockSparseMatrix;
+using paddle::lite::x86::math::SparseBlockType;
+
+void basic_gemm_fp32(bool traA,
+                     bool traB,
+                     int M,
+                     int N,
+                     int K,
+                     const float *A,
+                     int lda,
+                     const float *B,
+                     int ldb,
+                     float *C,
+                     int ldc) {
+  std::unique_ptr<paddle::lite::KernelContext> ctx1(
+      new paddle::lite::KernelContext);
+  auto &ctx = ctx1->As<paddle::lite::X86Context>();
+  paddle::lite::x86::math::Blas<paddle::lite::TargetType::kX86> matmul(ctx);
+  matmul.GEMM<float>(traA, traB, M, N, K, 1.f, A, lda, B, ldb, 0.f, C, ldc);
+}
+
+// Zero the blocks of a row-major [rows, cols] matrix with the given sparsity.
+void sparsify(float *data,
+              int rows,
+              int cols,
+              int block_h,
+              int block_w,
+              float sparsity) {
+  std::mt19937 rng(rows * cols);
+  std::uniform_real_distribution<float> dist(0.f, 1.f);
+  for (int r0 = 0; r0 < rows; r0 += block_h) {
+    for (int c0 = 0; c0 < cols; c0 += block_w) {
+      if (dist(rng) >= sparsity) continue;
+      for (int r = r0; r < std::min(r0 + block_h, rows); r++) {
+        for (int c = c0; c < std::min(c0 + block_w, cols); c++) {
+          data[r * cols + c] = 0.f;
+        }
+      }
+    }
+  }
+}
+
+float max_diff(const float *a, const float *b, int size) {
+  float max_err = 0.f;
+  for (int i = 0; i < size; i++) {
+    max_err = std::max(max_err, std::fabs(a[i] - b[i]));
+  }
+  return max_err;
+}
+
+// conv1x1: C[m, n] = A[m, k] * B[k, n], A is sparse.
+bool test_sparse_dense_gemm(
+    int m, int n, int k, SparseBlockType type, float sparsity, int repeat) {
+  int block_h = type == SparseBlockType::kBlock4x4 ? 4 : 1;
+  int block_w = type == SparseBlockType::kUnstructured ? 1 : 4;
+  Tensor ta, tb, tc, tc_basic;
+  ta.Resize({m, k});
+  tb.Resize({k, n});
+  tc.Resize({m, n});
+  tc_basic.Resize({m, n});
+  fill_tensor_rand(ta, -1.f, 1.f);
+  fill_tensor_rand(tb, -1.f, 1.f);
+  auto a_ptr = ta.mutable_data<float>();
+  sparsify(a_ptr, m, k, block_h, block_w, sparsity);
+  auto b_ptr = tb.data<float>();
+  auto c_ptr = tc.mutable_data<float>();
+  auto c_basic_ptr = tc_basic.mutable_data<float>();
+
+  Timer t0, t1;
+  for (int i = 0; i < repeat; i++) {
+    t0.Start();
+    basic_gemm_fp32(false, false, m, n, k, a_ptr, k, b_ptr, n, c_basic_ptr, n);
+    t0.Stop();
+  }
+  BlockSparseMatrix sparse;
+  paddle::lite::x86::math::PackBlockSparseMatrix(
+      a_ptr, m, k, false, type, &sparse);
+  for (int i = 0; i < repeat; i++) {
+    t1.Start();
+    paddle::lite::x86::math::SparseDenseGemm(sparse, b_ptr, n, c_ptr);
+    t1.Stop();
+  }
+  LOG(INFO) << "sparse x dense M: " << m << ", N: " << n << ", K: " << k
+            << ", block: " << block_h << "x" << block_w
+            << ", sparsity: " << sparsity
+            << ", dense(ms): " << t0.LapTimes().Avg()
+            << ", sparse(ms): " << t1.LapTimes().Avg()
+            << ", speedup: " << t0.LapTimes().Avg() / t1.LapTimes().Avg();
+  return max_diff(c_ptr, c_basic_ptr, m * n) < 1e-3f;
+}
+
+// fc: C[m, n] = relu(B[m, k] * W[k, n] + bias), W is sparse.
+bool test_dense_sparse_gemm(
+    int m, int n, int k, SparseBlockType type, float sparsity, int repeat) {
+  int block_h = type == SparseBlockType::kBlock4x4 ? 4 : 1;
+  int block_w = type == SparseBlockType::kUnstructured ? 1 : 4;
+  Tensor tw, twt, tb, tc, tc_basic, tbias;
+  tw.Resize({k, n});
+  twt.Resize({n, k});
+  tb.Resize({m, k});
+  tc.Resize({m, n});
+  tc_basic.Resize({m, n});
+  tbias.Resize({n});
+  fill_tensor_rand(twt, -1.f, 1.f);
+  fill_tensor_rand(tb, -1.f, 1.f);
+  fill_tensor_rand(tbias, -1.f, 1.f);
+  // The blocks are laid out on the transposed weights.
+  auto wt_ptr = twt.mutable_data<float>();
+  sparsify(wt_ptr, n, k, block_h, block_w, sparsity);
+  auto w_ptr = tw.mutable_data<float>();
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < k; j++) {
+      w_ptr[j * n + i] = wt_ptr[i * k + j];
+    }
+  }
+  auto b_ptr = tb.data<float>();
+  auto bias_ptr = tbias.data<float>();
+  auto c_ptr = tc.mutable_data<float>();
+  auto c_basic_ptr = tc_basic.mutable_data<float>();
+
+  Timer t0, t1;
+  for (int i = 0; i < repeat; i++) {
+    t0.Start();
+    basic_gemm_fp32(false, false, m, n, k, b_ptr, k, w_ptr, n, c_basic_ptr, n);
+    for (int y = 0; y < m; y++) {
+      for (int x = 0; x < n; x++) {
+        float v = c_basic_ptr[y * n + x] + bias_ptr[x];
+        c_basic_ptr[y * n + x] = std::max(v, 0.f);
+      }
+    }
+    t0.Stop();
+  }
+  BlockSparseMatrix sparse;
+  paddle::lite::x86::math::PackBlockSparseMatrix(
+      w_ptr, n, k, true, type, &sparse);
+  for (int i = 0; i < repeat; i++) {
+    t1.Start();
+    paddle::lite::x86::math::DenseSparseGemm(
+        b_ptr, m, sparse, bias_ptr, true, c_ptr);
+    t1.Stop();
+  }
+  LOG(INFO) << "dense x sparse M: " << m << ", N: " << n << ", K: " << k
+            << ", block: " << block_h << "x" << block_w
+            << ", sparsity: " << sparsity
+            << ", dense(ms): " << t0.LapTimes().Avg()
+            << ", sparse(ms): " << t1.LapTimes().Avg()
+            << ", speedup: " << t0.LapTimes().Avg() / t1.LapTimes().Avg();
+  return max_diff(c_ptr, c_basic_ptr, m * n) < 1e-3f;
+}
+
+TEST(TestX86SparseGemm, sparse_gemm_compute) {
+  for (auto type : {SparseBlockType::kUnstructured,
+                    SparseBlockType::kBlock1x4,
+                    SparseBlockType::kBlock4x4}) {
+    for (auto sparsity : {0.f, 0.5f, 0.9f}) {
+      for (int mm : {1, 7, 64}) {
+        for (int nn : {3, 33, 196}) {
+          for (int kk : {2, 35, 128}) {
+            if (!test_sparse_dense_gemm(mm, nn, kk, type, sparsity, 1)) {
+              LOG(FATAL) << "sparse x dense precision check failed!";
+            }
+            if (!test_dense_sparse_gemm(mm, nn, kk, type, sparsity, 1)) {
+              LOG(FATAL) << "dense x sparse precision check failed!";
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TestX86SparseGemm, speedup_vs_sparsity) {
+  for (auto type : {SparseBlockType::kUnstructured,
+                    SparseBlockType::kBlock1x4,
+                    SparseBlockType::kBlock4x4}) {
+    for (auto sparsity : {0.5f, 0.6f, 0.7f, 0.8f, 0.9f, 0.95f}) {
+      // conv1x1 of the last stage of mobilenet_v1 and a 1024x1000 fc
+      EXPECT_TRUE(test_sparse_dense_gemm(1024, 49, 1024, type, sparsity, 10));
+      EXPECT_TRUE(test_dense_sparse_gemm(1, 1000, 1024, type, sparsity, 10));
+    }
+  }
+}
+
+TEST(TestX86SparseGemm, detect_sparse_weight_type) {
+  int rows = 64;
+  int cols = 64;
+  Tensor tw;
+  tw.Resize({rows, cols});
+  fill_tensor_rand(tw, 0.5f, 1.f);
+  auto w_ptr = tw.mutable_data<float>();
+  paddle::lite::mir::X86SparseWeightDetectPass pass;
+  pass.SetSparseThreshold(0.5f);
+  EXPECT_EQ(pass.DetectSparseWeightType(w_ptr, rows, cols, false), "");
+  sparsify(w_ptr, rows, cols, 4, 4, 0.8f);
+  EXPECT_EQ(pass.DetectSparseWeightType(w_ptr, rows, cols, false), "4x4");
+}
+
+#endif  // LITE_WITH_X86
@@ -46,6 +46,13 @@
 #define QUANT_INPUT_OUTPUT_SCALE_RESTRICT_METHOD \
   "QUANT_INPUT_OUTPUT_SCALE_RESTRICT_METHOD"
 
+// The environment variables for the constant folding, use "CONSTANT_FOLDING_"
+// as prefix.
+// The maximum bytes of the outputs of an op folded by constant_folding_pass,
+// 1048576(default), the op whose outputs are larger than both of it and the
+// inputs is kept to avoid blowing up the model.
+#define CONSTANT_FOLDING_MAX_BYTES "CONSTANT_FOLDING_MAX_BYTES"
+
 namespace paddle {
 namespace lite {
 
@@ -58,6 +58,36 @@ inline const flatbuffers::TypeTable *ParamDescTypeTable();
 
 namespace ParamDesc_ {
 
+enum CompressType {
+  CompressType_NONE = 0,
+  CompressType_BYTE_SHUFFLE = 1,
+  CompressType_MIN = CompressType_NONE,
+  CompressType_MAX = CompressType_BYTE_SHUFFLE
+};
+
+inline const CompressType (&EnumValuesCompressType())[2] {
+  static const CompressType values[] = {
+    CompressType_NONE,
+    CompressType_BYTE_SHUFFLE
+  };
+  return values;
+}
+
+inline const char * const *EnumNamesCompressType() {
+  static const char * const names[3] = {
+    "NONE",
+    "BYTE_SHUFFLE",
+    nullptr
+  };
+  return names;
+}
+
+inline const char *EnumNameCompressType(CompressType e) {
+  if (flatbuffers::IsOutRange(e, CompressType_NONE, CompressType_BYTE_SHUFFLE)) return "";
+  const size_t index = static_cast<size_t>(e);
+  return EnumNamesCompressType()[index];
+}
+
 enum VariableDesc {
   VariableDesc_NONE = 0,
   VariableDesc_LoDTensorDesc = 1,
@@ -255,9 +285,13 @@ struct LoDTensorDescT : public flatbuffers::NativeTable {
   std::vector<int64_t> dim;
   paddle::lite::fbs::proto::VarType_::Type data_type;
   std::vector<int8_t> data;
+  paddle::lite::fbs::proto::ParamDesc_::CompressType compress_type;
+  uint64_t raw_size;
   LoDTensorDescT()
       : lod_level(0),
-        data_type(paddle::lite::fbs::proto::VarType_::Type_BOOL) {
+        data_type(paddle::lite::fbs::proto::VarType_::Type_BOOL),
+        compress_type(paddle::lite::fbs::proto::ParamDesc_::CompressType_NONE),
+        raw_size(0) {
   }
 };
 
@@ -267,7 +301,9 @@ inline bool operator==(const LoDTensorDescT &lhs, const LoDTensorDescT &rhs) {
       (lhs.lod == rhs.lod) &&
       (lhs.dim == rhs.dim) &&
       (lhs.data_type == rhs.data_type) &&
-      (lhs.data == rhs.data);
+      (lhs.data == rhs.data) &&
+      (lhs.compress_type == rhs.compress_type) &&
+      (lhs.raw_size == rhs.raw_size);
 }
 
 inline bool operator!=(const LoDTensorDescT &lhs, const LoDTensorDescT &rhs) {
@@ -286,7 +322,9 @@ struct LoDTensorDesc FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_LOD = 6,
     VT_DIM = 8,
     VT_DATA_TYPE = 10,
-    VT_DATA = 12
+    VT_DATA = 12,
+    VT_COMPRESS_TYPE = 14,
+    VT_RAW_SIZE = 16
   };
   int32_t lod_level() const {
     return GetField<int32_t>(VT_LOD_LEVEL, 0);
@@ -318,6 +356,18 @@ struct LoDTensorDesc FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   flatbuffers::Vector<int8_t> *mutable_data() {
     return GetPointer<flatbuffers::Vector<int8_t> *>(VT_DATA);
   }
+  paddle::lite::fbs::proto::ParamDesc_::CompressType compress_type() const {
+    return static_cast<paddle::lite::fbs::proto::ParamDesc_::CompressType>(GetField<int8_t>(VT_COMPRESS_TYPE, 0));
+  }
+  bool mutate_compress_type(paddle::lite::fbs::proto::ParamDesc_::CompressType _compress_type) {
+    return SetField<int8_t>(VT_COMPRESS_TYPE, static_cast<int8_t>(_compress_type), 0);
+  }
+  uint64_t raw_size() const {
+    return GetField<uint64_t>(VT_RAW_SIZE, 0);
+  }
+  bool mutate_raw_size(uint64_t _raw_size) {
+    return SetField<uint64_t>(VT_RAW_SIZE, _raw_size, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<int32_t>(verifier, VT_LOD_LEVEL) &&
@@ -328,6 +378,8 @@ struct LoDTensorDesc FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyField<int32_t>(verifier, VT_DATA_TYPE) &&
            VerifyOffset(verifier, VT_DATA) &&
            verifier.VerifyVector(data()) &&
+           VerifyField<int8_t>(verifier, VT_COMPRESS_TYPE) &&
+           VerifyField<uint64_t>(verifier, VT_RAW_SIZE) &&
            verifier.EndTable();
   }
   LoDTensorDescT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -354,6 +406,12 @@ struct LoDTensorDescBuilder {
   void add_data(flatbuffers::Offset<flatbuffers::Vector<int8_t>> data) {
     fbb_.AddOffset(LoDTensorDesc::VT_DATA, data);
   }
+  void add_compress_type(paddle::lite::fbs::proto::ParamDesc_::CompressType compress_type) {
+    fbb_.AddElement<int8_t>(LoDTensorDesc::VT_COMPRESS_TYPE, static_cast<int8_t>(compress_type), 0);
+  }
+  void add_raw_size(uint64_t raw_size) {
+    fbb_.AddElement<uint64_t>(LoDTensorDesc::VT_RAW_SIZE, raw_size, 0);
+  }
   explicit LoDTensorDescBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -372,13 +430,17 @@ inline flatbuffers::Offset<LoDTensorDesc> CreateLoDTensorDesc(
     flatbuffers::Offset<flatbuffers::Vector<int64_t>> lod = 0,
     flatbuffers::Offset<flatbuffers::Vector<int64_t>> dim = 0,
     paddle::lite::fbs::proto::VarType_::Type data_type = paddle::lite::fbs::proto::VarType_::Type_BOOL,
-    flatbuffers::Offset<flatbuffers::Vector<int8_t>> data = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<int8_t>> data = 0,
+    paddle::lite::fbs::proto::ParamDesc_::CompressType compress_type = paddle::lite::fbs::proto::ParamDesc_::CompressType_NONE,
+    uint64_t raw_size = 0) {
   LoDTensorDescBuilder builder_(_fbb);
+  builder_.add_raw_size(raw_size);
   builder_.add_data(data);
   builder_.add_data_type(data_type);
   builder_.add_dim(dim);
   builder_.add_lod(lod);
   builder_.add_lod_level(lod_level);
+  builder_.add_compress_type(compress_type);
   return builder_.Finish();
 }
 
@@ -388,7 +450,9 @@ inline flatbuffers::Offset<LoDTensorDesc> CreateLoDTensorDescDirect(
     const std::vector<int64_t> *lod = nullptr,
     const std::vector<int64_t> *dim = nullptr,
     paddle::lite::fbs::proto::VarType_::Type data_type = paddle::lite::fbs::proto::VarType_::Type_BOOL,
-    const std::vector<int8_t> *data = nullptr) {
+    const std::vector<int8_t> *data = nullptr,
+    paddle::lite::fbs::proto::ParamDesc_::CompressType compress_type = paddle::lite::fbs::proto::ParamDesc_::CompressType_NONE,
+    uint64_t raw_size = 0) {
   auto lod__ = lod ? _fbb.CreateVector<int64_t>(*lod) : 0;
   auto dim__ = dim ? _fbb.CreateVector<int64_t>(*dim) : 0;
   auto data__ = data ? _fbb.CreateVector<int8_t>(*data) : 0;
@@ -398,7 +462,9 @@ inline flatbuffers::Offset<LoDTensorDesc> CreateLoDTensorDescDirect(
       lod__,
       dim__,
       data_type,
-      data__);
+      data__,
+      compress_type,
+      raw_size);
 }
 
 flatbuffers::Offset<LoDTensorDesc> CreateLoDTensorDesc(flatbuffers::FlatBufferBuilder &_fbb, const LoDTensorDescT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
@@ -679,6 +745,8 @@ inline void LoDTensorDesc::UnPackTo(LoDTensorDescT *_o, const flatbuffers::resol
   { auto _e = dim(); if (_e) { _o->dim.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->dim[_i] = _e->Get(_i); } } }
   { auto _e = data_type(); _o->data_type = _e; }
   { auto _e = data(); if (_e) { _o->data.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->data[_i] = _e->Get(_i); } } }
+  { auto _e = compress_type(); _o->compress_type = _e; }
+  { auto _e = raw_size(); _o->raw_size = _e; }
 }
 
 inline flatbuffers::Offset<LoDTensorDesc> LoDTensorDesc::Pack(flatbuffers::FlatBufferBuilder &_fbb, const LoDTensorDescT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -694,13 +762,17 @@ inline flatbuffers::Offset<LoDTensorDesc> CreateLoDTensorDesc(flatbuffers::FlatB
   auto _dim = _fbb.CreateVector(_o->dim);
   auto _data_type = _o->data_type;
   auto _data = _fbb.CreateVector(_o->data);
+  auto _compress_type = _o->compress_type;
+  auto _raw_size = _o->raw_size;
   return paddle::lite::fbs::proto::ParamDesc_::CreateLoDTensorDesc(
       _fbb,
       _lod_level,
       _lod,
       _dim,
       _data_type,
-      _data);
+      _data,
+      _compress_type,
+      _raw_size);
 }
 
 inline VersionDescT *VersionDesc::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
@@ -840,6 +912,24 @@ inline void VariableDescUnion::Reset() {
   type = VariableDesc_NONE;
 }
 
+inline const flatbuffers::TypeTable *CompressTypeTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_CHAR, 0, 0 },
+    { flatbuffers::ET_CHAR, 0, 0 }
+  };
+  static const flatbuffers::TypeFunction type_refs[] = {
+    paddle::lite::fbs::proto::ParamDesc_::CompressTypeTypeTable
+  };
+  static const char * const names[] = {
+    "NONE",
+    "BYTE_SHUFFLE"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_ENUM, 2, type_codes, type_refs, nullptr, names
+  };
+  return &tt;
+}
+
 inline const flatbuffers::TypeTable *VariableDescTypeTable() {
   static const flatbuffers::TypeCode type_codes[] = {
     { flatbuffers::ET_SEQUENCE, 0, -1 },
@@ -884,20 +974,25 @@ inline const flatbuffers::TypeTable *LoDTensorDescTypeTable() {
     { flatbuffers::ET_LONG, 1, -1 },
     { flatbuffers::ET_LONG, 1, -1 },
     { flatbuffers::ET_INT, 0, 0 },
-    { flatbuffers::ET_CHAR, 1, -1 }
+    { flatbuffers::ET_CHAR, 1, -1 },
+    { flatbuffers::ET_CHAR, 0, 1 },
+    { flatbuffers::ET_ULONG, 0, -1 }
   };
   static const flatbuffers::TypeFunction type_refs[] = {
-    paddle::lite::fbs::proto::VarType_::TypeTypeTable
+    paddle::lite::fbs::proto::VarType_::TypeTypeTable,
+    paddle::lite::fbs::proto::ParamDesc_::CompressTypeTypeTable
   };
   static const char * const names[] = {
     "lod_level",
     "lod",
     "dim",
     "data_type",
-    "data"
+    "data",
+    "compress_type",
+    "raw_size"
   };
   static const flatbuffers::TypeTable tt = {
-    flatbuffers::ST_TABLE, 5, type_codes, type_refs, nullptr, names
+    flatbuffers::ST_TABLE, 7, type_codes, type_refs, nullptr, names
   };
   return &tt;
 }